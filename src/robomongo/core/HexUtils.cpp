@@ -2,8 +2,148 @@
 
 #include <mongo/util/hex.h>
 #include <pcrecpp.h>
+#include <cstring>
 #include <iostream>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ROBOMONGO_HEX_SSE2
+#endif
+
+// AVX2 code is compiled for every x86-64 build and used only when CPU supports it
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define ROBOMONGO_HEX_AVX2
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define ROBOMONGO_TARGET_AVX2
+#else
+#define ROBOMONGO_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace
+{
+    const char hexDigits[] = "0123456789abcdef";
+    const char base64Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    // Order of bytes of legacy UUIDs, as they are shown in every encoding
+    const unsigned char uuidOrder[][16] = {
+        { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },   // Default and Python
+        { 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8 },   // Java: both halves reversed
+        { 3, 2, 1, 0, 5, 4, 7, 6, 8, 9, 10, 11, 12, 13, 14, 15 }    // C#: first three groups reversed
+    };
+
+#ifdef ROBOMONGO_HEX_SSE2
+    // Nibbles (0..15) to lowercase hex digits
+    inline __m128i hexFromNibbles(__m128i nibbles)
+    {
+        __m128i const letters = _mm_and_si128(_mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9)), _mm_set1_epi8('a' - '0' - 10));
+        return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), letters);
+    }
+#endif
+
+#ifdef ROBOMONGO_HEX_AVX2
+    bool hasAvx2()
+    {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7)
+            return false;
+
+        // AVX state has to be enabled by OS as well
+        __cpuid(info, 1);
+        if (!(info[2] & (1 << 27)) || (_xgetbv(0) & 6) != 6)
+            return false;
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+
+    bool const useAvx2 = hasAvx2();
+
+    ROBOMONGO_TARGET_AVX2 inline __m256i hexFromNibbles(__m256i nibbles)
+    {
+        __m256i const letters = _mm256_and_si256(_mm256_cmpgt_epi8(nibbles, _mm256_set1_epi8(9)), _mm256_set1_epi8('a' - '0' - 10));
+        return _mm256_add_epi8(_mm256_add_epi8(nibbles, _mm256_set1_epi8('0')), letters);
+    }
+
+    // Splits 3-byte groups into 6-bit values, one per byte ("Faster Base64
+    // Encoding and Decoding using AVX2 Instructions", W. Mula, D. Lemire)
+    ROBOMONGO_TARGET_AVX2 inline __m256i base64Reshuffle(__m256i input)
+    {
+        __m256i const in = _mm256_shuffle_epi8(input, _mm256_set_epi8(
+            10, 11,  9, 10,  7,  8,  6,  7,  4,  5,  3,  4,  1,  2,  0,  1,
+            14, 15, 13, 14, 11, 12, 10, 11,  8,  9,  7,  8,  5,  6,  4,  5));
+
+        __m256i const t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+        __m256i const t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+        __m256i const t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+        __m256i const t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+        return _mm256_or_si256(t1, t3);
+    }
+
+    // 6-bit values to base64 alphabet
+    ROBOMONGO_TARGET_AVX2 inline __m256i base64Translate(__m256i in)
+    {
+        __m256i const lut = _mm256_setr_epi8(
+            65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0,
+            65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+        __m256i indices = _mm256_subs_epu8(in, _mm256_set1_epi8(51));
+        __m256i const mask = _mm256_cmpgt_epi8(in, _mm256_set1_epi8(25));
+        indices = _mm256_sub_epi8(indices, mask);
+        return _mm256_add_epi8(in, _mm256_shuffle_epi8(lut, indices));
+    }
+
+    // Converts 32-byte blocks, returns number of bytes converted
+    ROBOMONGO_TARGET_AVX2 size_t toHexLowerAvx2(const unsigned char *in, size_t len, char *out)
+    {
+        size_t done = 0;
+        for (; len - done >= 32; done += 32) {
+            __m256i const v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + done));
+            __m256i const lo = hexFromNibbles(_mm256_and_si256(v, _mm256_set1_epi8(0x0f)));
+            __m256i const hi = hexFromNibbles(_mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0f)));
+
+            // Unpack works within 128-bit lanes, so lanes are put in order afterwards
+            __m256i const first = _mm256_unpacklo_epi8(hi, lo);
+            __m256i const second = _mm256_unpackhi_epi8(hi, lo);
+            char *const dest = out + 2 * done;
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest), _mm256_permute2x128_si256(first, second, 0x20));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + 32), _mm256_permute2x128_si256(first, second, 0x31));
+        }
+        return done;
+    }
+
+    // Encodes 24-byte blocks while 32 bytes can be read, returns number of bytes encoded.
+    // Every iteration reads 32 bytes starting 4 bytes before the current position and
+    // encodes 24 of them. The first load is masked, in order not to touch memory before the data.
+    ROBOMONGO_TARGET_AVX2 size_t toBase64Avx2(const unsigned char *in, size_t len, char *out)
+    {
+        if (len < 32)
+            return 0;
+
+        size_t done = 0;
+        __m256i v = _mm256_maskload_epi32(reinterpret_cast<const int *>(in - 4),
+                                          _mm256_set_epi32(0x80000000, 0x80000000, 0x80000000, 0x80000000,
+                                                           0x80000000, 0x80000000, 0x80000000, 0x00000000));
+        while (true) {
+            v = base64Translate(base64Reshuffle(v));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + done / 3 * 4), v);
+            done += 24;
+            if (len - done < 32)
+                break;
+            v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + done - 4));
+        }
+        return done;
+    }
+#endif
+}
+
 namespace Robomongo
 {
     namespace HexUtils
@@ -21,9 +161,72 @@ namespace Robomongo
 
         std::string toStdHexLower(const char *raw, int len)
         {
-            const void* in = reinterpret_cast<const void*>(raw);
-            std::string stdstr = mongo::toHexLower(in, len);
-            return stdstr;
+            std::string result(2 * len, '\0');
+            toHexLower(raw, len, &result[0]);
+            return result;
+        }
+
+        void toHexLower(const char *raw, size_t len, char *out)
+        {
+            const unsigned char *in = reinterpret_cast<const unsigned char *>(raw);
+
+#ifdef ROBOMONGO_HEX_AVX2
+            if (useAvx2) {
+                size_t const done = toHexLowerAvx2(in, len, out);
+                len -= done;
+                in += done;
+                out += 2 * done;
+            }
+#endif
+
+#ifdef ROBOMONGO_HEX_SSE2
+            for (; len >= 16; len -= 16, in += 16, out += 32) {
+                __m128i const v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+                __m128i const lo = hexFromNibbles(_mm_and_si128(v, _mm_set1_epi8(0x0f)));
+                __m128i const hi = hexFromNibbles(_mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0f)));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_unpacklo_epi8(hi, lo));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 16), _mm_unpackhi_epi8(hi, lo));
+            }
+#endif
+
+            for (; len > 0; --len, ++in, out += 2) {
+                out[0] = hexDigits[*in >> 4];
+                out[1] = hexDigits[*in & 0x0f];
+            }
+        }
+
+        size_t toBase64(const char *raw, size_t len, char *out)
+        {
+            const unsigned char *in = reinterpret_cast<const unsigned char *>(raw);
+            char *const start = out;
+
+#ifdef ROBOMONGO_HEX_AVX2
+            if (useAvx2) {
+                size_t const done = toBase64Avx2(in, len, out);
+                len -= done;
+                in += done;
+                out += done / 3 * 4;
+            }
+#endif
+
+            for (; len >= 3; len -= 3, in += 3, out += 4) {
+                unsigned const triple = (unsigned(in[0]) << 16) | (unsigned(in[1]) << 8) | in[2];
+                out[0] = base64Alphabet[(triple >> 18) & 0x3f];
+                out[1] = base64Alphabet[(triple >> 12) & 0x3f];
+                out[2] = base64Alphabet[(triple >> 6) & 0x3f];
+                out[3] = base64Alphabet[triple & 0x3f];
+            }
+
+            if (len > 0) {
+                unsigned const triple = (unsigned(in[0]) << 16) | (len > 1 ? unsigned(in[1]) << 8 : 0);
+                out[0] = base64Alphabet[(triple >> 18) & 0x3f];
+                out[1] = base64Alphabet[(triple >> 12) & 0x3f];
+                out[2] = len > 1 ? base64Alphabet[(triple >> 6) & 0x3f] : '=';
+                out[3] = '=';
+                out += 4;
+            }
+
+            return out - start;
         }
 
         const char *fromHex(const std::string &s, int *outBytes)
@@ -154,13 +357,64 @@ namespace Robomongo
             return uuidToHex(uuid);
         }
 
-        std::string formatUuid(const mongo::BSONElement &element, Robomongo::UUIDEncoding encoding)
+        size_t formatUuid(const mongo::BSONElement &element, Robomongo::UUIDEncoding encoding, char *buffer)
         {
             mongo::BinDataType binType = element.binDataType();
 
             if (binType != mongo::newUUID && binType != mongo::bdtUUID)
                 throw std::invalid_argument("Binary subtype should be 3 (bdtUUID) or 4 (newUUID)");
 
+            int len;
+            const char *data = element.binData(len);
+            if (len != 16)
+                return 0;
+
+            const char *prefix = "UUID(\"";
+            const unsigned char *order = uuidOrder[0];
+            if (binType == mongo::bdtUUID) {
+                switch(encoding) {
+                case JavaLegacy:   prefix = "JUUID(\"";  order = uuidOrder[1]; break;
+                case CSharpLegacy: prefix = "NUUID(\"";  order = uuidOrder[2]; break;
+                case PythonLegacy: prefix = "PYUUID(\""; break;
+                default:           prefix = "LUUID(\""; break;
+                }
+            }
+
+            char bytes[16];
+            for (int i = 0; i < 16; ++i)
+                bytes[i] = data[order[i]];
+
+            char hex[32];
+            toHexLower(bytes, 16, hex);
+
+            // 8-4-4-4-12 groups of hex digits
+            size_t const prefixSize = strlen(prefix);
+            char *out = buffer;
+            memcpy(out, prefix, prefixSize);
+            out += prefixSize;
+            memcpy(out, hex, 8);
+            out[8] = '-';
+            memcpy(out + 9, hex + 8, 4);
+            out[13] = '-';
+            memcpy(out + 14, hex + 12, 4);
+            out[18] = '-';
+            memcpy(out + 19, hex + 16, 4);
+            out[23] = '-';
+            memcpy(out + 24, hex + 20, 12);
+            out[36] = '"';
+            out[37] = ')';
+            return prefixSize + 38;
+        }
+
+        std::string formatUuid(const mongo::BSONElement &element, Robomongo::UUIDEncoding encoding)
+        {
+            char buffer[UuidBufferSize];
+            size_t const size = formatUuid(element, encoding, buffer);
+            if (size)
+                return std::string(buffer, size);
+
+            // UUID of unusual size
+            mongo::BinDataType binType = element.binDataType();
             int len;
             const char *data = element.binData(len);
             std::string hex = HexUtils::toStdHexLower(data, len);
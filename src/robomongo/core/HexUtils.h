@@ -22,8 +22,26 @@ namespace Robomongo
      */
     namespace HexUtils
     {
+        enum {
+            UuidBufferSize = 48 // enough for PYUUID("xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx")
+        };
+
         bool isHexString(const std::string &hex);
         std::string toStdHexLower(const char *raw, int len);
+
+        /**
+         * @brief Writes 2 * len lowercase hex digits of raw bytes to "out" (SSE2, and AVX2 when CPU supports it)
+         */
+        void toHexLower(const char *raw, size_t len, char *out);
+
+        /**
+         * @brief Writes base64 (standard alphabet, with padding) of raw bytes to "out",
+         * which should have room for base64Size(len) characters (AVX2 when CPU supports it).
+         * @return number of characters written.
+         */
+        size_t toBase64(const char *raw, size_t len, char *out);
+        inline size_t base64Size(size_t len) { return (len + 2) / 3 * 4; }
+
         /**
          * @param str: data in hex format.
          * @param outBytes: out param - number of bytes in array.
@@ -44,5 +62,11 @@ namespace Robomongo
         std::string javaUuidToHex(const std::string &uuid);
         std::string pythonUuidToHex(const std::string &uuid);
         std::string formatUuid(const mongo::BSONElement &element, UUIDEncoding encoding);
+
+        /**
+         * @brief Writes UUID element, i.e. LUUID("..."), to buffer of at least UuidBufferSize bytes.
+         * @return number of characters written, or 0 if UUID data is not 16 bytes long.
+         */
+        size_t formatUuid(const mongo::BSONElement &element, UUIDEncoding encoding, char *buffer);
     }
 }
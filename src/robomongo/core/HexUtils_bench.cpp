@@ -0,0 +1,64 @@
+#include "gtest/gtest.h"
+#include "HexUtils.h"
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <mongo/util/base64.h>
+#include <mongo/util/hex.h>
+
+namespace
+{
+    std::string randomBytes(size_t len)
+    {
+        std::string bytes(len, '\0');
+        unsigned state = 12345;
+        for (size_t i = 0; i < len; ++i) {
+            state = state * 1103515245 + 12345;
+            bytes[i] = static_cast<char>(state >> 16);
+        }
+        return bytes;
+    }
+
+    std::string mongoBase64(const std::string &bytes)
+    {
+        std::stringstream ss;
+        mongo::base64::encode(ss, bytes.data(), bytes.size());
+        return ss.str();
+    }
+}
+
+TEST(hex_utils_bench, toHexLower_toBase64_Throughput)
+{
+    std::string const bytes = randomBytes(16 * 1024 * 1024);
+    using std::chrono::steady_clock;
+
+    auto const start = steady_clock::now();
+    std::string const mongoHex = mongo::toHexLower(bytes.data(), bytes.size());
+    auto const mongoHexDone = steady_clock::now();
+
+    std::string hex(2 * bytes.size(), '\0');
+    Robomongo::HexUtils::toHexLower(bytes.data(), bytes.size(), &hex[0]);
+    auto const hexDone = steady_clock::now();
+
+    std::string const mongoBase = mongoBase64(bytes);
+    auto const mongoBaseDone = steady_clock::now();
+
+    std::string base(Robomongo::HexUtils::base64Size(bytes.size()), '\0');
+    Robomongo::HexUtils::toBase64(bytes.data(), bytes.size(), &base[0]);
+    auto const baseDone = steady_clock::now();
+
+    EXPECT_EQ(mongoHex, hex);
+    EXPECT_EQ(mongoBase, base);
+
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    std::cout << "[ BENCH    ] " << bytes.size() << " bytes; "
+              << "hex: mongo " << duration_cast<microseconds>(mongoHexDone - start).count() << " us, "
+              << "HexUtils " << duration_cast<microseconds>(hexDone - mongoHexDone).count() << " us; "
+              << "base64: mongo " << duration_cast<microseconds>(mongoBaseDone - hexDone).count() << " us, "
+              << "HexUtils " << duration_cast<microseconds>(baseDone - mongoBaseDone).count() << " us"
+              << std::endl;
+}
@@ -1,8 +1,13 @@
 #include "gtest/gtest.h"
 #include "HexUtils.h"
 
+#include <sstream>
 #include <string>
 
+#include <mongo/bson/bsonobjbuilder.h>
+#include <mongo/util/base64.h>
+#include <mongo/util/hex.h>
+
 /* Example Test:
 *
 * TEST( [Test_Case_Name], [Test_Name] )
@@ -17,3 +22,75 @@ TEST(hex_utils_tests, test_1)
     EXPECT_TRUE(Robomongo::HexUtils::isHexString("a"));
 }
 
+
+namespace
+{
+    std::string randomBytes(size_t len)
+    {
+        std::string bytes(len, '\0');
+        unsigned state = 12345;
+        for (size_t i = 0; i < len; ++i) {
+            state = state * 1103515245 + 12345;
+            bytes[i] = static_cast<char>(state >> 16);
+        }
+        return bytes;
+    }
+
+    std::string mongoBase64(const std::string &bytes)
+    {
+        std::stringstream ss;
+        mongo::base64::encode(ss, bytes.data(), bytes.size());
+        return ss.str();
+    }
+
+    mongo::BSONObj uuidDocument(mongo::BinDataType type, const std::string &bytes)
+    {
+        mongo::BSONObjBuilder builder;
+        builder.appendBinData("uuid", bytes.size(), type, bytes.data());
+        return builder.obj();
+    }
+}
+
+TEST(hex_utils_tests, toHexLower_AllLengths_MatchesMongo)
+{
+    std::string const bytes = randomBytes(300);
+    for (size_t len = 0; len <= bytes.size(); ++len) {
+        std::string hex(2 * len, '\0');
+        Robomongo::HexUtils::toHexLower(bytes.data() + 1, len, &hex[0]);
+        ASSERT_EQ(mongo::toHexLower(bytes.data() + 1, len), hex) << len;
+    }
+}
+
+TEST(hex_utils_tests, toBase64_AllLengths_MatchesMongo)
+{
+    std::string const bytes = randomBytes(300);
+    for (size_t len = 0; len <= bytes.size(); ++len) {
+        std::string const data = bytes.substr(1, len);
+        std::string base64(Robomongo::HexUtils::base64Size(len), '\0');
+        size_t const size = Robomongo::HexUtils::toBase64(data.data(), len, &base64[0]);
+        ASSERT_EQ(base64.size(), size);
+        ASSERT_EQ(mongoBase64(data), base64) << len;
+    }
+}
+
+TEST(hex_utils_tests, formatUuid_AllEncodings_MatchesHexToUuid)
+{
+    using namespace Robomongo;
+    std::string const bytes = randomBytes(16);
+    std::string const hex = HexUtils::toStdHexLower(bytes.data(), bytes.size());
+
+    mongo::BSONObj const legacy = uuidDocument(mongo::bdtUUID, bytes);
+    EXPECT_EQ("LUUID(\"" + HexUtils::hexToUuid(hex, DefaultEncoding) + "\")", HexUtils::formatUuid(legacy.firstElement(), DefaultEncoding));
+    EXPECT_EQ("JUUID(\"" + HexUtils::hexToUuid(hex, JavaLegacy) + "\")", HexUtils::formatUuid(legacy.firstElement(), JavaLegacy));
+    EXPECT_EQ("NUUID(\"" + HexUtils::hexToUuid(hex, CSharpLegacy) + "\")", HexUtils::formatUuid(legacy.firstElement(), CSharpLegacy));
+    EXPECT_EQ("PYUUID(\"" + HexUtils::hexToUuid(hex, PythonLegacy) + "\")", HexUtils::formatUuid(legacy.firstElement(), PythonLegacy));
+
+    mongo::BSONObj const standard = uuidDocument(mongo::newUUID, bytes);
+    EXPECT_EQ("UUID(\"" + HexUtils::hexToUuid(hex) + "\")", HexUtils::formatUuid(standard.firstElement(), JavaLegacy));
+
+    // Unusual size is not formatted into buffer, but still supported
+    char buffer[HexUtils::UuidBufferSize];
+    mongo::BSONObj const shorter = uuidDocument(mongo::newUUID, bytes.substr(0, 15));
+    EXPECT_EQ(0u, HexUtils::formatUuid(shorter.firstElement(), DefaultEncoding, buffer));
+    EXPECT_EQ("UUID(\"" + HexUtils::hexToUuid(hex.substr(0, 30)) + "\")", HexUtils::formatUuid(shorter.firstElement(), DefaultEncoding));
+}
@@ -0,0 +1,100 @@
+#include "robomongo/core/domain/CurrentOpTracker.h"
+
+#include <unordered_map>
+
+namespace
+{
+    // Longer commands are cut, whole pipelines are not worth keeping for every poll
+    const size_t maxDetailsLength = 300;
+}
+
+namespace Robomongo
+{
+    CurrentOpTracker::CurrentOpTracker(long long finishedRetentionMs) :
+        _finishedRetentionMs(finishedRetentionMs)
+    {
+    }
+
+    void CurrentOpTracker::update(const std::vector<mongo::BSONObj> &inprog, long long nowMs)
+    {
+        std::unordered_map<std::string, size_t> previous;
+        for (size_t i = 0; i < _operations.size(); ++i)
+            previous[_operations[i].id] = i;
+
+        std::vector<bool> isSeen(_operations.size(), false);
+        std::vector<CurrentOperation> operations;
+
+        for (auto const& obj : inprog) {
+            CurrentOperation operation = fromCurrentOp(obj);
+            if (operation.id.empty())
+                continue;
+
+            std::unordered_map<std::string, size_t>::const_iterator const found = previous.find(operation.id);
+            if (found != previous.end() && _operations[found->second].state != CurrentOperation::Finished) {
+                operation.state = CurrentOperation::Running;
+                operation.firstSeen = _operations[found->second].firstSeen;
+                isSeen[found->second] = true;
+            }
+            else {
+                operation.state = CurrentOperation::New;
+                operation.firstSeen = nowMs;
+            }
+            operation.lastSeen = nowMs;
+            operations.push_back(operation);
+        }
+
+        for (size_t i = 0; i < _operations.size(); ++i) {
+            CurrentOperation const &operation = _operations[i];
+            if (isSeen[i])
+                continue;
+
+            if (operation.state == CurrentOperation::Finished) {
+                if (nowMs - operation.lastSeen <= _finishedRetentionMs)
+                    operations.push_back(operation);
+                continue;
+            }
+
+            CurrentOperation finished = operation;
+            finished.state = CurrentOperation::Finished;
+            operations.push_back(finished);
+        }
+
+        _operations.swap(operations);
+    }
+
+    CurrentOperation CurrentOpTracker::fromCurrentOp(const mongo::BSONObj &obj)
+    {
+        CurrentOperation operation;
+
+        mongo::BSONElement const opid = obj["opid"];
+        if (opid.type() == mongo::String)
+            operation.id = opid.valuestrsafe();
+        else if (opid.isNumber())
+            operation.id = std::to_string(opid.safeNumberLong());
+        if (!opid.eoo())
+            operation.opid = opid.wrap("op");
+
+        operation.op = obj.getStringField("op");
+        operation.ns = obj.getStringField("ns");
+        operation.client = obj.hasField("client") ? obj.getStringField("client") : obj.getStringField("client_s");
+        operation.appName = obj.getStringField("appName");
+        operation.planSummary = obj.getStringField("planSummary");
+        operation.waitingForLock = obj["waitingForLock"].trueValue();
+        operation.micros = obj.hasField("microsecs_running") ? obj["microsecs_running"].safeNumberLong()
+                                                             : obj["secs_running"].safeNumberLong() * 1000000;
+
+        std::string const message = obj.getStringField("msg");
+        std::string const description = obj.getStringField("desc");
+        if (!message.empty())
+            operation.details = message;
+        else if (obj["command"].isABSONObj())
+            operation.details = obj.getObjectField("command").toString();
+        else
+            operation.details = description;
+
+        if (operation.details.size() > maxDetailsLength)
+            operation.details = operation.details.substr(0, maxDetailsLength) + "...";
+
+        return operation;
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <mongo/bson/bsonobj.h>
+
+namespace Robomongo
+{
+    /**
+     * @brief Operation reported by $currentOp, followed across snapshots
+     */
+    struct CurrentOperation
+    {
+        enum State
+        {
+            New,        // first seen in the latest snapshot
+            Running,    // seen in previous snapshots too
+            Finished    // gone from the latest snapshot
+        };
+
+        std::string id;             // opid as text, "shard:1234" on mongos
+        mongo::BSONObj opid;        // { op: <opid> }, as killOp takes it
+        std::string op;
+        std::string ns;
+        std::string client;
+        std::string appName;
+        std::string planSummary;
+        std::string details;        // progress message or command, shortened
+        long long micros = 0;       // running time, the last one reported for finished operations
+        bool waitingForLock = false;
+
+        State state = New;
+        long long firstSeen = 0;    // milliseconds since epoch of snapshots
+        long long lastSeen = 0;
+    };
+
+    /**
+     * @brief Diffs consecutive $currentOp snapshots. Finished operations are kept
+     * for "finishedRetentionMs" after they were last seen.
+     */
+    class CurrentOpTracker
+    {
+    public:
+        explicit CurrentOpTracker(long long finishedRetentionMs = 30000);
+
+        /**
+         * @brief Applies snapshot of in-progress operations taken at "nowMs"
+         */
+        void update(const std::vector<mongo::BSONObj> &inprog, long long nowMs);
+
+        const std::vector<CurrentOperation> &operations() const { return _operations; }
+        long long finishedRetentionMs() const { return _finishedRetentionMs; }
+
+        static CurrentOperation fromCurrentOp(const mongo::BSONObj &op);
+
+    private:
+        std::vector<CurrentOperation> _operations;
+        long long _finishedRetentionMs;
+    };
+}
@@ -0,0 +1,52 @@
+#include "gtest/gtest.h"
+#include "robomongo/core/domain/CurrentOpTracker.h"
+
+#include "robomongo/shell/bson/json.h"
+
+using namespace Robomongo;
+
+TEST(CurrentOpTrackerTests, fromCurrentOp_MongosOperation_KeepsOpidForKill)
+{
+    CurrentOperation const operation = CurrentOpTracker::fromCurrentOp(mongo::Robomongo::fromjson(
+        "{ opid: 'shard0:42', op: 'query', ns: 'db.c', client_s: '10.0.0.1:5000', secs_running: 3,"
+        "  command: { find: 'c', filter: { a: 1 } } }"));
+
+    EXPECT_EQ("shard0:42", operation.id);
+    EXPECT_EQ("{ op: \"shard0:42\" }", operation.opid.toString());
+    EXPECT_EQ("10.0.0.1:5000", operation.client);
+    EXPECT_EQ(3000000, operation.micros);
+    EXPECT_EQ("{ find: \"c\", filter: { a: 1 } }", operation.details);
+}
+
+TEST(CurrentOpTrackerTests, update_Snapshots_AreDiffed)
+{
+    CurrentOpTracker tracker(1000);
+
+    std::vector<mongo::BSONObj> snapshot;
+    snapshot.push_back(mongo::Robomongo::fromjson("{ opid: 1, op: 'query', microsecs_running: 10 }"));
+    snapshot.push_back(mongo::Robomongo::fromjson("{ opid: 2, op: 'update', microsecs_running: 20 }"));
+    tracker.update(snapshot, 100);
+
+    ASSERT_EQ(2u, tracker.operations().size());
+    EXPECT_EQ(CurrentOperation::New, tracker.operations()[0].state);
+
+    snapshot.clear();
+    snapshot.push_back(mongo::Robomongo::fromjson("{ opid: 2, op: 'update', microsecs_running: 500 }"));
+    snapshot.push_back(mongo::Robomongo::fromjson("{ opid: 3, op: 'insert', microsecs_running: 5 }"));
+    tracker.update(snapshot, 600);
+
+    std::vector<CurrentOperation> const &operations = tracker.operations();
+    ASSERT_EQ(3u, operations.size());
+    EXPECT_EQ("2", operations[0].id);
+    EXPECT_EQ(CurrentOperation::Running, operations[0].state);
+    EXPECT_EQ(100, operations[0].firstSeen);
+    EXPECT_EQ(500, operations[0].micros);
+    EXPECT_EQ(CurrentOperation::New, operations[1].state);
+    EXPECT_EQ("1", operations[2].id);
+    EXPECT_EQ(CurrentOperation::Finished, operations[2].state);
+    EXPECT_EQ(100, operations[2].lastSeen);
+
+    // Finished operations are dropped after retention
+    tracker.update(snapshot, 1200);
+    EXPECT_EQ(2u, tracker.operations().size());
+}
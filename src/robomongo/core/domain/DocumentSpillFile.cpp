@@ -0,0 +1,99 @@
+#include "robomongo/core/domain/DocumentSpillFile.h"
+
+#include <QDir>
+#include <QTemporaryFile>
+
+#include "robomongo/core/domain/MongoDocument.h"
+#include "robomongo/core/utils/Logger.h"
+
+namespace
+{
+    using namespace Robomongo;
+
+    // Copies documents out of the buffer with "size" bytes of back to back BSON objects
+    std::vector<MongoDocumentPtr> parseDocuments(const char *data, qint64 size, size_t count)
+    {
+        std::vector<MongoDocumentPtr> documents;
+        documents.reserve(count);
+
+        qint64 position = 0;
+        while (position + 4 < size) {
+            mongo::BSONObj obj(data + position);
+            if (obj.objsize() <= 0 || position + obj.objsize() > size)
+                break;
+
+            documents.push_back(MongoDocument::fromBsonObj(obj.getOwned()));
+            position += obj.objsize();
+        }
+
+        return documents;
+    }
+}
+
+namespace Robomongo
+{
+    DocumentSpillFile::DocumentSpillFile() :
+        _count(0)
+    {
+    }
+
+    DocumentSpillFile::~DocumentSpillFile()
+    {
+    }
+
+    bool DocumentSpillFile::write(const std::vector<MongoDocumentPtr> &documents)
+    {
+        // File is only readable by the current user, and removed when object is destroyed
+        std::unique_ptr<QTemporaryFile> file(new QTemporaryFile(QDir::tempPath() + "/robo3t-result-XXXXXX.bson"));
+        if (!file->open()) {
+            LOG_MSG("Cannot create temporary file for results: " + file->errorString(), mongo::logger::LogSeverity::Warning());
+            return false;
+        }
+
+        for (std::vector<MongoDocumentPtr>::const_iterator it = documents.begin(); it != documents.end(); ++it) {
+            mongo::BSONObj const obj = (*it)->bsonObj();
+            if (file->write(obj.objdata(), obj.objsize()) != obj.objsize()) {
+                LOG_MSG("Cannot write results to temporary file: " + file->errorString(), mongo::logger::LogSeverity::Warning());
+                return false;
+            }
+        }
+
+        if (!file->flush())
+            return false;
+
+        _file = std::move(file);
+        _count = documents.size();
+        return true;
+    }
+
+    std::vector<MongoDocumentPtr> DocumentSpillFile::read()
+    {
+        std::vector<MongoDocumentPtr> documents;
+        if (!_file)
+            return documents;
+
+        qint64 const size = _file->size();
+        if (uchar *data = _file->map(0, size)) {
+            documents = parseDocuments(reinterpret_cast<const char *>(data), size, _count);
+            _file->unmap(data);
+        }
+        else {
+            _file->seek(0);
+            QByteArray const bytes = _file->readAll();
+            documents = parseDocuments(bytes.constData(), bytes.size(), _count);
+        }
+
+        if (documents.size() != _count)
+            LOG_MSG("Results restored from temporary file are incomplete", mongo::logger::LogSeverity::Warning());
+
+        _file.reset();
+        _count = 0;
+        return documents;
+    }
+
+    void DocumentSpillFile::clear()
+    {
+        _file.reset();
+        _count = 0;
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <QtGlobal>
+#include <memory>
+#include <vector>
+
+#include "robomongo/core/Core.h"
+
+QT_BEGIN_NAMESPACE
+class QTemporaryFile;
+QT_END_NAMESPACE
+
+namespace Robomongo
+{
+    /*
+    ** Raw BSON of documents, moved out of memory into a temporary file.
+    ** Documents are stored back to back, as every BSON object starts with its size.
+    */
+    class DocumentSpillFile
+    {
+    public:
+        DocumentSpillFile();
+        ~DocumentSpillFile();
+
+        /*
+        ** Writes documents to a new temporary file. Returns false if file
+        ** cannot be written, in that case documents should be kept in memory.
+        */
+        bool write(const std::vector<MongoDocumentPtr> &documents);
+
+        /*
+        ** Reads documents back (through memory mapping when possible) and removes the file
+        */
+        std::vector<MongoDocumentPtr> read();
+
+        /*
+        ** Drops spilled documents without reading them
+        */
+        void clear();
+
+        bool isEmpty() const { return !_file; }
+        size_t documentsCount() const { return _count; }
+
+    private:
+        std::unique_ptr<QTemporaryFile> _file;
+        size_t _count;
+    };
+}
@@ -0,0 +1,38 @@
+#include "gtest/gtest.h"
+#include "robomongo/core/domain/DocumentSpillFile.h"
+
+#include <mongo/bson/bsonobjbuilder.h>
+
+#include "robomongo/core/domain/MongoDocument.h"
+
+using namespace Robomongo;
+
+TEST(DocumentSpillFileTests, writeRead_Documents_RestoresSameBson)
+{
+    std::vector<MongoDocumentPtr> documents;
+    for (int i = 0; i < 1000; ++i)
+        documents.push_back(MongoDocument::fromBsonObj(BSON("_id" << i << "name" << std::string(i % 50, 'x'))));
+
+    DocumentSpillFile spill;
+    ASSERT_TRUE(spill.isEmpty());
+    ASSERT_TRUE(spill.write(documents));
+    EXPECT_FALSE(spill.isEmpty());
+    EXPECT_EQ(documents.size(), spill.documentsCount());
+
+    std::vector<MongoDocumentPtr> const restored = spill.read();
+    EXPECT_TRUE(spill.isEmpty());
+    ASSERT_EQ(documents.size(), restored.size());
+    for (size_t i = 0; i < documents.size(); ++i)
+        EXPECT_TRUE(documents[i]->bsonObj().binaryEqual(restored[i]->bsonObj())) << i;
+}
+
+TEST(DocumentSpillFileTests, clear_Spilled_DropsDocuments)
+{
+    std::vector<MongoDocumentPtr> documents(1, MongoDocument::fromBsonObj(BSON("a" << 1)));
+
+    DocumentSpillFile spill;
+    ASSERT_TRUE(spill.write(documents));
+    spill.clear();
+    EXPECT_TRUE(spill.isEmpty());
+    EXPECT_TRUE(spill.read().empty());
+}
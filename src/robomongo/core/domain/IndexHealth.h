@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <mongo/bson/bsonobj.h>
+
+namespace Robomongo
+{
+    /**
+     * @brief Index of collection with its usage since server restart
+     */
+    struct IndexUsageInfo
+    {
+        std::string name;
+        mongo::BSONObj key;
+        bool unique = false;
+        bool ttl = false;
+        bool special = false;       // sparse, partial, with collation, or not a plain b-tree index
+        long long accesses = -1;    // -1 when $indexStats is not available
+        long long since = 0;        // milliseconds since epoch when access counting started
+        long long sizeBytes = -1;
+        bool unused = false;
+        std::string redundantWith;  // name of index this one is a prefix of
+    };
+
+    /**
+     * @brief Compound index that would serve queries which scanned the collection
+     */
+    struct IndexSuggestion
+    {
+        mongo::BSONObj key;
+        std::string shape;          // i.e. "equality: status; sort: ts -1; range: age"
+        int queries = 0;
+        long long docsExamined = 0;
+        long long millis = 0;
+    };
+
+    struct IndexHealth
+    {
+        std::string ns;
+        std::vector<IndexUsageInfo> indexes;
+        std::vector<IndexSuggestion> suggestions;
+        int slowQueries = 0;            // entries of system.profile that were analyzed
+        std::vector<std::string> notes; // sources which were not available, and why
+    };
+}
@@ -19,5 +19,14 @@ namespace Robomongo
         mongo::BSONObj options;
         bool isValid = false;
         int resultIndex = -1;
+        std::string dbName = "";
+
+        // Server cursor of the results, pages are read with getMore while it is alive.
+        // "cursorBatch" keeps documents already read from the cursor but not yet shown,
+        // "cursorSkip" is the position of its first document (or of the next one on server).
+        long long cursorId = 0;
+        int cursorSkip = 0;
+        mongo::BSONObj cursorBatch;
+        mongo::BSONObj lsid;    // session of the cursor, if it was opened in a session
     };
 }
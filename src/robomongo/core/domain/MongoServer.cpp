@@ -18,6 +18,12 @@
 #include "robomongo/utils/StringOperations.h"
 
 #include <QApplication>
+#include <QTimer>
+
+namespace
+{
+    const int replicaSetMonitorIntervalMs = 5000;
+}
 
 namespace Robomongo {
     R_REGISTER_EVENT(MongoServerLoadingDatabasesEvent)
@@ -27,12 +33,18 @@ namespace Robomongo {
         _version(0.0f),
         _connectionType(connectionType),
         _worker(nullptr),
+        _monitorWorker(nullptr),
+        _schemaWorker(nullptr),
+        _storageWorker(nullptr),
         _isConnected(false),
         _connSettings(settings),
         _handle(handle),
         _bus(AppRegistry::instance().bus()),
         _app(AppRegistry::instance().app()),
-        _replicaSetInfo(nullptr)
+        _replicaSetInfo(nullptr),
+        _replicaSetMonitorTimer(nullptr),
+        _replicaSetStatusLoading(false),
+        _replicaSetMonitorFailed(false)
     {}
 
     bool MongoServer::isConnected() const {
@@ -50,6 +62,18 @@ namespace Robomongo {
             _worker->stopAndDelete();
         }
 
+        if (_monitorWorker) {
+            _monitorWorker->stopAndDelete();
+        }
+
+        if (_schemaWorker) {
+            _schemaWorker->stopAndDelete();
+        }
+
+        if (_storageWorker) {
+            _storageWorker->stopAndDelete();
+        }
+
         // MongoWorker "_worker" is not deleted here, because it is now owned by
         // another thread (call to moveToThread() made in MongoWorker constructor).
         // It will be deleted by this thread by means of "deleteLater()", which
@@ -116,6 +140,54 @@ namespace Robomongo {
         _bus->send(_worker, new DropDatabaseRequest(this, dbName));
     }
 
+    void MongoServer::loadIndexHealth(const MongoCollectionInfo &collection)
+    {
+        _bus->send(_worker, new IndexHealthRequest(this, collection));
+    }
+
+    void MongoServer::analyzeSchema(const MongoCollectionInfo &collection, int sampleSize,
+                                    const SchemaAnalysisCancel &cancel)
+    {
+        _bus->send(schemaWorker(), new AnalyzeSchemaRequest(this, collection, sampleSize, cancel));
+    }
+
+    void MongoServer::setProfilingLevel(const std::string &dbName, int level, int slowMs)
+    {
+        // Same worker as polling of profiler, so that reads follow the level change
+        _bus->send(monitorWorker(), new ProfilingLevelRequest(this, dbName, level, slowMs));
+    }
+
+    void MongoServer::loadProfiler(const std::string &dbName, const ProfilerWindow &window)
+    {
+        _bus->send(monitorWorker(), new LoadProfilerRequest(this, dbName, window));
+    }
+
+    void MongoServer::loadCurrentOps(const std::string &dbName, const CurrentOpTracker &tracker)
+    {
+        _bus->send(monitorWorker(), new CurrentOpRequest(this, dbName, tracker));
+    }
+
+    void MongoServer::killOp(const mongo::BSONObj &opid, const std::string &id)
+    {
+        _bus->send(monitorWorker(), new KillOpRequest(this, opid, id));
+    }
+
+    void MongoServer::loadStorageReport(const std::string &dbName)
+    {
+        _bus->send(storageWorker(), new StorageReportRequest(this, dbName));
+    }
+
+    StorageReport MongoServer::storageReport(const std::string &dbName) const
+    {
+        std::map<std::string, StorageReport>::const_iterator const it = _storageReports.find(dbName);
+        return it != _storageReports.end() ? it->second : StorageReport();
+    }
+
+    void MongoServer::loadServerStatus()
+    {
+        _bus->send(monitorWorker(), new ServerStatusRequest(this));
+    }
+
     void MongoServer::insertDocuments(const std::vector<mongo::BSONObj> &objCont,
                                       const MongoNamespace &ns) {
         for (std::vector<mongo::BSONObj>::const_iterator it = objCont.begin(); it != objCont.end(); it++) {
@@ -220,6 +292,10 @@ namespace Robomongo {
             // successful connection.
             if (ConnectionPrimary == event->connectionType)
                 _bus->send(_worker, new RefreshReplicaSetFolderRequest(this, false));
+
+            // Only explorer shows replica set status, shell and test connections do not monitor it
+            if (ConnectionPrimary == _connectionType)
+                startReplicaSetMonitor();
         }
 
         // Save connected db version if not saved before and if this is primary connection.
@@ -315,6 +391,36 @@ namespace Robomongo {
                                   AppRegistry::instance().settingsManager()->shellTimeoutSec());
     }
 
+    MongoWorker *MongoServer::createServiceWorker() const
+    {
+        // Service workers never use shell: no script engine and no .mongorc.js
+        return new MongoWorker(_connSettings->clone(), false,
+                               AppRegistry::instance().settingsManager()->batchSize(),
+                               AppRegistry::instance().settingsManager()->mongoTimeoutSec(),
+                               AppRegistry::instance().settingsManager()->shellTimeoutSec(), true);
+    }
+
+    MongoWorker *MongoServer::monitorWorker()
+    {
+        if (!_monitorWorker)
+            _monitorWorker = createServiceWorker();
+        return _monitorWorker;
+    }
+
+    MongoWorker *MongoServer::schemaWorker()
+    {
+        if (!_schemaWorker)
+            _schemaWorker = createServiceWorker();
+        return _schemaWorker;
+    }
+
+    MongoWorker *MongoServer::storageWorker()
+    {
+        if (!_storageWorker)
+            _storageWorker = createServiceWorker();
+        return _storageWorker;
+    }
+
     void MongoServer::handle(CreateDatabaseResponse *event) 
     {
         if (event->isError()) {
@@ -347,6 +453,122 @@ namespace Robomongo {
         }
     }
 
+    void MongoServer::handle(IndexHealthResponse *event)
+    {
+        if (event->isError())
+            _bus->publish(new IndexHealthLoadedEvent(this, event->ns(), event->error()));
+        else
+            _bus->publish(new IndexHealthLoadedEvent(this, event->health()));
+    }
+
+    void MongoServer::handle(AnalyzeSchemaResponse *event)
+    {
+        if (event->isError())
+            _bus->publish(new AnalyzeSchemaResponse(this, event->ns(), event->error()));
+        else
+            _bus->publish(new AnalyzeSchemaResponse(this, event->report()));
+    }
+
+    void MongoServer::handle(ProfilingLevelResponse *event)
+    {
+        if (event->isError())
+            _bus->publish(new ProfilingLevelResponse(this, event->database(), event->error()));
+        else
+            _bus->publish(new ProfilingLevelResponse(this, event->database(), event->level(), event->slowMs()));
+    }
+
+    void MongoServer::handle(LoadProfilerResponse *event)
+    {
+        if (event->isError())
+            _bus->publish(new LoadProfilerResponse(this, event->database(), event->error()));
+        else
+            _bus->publish(new LoadProfilerResponse(this, event->database(), event->window(), event->shapes()));
+    }
+
+    void MongoServer::handle(CurrentOpResponse *event)
+    {
+        if (event->isError())
+            _bus->publish(new CurrentOpResponse(this, event->database(), event->error()));
+        else
+            _bus->publish(new CurrentOpResponse(this, event->database(), event->tracker()));
+    }
+
+    void MongoServer::handle(KillOpResponse *event)
+    {
+        if (event->isError())
+            _bus->publish(new KillOpResponse(this, event->id(), event->error()));
+        else
+            _bus->publish(new KillOpResponse(this, event->id()));
+    }
+
+    void MongoServer::handle(StorageReportResponse *event)
+    {
+        if (event->isError()) {
+            _bus->publish(new StorageReportResponse(this, event->database(), event->error()));
+            return;
+        }
+
+        _storageReports[event->database()] = event->report();
+        _bus->publish(new StorageReportResponse(this, event->report()));
+    }
+
+    void MongoServer::handle(ServerStatusResponse *event)
+    {
+        if (event->isError())
+            _bus->publish(new ServerStatusResponse(this, event->error()));
+        else
+            _bus->publish(new ServerStatusResponse(this, event->status(), event->timeMs()));
+    }
+
+    void MongoServer::startReplicaSetMonitor()
+    {
+        if (_replicaSetMonitorTimer)
+            return;
+
+        _replicaSetMonitorTimer = new QTimer(this);
+        _replicaSetMonitorTimer->setInterval(replicaSetMonitorIntervalMs);
+        VERIFY(connect(_replicaSetMonitorTimer, SIGNAL(timeout()), this, SLOT(refreshReplicaSetStatus())));
+        _replicaSetMonitorTimer->start();
+        refreshReplicaSetStatus();
+    }
+
+    void MongoServer::refreshReplicaSetStatus()
+    {
+        if (_replicaSetStatusLoading)
+            return;
+
+        _replicaSetStatusLoading = true;
+        _bus->send(monitorWorker(), new ReplicaSetStatusRequest(this));
+    }
+
+    void MongoServer::handle(ReplicaSetStatusResponse *event)
+    {
+        _replicaSetStatusLoading = false;
+
+        // Folder is refreshed once, the usual refresh reports unreachable primary
+        if (event->isError()) {
+            if (_replicaSetMonitorFailed)
+                return;
+
+            _replicaSetMonitorFailed = true;
+            _replicaSetStatus = ReplicaSetStatus();
+            _bus->publish(new ReplicaSetStatusChanged(this, _replicaSetStatus, true));
+            return;
+        }
+
+        ReplicaSetStatus const status = event->status();
+        if (!_replicaSetMonitorFailed && !status.differsFrom(_replicaSetStatus))
+            return;
+
+        bool const topologyChanged = _replicaSetMonitorFailed || 
+            (!_replicaSetStatus.empty() && 
+             (status.primary() != _replicaSetStatus.primary() || status.hasOtherMembers(_replicaSetStatus)));
+
+        _replicaSetMonitorFailed = false;
+        _replicaSetStatus = status;
+        _bus->publish(new ReplicaSetStatusChanged(this, _replicaSetStatus, topologyChanged));
+    }
+
     void MongoServer::handle(ReplicaSetRefreshed *event) 
     {
         handleReplicaSetRefreshEvents(event->isError(), event->error(), event->replicaSet, false);
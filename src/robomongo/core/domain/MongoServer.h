@@ -1,9 +1,14 @@
 #pragma once
+#include <map>
 #include <QObject>
 
 #include "robomongo/core/settings/ConnectionSettings.h"
 #include "robomongo/core/events/MongoEvents.h"
 
+QT_BEGIN_NAMESPACE
+class QTimer;
+QT_END_NAMESPACE
+
 namespace Robomongo
 {
     class MongoWorker;
@@ -87,6 +92,49 @@ namespace Robomongo
         void saveDocument(const mongo::BSONObj &obj, const MongoNamespace &ns);
         void removeDocuments(mongo::Query query, const MongoNamespace &ns, RemoveDocumentCount removeCount, 
                              int index = 0);
+
+        /**
+         * @brief Loads index usage and suggested indexes of collection asynchronously,
+         * IndexHealthLoadedEvent is published when done.
+         */
+        void loadIndexHealth(const MongoCollectionInfo &collection);
+
+        /**
+         * @brief Analyzes schema of random sample of collection asynchronously on schema
+         * worker, AnalyzeSchemaResponse is published with this server as sender. Analysis
+         * stops with error as soon as "cancel" is set.
+         */
+        void analyzeSchema(const MongoCollectionInfo &collection, int sampleSize,
+                           const SchemaAnalysisCancel &cancel);
+
+        /**
+         * @brief Database profiler requests, responses are published with this server
+         * as sender. Level -1 only reads profiling level. Run on monitoring worker,
+         * so that polling doesn't wait behind interactive queries.
+         */
+        void setProfilingLevel(const std::string &dbName, int level, int slowMs);
+        void loadProfiler(const std::string &dbName, const ProfilerWindow &window);
+
+        /**
+         * @brief Operations monitor requests, sent to monitoring worker so that polling
+         * never waits for interactive requests. Responses are published with this server
+         * as sender.
+         */
+        void loadCurrentOps(const std::string &dbName, const CurrentOpTracker &tracker);
+        void killOp(const mongo::BSONObj &opid, const std::string &id);
+        void loadServerStatus();
+
+        /**
+         * @brief Loads sizes of collections of database on storage worker, result is
+         * cached by server and published with StorageReportResponse.
+         */
+        void loadStorageReport(const std::string &dbName);
+
+        /**
+         * @brief The latest loaded storage report of database, empty when not loaded yet
+         */
+        StorageReport storageReport(const std::string &dbName) const;
+
         float version() const{ return _version; }
         const std::string& getStorageEngineType() const { return _storageEngineType; }
 
@@ -103,6 +151,12 @@ namespace Robomongo
 
         ReplicaSet* replicaSetInfo() const { return _replicaSetInfo.get(); }
 
+        /**
+         * @brief The latest status sampled by replica set monitor, empty until the first
+         * sample or when monitor failed
+         */
+        const ReplicaSetStatus &replicaSetStatus() const { return _replicaSetStatus; }
+
         void handle(ReplicaSetRefreshed *event);
 
         void changeWorkerShellTimeout(int newTimeout);
@@ -115,6 +169,16 @@ namespace Robomongo
         void handle(RemoveDocumentResponse *event);
         void handle(CreateDatabaseResponse *event);
         void handle(DropDatabaseResponse *event);
+        void handle(IndexHealthResponse *event);
+        void handle(AnalyzeSchemaResponse *event);
+        void handle(ProfilingLevelResponse *event);
+        void handle(LoadProfilerResponse *event);
+        void handle(CurrentOpResponse *event);
+        void handle(KillOpResponse *event);
+        void handle(ServerStatusResponse *event);
+        void handle(ReplicaSetStatusResponse *event);
+        void handle(StorageReportResponse *event);
+        void refreshReplicaSetStatus();
 
     private:                 
         void clearDatabases();
@@ -124,7 +188,40 @@ namespace Robomongo
         void handleConnectionFailure(EstablishConnectionResponse* event);
         void hideProgressBar() const;
 
+        /**
+         * @brief Worker with its own thread and connection, created by the first
+         * monitoring request (current operations, dashboard, replica set monitor)
+         */
+        MongoWorker *monitorWorker();
+
+        /**
+         * @brief Worker with its own thread and connection for schema analysis, so that
+         * long sampling doesn't block interactive requests or monitoring
+         */
+        MongoWorker *schemaWorker();
+
+        /**
+         * @brief Worker with its own thread and connection for storage reports, that run
+         * a command per collection and would delay polling of monitoring worker
+         */
+        MongoWorker *storageWorker();
+
+        /**
+         * @brief Worker for requests that never use shell: it has no script engine,
+         * so polling doesn't keep a second shell connection and JS runtime per server
+         */
+        MongoWorker *createServiceWorker() const;
+
+        /**
+         * @brief Samples replSetGetStatus in background, ReplicaSetStatusChanged is
+         * published only when status visibly changed
+         */
+        void startReplicaSetMonitor();
+
         MongoWorker *_worker;
+        MongoWorker *_monitorWorker;
+        MongoWorker *_schemaWorker;
+        MongoWorker *_storageWorker;
         std::unique_ptr<ConnectionSettings> _connSettings;
         EventBus *_bus;
         App *_app;
@@ -137,6 +234,13 @@ namespace Robomongo
 
         QList<MongoDatabase *> _databases;
         std::unique_ptr<ReplicaSet> _replicaSetInfo;
+
+        QTimer *_replicaSetMonitorTimer;
+        ReplicaSetStatus _replicaSetStatus;
+        bool _replicaSetStatusLoading;
+        bool _replicaSetMonitorFailed;
+
+        std::map<std::string, StorageReport> _storageReports;
     };
 
     class MongoServerLoadingDatabasesEvent : public Event
@@ -43,7 +43,7 @@ namespace Robomongo
         std::string const finalScript = script.empty() ? query() : script;
         eventBus()->publish(new ScriptExecutingEvent(this));
         eventBus()->send(_server->worker(), 
-            new ExecuteScriptRequest(this, finalScript, dbName, _aggrInfo));
+            new ExecuteScriptRequest(this, finalScript, dbName));
         if (!_scriptInfo.script().isEmpty())
             LOG_MSG(_scriptInfo.script(), mongo::logger::LogSeverity::Info());
     }
@@ -53,6 +53,23 @@ namespace Robomongo
         eventBus()->send(_server->worker(), new ExecuteQueryRequest(this, resultIndex, info));
     }
 
+    void MongoShell::aggregatePage(int resultIndex, const AggrInfo &info, int skip, int batchSize)
+    {
+        eventBus()->send(_server->worker(), 
+            new ExecuteAggregatePageRequest(this, resultIndex, info, skip, batchSize));
+    }
+
+    void MongoShell::profilePipeline(int resultIndex, const AggrInfo &info)
+    {
+        eventBus()->send(_server->worker(), new ProfilePipelineRequest(this, resultIndex, info));
+    }
+
+    void MongoShell::killAggregateCursor(const AggrInfo &info)
+    {
+        if (info.cursorId)
+            eventBus()->send(_server->worker(), new KillAggregateCursorRequest(this, info));
+    }
+
     void MongoShell::autocomplete(const std::string &prefix)
     {
         AutocompletionMode autocompletionMode {
@@ -100,6 +117,28 @@ namespace Robomongo
         );
     }
 
+    void MongoShell::handle(ExecuteAggregatePageResponse *event)
+    {
+        if (event->isError()) {
+            eventBus()->publish(new DocumentListLoadedEvent(this, event->error()));
+            return;
+        }
+
+        eventBus()->publish(
+            new DocumentListLoadedEvent(this, event->resultIndex, event->aggrInfo, event->documents)
+        );
+    }
+
+    void MongoShell::handle(ProfilePipelineResponse *event)
+    {
+        if (event->isError()) {
+            eventBus()->publish(new PipelineProfiledEvent(this, event->resultIndex, event->error()));
+            return;
+        }
+
+        eventBus()->publish(new PipelineProfiledEvent(this, event->resultIndex, event->profile));
+    }
+
     void MongoShell::handle(ExecuteScriptResponse *event)
     {
         if (!event->isError()) {
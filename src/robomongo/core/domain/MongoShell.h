@@ -17,6 +17,9 @@ namespace Robomongo
 
         void open(const std::string &script, const std::string &dbName = std::string());
         void query(int resultIndex, const MongoQueryInfo &info);
+        void aggregatePage(int resultIndex, const AggrInfo &info, int skip, int batchSize);
+        void profilePipeline(int resultIndex, const AggrInfo &info);
+        void killAggregateCursor(const AggrInfo &info);
         void autocomplete(const std::string &prefix);
         void stop();
         MongoServer *server() const { return _server; }
@@ -28,7 +31,6 @@ namespace Robomongo
         const CursorPosition &cursor() const { return _scriptInfo.cursor(); }
         void setScript(const QString &script) { return _scriptInfo.setScript(script); }
         void setScriptExecutable(bool execute) { _scriptInfo.setExecutable(execute); }
-        void setAggrInfo(AggrInfo const& aggrInfo) { _aggrInfo = aggrInfo; }
         QString filePath() const { return _scriptInfo.filePath(); }
 
         bool saveToFile();
@@ -37,12 +39,13 @@ namespace Robomongo
 
     protected Q_SLOTS:
         void handle(ExecuteQueryResponse *event);
+        void handle(ExecuteAggregatePageResponse *event);
+        void handle(ProfilePipelineResponse *event);
         void handle(ExecuteScriptResponse *event);
         void handle(AutocompleteResponse *event);
 
     private:        
         ScriptInfo _scriptInfo;
-        AggrInfo _aggrInfo;
         MongoServer *_server;
     };
 
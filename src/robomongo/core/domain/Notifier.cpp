@@ -52,7 +52,7 @@ namespace Robomongo
 
         bool isArrayChild(BsonTreeItem const *item)
         {
-            return BsonUtils::isArray(dynamic_cast<BsonTreeItem*>(item->parent())->type());
+            return BsonUtils::isArray(item->parent()->type());
         }
 
         bool isDocumentRoot(BsonTreeItem const *item)
@@ -303,7 +303,7 @@ namespace Robomongo
                 namesList.push_front(QString::fromStdString(documentItemHelper->fieldName()));
             }
 
-            documentItemHelper = dynamic_cast<BsonTreeItem*>(documentItemHelper->parent());
+            documentItemHelper = documentItemHelper->parent();
         }
 
         QClipboard *clipboard = QApplication::clipboard();
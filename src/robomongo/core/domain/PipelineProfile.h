@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Robomongo
+{
+    /**
+     * @brief Costs of one stage of aggregation pipeline, -1 when unknown
+     */
+    struct PipelineStageProfile
+    {
+        std::string name;           // i.e. "$group", "$cursor" for the part run by query engine
+        std::string details;        // plan summary, or why stage was not profiled
+        long long timeMillis = -1;  // time of this stage only
+        long long docsIn = -1;
+        long long docsOut = -1;
+        long long memoryBytes = -1; // peak memory of accumulators or sort
+        bool spilled = false;       // stage used disk
+    };
+
+    /**
+     * @brief Stage-by-stage profile of aggregation pipeline
+     */
+    struct PipelineProfile
+    {
+        std::vector<PipelineStageProfile> stages;
+
+        // Number of documents stages were run on, when server explain has no per-stage
+        // statistics and prefixes of pipeline were timed instead (0 when explain was enough)
+        int sampleSize = 0;
+
+        std::string planSummary;    // indexes used by the query engine
+        std::string note;           // i.e. "2 shards, merging part is not profiled"
+    };
+}
@@ -0,0 +1,291 @@
+#include "robomongo/core/domain/ProfilerWindow.h"
+
+#include <algorithm>
+#include <map>
+
+namespace
+{
+    bool isOperatorObject(const mongo::BSONElement &elem)
+    {
+        return elem.type() == mongo::Object && !elem.Obj().isEmpty() &&
+               elem.Obj().firstElementFieldName()[0] == '$';
+    }
+
+    void appendFilter(std::string &out, const mongo::BSONObj &filter);
+
+    void appendOperators(std::string &out, const mongo::BSONObj &operators)
+    {
+        out += "{ ";
+        bool first = true;
+        for (mongo::BSONObjIterator it(operators); it.more(); ) {
+            mongo::BSONElement const elem = it.next();
+            std::string const name = elem.fieldName();
+            if (!first)
+                out += ", ";
+            first = false;
+
+            out += name + ": ";
+            if ((name == "$elemMatch" || name == "$not") && elem.type() == mongo::Object)
+                appendFilter(out, elem.Obj());
+            else
+                out += "?";
+        }
+        out += " }";
+    }
+
+    void appendFilter(std::string &out, const mongo::BSONObj &filter)
+    {
+        if (filter.isEmpty()) {
+            out += "{}";
+            return;
+        }
+
+        out += "{ ";
+        bool first = true;
+        for (mongo::BSONObjIterator it(filter); it.more(); ) {
+            mongo::BSONElement const elem = it.next();
+            std::string const name = elem.fieldName();
+            if (!first)
+                out += ", ";
+            first = false;
+
+            out += name + ": ";
+            if ((name == "$and" || name == "$or" || name == "$nor") && elem.type() == mongo::Array) {
+                out += "[ ";
+                bool firstClause = true;
+                for (mongo::BSONObjIterator clauses(elem.Obj()); clauses.more(); ) {
+                    mongo::BSONElement const clause = clauses.next();
+                    if (!firstClause)
+                        out += ", ";
+                    firstClause = false;
+
+                    if (clause.type() == mongo::Object)
+                        appendFilter(out, clause.Obj());
+                    else
+                        out += "?";
+                }
+                out += " ]";
+            }
+            else if (isOperatorObject(elem)) {
+                appendOperators(out, elem.Obj());
+            }
+            else {
+                out += "?";
+            }
+        }
+        out += " }";
+    }
+
+    // Sort holds no values, only directions, so it is kept as is
+    void appendSort(std::string &out, const mongo::BSONObj &sort)
+    {
+        if (!sort.isEmpty())
+            out += " sort " + sort.toString();
+    }
+
+    std::string commandShape(const mongo::BSONObj &command)
+    {
+        std::string const name = command.firstElementFieldName();
+        std::string shape = name;
+
+        if (name == "find") {
+            shape += " ";
+            appendFilter(shape, command.getObjectField("filter"));
+            appendSort(shape, command.getObjectField("sort"));
+        }
+        else if (name == "aggregate") {
+            shape += " [ ";
+            bool first = true;
+            for (mongo::BSONObjIterator it(command.getObjectField("pipeline")); it.more(); ) {
+                mongo::BSONElement const stage = it.next();
+                if (stage.type() != mongo::Object)
+                    continue;
+                if (!first)
+                    shape += ", ";
+                first = false;
+
+                std::string const stageName = stage.Obj().firstElementFieldName();
+                shape += stageName;
+                if (stageName == "$match") {
+                    shape += " ";
+                    appendFilter(shape, stage.Obj().getObjectField("$match"));
+                }
+                else if (stageName == "$sort") {
+                    shape += " " + stage.Obj().getObjectField("$sort").toString();
+                }
+            }
+            shape += " ]";
+        }
+        else if (name == "count") {
+            shape += " ";
+            appendFilter(shape, command.getObjectField("query"));
+        }
+        else if (name == "distinct") {
+            shape += " " + std::string(command.getStringField("key")) + " ";
+            appendFilter(shape, command.getObjectField("query"));
+        }
+        else if (name == "findAndModify" || name == "findandmodify") {
+            shape = "findAndModify ";
+            appendFilter(shape, command.getObjectField("query"));
+            appendSort(shape, command.getObjectField("sort"));
+        }
+
+        return shape;
+    }
+
+    // Nearest-rank percentile of sorted values
+    long long percentile(const std::vector<long long> &sorted, int percent)
+    {
+        size_t const rank = (sorted.size() * percent + 99) / 100;
+        return sorted[rank ? rank - 1 : 0];
+    }
+}
+
+namespace Robomongo
+{
+    ProfilerWindow::ProfilerWindow(size_t capacity) :
+        _capacity(capacity),
+        _lastTs(0),
+        _lastTsCount(0),
+        _totalCount(0)
+    {
+    }
+
+    void ProfilerWindow::append(const std::vector<mongo::BSONObj> &entries)
+    {
+        int seen = _lastTsCount;
+        for (auto const& entry : entries) {
+            ProfiledOperation const operation = fromProfileEntry(entry);
+            if (operation.ts < _lastTs)
+                continue;
+
+            if (operation.ts == _lastTs) {
+                if (seen > 0) {
+                    --seen;
+                    continue;
+                }
+                ++_lastTsCount;
+            }
+            else {
+                _lastTs = operation.ts;
+                _lastTsCount = 1;
+            }
+
+            _operations.push_back(operation);
+            ++_totalCount;
+        }
+
+        while (_operations.size() > _capacity)
+            _operations.pop_front();
+    }
+
+    std::vector<QueryShapeStats> ProfilerWindow::shapes() const
+    {
+        std::vector<QueryShapeStats> result;
+        std::vector<std::vector<long long> > times;
+        std::map<std::string, size_t> positions;
+
+        for (auto const& operation : _operations) {
+            std::string const key = operation.ns + '\0' + operation.op + '\0' + operation.shape;
+            std::map<std::string, size_t>::const_iterator const found = positions.find(key);
+            size_t const position = found == positions.end() ? result.size() : found->second;
+            if (found == positions.end()) {
+                positions[key] = position;
+                QueryShapeStats stats;
+                stats.op = operation.op;
+                stats.ns = operation.ns;
+                stats.shape = operation.shape;
+                result.push_back(stats);
+                times.push_back(std::vector<long long>());
+            }
+
+            QueryShapeStats &stats = result[position];
+            stats.count++;
+            stats.totalMillis += operation.millis;
+            stats.docsExamined += operation.docsExamined;
+            stats.keysExamined += operation.keysExamined;
+            stats.returned += operation.returned;
+            stats.planSummary = operation.planSummary;
+            stats.lastTs = operation.ts;
+            times[position].push_back(operation.millis);
+        }
+
+        for (size_t i = 0; i < result.size(); ++i) {
+            std::vector<long long> &sorted = times[i];
+            std::sort(sorted.begin(), sorted.end());
+            result[i].p50 = percentile(sorted, 50);
+            result[i].p95 = percentile(sorted, 95);
+            result[i].max = sorted.back();
+        }
+
+        std::stable_sort(result.begin(), result.end(),
+                         [](const QueryShapeStats &left, const QueryShapeStats &right) {
+                             return left.totalMillis > right.totalMillis;
+                         });
+        return result;
+    }
+
+    void ProfilerWindow::clear()
+    {
+        // Tail position is kept, so cleared operations are not read again
+        _operations.clear();
+        _totalCount = 0;
+    }
+
+    ProfiledOperation ProfilerWindow::fromProfileEntry(const mongo::BSONObj &entry)
+    {
+        ProfiledOperation operation;
+        if (entry["ts"].type() == mongo::Date)
+            operation.ts = entry["ts"].date().toMillisSinceEpoch();
+        operation.op = entry.getStringField("op");
+        operation.ns = entry.getStringField("ns");
+        operation.millis = entry["millis"].safeNumberLong();
+        operation.planSummary = entry.getStringField("planSummary");
+
+        // Names before 3.2
+        operation.docsExamined = entry.hasField("docsExamined") ? entry["docsExamined"].safeNumberLong()
+                                                                : entry["nscannedObjects"].safeNumberLong();
+        operation.keysExamined = entry.hasField("keysExamined") ? entry["keysExamined"].safeNumberLong()
+                                                                : entry["nscanned"].safeNumberLong();
+        operation.returned = entry.hasField("nreturned") ? entry["nreturned"].safeNumberLong()
+            : entry["nMatched"].safeNumberLong() + entry["ndeleted"].safeNumberLong();
+
+        mongo::BSONObj command = entry.getObjectField("command");
+        if (operation.op == "getmore" && entry["originatingCommand"].isABSONObj())
+            command = entry.getObjectField("originatingCommand");
+
+        if (operation.op == "insert") {
+            operation.shape = "insert";
+        }
+        else if (operation.op == "update" || operation.op == "remove") {
+            // Statement is recorded as command since 3.6, as query before
+            operation.shape = operation.op + " ";
+            appendFilter(operation.shape, command.hasField("q") ? command.getObjectField("q")
+                                                                : entry.getObjectField("query"));
+        }
+        else if (!command.isEmpty()) {
+            operation.shape = commandShape(command);
+        }
+        else if (entry["query"].isABSONObj()) {
+            // Query before 3.2 was recorded as filter itself or {$query, orderby}
+            mongo::BSONObj const query = entry.getObjectField("query");
+            bool const isWrapped = query.hasField("$query");
+            operation.shape = "find ";
+            appendFilter(operation.shape, isWrapped ? query.getObjectField("$query") : query);
+            if (isWrapped)
+                appendSort(operation.shape, query.getObjectField("orderby"));
+        }
+        else {
+            operation.shape = operation.op;
+        }
+
+        return operation;
+    }
+
+    std::string ProfilerWindow::filterShape(const mongo::BSONObj &filter)
+    {
+        std::string shape;
+        appendFilter(shape, filter);
+        return shape;
+    }
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include <mongo/bson/bsonobj.h>
+
+namespace Robomongo
+{
+    /**
+     * @brief Operation recorded by database profiler, with its query reduced to shape
+     */
+    struct ProfiledOperation
+    {
+        long long ts = 0;               // milliseconds since epoch
+        std::string op;                 // query, getmore, update, remove, command, insert
+        std::string ns;
+        std::string shape;              // i.e. "find { status: ?, age: { $gt: ? } } sort { ts: -1 }"
+        long long millis = 0;
+        long long docsExamined = 0;
+        long long keysExamined = 0;
+        long long returned = 0;
+        std::string planSummary;
+    };
+
+    /**
+     * @brief Operations of the same shape, times are in milliseconds
+     */
+    struct QueryShapeStats
+    {
+        std::string op;
+        std::string ns;
+        std::string shape;
+        int count = 0;
+        long long p50 = 0;
+        long long p95 = 0;
+        long long max = 0;
+        long long totalMillis = 0;
+        long long docsExamined = 0;
+        long long keysExamined = 0;
+        long long returned = 0;
+        std::string planSummary;        // of the latest operation
+        long long lastTs = 0;
+    };
+
+    /**
+     * @brief Latest operations read from system.profile, at most "capacity" of them.
+     * Profiler collection is tailed by "ts": entries are read from lastTs() inclusive,
+     * and entries of that millisecond which were already read are skipped on append.
+     */
+    class ProfilerWindow
+    {
+    public:
+        explicit ProfilerWindow(size_t capacity = 5000);
+
+        /**
+         * @brief Appends profiler entries in order they were recorded, oldest operations
+         * are dropped when window is full
+         */
+        void append(const std::vector<mongo::BSONObj> &entries);
+
+        /**
+         * @brief Operations grouped by namespace, type and shape, most total time first
+         */
+        std::vector<QueryShapeStats> shapes() const;
+
+        void clear();
+
+        long long lastTs() const { return _lastTs; }
+        int lastTsCount() const { return _lastTsCount; }
+        size_t size() const { return _operations.size(); }
+        size_t capacity() const { return _capacity; }
+
+        /**
+         * @brief Operations appended since creation or clear(), including dropped ones
+         */
+        long long totalCount() const { return _totalCount; }
+
+        static ProfiledOperation fromProfileEntry(const mongo::BSONObj &entry);
+
+        /**
+         * @brief Filter with values replaced by "?", operators and field names are kept
+         */
+        static std::string filterShape(const mongo::BSONObj &filter);
+
+    private:
+        std::deque<ProfiledOperation> _operations;
+        size_t _capacity;
+        long long _lastTs;
+        int _lastTsCount;
+        long long _totalCount;
+    };
+}
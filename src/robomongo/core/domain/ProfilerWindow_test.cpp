@@ -0,0 +1,87 @@
+#include "gtest/gtest.h"
+#include "robomongo/core/domain/ProfilerWindow.h"
+
+#include "robomongo/shell/bson/json.h"
+
+using namespace Robomongo;
+
+namespace
+{
+    mongo::BSONObj findEntry(long long ts, long long millis, const std::string &filter)
+    {
+        return mongo::Robomongo::fromjson(
+            "{ op: 'query', ns: 'db.c', ts: { $date: " + std::to_string(ts) + " }, millis: " + 
+            std::to_string(millis) + ", docsExamined: 100, nreturned: 1, planSummary: 'COLLSCAN',"
+            "  command: { find: 'c', filter: " + filter + " } }");
+    }
+}
+
+TEST(ProfilerWindowTests, fromProfileEntry_Values_AreReplacedInShape)
+{
+    ProfiledOperation const find = ProfilerWindow::fromProfileEntry(mongo::Robomongo::fromjson(
+        "{ op: 'query', command: { find: 'c', filter: { a: 5, b: { $gt: 1, $lt: 9 }, $or: [ { c: 'x' }, { d: { e: 1 } } ],"
+        "  tags: { $elemMatch: { k: 'v' } } }, sort: { ts: -1 } } }"));
+    EXPECT_EQ("find { a: ?, b: { $gt: ?, $lt: ? }, $or: [ { c: ? }, { d: ? } ], tags: { $elemMatch: { k: ? } } }"
+              " sort { ts: -1 }", find.shape);
+
+    ProfiledOperation const update = ProfilerWindow::fromProfileEntry(mongo::Robomongo::fromjson(
+        "{ op: 'update', command: { q: { _id: 7 }, u: { $set: { a: 1 } } } }"));
+    EXPECT_EQ("update { _id: ? }", update.shape);
+
+    ProfiledOperation const getMore = ProfilerWindow::fromProfileEntry(mongo::Robomongo::fromjson(
+        "{ op: 'getmore', command: { getMore: 1 }, originatingCommand: { aggregate: 'c',"
+        "  pipeline: [ { $match: { a: 1 } }, { $group: { _id: '$a' } } ] } }"));
+    EXPECT_EQ("aggregate [ $match { a: ? }, $group ]", getMore.shape);
+}
+
+TEST(ProfilerWindowTests, append_TailedEntries_AreNotDuplicatedAndWindowIsBounded)
+{
+    ProfilerWindow window(3);
+
+    std::vector<mongo::BSONObj> entries;
+    entries.push_back(findEntry(1000, 5, "{ a: 1 }"));
+    entries.push_back(findEntry(2000, 7, "{ a: 2 }"));
+    entries.push_back(findEntry(2000, 9, "{ b: 2 }"));
+    window.append(entries);
+
+    EXPECT_EQ(2000, window.lastTs());
+    EXPECT_EQ(2, window.lastTsCount());
+
+    // Next read starts from the last timestamp inclusive
+    entries.clear();
+    entries.push_back(findEntry(2000, 7, "{ a: 2 }"));
+    entries.push_back(findEntry(2000, 9, "{ b: 2 }"));
+    entries.push_back(findEntry(2000, 11, "{ a: 3 }"));
+    entries.push_back(findEntry(3000, 13, "{ a: 4 }"));
+    window.append(entries);
+
+    EXPECT_EQ(5, window.totalCount());
+    EXPECT_EQ(3u, window.size());
+    EXPECT_EQ(3000, window.lastTs());
+    EXPECT_EQ(1, window.lastTsCount());
+}
+
+TEST(ProfilerWindowTests, shapes_SameShape_IsGroupedWithPercentiles)
+{
+    ProfilerWindow window;
+
+    std::vector<mongo::BSONObj> entries;
+    for (int i = 1; i <= 20; ++i)
+        entries.push_back(findEntry(i, i * 10, "{ a: " + std::to_string(i) + " }"));
+    entries.push_back(findEntry(21, 1, "{ b: 1 }"));
+    window.append(entries);
+
+    std::vector<QueryShapeStats> const shapes = window.shapes();
+    ASSERT_EQ(2u, shapes.size());
+
+    EXPECT_EQ("find { a: ? }", shapes[0].shape);
+    EXPECT_EQ(20, shapes[0].count);
+    EXPECT_EQ(100, shapes[0].p50);
+    EXPECT_EQ(190, shapes[0].p95);
+    EXPECT_EQ(200, shapes[0].max);
+    EXPECT_EQ(2000, shapes[0].docsExamined);
+    EXPECT_EQ("COLLSCAN", shapes[0].planSummary);
+
+    EXPECT_EQ("find { b: ? }", shapes[1].shape);
+    EXPECT_EQ(1, shapes[1].max);
+}
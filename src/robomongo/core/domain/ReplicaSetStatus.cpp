@@ -0,0 +1,104 @@
+#include "robomongo/core/domain/ReplicaSetStatus.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace
+{
+    long long millis(const mongo::BSONElement &elem)
+    {
+        return elem.type() == mongo::Date ? elem.date().toMillisSinceEpoch() : 0;
+    }
+
+    // Small jitter of heartbeats is not an update
+    bool isPingChanged(long long left, long long right)
+    {
+        if ((left < 0) != (right < 0))
+            return true;
+
+        return std::llabs(left - right) > 10 + std::max(left, right) / 5;
+    }
+}
+
+namespace Robomongo
+{
+    std::string ReplicaSetStatus::primary() const
+    {
+        for (auto const& member : members) {
+            if (member.isPrimary)
+                return member.name;
+        }
+        return std::string();
+    }
+
+    bool ReplicaSetStatus::hasOtherMembers(const ReplicaSetStatus &other) const
+    {
+        if (members.size() != other.members.size())
+            return true;
+
+        for (size_t i = 0; i < members.size(); ++i) {
+            if (members[i].name != other.members[i].name)
+                return true;
+        }
+        return false;
+    }
+
+    bool ReplicaSetStatus::differsFrom(const ReplicaSetStatus &other) const
+    {
+        if (setName != other.setName || hasOtherMembers(other))
+            return true;
+
+        for (size_t i = 0; i < members.size(); ++i) {
+            ReplicaSetMember const &left = members[i];
+            ReplicaSetMember const &right = other.members[i];
+            if (left.state != right.state || left.healthy != right.healthy ||
+                left.lagMs / 1000 != right.lagMs / 1000 || isPingChanged(left.pingMs, right.pingMs))
+                return true;
+        }
+        return false;
+    }
+
+    ReplicaSetStatus ReplicaSetStatus::fromReplSetGetStatus(const mongo::BSONObj &status)
+    {
+        ReplicaSetStatus result;
+        result.setName = status.getStringField("set");
+
+        long long primaryOptimeMs = -1, latestOptimeMs = -1;
+        for (mongo::BSONObjIterator it(status.getObjectField("members")); it.more(); ) {
+            mongo::BSONElement const elem = it.next();
+            if (!elem.isABSONObj())
+                continue;
+
+            mongo::BSONObj const obj = elem.Obj();
+            ReplicaSetMember member;
+            member.name = obj.getStringField("name");
+            member.state = obj.getStringField("stateStr");
+            member.healthy = obj.getField("health").numberDouble() > 0;
+            member.isPrimary = obj.getField("state").numberDouble() == 1;
+            member.isSelf = obj.getField("self").trueValue();
+            member.optimeMs = millis(obj.getField("optimeDate"));
+
+            mongo::BSONElement const ping = obj.getField("pingMs");
+            if (ping.isNumber())
+                member.pingMs = ping.safeNumberLong();
+
+            // Members that do not replicate (i.e. arbiters) have no optime
+            if (member.optimeMs > 0 && member.healthy) {
+                latestOptimeMs = std::max(latestOptimeMs, member.optimeMs);
+                if (member.isPrimary)
+                    primaryOptimeMs = member.optimeMs;
+            }
+
+            result.members.push_back(member);
+        }
+
+        // Without primary lag is measured from the most recent member
+        long long const baseMs = primaryOptimeMs >= 0 ? primaryOptimeMs : latestOptimeMs;
+        for (auto &member : result.members) {
+            if (baseMs >= 0 && member.optimeMs > 0 && member.healthy)
+                member.lagMs = std::max(0LL, baseMs - member.optimeMs);
+        }
+
+        return result;
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <mongo/bson/bsonobj.h>
+
+namespace Robomongo
+{
+    /**
+     * @brief Member of replica set as reported by replSetGetStatus
+     */
+    struct ReplicaSetMember
+    {
+        std::string name;           // host:port from replica set config
+        std::string state;          // i.e. "PRIMARY", "SECONDARY", "ARBITER"
+        bool healthy = false;
+        bool isPrimary = false;
+        bool isSelf = false;        // member that reported the status, it has no heartbeat
+        long long optimeMs = 0;     // time of the last applied operation
+        long long lagMs = -1;       // behind primary, -1 when unknown
+        long long pingMs = -1;      // heartbeat round trip, -1 when unknown
+    };
+
+    /**
+     * @brief Replication state of all members, sampled by background monitor of server
+     */
+    struct ReplicaSetStatus
+    {
+        std::string setName;
+        std::vector<ReplicaSetMember> members;
+
+        bool empty() const { return members.empty(); }
+
+        /**
+         * @returns name of primary, empty when there is no primary
+         */
+        std::string primary() const;
+
+        /**
+         * @brief True when names of members are different
+         */
+        bool hasOtherMembers(const ReplicaSetStatus &other) const;
+
+        /**
+         * @brief True when differences are visible to user: states, health, lag in whole seconds,
+         * or heartbeat latency changed noticeably
+         */
+        bool differsFrom(const ReplicaSetStatus &other) const;
+
+        static ReplicaSetStatus fromReplSetGetStatus(const mongo::BSONObj &status);
+    };
+}
@@ -0,0 +1,43 @@
+#include "gtest/gtest.h"
+#include "robomongo/core/domain/ReplicaSetStatus.h"
+
+#include "robomongo/shell/bson/json.h"
+
+using namespace Robomongo;
+
+namespace
+{
+    mongo::BSONObj replSetGetStatus(long long secondaryOptime, long long pingMs)
+    {
+        return mongo::Robomongo::fromjson(
+            "{ set: 'rs0', members: ["
+            "  { name: 'a:27017', health: 1, state: 1, stateStr: 'PRIMARY', optimeDate: { $date: 100000 }, self: true },"
+            "  { name: 'b:27017', health: 1, state: 2, stateStr: 'SECONDARY', optimeDate: { $date: " +
+            std::to_string(secondaryOptime) + " }, pingMs: " + std::to_string(pingMs) + " },"
+            "  { name: 'c:27017', health: 1, state: 7, stateStr: 'ARBITER', pingMs: 1 } ] }");
+    }
+}
+
+TEST(ReplicaSetStatusTests, fromReplSetGetStatus_Lag_IsBehindPrimary)
+{
+    ReplicaSetStatus const status = ReplicaSetStatus::fromReplSetGetStatus(replSetGetStatus(97500, 3));
+
+    EXPECT_EQ("rs0", status.setName);
+    EXPECT_EQ("a:27017", status.primary());
+    ASSERT_EQ(3u, status.members.size());
+    EXPECT_EQ(0, status.members[0].lagMs);
+    EXPECT_EQ(-1, status.members[0].pingMs);
+    EXPECT_EQ(2500, status.members[1].lagMs);
+    EXPECT_EQ(3, status.members[1].pingMs);
+    EXPECT_EQ(-1, status.members[2].lagMs);
+}
+
+TEST(ReplicaSetStatusTests, differsFrom_SmallChanges_AreIgnored)
+{
+    ReplicaSetStatus const status = ReplicaSetStatus::fromReplSetGetStatus(replSetGetStatus(97500, 3));
+
+    EXPECT_FALSE(ReplicaSetStatus::fromReplSetGetStatus(replSetGetStatus(97100, 8)).differsFrom(status));
+    EXPECT_TRUE(ReplicaSetStatus::fromReplSetGetStatus(replSetGetStatus(96000, 3)).differsFrom(status));
+    EXPECT_TRUE(ReplicaSetStatus::fromReplSetGetStatus(replSetGetStatus(97500, 40)).differsFrom(status));
+    EXPECT_TRUE(ReplicaSetStatus().differsFrom(status));
+}
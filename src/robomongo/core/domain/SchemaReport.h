@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Robomongo
+{
+    /**
+     * @brief Statistics of one field path in sampled documents. Elements of arrays
+     * are reported under path of the array with "[]" appended, i.e. "tags[]", "items[].sku".
+     */
+    struct SchemaField
+    {
+        enum { ArrayLengthBuckets = 7 };
+
+        std::string path;
+        long long documents = 0;    // documents where path is present
+        long long values = 0;       // occurrences, more than documents inside arrays
+        std::vector<std::pair<int, long long> > types;   // BSON type -> occurrences, most frequent first
+        long long distinct = -1;    // estimated distinct scalar values, -1 when there are none
+
+        bool hasNumbers = false;
+        double minNumber = 0;
+        double maxNumber = 0;
+
+        bool hasDates = false;
+        long long minDate = 0;      // milliseconds since epoch
+        long long maxDate = 0;
+
+        bool hasStrings = false;
+        std::string minString;      // shortened to 64 bytes
+        std::string maxString;
+
+        // Lengths of arrays: 0, 1, 2-4, 5-9, 10-49, 50-99, 100 and more
+        long long arrayLengths[ArrayLengthBuckets] = {};
+    };
+
+    struct SchemaReport
+    {
+        std::string ns;
+        int sampleSize = 0;             // requested sample size
+        long long documents = 0;        // analyzed documents
+        std::vector<SchemaField> fields;    // sorted by path
+
+        size_t maxFields = 0;
+        long long skippedValues = 0;    // values of paths beyond "maxFields"
+        int threads = 0;
+        long long millis = 0;
+    };
+
+    /**
+     * @brief Shared by requester and worker, set to true to stop analysis in progress
+     */
+    typedef std::shared_ptr<std::atomic<bool> > SchemaAnalysisCancel;
+}
@@ -0,0 +1,170 @@
+#include "robomongo/core/domain/ServerMetrics.h"
+
+#include <algorithm>
+
+namespace
+{
+    // Counters of rate metrics, in order of ServerMetrics::Metric
+    const char *const counterPaths[] = {
+        "opcounters.insert",
+        "opcounters.query",
+        "opcounters.update",
+        "opcounters.delete",
+        "opcounters.getmore",
+        "opcounters.command",
+        "network.bytesIn",
+        "network.bytesOut",
+        "extra_info.page_faults"
+    };
+
+    const size_t countersCount = sizeof(counterPaths) / sizeof(counterPaths[0]);
+
+    // Counters are never negative, so this marks unknown values
+    const double unknown = -1;
+
+    double number(const mongo::BSONObj &obj, const char *path)
+    {
+        mongo::BSONElement const elem = obj.getFieldDotted(path);
+        return elem.isNumber() ? elem.numberDouble() : unknown;
+    }
+}
+
+namespace Robomongo
+{
+    MetricSeries::MetricSeries(size_t capacity) :
+        _times(capacity),
+        _values(capacity),
+        _begin(0),
+        _size(0)
+    {
+    }
+
+    void MetricSeries::append(long long timeMs, double value)
+    {
+        if (_times.empty())
+            return;
+
+        if (_size < _times.size()) {
+            _times[index(_size)] = timeMs;
+            _values[index(_size)] = value;
+            ++_size;
+            return;
+        }
+
+        _times[_begin] = timeMs;
+        _values[_begin] = value;
+        _begin = (_begin + 1) % _times.size();
+    }
+
+    void MetricSeries::clear()
+    {
+        _begin = 0;
+        _size = 0;
+    }
+
+    double MetricSeries::max() const
+    {
+        double result = 0;
+        for (size_t i = 0; i < _size; ++i)
+            result = std::max(result, value(i));
+        return result;
+    }
+
+    ServerMetrics::ServerMetrics(size_t capacity) :
+        _series(MetricsCount, MetricSeries(capacity)),
+        _counters(countersCount, unknown),
+        _uptimeMs(0),
+        _readTicketsTotal(0),
+        _writeTicketsTotal(0)
+    {
+    }
+
+    void ServerMetrics::update(const mongo::BSONObj &serverStatus, long long nowMs)
+    {
+        _host = serverStatus.getStringField("host");
+        _version = serverStatus.getStringField("version");
+
+        // Differences are taken by server uptime, so delays of replies do not distort rates
+        double const uptimeMs = number(serverStatus, "uptimeMillis");
+        long long const elapsedMs = uptimeMs == unknown ? 0 : static_cast<long long>(uptimeMs) - _uptimeMs;
+        _uptimeMs = uptimeMs == unknown ? 0 : static_cast<long long>(uptimeMs);
+
+        for (size_t i = 0; i < countersCount; ++i) {
+            double const previous = _counters[i];
+            double const current = number(serverStatus, counterPaths[i]);
+            _counters[i] = current;
+
+            // Restarted server or counter reset
+            if (previous == unknown || current == unknown || current < previous || elapsedMs <= 0)
+                continue;
+
+            _series[i].append(nowMs, (current - previous) * 1000 / elapsedMs);
+        }
+
+        double const connections = number(serverStatus, "connections.current");
+        if (connections != unknown)
+            _series[Connections].append(nowMs, connections);
+
+        mongo::BSONObj const cache = serverStatus.getObjectField("wiredTiger").getObjectField("cache");
+        double const cacheMax = number(cache, "maximum bytes configured");
+        if (cacheMax > 0) {
+            double const used = number(cache, "bytes currently in the cache");
+            if (used != unknown)
+                _series[CacheUsed].append(nowMs, used * 100 / cacheMax);
+
+            double const dirty = number(cache, "tracked dirty bytes in the cache");
+            if (dirty != unknown)
+                _series[CacheDirty].append(nowMs, dirty * 100 / cacheMax);
+        }
+
+        // Tickets are reported by execution queues since 7.0
+        mongo::BSONObj tickets = serverStatus.getObjectField("queues").getObjectField("execution");
+        if (tickets.isEmpty())
+            tickets = serverStatus.getObjectField("wiredTiger").getObjectField("concurrentTransactions");
+
+        double const readOut = number(tickets, "read.out");
+        if (readOut != unknown) {
+            _series[ReadTicketsInUse].append(nowMs, readOut);
+            _readTicketsTotal = std::max(0.0, number(tickets, "read.totalTickets"));
+        }
+
+        double const writeOut = number(tickets, "write.out");
+        if (writeOut != unknown) {
+            _series[WriteTicketsInUse].append(nowMs, writeOut);
+            _writeTicketsTotal = std::max(0.0, number(tickets, "write.totalTickets"));
+        }
+    }
+
+    void ServerMetrics::clear()
+    {
+        for (auto &series : _series)
+            series.clear();
+    }
+
+    const char *ServerMetrics::name(Metric metric)
+    {
+        switch (metric) {
+        case Inserts: return "Inserts";
+        case Queries: return "Queries";
+        case Updates: return "Updates";
+        case Deletes: return "Deletes";
+        case GetMores: return "Get Mores";
+        case Commands: return "Commands";
+        case NetworkIn: return "Network In";
+        case NetworkOut: return "Network Out";
+        case PageFaults: return "Page Faults";
+        case Connections: return "Connections";
+        case CacheUsed: return "Cache Used";
+        case CacheDirty: return "Cache Dirty";
+        case ReadTicketsInUse: return "Read Tickets In Use";
+        case WriteTicketsInUse: return "Write Tickets In Use";
+        case MetricsCount: break;
+        }
+        return "";
+    }
+
+    bool ServerMetrics::isRate(Metric metric)
+    {
+        return static_cast<size_t>(metric) < countersCount;
+    }
+}
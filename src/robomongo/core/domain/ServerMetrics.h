@@ -0,0 +1,109 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <mongo/bson/bsonobj.h>
+
+namespace Robomongo
+{
+    /**
+     * @brief Fixed-size ring buffer of samples of one metric, the oldest sample
+     * is overwritten when buffer is full
+     */
+    class MetricSeries
+    {
+    public:
+        explicit MetricSeries(size_t capacity = 0);
+
+        void append(long long timeMs, double value);
+        void clear();
+
+        size_t size() const { return _size; }
+        size_t capacity() const { return _times.size(); }
+        bool empty() const { return _size == 0; }
+
+        /**
+         * @brief Sample "i", the oldest is 0
+         */
+        long long time(size_t i) const { return _times[index(i)]; }
+        double value(size_t i) const { return _values[index(i)]; }
+
+        double last() const { return value(_size - 1); }
+        double max() const;
+
+    private:
+        size_t index(size_t i) const { return (_begin + i) % _times.size(); }
+
+        std::vector<long long> _times;
+        std::vector<double> _values;
+        size_t _begin;
+        size_t _size;
+    };
+
+    /**
+     * @brief Time series of server metrics, built from consecutive serverStatus replies.
+     * Counters (operations, network bytes, page faults) are turned into rates per second,
+     * other metrics are sampled as is.
+     */
+    class ServerMetrics
+    {
+    public:
+        enum Metric
+        {
+            Inserts,
+            Queries,
+            Updates,
+            Deletes,
+            GetMores,
+            Commands,
+            NetworkIn,          // bytes per second
+            NetworkOut,
+            PageFaults,
+            Connections,
+            CacheUsed,          // percent of configured WiredTiger cache
+            CacheDirty,
+            ReadTicketsInUse,
+            WriteTicketsInUse,
+            MetricsCount
+        };
+
+        /**
+         * @param capacity: samples kept for every metric
+         */
+        explicit ServerMetrics(size_t capacity = 600);
+
+        /**
+         * @brief Appends samples of serverStatus reply received at "nowMs".
+         * Metrics the server does not report are skipped.
+         */
+        void update(const mongo::BSONObj &serverStatus, long long nowMs);
+
+        void clear();
+
+        const MetricSeries &series(Metric metric) const { return _series[metric]; }
+
+        /**
+         * @brief Total of read or write tickets, zero when unknown
+         */
+        double ticketsTotal(bool write) const { return write ? _writeTicketsTotal : _readTicketsTotal; }
+
+        std::string host() const { return _host; }
+        std::string version() const { return _version; }
+
+        static const char *name(Metric metric);
+        static bool isRate(Metric metric);
+
+    private:
+        std::vector<MetricSeries> _series;
+
+        // Counters of the previous sample, rates are computed from differences
+        std::vector<double> _counters;
+        long long _uptimeMs;
+
+        double _readTicketsTotal;
+        double _writeTicketsTotal;
+        std::string _host;
+        std::string _version;
+    };
+}
@@ -0,0 +1,54 @@
+#include "gtest/gtest.h"
+#include "robomongo/core/domain/ServerMetrics.h"
+
+#include "robomongo/shell/bson/json.h"
+
+using namespace Robomongo;
+
+namespace
+{
+    mongo::BSONObj serverStatus(long long uptimeMs, long long inserts, long long bytesIn)
+    {
+        return mongo::Robomongo::fromjson(
+            "{ host: 'h:27017', uptimeMillis: " + std::to_string(uptimeMs) + ", opcounters: { insert: " +
+            std::to_string(inserts) + " }, network: { bytesIn: " + std::to_string(bytesIn) + " },"
+            "  connections: { current: 7 }, wiredTiger: { cache: { 'maximum bytes configured': 1000,"
+            "  'bytes currently in the cache': 250, 'tracked dirty bytes in the cache': 50 },"
+            "  concurrentTransactions: { read: { out: 3, totalTickets: 128 }, write: { out: 1, totalTickets: 128 } } } }");
+    }
+}
+
+TEST(ServerMetricsTests, series_Full_OverwritesOldest)
+{
+    MetricSeries series(3);
+    for (int i = 1; i <= 5; ++i)
+        series.append(i * 1000, i);
+
+    ASSERT_EQ(3u, series.size());
+    EXPECT_EQ(3, series.value(0));
+    EXPECT_EQ(5000, series.time(2));
+    EXPECT_EQ(5, series.last());
+    EXPECT_EQ(5, series.max());
+}
+
+TEST(ServerMetricsTests, update_Counters_AreRatesByUptime)
+{
+    ServerMetrics metrics(10);
+    metrics.update(serverStatus(10000, 100, 5000), 1);
+    EXPECT_TRUE(metrics.series(ServerMetrics::Inserts).empty());
+    EXPECT_EQ(1u, metrics.series(ServerMetrics::Connections).size());
+
+    metrics.update(serverStatus(12000, 300, 9000), 2);
+    ASSERT_EQ(1u, metrics.series(ServerMetrics::Inserts).size());
+    EXPECT_EQ(100, metrics.series(ServerMetrics::Inserts).last());
+    EXPECT_EQ(2000, metrics.series(ServerMetrics::NetworkIn).last());
+    EXPECT_EQ(25, metrics.series(ServerMetrics::CacheUsed).last());
+    EXPECT_EQ(5, metrics.series(ServerMetrics::CacheDirty).last());
+    EXPECT_EQ(3, metrics.series(ServerMetrics::ReadTicketsInUse).last());
+    EXPECT_EQ(128, metrics.ticketsTotal(true));
+
+    // Restarted server has no rate for the first sample
+    metrics.update(serverStatus(1000, 5, 10), 3);
+    EXPECT_EQ(1u, metrics.series(ServerMetrics::Inserts).size());
+    EXPECT_TRUE(metrics.series(ServerMetrics::PageFaults).empty());
+}
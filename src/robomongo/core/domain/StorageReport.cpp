@@ -0,0 +1,71 @@
+#include "robomongo/core/domain/StorageReport.h"
+
+namespace
+{
+    // Reported by WiredTiger for every file, servers before 4.4 have no "freeStorageSize"
+    const char *const reusableBytesPath = "block-manager.file bytes available for reuse";
+
+    long long reusableBytes(const mongo::BSONObj &details)
+    {
+        return details.getFieldDotted(reusableBytesPath).safeNumberLong();
+    }
+}
+
+namespace Robomongo
+{
+    double CollectionStorage::compressionRatio() const
+    {
+        long long const used = storageSize - freeBytes;
+        return used > 0 ? static_cast<double>(dataSize) / used : 0;
+    }
+
+    void CollectionStorage::add(const mongo::BSONObj &storageStats)
+    {
+        count += storageStats.getField("count").safeNumberLong();
+        dataSize += storageStats.getField("size").safeNumberLong();
+        storageSize += storageStats.getField("storageSize").safeNumberLong();
+        indexSize += storageStats.getField("totalIndexSize").safeNumberLong();
+
+        mongo::BSONObj const indexDetails = storageStats.getObjectField("indexDetails");
+        if (storageStats.hasField("freeStorageSize"))
+            freeBytes += storageStats.getField("freeStorageSize").safeNumberLong();
+        else
+            freeBytes += reusableBytes(storageStats.getObjectField("wiredTiger"));
+
+        for (mongo::BSONObjIterator it(storageStats.getObjectField("indexSizes")); it.more(); ) {
+            mongo::BSONElement const elem = it.next();
+            std::string const name = elem.fieldName();
+            long long const free = reusableBytes(indexDetails.getObjectField(name));
+
+            IndexStorage *index = nullptr;
+            for (auto &existing : indexes) {
+                if (existing.name == name)
+                    index = &existing;
+            }
+            if (!index) {
+                indexes.push_back(IndexStorage());
+                index = &indexes.back();
+                index->name = name;
+            }
+
+            index->sizeBytes += elem.safeNumberLong();
+            index->freeBytes += free;
+            indexFreeBytes += free;
+        }
+    }
+
+    CollectionStorage StorageReport::total() const
+    {
+        CollectionStorage total;
+        total.name = database;
+        for (auto const& collection : collections) {
+            total.count += collection.count;
+            total.dataSize += collection.dataSize;
+            total.storageSize += collection.storageSize;
+            total.freeBytes += collection.freeBytes;
+            total.indexSize += collection.indexSize;
+            total.indexFreeBytes += collection.indexFreeBytes;
+        }
+        return total;
+    }
+}
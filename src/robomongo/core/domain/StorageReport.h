@@ -0,0 +1,58 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <mongo/bson/bsonobj.h>
+
+namespace Robomongo
+{
+    struct IndexStorage
+    {
+        std::string name;
+        long long sizeBytes = 0;
+        long long freeBytes = 0;    // allocated but reusable by storage engine
+    };
+
+    /**
+     * @brief Storage of one collection summed over all shards
+     */
+    struct CollectionStorage
+    {
+        std::string name;
+        long long count = 0;
+        long long dataSize = 0;         // uncompressed size of documents
+        long long storageSize = 0;      // allocated on disk for documents
+        long long freeBytes = 0;        // reusable bytes of documents, part of storageSize
+        long long indexSize = 0;
+        long long indexFreeBytes = 0;
+        std::vector<IndexStorage> indexes;
+        std::string error;              // collection stats could not be read
+
+        long long totalSize() const { return storageSize + indexSize; }
+
+        /**
+         * @returns uncompressed size divided by used storage, 0 when unknown
+         */
+        double compressionRatio() const;
+
+        /**
+         * @brief Adds "storageStats" of $collStats or reply of collStats command.
+         * Sharded collections report stats of every shard separately.
+         */
+        void add(const mongo::BSONObj &storageStats);
+    };
+
+    /**
+     * @brief Sizes of all collections of database, cached by server until refreshed
+     */
+    struct StorageReport
+    {
+        std::string database;
+        std::vector<CollectionStorage> collections;
+        long long timeMs = 0;   // when loading finished, milliseconds since epoch
+
+        bool empty() const { return timeMs == 0; }
+        CollectionStorage total() const;
+    };
+}
@@ -0,0 +1,45 @@
+#include "gtest/gtest.h"
+#include "robomongo/core/domain/StorageReport.h"
+
+#include "robomongo/shell/bson/json.h"
+
+using namespace Robomongo;
+
+TEST(StorageReportTests, add_FreeStorageSize_IsPreferred)
+{
+    CollectionStorage storage;
+    storage.add(mongo::Robomongo::fromjson(
+        "{ count: 10, size: 4000, storageSize: 2000, freeStorageSize: 500, totalIndexSize: 300,"
+        "  wiredTiger: { 'block-manager': { 'file bytes available for reuse': 700 } },"
+        "  indexSizes: { _id_: 200, a_1: 100 },"
+        "  indexDetails: { a_1: { 'block-manager': { 'file bytes available for reuse': 40 } } } }"));
+
+    EXPECT_EQ(10, storage.count);
+    EXPECT_EQ(500, storage.freeBytes);
+    EXPECT_EQ(2300, storage.totalSize());
+    EXPECT_NEAR(4000.0 / 1500, storage.compressionRatio(), 1e-9);
+    ASSERT_EQ(2u, storage.indexes.size());
+    EXPECT_EQ("a_1", storage.indexes[1].name);
+    EXPECT_EQ(40, storage.indexes[1].freeBytes);
+    EXPECT_EQ(40, storage.indexFreeBytes);
+}
+
+TEST(StorageReportTests, add_Shards_AreSummed)
+{
+    CollectionStorage storage;
+    for (int shard = 0; shard < 2; ++shard) {
+        storage.add(mongo::Robomongo::fromjson(
+            "{ count: 5, size: 100, storageSize: 50, totalIndexSize: 20, indexSizes: { _id_: 20 },"
+            "  wiredTiger: { 'block-manager': { 'file bytes available for reuse': 10 } } }"));
+    }
+
+    EXPECT_EQ(10, storage.count);
+    EXPECT_EQ(20, storage.freeBytes);
+    ASSERT_EQ(1u, storage.indexes.size());
+    EXPECT_EQ(40, storage.indexes[0].sizeBytes);
+
+    StorageReport report;
+    report.collections.push_back(storage);
+    report.collections.push_back(storage);
+    EXPECT_EQ(80, report.total().indexSize);
+}
@@ -33,6 +33,7 @@
 #include "robomongo/core/domain/MongoDocument.h"
 #include "robomongo/core/utils/Logger.h"
 #include "robomongo/core/utils/QtUtils.h"
+#include "robomongo/core/utils/ExplainUtils.h"
 
 namespace
 {
@@ -167,8 +168,7 @@ namespace Robomongo
         _initialized = true;
     }
 
-    MongoShellExecResult ScriptEngine::exec(const std::string &originalScript, const std::string &dbName, 
-                                            AggrInfo aggrInfo /* = AggrInfo() */)
+    MongoShellExecResult ScriptEngine::exec(const std::string &originalScript, const std::string &dbName)
     {
         QMutexLocker lock(&_mutex);
 
@@ -239,9 +239,13 @@ namespace Robomongo
 
                     std::vector<MongoDocumentPtr> docs = MongoDocument::fromBsonObj(__objects);
 
+                    // Explain output has its own view
+                    if (type.empty() && docs.size() == 1 && ExplainUtils::isExplainOutput(docs.front()->bsonObj()))
+                        type = "explain";
+
                     if (!answer.empty() || docs.size() > 0)
                         results.push_back(
-                            prepareResult(type, answer, docs, elapsed, statement, aggrInfo)
+                            prepareResult(type, answer, docs, elapsed, statement)
                         );
                 }
                 catch (const std::exception &e) {
@@ -333,7 +337,7 @@ namespace Robomongo
 
     MongoShellResult ScriptEngine::prepareResult(const std::string &type, const std::string &output,
                                                  const std::vector<MongoDocumentPtr> &objects, qint64 elapsedms,
-                                                 const std::string &statement, AggrInfo aggrInfo /*= AggrInfo()*/)
+                                                 const std::string &statement)
     {
         const char *script =
             "__robomongoQuery = false; \n"
@@ -363,6 +367,13 @@ namespace Robomongo
             "    __robomongoDbName = __robomongoLastRes._db.getName();\n "
             "    __robomongoServerAddress = __robomongoLastRes._db._mongo.host; \n"
             "    __robomongoCollectionName = __robomongoLastRes._collName; \n"
+            "    __robomongoAggregateCursor = { id: NumberLong(0), batch: [] }; \n"
+            "    try { \n"
+            "        __robomongoAggregateCursor.id = __robomongoLastRes._cursorid; \n"
+            "        __robomongoAggregateCursor.batch = __robomongoLastRes._batch.slice().reverse(); \n"
+            "        var __robomongoLsid = __robomongoLastRes._db.getSession().getSessionId(); \n"
+            "        if (__robomongoLsid) __robomongoAggregateCursor.lsid = __robomongoLsid; \n"
+            "    } catch (e) {} \n"
             "} \n"
             ;
 
@@ -396,14 +407,17 @@ namespace Robomongo
             mongo::BSONObj const pipeline = _scope->getObject("__robomongoAggregatePipeline");
             mongo::BSONObj const options = _scope->getObject("__robomongoAggregateOptions");
 
-            // This query can be paging of an original aggr. query, we store the original/unpaged 
-            // pipeline object here.
-            mongo::BSONObj const origPipeline = aggrInfo.isValid ? aggrInfo.pipeline : pipeline;
-            int const skip = aggrInfo.isValid ? aggrInfo.skip : 0;
-            int const batchSize = aggrInfo.isValid ? aggrInfo.batchSize : 50;
-            int const resultIndex = aggrInfo.isValid ? aggrInfo.resultIndex : -1;
-
-            AggrInfo const newAggrInfo { collectionName, skip, batchSize, origPipeline, options, resultIndex };
+            // Pages after the first one are read by worker, see MongoClient::aggregatePage()
+            AggrInfo newAggrInfo { collectionName, 0, 50, pipeline, options, -1 };
+            newAggrInfo.dbName = dbName;
+
+            // Shell keeps the cursor open: documents it buffered are shown first, then pages
+            // are read from the server. Cursor position follows the documents printed.
+            mongo::BSONObj const cursor = _scope->getObject("__robomongoAggregateCursor");
+            newAggrInfo.cursorId = cursor["id"].safeNumberLong();
+            newAggrInfo.cursorSkip = static_cast<int>(objects.size());
+            newAggrInfo.cursorBatch = cursor["batch"].isABSONObj() ? cursor["batch"].Obj().getOwned() : mongo::BSONObj();
+            newAggrInfo.lsid = cursor["lsid"].isABSONObj() ? cursor["lsid"].Obj().getOwned() : mongo::BSONObj();
             return MongoShellResult(type, output, objects, MongoQueryInfo(), statement, elapsedms, newAggrInfo);
         }
         return MongoShellResult(type, output, objects, MongoQueryInfo(), statement, elapsedms);
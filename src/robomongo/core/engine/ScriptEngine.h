@@ -21,8 +21,7 @@ namespace Robomongo
         ~ScriptEngine();
 
         void init(bool isLoadMongoJs, const std::string& serverAddr = "", const std::string& dbName = "");
-        MongoShellExecResult exec(const std::string &script, const std::string &dbName = std::string(),
-                                  AggrInfo aggrInfo = AggrInfo());
+        MongoShellExecResult exec(const std::string &script, const std::string &dbName = std::string());
         void interrupt();
 
         void use(const std::string &dbName);
@@ -41,7 +40,7 @@ namespace Robomongo
 
         MongoShellResult prepareResult(const std::string &type, const std::string &output, 
                                        const std::vector<MongoDocumentPtr> &objects, qint64 elapsedms,
-                                       const std::string &statement, AggrInfo aggrInfo = AggrInfo());
+                                       const std::string &statement);
 
         MongoShellExecResult prepareExecResult(
             const std::vector<MongoShellResult> &results, bool timeoutReached = false);
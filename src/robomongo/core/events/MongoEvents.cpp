@@ -21,6 +21,26 @@ namespace Robomongo
     R_REGISTER_EVENT(AddEditIndexResponse)
     R_REGISTER_EVENT(DropCollectionIndexRequest)
     R_REGISTER_EVENT(DropCollectionIndexResponse)
+    R_REGISTER_EVENT(AnalyzeSchemaRequest)
+    R_REGISTER_EVENT(AnalyzeSchemaResponse)
+    R_REGISTER_EVENT(IndexHealthRequest)
+    R_REGISTER_EVENT(IndexHealthResponse)
+    R_REGISTER_EVENT(IndexHealthLoadedEvent)
+    R_REGISTER_EVENT(ProfilingLevelRequest)
+    R_REGISTER_EVENT(ProfilingLevelResponse)
+    R_REGISTER_EVENT(LoadProfilerRequest)
+    R_REGISTER_EVENT(LoadProfilerResponse)
+    R_REGISTER_EVENT(CurrentOpRequest)
+    R_REGISTER_EVENT(CurrentOpResponse)
+    R_REGISTER_EVENT(ServerStatusRequest)
+    R_REGISTER_EVENT(ServerStatusResponse)
+    R_REGISTER_EVENT(ReplicaSetStatusRequest)
+    R_REGISTER_EVENT(ReplicaSetStatusResponse)
+    R_REGISTER_EVENT(ReplicaSetStatusChanged)
+    R_REGISTER_EVENT(StorageReportRequest)
+    R_REGISTER_EVENT(StorageReportResponse)
+    R_REGISTER_EVENT(KillOpRequest)
+    R_REGISTER_EVENT(KillOpResponse)
     R_REGISTER_EVENT(LoadUsersResponse)
     R_REGISTER_EVENT(LoadFunctionsRequest)
     R_REGISTER_EVENT(LoadFunctionsResponse)
@@ -31,6 +51,12 @@ namespace Robomongo
     R_REGISTER_EVENT(OpeningShellEvent)
     R_REGISTER_EVENT(ExecuteQueryRequest)
     R_REGISTER_EVENT(ExecuteQueryResponse)
+    R_REGISTER_EVENT(ExecuteAggregatePageRequest)
+    R_REGISTER_EVENT(ExecuteAggregatePageResponse)
+    R_REGISTER_EVENT(KillAggregateCursorRequest)
+    R_REGISTER_EVENT(ProfilePipelineRequest)
+    R_REGISTER_EVENT(ProfilePipelineResponse)
+    R_REGISTER_EVENT(PipelineProfiledEvent)
     R_REGISTER_EVENT(DocumentListLoadedEvent)
     R_REGISTER_EVENT(ExecuteScriptRequest)
     R_REGISTER_EVENT(ExecuteScriptResponse)
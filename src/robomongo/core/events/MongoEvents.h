@@ -12,6 +12,13 @@
 #include "robomongo/core/domain/MongoFunction.h"
 #include "robomongo/core/events/MongoEventsInfo.h"
 #include "robomongo/core/domain/MongoAggregateInfo.h"
+#include "robomongo/core/domain/PipelineProfile.h"
+#include "robomongo/core/domain/IndexHealth.h"
+#include "robomongo/core/domain/SchemaReport.h"
+#include "robomongo/core/domain/ProfilerWindow.h"
+#include "robomongo/core/domain/CurrentOpTracker.h"
+#include "robomongo/core/domain/ReplicaSetStatus.h"
+#include "robomongo/core/domain/StorageReport.h"
 #include "robomongo/core/Event.h"
 #include "robomongo/core/Enums.h"
 #include "robomongo/core/mongodb/ReplicaSet.h"
@@ -307,6 +314,309 @@ namespace Robomongo
         std::string _index;
     };
 
+    class AnalyzeSchemaRequest : public Event
+    {
+        R_EVENT
+    public:
+        AnalyzeSchemaRequest(QObject *sender, const MongoCollectionInfo &collection, int sampleSize,
+                             const SchemaAnalysisCancel &cancel) :
+            Event(sender), _collection(collection), _sampleSize(sampleSize), _cancel(cancel) {}
+        MongoCollectionInfo collection() const { return _collection; }
+        int sampleSize() const { return _sampleSize; }
+        SchemaAnalysisCancel cancel() const { return _cancel; }
+    private:
+        const MongoCollectionInfo _collection;
+        const int _sampleSize;
+        const SchemaAnalysisCancel _cancel;
+    };
+
+    class AnalyzeSchemaResponse : public Event
+    {
+        R_EVENT
+    public:
+        AnalyzeSchemaResponse(QObject *sender, const SchemaReport &report) :
+            Event(sender), _ns(report.ns), _report(report) {}
+
+        AnalyzeSchemaResponse(QObject *sender, const std::string &ns, const EventError &error) :
+            Event(sender, error), _ns(ns) {}
+
+        std::string ns() const { return _ns; }
+        SchemaReport report() const { return _report; }
+    private:
+        std::string _ns;
+        SchemaReport _report;
+    };
+
+    class IndexHealthRequest : public Event
+    {
+        R_EVENT
+    public:
+        IndexHealthRequest(QObject *sender, const MongoCollectionInfo &collection) :
+            Event(sender), _collection(collection) {}
+        MongoCollectionInfo collection() const { return _collection; }
+    private:
+        const MongoCollectionInfo _collection;
+    };
+
+    class IndexHealthResponse : public Event
+    {
+        R_EVENT
+    public:
+        IndexHealthResponse(QObject *sender, const IndexHealth &health) :
+            Event(sender), _ns(health.ns), _health(health) {}
+
+        IndexHealthResponse(QObject *sender, const std::string &ns, const EventError &error) :
+            Event(sender, error), _ns(ns) {}
+
+        std::string ns() const { return _ns; }
+        IndexHealth health() const { return _health; }
+    private:
+        std::string _ns;
+        IndexHealth _health;
+    };
+
+    /**
+     * @brief Profiling level and slow operation threshold of database.
+     * Level -1 of request only reads them.
+     */
+    class ProfilingLevelRequest : public Event
+    {
+        R_EVENT
+    public:
+        ProfilingLevelRequest(QObject *sender, const std::string &database, int level, int slowMs) :
+            Event(sender), _database(database), _level(level), _slowMs(slowMs) {}
+        std::string database() const { return _database; }
+        int level() const { return _level; }
+        int slowMs() const { return _slowMs; }
+    private:
+        const std::string _database;
+        const int _level;
+        const int _slowMs;
+    };
+
+    class ProfilingLevelResponse : public Event
+    {
+        R_EVENT
+    public:
+        ProfilingLevelResponse(QObject *sender, const std::string &database, int level, int slowMs) :
+            Event(sender), _database(database), _level(level), _slowMs(slowMs) {}
+
+        ProfilingLevelResponse(QObject *sender, const std::string &database, const EventError &error) :
+            Event(sender, error), _database(database), _level(-1), _slowMs(-1) {}
+
+        std::string database() const { return _database; }
+        int level() const { return _level; }
+        int slowMs() const { return _slowMs; }
+    private:
+        std::string _database;
+        int _level;
+        int _slowMs;
+    };
+
+    /**
+     * @brief Reads operations recorded since the last read into window,
+     * and groups the window by query shape
+     */
+    class LoadProfilerRequest : public Event
+    {
+        R_EVENT
+    public:
+        LoadProfilerRequest(QObject *sender, const std::string &database, const ProfilerWindow &window) :
+            Event(sender), _database(database), _window(window) {}
+        std::string database() const { return _database; }
+        ProfilerWindow window() const { return _window; }
+    private:
+        const std::string _database;
+        const ProfilerWindow _window;
+    };
+
+    class LoadProfilerResponse : public Event
+    {
+        R_EVENT
+    public:
+        LoadProfilerResponse(QObject *sender, const std::string &database, const ProfilerWindow &window,
+                             const std::vector<QueryShapeStats> &shapes) :
+            Event(sender), _database(database), _window(window), _shapes(shapes) {}
+
+        LoadProfilerResponse(QObject *sender, const std::string &database, const EventError &error) :
+            Event(sender, error), _database(database) {}
+
+        std::string database() const { return _database; }
+        ProfilerWindow window() const { return _window; }
+        std::vector<QueryShapeStats> shapes() const { return _shapes; }
+    private:
+        std::string _database;
+        ProfilerWindow _window;
+        std::vector<QueryShapeStats> _shapes;
+    };
+
+    /**
+     * @brief Applies snapshot of operations in progress to tracker.
+     * Empty database means operations of all databases.
+     */
+    class CurrentOpRequest : public Event
+    {
+        R_EVENT
+    public:
+        CurrentOpRequest(QObject *sender, const std::string &database, const CurrentOpTracker &tracker) :
+            Event(sender), _database(database), _tracker(tracker) {}
+        std::string database() const { return _database; }
+        CurrentOpTracker tracker() const { return _tracker; }
+    private:
+        const std::string _database;
+        const CurrentOpTracker _tracker;
+    };
+
+    class CurrentOpResponse : public Event
+    {
+        R_EVENT
+    public:
+        CurrentOpResponse(QObject *sender, const std::string &database, const CurrentOpTracker &tracker) :
+            Event(sender), _database(database), _tracker(tracker) {}
+
+        CurrentOpResponse(QObject *sender, const std::string &database, const EventError &error) :
+            Event(sender, error), _database(database) {}
+
+        std::string database() const { return _database; }
+        CurrentOpTracker tracker() const { return _tracker; }
+    private:
+        std::string _database;
+        CurrentOpTracker _tracker;
+    };
+
+    /**
+     * @brief serverStatus reply for performance dashboard, only sections with
+     * sampled metrics are requested
+     */
+    class ServerStatusRequest : public Event
+    {
+        R_EVENT
+    public:
+        ServerStatusRequest(QObject *sender) :
+            Event(sender) {}
+    };
+
+    class ServerStatusResponse : public Event
+    {
+        R_EVENT
+    public:
+        ServerStatusResponse(QObject *sender, const mongo::BSONObj &status, long long timeMs) :
+            Event(sender), _status(status), _timeMs(timeMs) {}
+
+        ServerStatusResponse(QObject *sender, const EventError &error) :
+            Event(sender, error), _timeMs(0) {}
+
+        mongo::BSONObj status() const { return _status; }
+        long long timeMs() const { return _timeMs; }
+    private:
+        mongo::BSONObj _status;
+        long long _timeMs;
+    };
+
+    /**
+     * @brief replSetGetStatus sampled by replica set monitor of server
+     */
+    class ReplicaSetStatusRequest : public Event
+    {
+        R_EVENT
+    public:
+        ReplicaSetStatusRequest(QObject *sender) :
+            Event(sender) {}
+    };
+
+    class ReplicaSetStatusResponse : public Event
+    {
+        R_EVENT
+    public:
+        ReplicaSetStatusResponse(QObject *sender, const ReplicaSetStatus &status) :
+            Event(sender), _status(status) {}
+
+        ReplicaSetStatusResponse(QObject *sender, const EventError &error) :
+            Event(sender, error) {}
+
+        ReplicaSetStatus status() const { return _status; }
+    private:
+        ReplicaSetStatus _status;
+    };
+
+    /**
+     * @brief Published by server when replica set monitor sees a visible change.
+     * "topologyChanged" is set when primary, members or reachability changed, so
+     * the replica set folder must be refreshed in full.
+     */
+    class ReplicaSetStatusChanged : public Event
+    {
+        R_EVENT
+    public:
+        ReplicaSetStatusChanged(QObject *sender, const ReplicaSetStatus &status, bool topologyChanged) :
+            Event(sender), _status(status), _topologyChanged(topologyChanged) {}
+
+        ReplicaSetStatus status() const { return _status; }
+        bool topologyChanged() const { return _topologyChanged; }
+    private:
+        const ReplicaSetStatus _status;
+        const bool _topologyChanged;
+    };
+
+    /**
+     * @brief Sizes of all collections and indexes of database
+     */
+    class StorageReportRequest : public Event
+    {
+        R_EVENT
+    public:
+        StorageReportRequest(QObject *sender, const std::string &database) :
+            Event(sender), _database(database) {}
+        std::string database() const { return _database; }
+    private:
+        const std::string _database;
+    };
+
+    class StorageReportResponse : public Event
+    {
+        R_EVENT
+    public:
+        StorageReportResponse(QObject *sender, const StorageReport &report) :
+            Event(sender), _database(report.database), _report(report) {}
+
+        StorageReportResponse(QObject *sender, const std::string &database, const EventError &error) :
+            Event(sender, error), _database(database) {}
+
+        std::string database() const { return _database; }
+        StorageReport report() const { return _report; }
+    private:
+        std::string _database;
+        StorageReport _report;
+    };
+
+    class KillOpRequest : public Event
+    {
+        R_EVENT
+    public:
+        KillOpRequest(QObject *sender, const mongo::BSONObj &opid, const std::string &id) :
+            Event(sender), _opid(opid), _id(id) {}
+        mongo::BSONObj opid() const { return _opid; }
+        std::string id() const { return _id; }
+    private:
+        const mongo::BSONObj _opid;
+        const std::string _id;
+    };
+
+    class KillOpResponse : public Event
+    {
+        R_EVENT
+    public:
+        KillOpResponse(QObject *sender, const std::string &id) :
+            Event(sender), _id(id) {}
+
+        KillOpResponse(QObject *sender, const std::string &id, const EventError &error) :
+            Event(sender, error), _id(id) {}
+
+        std::string id() const { return _id; }
+    private:
+        std::string _id;
+    };
+
     /**
      * @brief Load Users
      */
@@ -923,6 +1233,101 @@ namespace Robomongo
         std::vector<MongoDocumentPtr> documents;
     };
 
+    class ExecuteAggregatePageRequest : public Event
+    {
+        R_EVENT
+
+    public:
+        ExecuteAggregatePageRequest(QObject *sender, int resultIndex, const AggrInfo &aggrInfo, int skip, int batchSize) :
+            Event(sender),
+            _resultIndex(resultIndex),
+            _aggrInfo(aggrInfo),
+            _skip(skip),
+            _batchSize(batchSize) {}
+
+        int resultIndex() const { return _resultIndex; }
+        AggrInfo aggrInfo() const { return _aggrInfo; }
+        int skip() const { return _skip; }
+        int batchSize() const { return _batchSize; }
+
+    private:
+        int _resultIndex;
+        AggrInfo _aggrInfo;
+        int _skip;
+        int _batchSize;
+    };
+
+    class ExecuteAggregatePageResponse : public Event
+    {
+        R_EVENT
+
+        ExecuteAggregatePageResponse(QObject *sender, int resultIndex, const AggrInfo &aggrInfo, const std::vector<MongoDocumentPtr> &documents) :
+            Event(sender),
+            resultIndex(resultIndex),
+            aggrInfo(aggrInfo),
+            documents(documents) { }
+
+        ExecuteAggregatePageResponse(QObject *sender, const EventError &error) :
+            Event(sender, error) {}
+
+        int resultIndex;
+        AggrInfo aggrInfo;
+        std::vector<MongoDocumentPtr> documents;
+    };
+
+    /**
+     * @brief Closes server cursor of aggregation results that are no longer shown, no response
+     */
+    class KillAggregateCursorRequest : public Event
+    {
+        R_EVENT
+
+    public:
+        KillAggregateCursorRequest(QObject *sender, const AggrInfo &aggrInfo) :
+            Event(sender),
+            _aggrInfo(aggrInfo) {}
+
+        AggrInfo aggrInfo() const { return _aggrInfo; }
+
+    private:
+        AggrInfo _aggrInfo;
+    };
+
+    class ProfilePipelineRequest : public Event
+    {
+        R_EVENT
+
+    public:
+        ProfilePipelineRequest(QObject *sender, int resultIndex, const AggrInfo &aggrInfo) :
+            Event(sender),
+            _resultIndex(resultIndex),
+            _aggrInfo(aggrInfo) {}
+
+        int resultIndex() const { return _resultIndex; }
+        AggrInfo aggrInfo() const { return _aggrInfo; }
+
+    private:
+        int _resultIndex;
+        AggrInfo _aggrInfo;
+    };
+
+    class ProfilePipelineResponse : public Event
+    {
+        R_EVENT
+
+        ProfilePipelineResponse(QObject *sender, int resultIndex, const PipelineProfile &profile) :
+            Event(sender),
+            resultIndex(resultIndex),
+            profile(profile) { }
+
+        ProfilePipelineResponse(QObject *sender, int resultIndex, const EventError &error) :
+            Event(sender, error),
+            resultIndex(resultIndex) {}
+
+        int resultIndex;
+        PipelineProfile profile;
+    };
+
     class AutocompleteRequest : public Event
     {
         R_EVENT
@@ -962,11 +1367,10 @@ namespace Robomongo
         R_EVENT
 
         ExecuteScriptRequest(QObject *sender, const std::string &script, const std::string &dbName, 
-                             AggrInfo aggrInfo = AggrInfo(), int take = 0, int skip = 0) :
+                             int take = 0, int skip = 0) :
             Event(sender),
             script(script),
             databaseName(dbName),
-            aggrInfo(aggrInfo),
             take(take),
             skip(skip)
             {}
@@ -975,7 +1379,6 @@ namespace Robomongo
         std::string databaseName;
         int take; //
         int skip;
-        AggrInfo const aggrInfo;
     };
 
     class ExecuteScriptResponse : public Event
@@ -1084,17 +1487,25 @@ namespace Robomongo
             _query(query),
             _documents(docs) { }
 
+        DocumentListLoadedEvent(QObject *sender, int resultIndex, const AggrInfo &aggrInfo, const std::vector<MongoDocumentPtr> &docs) :
+            Event(sender),
+            _resultIndex(resultIndex),
+            _aggrInfo(aggrInfo),
+            _documents(docs) { }
+
         DocumentListLoadedEvent(QObject *sender, const EventError &error) :
             Event(sender, error) {}
 
         int resultIndex() const { return _resultIndex; }
         MongoQueryInfo queryInfo() const { return _queryInfo; }
+        AggrInfo aggrInfo() const { return _aggrInfo; }
         std::vector<MongoDocumentPtr> documents() const { return _documents; }
         std::string query() const { return _query; }
 
     private:
         int _resultIndex;
         MongoQueryInfo _queryInfo;
+        AggrInfo _aggrInfo;
         std::vector<MongoDocumentPtr> _documents;
         std::string _query;
     };
@@ -1121,6 +1532,44 @@ namespace Robomongo
         bool const _timeoutReached = false;
     };
 
+    class PipelineProfiledEvent : public Event
+    {
+        R_EVENT
+
+    public:
+        PipelineProfiledEvent(QObject *sender, int resultIndex, const PipelineProfile &profile) :
+            Event(sender), _resultIndex(resultIndex), _profile(profile) {}
+
+        PipelineProfiledEvent(QObject *sender, int resultIndex, const EventError &error) :
+            Event(sender, error), _resultIndex(resultIndex) {}
+
+        int resultIndex() const { return _resultIndex; }
+        PipelineProfile profile() const { return _profile; }
+
+    private:
+        int _resultIndex;
+        PipelineProfile _profile;
+    };
+
+    class IndexHealthLoadedEvent : public Event
+    {
+        R_EVENT
+
+    public:
+        IndexHealthLoadedEvent(QObject *sender, const IndexHealth &health) :
+            Event(sender), _ns(health.ns), _health(health) {}
+
+        IndexHealthLoadedEvent(QObject *sender, const std::string &ns, const EventError &error) :
+            Event(sender, error), _ns(ns) {}
+
+        std::string ns() const { return _ns; }
+        IndexHealth health() const { return _health; }
+
+    private:
+        std::string _ns;
+        IndexHealth _health;
+    };
+
     class ScriptExecutingEvent : public Event
     {
         R_EVENT
@@ -1,9 +1,18 @@
 #include "robomongo/core/mongodb/MongoClient.h"
 
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <exception>
+#include <thread>
+
 #include "mongo/db/namespace_string.h"
 
 #include "robomongo/core/domain/MongoDocument.h"
 #include "robomongo/core/utils/BsonUtils.h"
+#include "robomongo/core/utils/ExplainUtils.h"
+#include "robomongo/core/utils/IndexAdvisor.h"
+#include "robomongo/core/utils/SchemaAnalyzer.h"
 #include "robomongo/shell/bson/json.h"
 
 namespace
@@ -32,6 +41,84 @@ namespace
 
         return info;
     }
+
+    // Failed command with error code reported by server
+    class CommandError : public std::runtime_error
+    {
+    public:
+        CommandError(const std::string &message, int code) :
+            std::runtime_error(message), _code(code) {}
+
+        int code() const { return _code; }
+
+    private:
+        int _code;
+    };
+
+    mongo::BSONObj runCommandOrThrow(mongo::DBClientBase *dbclient, const std::string &dbName,
+                                     const mongo::BSONObj &cmd)
+    {
+        mongo::BSONObj result;
+        if (!dbclient->runCommand(dbName, cmd, result)) {
+            std::string errStr = result.getStringField("errmsg");
+            if (errStr.empty())
+                errStr = "Failed to get error message.";
+
+            throw CommandError(errStr, result["code"].numberInt());
+        }
+        return result;
+    }
+
+    // getMore failed because server has no such cursor or it belongs to another session.
+    // Cursor of the shell is opened by another connection, session of the shell may be gone.
+    bool isCursorLost(int code)
+    {
+        return code == 43                       // CursorNotFound
+            || code == 50737 || code == 50738   // other session, MongoDB 3.6 - 4.2
+            || code == 13;                      // Unauthorized, other session since MongoDB 4.4
+    }
+
+    // Aggregation stage is not known to server, i.e. $collStats before MongoDB 3.4
+    bool isUnrecognizedStage(int code)
+    {
+        return code == 40324        // UnrecognizedPipelineStage, MongoDB 3.6+
+            || code == 16436;       // MongoDB 3.2 and earlier
+    }
+
+    // Appends documents of "firstBatch" or "nextBatch" of cursor reply, returns id of the cursor
+    long long appendCursorBatch(const mongo::BSONObj &reply, const char *batchName,
+                                std::vector<mongo::BSONObj> &documents)
+    {
+        mongo::BSONObj const cursor = reply.getObjectField("cursor");
+        if (cursor.isEmpty())
+            throw std::runtime_error("Aggregation did not return a cursor.");
+
+        for (mongo::BSONObjIterator it(cursor.getObjectField(batchName)); it.more(); )
+            documents.push_back(it.next().Obj().getOwned());
+
+        return cursor["id"].safeNumberLong();
+    }
+
+    std::string escapeRegex(const std::string &text)
+    {
+        std::string result;
+        for (char c : text) {
+            if (!isalnum(static_cast<unsigned char>(c)) && c != '_' && c != '-')
+                result += '\\';
+            result += c;
+        }
+        return result;
+    }
+
+    // Options of aggregate command given by user, cursor options are set by caller
+    void appendAggregateOptions(mongo::BSONObjBuilder &cmd, const mongo::BSONObj &options)
+    {
+        for (mongo::BSONObjIterator it(options); it.more(); ) {
+            mongo::BSONElement const option = it.next();
+            if (std::string("cursor") != option.fieldName() && std::string("explain") != option.fieldName())
+                cmd.append(option);
+        }
+    }
 }
 
 namespace Robomongo
@@ -577,6 +664,539 @@ namespace Robomongo
         return docs;
     }
 
+    std::vector<MongoDocumentPtr> MongoClient::aggregatePage(AggrInfo &info, int skip, int batchSize)
+    {
+        std::vector<MongoDocumentPtr> docs;
+
+        // Cursor only moves forward
+        if (skip >= info.cursorSkip && (info.cursorId || !info.cursorBatch.isEmpty())) {
+            try {
+                docs = readAggregateCursor(info, skip, batchSize);
+                info.skip = skip;
+                info.batchSize = batchSize;
+                return docs;
+            }
+            catch (const CommandError &ex) {
+                if (!isCursorLost(ex.code()))
+                    throw;
+
+                // I.e. cursor timed out on server, pipeline runs again
+                info.cursorId = 0;
+                info.cursorBatch = mongo::BSONObj();
+            }
+        }
+
+        docs = runAggregate(info, skip, batchSize);
+        info.skip = skip;
+        info.batchSize = batchSize;
+        return docs;
+    }
+
+    std::vector<MongoDocumentPtr> MongoClient::readAggregateCursor(AggrInfo &info, int skip, int batchSize)
+    {
+        // Documents from the cursor position, buffered ones go first
+        std::vector<mongo::BSONObj> fetched;
+        for (mongo::BSONObjIterator it(info.cursorBatch); it.more(); )
+            fetched.push_back(it.next().Obj());
+
+        size_t const needed = static_cast<size_t>(skip - info.cursorSkip) + batchSize;
+        while (fetched.size() < needed && info.cursorId) {
+            mongo::BSONObjBuilder cmd;
+            cmd.append("getMore", info.cursorId);
+            cmd.append("collection", info.collectionName);
+            cmd.append("batchSize", static_cast<long long>(needed - fetched.size()));
+            if (!info.lsid.isEmpty())
+                cmd.append("lsid", info.lsid);
+
+            info.cursorId = appendCursorBatch(runCommandOrThrow(_dbclient, info.dbName, cmd.obj()),
+                                              "nextBatch", fetched);
+        }
+
+        std::vector<MongoDocumentPtr> docs;
+        size_t const first = std::min(fetched.size(), static_cast<size_t>(skip - info.cursorSkip));
+        size_t const last = std::min(fetched.size(), needed);
+        for (size_t i = first; i < last; ++i)
+            docs.push_back(MongoDocument::fromBsonObj(fetched[i]));
+
+        // Documents read beyond the page are kept for the next one
+        mongo::BSONArrayBuilder rest;
+        for (size_t i = last; i < fetched.size(); ++i)
+            rest.append(fetched[i]);
+
+        info.cursorBatch = rest.arr();
+        info.cursorSkip += static_cast<int>(last);
+        return docs;
+    }
+
+    std::vector<MongoDocumentPtr> MongoClient::runAggregate(AggrInfo &info, int skip, int batchSize)
+    {
+        killAggregateCursor(info);
+
+        mongo::BSONArrayBuilder pipeline;
+        for (mongo::BSONObjIterator it(info.pipeline); it.more(); )
+            pipeline.append(it.next());
+        if (skip > 0)
+            pipeline.append(BSON("$skip" << skip));
+
+        mongo::BSONObjBuilder cmd;
+        cmd.append("aggregate", info.collectionName);
+        cmd.appendArray("pipeline", pipeline.arr());
+        appendAggregateOptions(cmd, info.options);
+        cmd.append("cursor", BSON("batchSize" << batchSize));
+
+        std::vector<mongo::BSONObj> fetched;
+        info.cursorId = appendCursorBatch(runCommandOrThrow(_dbclient, info.dbName, cmd.obj()),
+                                          "firstBatch", fetched);
+        info.cursorSkip = skip + static_cast<int>(fetched.size());
+        info.cursorBatch = mongo::BSONObj();
+
+        // Cursor is opened on this connection, outside of shell session
+        info.lsid = mongo::BSONObj();
+
+        std::vector<MongoDocumentPtr> docs;
+        for (auto const& obj : fetched)
+            docs.push_back(MongoDocument::fromBsonObj(obj));
+        return docs;
+    }
+
+    PipelineProfile MongoClient::profilePipeline(const AggrInfo &info, int sampleSize)
+    {
+        // Stages writing results are not run
+        mongo::BSONArrayBuilder readPipeline;
+        std::vector<std::string> outputStages;
+        int stagesCount = 0;
+        for (mongo::BSONObjIterator it(info.pipeline); it.more(); ) {
+            mongo::BSONElement const stage = it.next();
+            std::string const name = stage.Obj().firstElementFieldName();
+            if (ExplainUtils::isOutputStage(name) || !outputStages.empty()) {
+                outputStages.push_back(name);
+                continue;
+            }
+            readPipeline.append(stage);
+            ++stagesCount;
+        }
+        mongo::BSONObj const pipeline = readPipeline.arr();
+
+        mongo::BSONObjBuilder aggregate;
+        aggregate.append("aggregate", info.collectionName);
+        aggregate.appendArray("pipeline", pipeline);
+        appendAggregateOptions(aggregate, info.options);
+        aggregate.append("cursor", mongo::BSONObj());
+
+        mongo::BSONObj const explain = runCommandOrThrow(_dbclient, info.dbName, 
+            BSON("explain" << aggregate.obj() << "verbosity" << "executionStats"));
+
+        PipelineProfile profile;
+        if (!ExplainUtils::parsePipelineExplain(explain, profile)) {
+            // Server did not report every stage: prefixes of pipeline are timed on a sample,
+            // cost of stage is the difference from the previous prefix
+            std::vector<long long> counts;
+            std::vector<long long> times;
+            for (int prefix = 0; prefix <= stagesCount; ++prefix) {
+                mongo::BSONObjBuilder cmd;
+                cmd.append("aggregate", info.collectionName);
+                cmd.appendArray("pipeline", ExplainUtils::sampledPrefix(pipeline, prefix, sampleSize));
+                appendAggregateOptions(cmd, info.options);
+                cmd.append("cursor", mongo::BSONObj());
+
+                auto const start = std::chrono::steady_clock::now();
+                std::vector<mongo::BSONObj> batch;
+                appendCursorBatch(runCommandOrThrow(_dbclient, info.dbName, cmd.obj()), "firstBatch", batch);
+                auto const elapsed = std::chrono::steady_clock::now() - start;
+
+                counts.push_back(batch.empty() ? 0 : batch.front()["n"].safeNumberLong());
+                times.push_back(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+            }
+
+            profile.stages.clear();
+            profile.sampleSize = sampleSize;
+            int index = 0;
+            for (mongo::BSONObjIterator it(pipeline); it.more(); ++index) {
+                PipelineStageProfile stage;
+                stage.name = it.next().Obj().firstElementFieldName();
+                stage.docsIn = counts[index];
+                stage.docsOut = counts[index + 1];
+                stage.timeMillis = std::max(0LL, times[index + 1] - times[index]);
+                profile.stages.push_back(stage);
+            }
+        }
+
+        for (auto const& name : outputStages) {
+            PipelineStageProfile stage;
+            stage.name = name;
+            stage.details = "Not run, stages writing results are not profiled";
+            profile.stages.push_back(stage);
+        }
+
+        return profile;
+    }
+
+    SchemaReport MongoClient::analyzeSchema(const MongoCollectionInfo &collection, int sampleSize,
+                                            const std::atomic<bool> &cancelled)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        MongoNamespace const ns = collection.ns();
+
+        SchemaReport report;
+        report.ns = ns.toString();
+        report.sampleSize = sampleSize;
+        report.threads = static_cast<int>(std::max(1u, std::min(4u, std::thread::hardware_concurrency())));
+
+        mongo::BSONObjBuilder cmd;
+        cmd.append("aggregate", ns.collectionName());
+        cmd.appendArray("pipeline", BSON_ARRAY(BSON("$sample" << BSON("size" << sampleSize))));
+        cmd.append("cursor", BSON("batchSize" << 1000));
+
+        std::vector<mongo::BSONObj> batch, next;
+        long long cursorId = appendCursorBatch(runCommandOrThrow(_dbclient, ns.databaseName(), cmd.obj()),
+                                               "firstBatch", batch);
+
+        // Every thread has its own analyzer, they are merged at the end. Exception
+        // can't leave a thread, it is kept and thrown again after the join.
+        std::vector<SchemaAnalyzer> analyzers(report.threads);
+        std::vector<std::exception_ptr> errors(report.threads);
+        std::vector<std::thread> threads;
+        auto const joinThreads = [&threads]() {
+            for (auto &thread : threads)
+                thread.join();
+            threads.clear();
+        };
+
+        try {
+            while (!batch.empty()) {
+                if (cancelled)
+                    throw std::runtime_error("Schema analysis was cancelled.");
+
+                for (size_t i = 0; i < analyzers.size(); ++i) {
+                    size_t const begin = batch.size() * i / analyzers.size();
+                    size_t const end = batch.size() * (i + 1) / analyzers.size();
+                    SchemaAnalyzer &analyzer = analyzers[i];
+                    std::exception_ptr &error = errors[i];
+                    threads.push_back(std::thread([&analyzer, &error, &batch, begin, end]() {
+                        try {
+                            for (size_t j = begin; j < end; ++j)
+                                analyzer.add(batch[j]);
+                        } catch (...) {
+                            error = std::current_exception();
+                        }
+                    }));
+                }
+
+                // Next batch is read while the current one is analyzed, only two are kept in memory
+                next.clear();
+                if (cursorId) {
+                    mongo::BSONObjBuilder getMore;
+                    getMore.append("getMore", cursorId);
+                    getMore.append("collection", ns.collectionName());
+                    getMore.append("batchSize", 1000);
+                    cursorId = appendCursorBatch(runCommandOrThrow(_dbclient, ns.databaseName(), getMore.obj()),
+                                                 "nextBatch", next);
+                }
+
+                joinThreads();
+                for (auto const& error : errors) {
+                    if (error)
+                        std::rethrow_exception(error);
+                }
+                batch.swap(next);
+            }
+        } catch (...) {
+            joinThreads();
+
+            // Sample is not read to the end, cursor would stay open until timeout.
+            // Failure to kill it must not hide the original error.
+            if (cursorId) {
+                try {
+                    mongo::BSONObjBuilder killCursors;
+                    killCursors.append("killCursors", ns.collectionName());
+                    killCursors.append("cursors", BSON_ARRAY(cursorId));
+                    mongo::BSONObj result;
+                    _dbclient->runCommand(ns.databaseName(), killCursors.obj(), result);
+                } catch (...) {
+                }
+            }
+            throw;
+        }
+
+        for (size_t i = 1; i < analyzers.size(); ++i)
+            analyzers.front().merge(analyzers[i]);
+        analyzers.front().fillReport(report);
+
+        report.millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        return report;
+    }
+
+    IndexHealth MongoClient::indexHealth(const MongoCollectionInfo &collection)
+    {
+        MongoNamespace const ns = collection.ns();
+
+        IndexHealth health;
+        health.ns = ns.toString();
+
+        std::list<mongo::BSONObj> const specs = _dbclient->getIndexSpecs(ns.toString());
+        for (auto const& spec : specs) {
+            IndexUsageInfo index;
+            index.name = spec.getStringField("name");
+            index.key = spec.getObjectField("key").getOwned();
+            index.unique = spec.getBoolField("unique");
+            index.ttl = spec.hasField("expireAfterSeconds");
+            index.special = spec.getBoolField("sparse") || spec.hasField("partialFilterExpression") ||
+                            spec.hasField("collation");
+
+            // Text, geo, hashed and wildcard indexes do not keep plain field order
+            for (mongo::BSONObjIterator it(index.key); it.more(); ) {
+                mongo::BSONElement const field = it.next();
+                if (!field.isNumber() || std::string(field.fieldName()).find("$**") != std::string::npos)
+                    index.special = true;
+            }
+            health.indexes.push_back(index);
+        }
+
+        try {
+            mongo::BSONObjBuilder cmd;
+            cmd.append("aggregate", ns.collectionName());
+            cmd.appendArray("pipeline", BSON_ARRAY(BSON("$indexStats" << mongo::BSONObj())));
+            cmd.append("cursor", mongo::BSONObj());
+
+            std::vector<mongo::BSONObj> stats;
+            appendCursorBatch(runCommandOrThrow(_dbclient, ns.databaseName(), cmd.obj()), "firstBatch", stats);
+
+            // Sharded collection has one document per index on every shard
+            for (auto const& stat : stats) {
+                std::string const name = stat.getStringField("name");
+                mongo::BSONObj const accesses = stat.getObjectField("accesses");
+                for (auto &index : health.indexes) {
+                    if (index.name != name)
+                        continue;
+
+                    index.accesses = std::max(index.accesses, 0LL) + accesses["ops"].safeNumberLong();
+                    if (accesses["since"].type() == mongo::Date) {
+                        long long const since = accesses["since"].date().toMillisSinceEpoch();
+                        index.since = index.since ? std::min(index.since, since) : since;
+                    }
+                }
+            }
+        } catch (const std::exception &ex) {
+            health.notes.push_back(std::string("Index usage is not available: ") + ex.what());
+        }
+
+        mongo::BSONObj stats;
+        if (_dbclient->runCommand(ns.databaseName(), BSON("collStats" << ns.collectionName()), stats)) {
+            mongo::BSONObj const sizes = stats.getObjectField("indexSizes");
+            for (auto &index : health.indexes) {
+                if (sizes.hasField(index.name))
+                    index.sizeBytes = sizes[index.name].safeNumberLong();
+            }
+        }
+
+        IndexAdvisor::markUnusedAndRedundant(health.indexes);
+
+        // Newest operations are analyzed, profiler level 1 records only slow ones
+        std::vector<mongo::BSONObj> entries;
+        try {
+            mongo::BSONObjBuilder cmd;
+            cmd.append("find", "system.profile");
+            cmd.append("filter", BSON("ns" << ns.toString()));
+            cmd.append("sort", BSON("ts" << -1));
+            cmd.append("projection", BSON("command" << 1 << "originatingCommand" << 1 << "query" << 1 <<
+                                           "planSummary" << 1 << "docsExamined" << 1 << "nreturned" << 1 <<
+                                           "nMatched" << 1 << "ndeleted" << 1 << "millis" << 1));
+            cmd.append("limit", 1000);
+            cmd.append("singleBatch", true);
+            appendCursorBatch(runCommandOrThrow(_dbclient, ns.databaseName(), cmd.obj()), "firstBatch", entries);
+        } catch (const std::exception &ex) {
+            health.notes.push_back(std::string("Profiled queries are not available: ") + ex.what());
+        }
+
+        health.slowQueries = static_cast<int>(entries.size());
+        health.suggestions = IndexAdvisor::suggestIndexes(entries, health.indexes);
+
+        if (entries.empty()) {
+            health.notes.push_back("No profiled queries of the collection. To record slow queries, run "
+                                   "db.setProfilingLevel(1) in database " + ns.databaseName() + ".");
+        }
+
+        return health;
+    }
+
+    void MongoClient::profilingLevel(const std::string &dbName, int &level, int &slowMs)
+    {
+        bool const isRead = level < 0;
+
+        mongo::BSONObjBuilder cmd;
+        cmd.append("profile", isRead ? -1 : level);
+        if (!isRead && slowMs >= 0)
+            cmd.append("slowms", slowMs);
+
+        // Reply has values before the change
+        mongo::BSONObj const result = runCommandOrThrow(_dbclient, dbName, cmd.obj());
+        if (isRead)
+            level = result["was"].numberInt();
+        if (isRead || slowMs < 0)
+            slowMs = result["slowms"].numberInt();
+    }
+
+    void MongoClient::readProfiler(const std::string &dbName, ProfilerWindow &window, int limit)
+    {
+        // Operations of the last read millisecond are read again and skipped by window
+        int const count = window.lastTsCount() + limit;
+
+        mongo::BSONObjBuilder filter;
+        filter.append("ts", BSON("$gte" << mongo::Date_t::fromMillisSinceEpoch(window.lastTs())));
+        filter.append("ns", BSON("$ne" << dbName + ".system.profile"));
+
+        // Profiler collection is capped, natural order is the order operations were recorded
+        mongo::BSONObjBuilder cmd;
+        cmd.append("find", "system.profile");
+        cmd.append("filter", filter.obj());
+        cmd.append("sort", BSON("$natural" << 1));
+        cmd.append("projection", BSON("ts" << 1 << "op" << 1 << "ns" << 1 << "millis" << 1 << 
+                                      "planSummary" << 1 << "docsExamined" << 1 << "keysExamined" << 1 <<
+                                      "nscanned" << 1 << "nscannedObjects" << 1 << "nreturned" << 1 <<
+                                      "nMatched" << 1 << "ndeleted" << 1 << "command" << 1 <<
+                                      "originatingCommand" << 1 << "query" << 1));
+        cmd.append("limit", count);
+        cmd.append("batchSize", count);
+        cmd.append("singleBatch", true);
+
+        std::vector<mongo::BSONObj> entries;
+        appendCursorBatch(runCommandOrThrow(_dbclient, dbName, cmd.obj()), "firstBatch", entries);
+        window.append(entries);
+    }
+
+    std::vector<mongo::BSONObj> MongoClient::currentOp(const std::string &dbName)
+    {
+        // Own polls are marked, so monitor does not show itself
+        const char *const comment = "robo3t operations monitor";
+
+        mongo::BSONObjBuilder match;
+        match.append("active", true);
+        match.append("command.comment", BSON("$ne" << comment));
+        if (!dbName.empty())
+            match.appendRegex("ns", "^" + escapeRegex(dbName) + "\\.");
+
+        mongo::BSONObj const projection = BSON("opid" << 1 << "op" << 1 << "ns" << 1 << "desc" << 1 << 
+                                               "client" << 1 << "client_s" << 1 << "appName" << 1 <<
+                                               "microsecs_running" << 1 << "secs_running" << 1 << 
+                                               "planSummary" << 1 << "waitingForLock" << 1 << "msg" << 1 <<
+                                               "command" << 1);
+
+        mongo::BSONObjBuilder cmd;
+        cmd.append("aggregate", 1);
+        cmd.appendArray("pipeline", BSON_ARRAY(BSON("$currentOp" << BSON("allUsers" << true)) <<
+                                               BSON("$match" << match.obj()) << 
+                                               BSON("$project" << projection)));
+        cmd.append("cursor", BSON("batchSize" << 1000));
+        cmd.append("comment", comment);
+
+        std::vector<mongo::BSONObj> inprog;
+        mongo::BSONObj result;
+        if (_dbclient->runCommand("admin", cmd.obj(), result)) {
+            appendCursorBatch(result, "firstBatch", inprog);
+            return inprog;
+        }
+
+        // $currentOp stage is available since 3.6
+        mongo::BSONObjBuilder legacy;
+        legacy.append("currentOp", 1);
+        legacy.append("active", true);
+        if (!dbName.empty())
+            legacy.appendRegex("ns", "^" + escapeRegex(dbName) + "\\.");
+
+        mongo::BSONObj const reply = runCommandOrThrow(_dbclient, "admin", legacy.obj());
+        for (mongo::BSONObjIterator it(reply.getObjectField("inprog")); it.more(); ) {
+            mongo::BSONElement const op = it.next();
+            if (op.isABSONObj())
+                inprog.push_back(op.Obj().getOwned());
+        }
+        return inprog;
+    }
+
+    void MongoClient::killOp(const mongo::BSONObj &opid)
+    {
+        mongo::BSONObjBuilder cmd;
+        cmd.append("killOp", 1);
+        cmd.appendElements(opid);
+        runCommandOrThrow(_dbclient, "admin", cmd.obj());
+    }
+
+    mongo::BSONObj MongoClient::serverStatus()
+    {
+        mongo::BSONObj const cmd = BSON("serverStatus" << 1 << "repl" << 0 << "metrics" << 0 << "locks" << 0 <<
+                                        "globalLock" << 0 << "asserts" << 0 << "opcountersRepl" << 0 <<
+                                        "transactions" << 0 << "logicalSessionRecordCache" << 0 <<
+                                        "flowControl" << 0 << "catalogStats" << 0);
+        return runCommandOrThrow(_dbclient, "admin", cmd).getOwned();
+    }
+
+    mongo::BSONObj MongoClient::replicaSetStatus()
+    {
+        return runCommandOrThrow(_dbclient, "admin", BSON("replSetGetStatus" << 1)).getOwned();
+    }
+
+    StorageReport MongoClient::storageReport(const std::string &dbName)
+    {
+        StorageReport report;
+        report.database = dbName;
+
+        std::list<mongo::BSONObj> const infos = _dbclient->getCollectionInfos(dbName);
+        for (auto const& info : infos) {
+            // Views have no storage of their own
+            if (info.hasField("type") && std::string(info.getStringField("type")) != "collection")
+                continue;
+
+            CollectionStorage storage;
+            storage.name = info.getStringField("name");
+            try {
+                try {
+                    mongo::BSONObjBuilder cmd;
+                    cmd.append("aggregate", storage.name);
+                    cmd.appendArray("pipeline", BSON_ARRAY(BSON("$collStats" << BSON("storageStats" << mongo::BSONObj()))));
+                    cmd.append("cursor", mongo::BSONObj());
+
+                    // One document for every shard
+                    std::vector<mongo::BSONObj> shards;
+                    appendCursorBatch(runCommandOrThrow(_dbclient, dbName, cmd.obj()), "firstBatch", shards);
+                    for (auto const& shard : shards)
+                        storage.add(shard.getObjectField("storageStats"));
+                } catch (const CommandError &ex) {
+                    // $collStats is supported since MongoDB 3.4
+                    if (!isUnrecognizedStage(ex.code()))
+                        throw;
+
+                    storage.add(runCommandOrThrow(_dbclient, dbName, BSON("collStats" << storage.name)));
+                }
+            } catch (const CommandError &ex) {
+                // I.e. not authorized for this collection, the other ones are still reported.
+                // Network errors are not caught, the whole report fails.
+                storage.error = ex.what();
+            }
+            report.collections.push_back(storage);
+        }
+
+        report.timeMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        return report;
+    }
+
+    void MongoClient::killAggregateCursor(AggrInfo &info)
+    {
+        if (!info.cursorId)
+            return;
+
+        mongo::BSONObjBuilder cmd;
+        cmd.append("killCursors", info.collectionName);
+        cmd.append("cursors", BSON_ARRAY(info.cursorId));
+        if (!info.lsid.isEmpty())
+            cmd.append("lsid", info.lsid);
+
+        // Cursor may be already gone, it is not an error
+        mongo::BSONObj result;
+        _dbclient->runCommand(info.dbName, cmd.obj(), result);
+        info.cursorId = 0;
+    }
+
     MongoCollectionInfo MongoClient::runCollStatsCommand(const std::string &ns)
     {
         MongoCollectionInfo info(ns);
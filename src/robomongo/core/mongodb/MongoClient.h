@@ -5,6 +5,12 @@
 
 #include "robomongo/core/Core.h"
 #include "robomongo/core/domain/MongoQueryInfo.h"
+#include "robomongo/core/domain/MongoAggregateInfo.h"
+#include "robomongo/core/domain/PipelineProfile.h"
+#include "robomongo/core/domain/IndexHealth.h"
+#include "robomongo/core/domain/ProfilerWindow.h"
+#include "robomongo/core/domain/SchemaReport.h"
+#include "robomongo/core/domain/StorageReport.h"
 #include "robomongo/core/domain/MongoUser.h"
 #include "robomongo/core/domain/MongoFunction.h"
 #include "robomongo/core/events/MongoEventsInfo.h"
@@ -52,12 +58,91 @@ namespace Robomongo
         void removeDocuments(const MongoNamespace &ns, mongo::Query query, bool justOne = true);
         std::vector<MongoDocumentPtr> query(const MongoQueryInfo &info);
 
+        /**
+         * @brief Loads "batchSize" documents of aggregation results, starting at "skip".
+         * Documents are read from the server cursor of "info" with getMore, as long as the
+         * cursor is alive and is not past "skip". Otherwise pipeline runs again with a $skip
+         * stage and the new cursor is kept. Pipeline also runs again when getMore fails because
+         * the cursor is not found or belongs to the session of the shell; other errors are
+         * thrown. Cursor state and paging of "info" are updated.
+         */
+        std::vector<MongoDocumentPtr> aggregatePage(AggrInfo &info, int skip, int batchSize);
+
+        /**
+         * @brief Kills server cursor of aggregation results, if it is still open
+         */
+        void killAggregateCursor(AggrInfo &info);
+
+        /**
+         * @brief Cost of every stage of aggregation pipeline, from "executionStats" explain.
+         * When server does not report stages separately, prefixes of pipeline are run
+         * on "sampleSize" documents instead. Stages writing results ($out, $merge) are skipped.
+         */
+        PipelineProfile profilePipeline(const AggrInfo &info, int sampleSize);
+
+        /**
+         * @brief Usage and size of collection indexes ($indexStats, collStats) with
+         * indexes suggested for slow queries recorded by database profiler.
+         * Sources that are not available (old server, no privileges, profiler off)
+         * are listed in notes, the rest is still analyzed.
+         */
+        IndexHealth indexHealth(const MongoCollectionInfo &collection);
+
+        /**
+         * @brief Schema of "sampleSize" random documents. Batches of cursor are analyzed
+         * by several threads while the next batch is read. Throws when "cancelled" is set
+         * before the last batch is analyzed.
+         */
+        SchemaReport analyzeSchema(const MongoCollectionInfo &collection, int sampleSize,
+                                   const std::atomic<bool> &cancelled);
+
+        /**
+         * @brief Sets profiling level (0, 1 or 2) and slow operation threshold of database,
+         * level -1 only reads them. Current values are returned in "level" and "slowMs".
+         */
+        void profilingLevel(const std::string &dbName, int &level, int &slowMs);
+
+        /**
+         * @brief Appends to "window" at most "limit" operations which database profiler
+         * recorded since the last read
+         */
+        void readProfiler(const std::string &dbName, ProfilerWindow &window, int limit);
+
+        /**
+         * @brief Active operations of database, or of all databases when "dbName" is empty.
+         * Only fields shown by operations monitor are read.
+         */
+        std::vector<mongo::BSONObj> currentOp(const std::string &dbName);
+
+        /**
+         * @param opid: { op: <opid> }
+         */
+        void killOp(const mongo::BSONObj &opid);
+
+        /**
+         * @brief serverStatus without sections that are large and not sampled
+         * (replication, metrics, locks etc.)
+         */
+        mongo::BSONObj serverStatus();
+
+        mongo::BSONObj replicaSetStatus();
+
+        /**
+         * @brief $collStats of every collection of database, collStats command for
+         * servers without $collStats. Command error of one collection (i.e. not authorized)
+         * is reported in its entry, other errors are thrown.
+         */
+        StorageReport storageReport(const std::string &dbName);
+
         MongoCollectionInfo runCollStatsCommand(const std::string &ns);
         std::vector<MongoCollectionInfo> runCollStatsCommand(const std::vector<std::string> &namespaces);
 
         void done();
 
     private:
+        std::vector<MongoDocumentPtr> readAggregateCursor(AggrInfo &info, int skip, int batchSize);
+        std::vector<MongoDocumentPtr> runAggregate(AggrInfo &info, int skip, int batchSize);
+
         mongo::DBClientBase *const _dbclient;
         void checkLastErrorAndThrow(const std::string &db);
     };
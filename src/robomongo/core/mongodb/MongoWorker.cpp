@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <exception>
 
+#include <QDateTime>
 #include <QThread>
 
 #include <mongo/client/global_conn_pool.h>
@@ -34,10 +35,12 @@ namespace Robomongo
     std::string const APP_NAME_VERSION { "robo3t-" + APP_VERSION };
 
     MongoWorker::MongoWorker(ConnectionSettings *connection, bool isLoadMongoRcJs, int batchSize,
-                             double mongoTimeoutSec, int shellTimeoutSec, QObject *parent) 
+                             double mongoTimeoutSec, int shellTimeoutSec, bool isServiceWorker,
+                             QObject *parent) 
         : QObject(parent),
         _scriptEngine(nullptr),
         _isLoadMongoRcJs(isLoadMongoRcJs),
+        _isServiceWorker(isServiceWorker),
         _batchSize(batchSize),
         _timerId(-1),
         _dbAutocompleteCacheTimerId(-1),
@@ -112,12 +115,18 @@ namespace Robomongo
     void MongoWorker::init()
     {        
         try {
+            constexpr int PING_INTERVAL_MSEC { 60 * 1000 };  // 60 seconds
+            if (_timerId == -1)
+                _timerId = startTimer(PING_INTERVAL_MSEC);
+
+            // Service workers use only their own connection, shell is never needed
+            if (_isServiceWorker)
+                return;
+
             _scriptEngine.reset(new ScriptEngine(_connSettings, _shellTimeoutSec));
             _scriptEngine->init(_isLoadMongoRcJs);
             _scriptEngine->use(_connSettings->defaultDatabase());
             _scriptEngine->setBatchSize(_batchSize);
-            constexpr int PING_INTERVAL_MSEC { 60 * 1000 };  // 60 seconds
-            _timerId = startTimer(PING_INTERVAL_MSEC);
             _dbAutocompleteCacheTimerId = startTimer(30000);
         } catch (const std::exception &ex) {
             auto const msg { "Failed to initialize MongoWorker. Reason: "};
@@ -154,6 +163,13 @@ namespace Robomongo
     void MongoWorker::stopAndDelete()
     {
         _isQuiting = 1;
+
+        // Requests sent before, i.e. killing cursors of closed results, are handled first
+        QMetaObject::invokeMethod(this, "quitThread", Qt::QueuedConnection);
+    }
+
+    void MongoWorker::quitThread()
+    {
         _thread->quit();
     }
 
@@ -239,21 +255,7 @@ namespace Robomongo
                 }
             }
 
-            if (_connSettings->hasEnabledPrimaryCredential()) {
-                CredentialSettings const * const credentials = _connSettings->primaryCredential();
-
-                // Building BSON object:
-                mongo::BSONObj const authParams { 
-                    mongo::BSONObjBuilder()
-                    .append("user", credentials->userName())
-                    .append("db", credentials->databaseName())
-                    .append("pwd", credentials->userPassword())
-                    .append("mechanism", credentials->mechanism())
-                    .obj()
-                };
-
-                conn->auth(authParams);
-            }
+            authenticate(conn);
 
             boost::scoped_ptr<MongoClient> client(getClient());
             std::vector<std::string> const dbNames = getDatabaseNamesSafe(event);
@@ -464,6 +466,143 @@ namespace Robomongo
         }
     }
 
+    void MongoWorker::handle(IndexHealthRequest *event)
+    {
+        try {
+            boost::scoped_ptr<MongoClient> client(getClient());
+            IndexHealth const health = client->indexHealth(event->collection());
+            client->done();
+
+            reply(event->sender(), new IndexHealthResponse(this, health));
+        } catch(const std::exception &ex) {
+            reply(event->sender(), 
+                new IndexHealthResponse(this, event->collection().ns().toString(), EventError(ex.what())));
+            sendLog(this, LogEvent::RBM_ERROR, ex.what());
+        }
+    }
+
+    void MongoWorker::handle(AnalyzeSchemaRequest *event)
+    {
+        try {
+            boost::scoped_ptr<MongoClient> client(getMonitorClient());
+            SchemaReport const report = client->analyzeSchema(event->collection(), event->sampleSize(),
+                                                              *event->cancel());
+            client->done();
+
+            reply(event->sender(), new AnalyzeSchemaResponse(this, report));
+        } catch(const std::exception &ex) {
+            reply(event->sender(), 
+                new AnalyzeSchemaResponse(this, event->collection().ns().toString(), EventError(ex.what())));
+            sendLog(this, LogEvent::RBM_ERROR, ex.what());
+        }
+    }
+
+    void MongoWorker::handle(ProfilingLevelRequest *event)
+    {
+        try {
+            boost::scoped_ptr<MongoClient> client(getMonitorClient());
+            int level = event->level();
+            int slowMs = event->slowMs();
+            client->profilingLevel(event->database(), level, slowMs);
+            client->done();
+
+            reply(event->sender(), new ProfilingLevelResponse(this, event->database(), level, slowMs));
+        } catch(const std::exception &ex) {
+            reply(event->sender(), new ProfilingLevelResponse(this, event->database(), EventError(ex.what())));
+            sendLog(this, LogEvent::RBM_ERROR, ex.what());
+        }
+    }
+
+    void MongoWorker::handle(LoadProfilerRequest *event)
+    {
+        // Operations read at once, the rest is read by the next request
+        const int readLimit = 1000;
+
+        try {
+            boost::scoped_ptr<MongoClient> client(getMonitorClient());
+            ProfilerWindow window = event->window();
+            client->readProfiler(event->database(), window, readLimit);
+            client->done();
+
+            reply(event->sender(), new LoadProfilerResponse(this, event->database(), window, window.shapes()));
+        } catch(const std::exception &ex) {
+            // Profiler dialog shows the error, it is not logged on every poll
+            reply(event->sender(), new LoadProfilerResponse(this, event->database(), EventError(ex.what())));
+        }
+    }
+
+    void MongoWorker::handle(CurrentOpRequest *event)
+    {
+        try {
+            boost::scoped_ptr<MongoClient> client(getMonitorClient());
+            std::vector<mongo::BSONObj> const inprog = client->currentOp(event->database());
+            client->done();
+
+            CurrentOpTracker tracker = event->tracker();
+            tracker.update(inprog, QDateTime::currentMSecsSinceEpoch());
+            reply(event->sender(), new CurrentOpResponse(this, event->database(), tracker));
+        } catch(const std::exception &ex) {
+            // Monitor shows the error, it is not logged on every poll
+            reply(event->sender(), new CurrentOpResponse(this, event->database(), EventError(ex.what())));
+        }
+    }
+
+    void MongoWorker::handle(KillOpRequest *event)
+    {
+        try {
+            boost::scoped_ptr<MongoClient> client(getMonitorClient());
+            client->killOp(event->opid());
+            client->done();
+
+            reply(event->sender(), new KillOpResponse(this, event->id()));
+        } catch(const std::exception &ex) {
+            reply(event->sender(), new KillOpResponse(this, event->id(), EventError(ex.what())));
+            sendLog(this, LogEvent::RBM_ERROR, ex.what());
+        }
+    }
+
+    void MongoWorker::handle(ServerStatusRequest *event)
+    {
+        try {
+            boost::scoped_ptr<MongoClient> client(getMonitorClient());
+            mongo::BSONObj const status = client->serverStatus();
+            client->done();
+
+            reply(event->sender(), new ServerStatusResponse(this, status, QDateTime::currentMSecsSinceEpoch()));
+        } catch(const std::exception &ex) {
+            // Dashboard shows the error, it is not logged on every poll
+            reply(event->sender(), new ServerStatusResponse(this, EventError(ex.what())));
+        }
+    }
+
+    void MongoWorker::handle(StorageReportRequest *event)
+    {
+        try {
+            boost::scoped_ptr<MongoClient> client(getMonitorClient());
+            StorageReport const report = client->storageReport(event->database());
+            client->done();
+
+            reply(event->sender(), new StorageReportResponse(this, report));
+        } catch(const std::exception &ex) {
+            reply(event->sender(), new StorageReportResponse(this, event->database(), EventError(ex.what())));
+            sendLog(this, LogEvent::RBM_ERROR, ex.what());
+        }
+    }
+
+    void MongoWorker::handle(ReplicaSetStatusRequest *event)
+    {
+        try {
+            boost::scoped_ptr<MongoClient> client(getMonitorClient());
+            mongo::BSONObj const status = client->replicaSetStatus();
+            client->done();
+
+            reply(event->sender(), new ReplicaSetStatusResponse(this, ReplicaSetStatus::fromReplSetGetStatus(status)));
+        } catch(const std::exception &ex) {
+            // Server refreshes replica set folder, which reports the error
+            reply(event->sender(), new ReplicaSetStatusResponse(this, EventError(ex.what())));
+        }
+    }
+
     void MongoWorker::handle(AddEditIndexRequest *event)
     {
         const IndexInfo &newIndex = event->newInfo();
@@ -599,6 +738,52 @@ namespace Robomongo
         }
     }
 
+    void MongoWorker::handle(ExecuteAggregatePageRequest *event)
+    {
+        try {
+            boost::scoped_ptr<MongoClient> client { getClient() };
+            AggrInfo aggrInfo = event->aggrInfo();
+            std::vector<MongoDocumentPtr> docs = client->aggregatePage(aggrInfo, event->skip(), event->batchSize());
+            client->done();
+            reply(event->sender(),
+                new ExecuteAggregatePageResponse(this, event->resultIndex(), aggrInfo, docs)
+            );
+        } catch(const std::exception &ex) {
+            reply(event->sender(), new ExecuteAggregatePageResponse(this, EventError(ex.what())));
+            sendLog(this, LogEvent::RBM_ERROR, std::string(ex.what()));
+        }
+    }
+
+    void MongoWorker::handle(KillAggregateCursorRequest *event)
+    {
+        try {
+            boost::scoped_ptr<MongoClient> client { getClient() };
+            AggrInfo aggrInfo = event->aggrInfo();
+            client->killAggregateCursor(aggrInfo);
+            client->done();
+        } catch(const std::exception &ex) {
+            // Server closes idle cursor itself, failure is only logged
+            sendLog(this, LogEvent::RBM_WARN, std::string(ex.what()));
+        }
+    }
+
+    void MongoWorker::handle(ProfilePipelineRequest *event)
+    {
+        // Documents each prefix of pipeline is run on, when explain has no stage statistics
+        const int sampleSize = 10000;
+
+        try {
+            boost::scoped_ptr<MongoClient> client { getClient() };
+            PipelineProfile const profile = client->profilePipeline(event->aggrInfo(), sampleSize);
+            client->done();
+            reply(event->sender(), new ProfilePipelineResponse(this, event->resultIndex(), profile));
+        } catch(const std::exception &ex) {
+            reply(event->sender(), 
+                new ProfilePipelineResponse(this, event->resultIndex(), EventError(ex.what())));
+            sendLog(this, LogEvent::RBM_ERROR, std::string(ex.what()));
+        }
+    }
+
     /**
      * @brief Execute javascript
      */
@@ -628,9 +813,7 @@ namespace Robomongo
 
             // todo: should we use dbName from event or _connSettings? 
             MongoShellExecResult result {
-                _scriptEngine->exec(
-                    event->script, _connSettings->defaultDatabase(), event->aggrInfo
-                )
+                _scriptEngine->exec(event->script, _connSettings->defaultDatabase())
             };
 
             // To fix the problem where 'result' comes with old primary address.
@@ -982,6 +1165,47 @@ namespace Robomongo
         return new MongoClient(getConnection().first);
     }
 
+    MongoClient *MongoWorker::getMonitorClient()
+    {
+        // Service workers get no EstablishConnectionRequest, they connect on the first request
+        bool const isConnected = _dbclient || _dbclientRepSet;
+        try {
+            auto const& connAndErrorStr = getConnection(true);
+            if (!connAndErrorStr.first)
+                throw std::runtime_error("Connection failure. " + connAndErrorStr.second);
+
+            if (!isConnected)
+                authenticate(connAndErrorStr.first);
+
+            return new MongoClient(connAndErrorStr.first);
+        } catch (const std::exception &) {
+            // Next request connects again
+            _dbclient.reset();
+            _dbclientRepSet.reset();
+            throw;
+        }
+    }
+
+    void MongoWorker::authenticate(mongo::DBClientBase *conn) const
+    {
+        if (!_connSettings->hasEnabledPrimaryCredential())
+            return;
+
+        CredentialSettings const * const credentials = _connSettings->primaryCredential();
+
+        // Building BSON object:
+        mongo::BSONObj const authParams { 
+            mongo::BSONObjBuilder()
+            .append("user", credentials->userName())
+            .append("db", credentials->databaseName())
+            .append("pwd", credentials->userPassword())
+            .append("mechanism", credentials->mechanism())
+            .obj()
+        };
+
+        conn->auth(authParams);
+    }
+
     void MongoWorker::configureSSL()
     {
         // As a precaution reset SSL global params for any kind of connection request (SSL or non-SSL)
@@ -1087,6 +1311,16 @@ namespace Robomongo
             if (!dbclientTemp->connect(node, APP_NAME_VERSION).isOK())
                 return "";
 
+            // Without script engine set name is read from isMaster, which needs no authentication
+            if (_isServiceWorker) {
+                mongo::BSONObj info;
+                if (dbclientTemp->runCommand("admin", BSON("isMaster" << 1), info))
+                    setName = info.getStringField("setName");
+                if (!setName.empty())
+                    break;
+                continue;
+            }
+
             _scriptEngine->init(_isLoadMongoRcJs, node.toString());
             MongoShellExecResult const& result = _scriptEngine->exec("rs.status()", "");
             if (!result.results().empty()) {
@@ -24,8 +24,13 @@ namespace Robomongo
         Q_OBJECT
 
     public:        
+        /**
+         * @param isServiceWorker: worker runs only native commands (monitoring, sampling,
+         * storage reports). Script engine, its shell connection and autocompletion are not created.
+         */
         explicit MongoWorker(ConnectionSettings *connection, bool isLoadMongoRcJs, int batchSize,
-                             double mongoTimeoutSec, int shellTimeoutSec, QObject *parent = nullptr);
+                             double mongoTimeoutSec, int shellTimeoutSec, bool isServiceWorker = false,
+                             QObject *parent = nullptr);
 
         ~MongoWorker();
         void interrupt();
@@ -36,6 +41,11 @@ namespace Robomongo
 
         void init();
 
+        /**
+         * @brief Stops thread of the worker, queued by stopAndDelete() after pending requests
+         */
+        void quitThread();
+
         /**
          * @brief Every minute we are issuing { ping : 1 } command to every used connection
          * in order to avoid dropped connections.
@@ -73,6 +83,33 @@ namespace Robomongo
         */
         void handle(LoadCollectionIndexesRequest *event);
 
+        /**
+         * @brief Load index usage and suggested indexes of collection
+         */
+        void handle(IndexHealthRequest *event);
+
+        /**
+         * @brief Schema of random sample of collection documents
+         */
+        void handle(AnalyzeSchemaRequest *event);
+
+        /**
+         * @brief Database profiler level, and operations it recorded
+         */
+        void handle(ProfilingLevelRequest *event);
+        void handle(LoadProfilerRequest *event);
+
+        /**
+         * @brief Snapshot of operations in progress, killing one of them, server metrics
+         * and replica set status.
+         * Sent to monitoring worker of server, which has its own connection.
+         */
+        void handle(CurrentOpRequest *event);
+        void handle(KillOpRequest *event);
+        void handle(ServerStatusRequest *event);
+        void handle(ReplicaSetStatusRequest *event);
+        void handle(StorageReportRequest *event);
+
         /**
         * @brief Add/edit indexes in collection
         */
@@ -103,6 +140,17 @@ namespace Robomongo
          */
         void handle(ExecuteQueryRequest *event);
 
+        /**
+         * @brief Load page of aggregation results
+         */
+        void handle(ExecuteAggregatePageRequest *event);
+        void handle(KillAggregateCursorRequest *event);
+
+        /**
+         * @brief Profile stages of aggregation pipeline
+         */
+        void handle(ProfilePipelineRequest *event);
+
         /**
          * @brief Execute javascript
          */
@@ -145,6 +193,13 @@ namespace Robomongo
         std::pair<mongo::DBClientBase*, std::string> getConnection(bool mayReturnNull = false);
         MongoClient *getClient();
 
+        /**
+         * @brief Client of connection which is opened and authenticated by the first request,
+         * used by service workers (monitoring, schema sampling, storage reports)
+         */
+        MongoClient *getMonitorClient();
+        void authenticate(mongo::DBClientBase *conn) const;
+
         /**
         *@brief Reset and update global mongo SSL settings (mongo::sslGlobalParams)
         */
@@ -184,6 +239,7 @@ namespace Robomongo
         std::unique_ptr<ScriptEngine> _scriptEngine;
 
         const bool _isLoadMongoRcJs;
+        const bool _isServiceWorker;
         const int _batchSize;
         int _timerId;
         int _dbAutocompleteCacheTimerId;
@@ -104,10 +104,12 @@ namespace Robomongo
         _viewMode(Robomongo::Tree),
         _autocompletionMode(AutocompleteAll),
         _loadMongoRcJs(false),
+        _flattenTableColumns(false),
         _minimizeToTray(false),
         _lineNumbers(false),
         _disableConnectionShortcuts(false),
         _batchSize(50),
+        _resultMemoryBudgetMb(1024),
         _textFontFamily(""),
         _textFontPointSize(-1),
         _mongoTimeoutSec(10),
@@ -217,6 +219,8 @@ namespace Robomongo
         }
 
         _autoExpand = map.contains("autoExpand") ? map.value("autoExpand").toBool() : true;
+        _flattenTableColumns = map.contains("flattenTableColumns") ? 
+                               map.value("flattenTableColumns").toBool() : false;
         _autoExec = map.contains("autoExec") ? map.value("autoExec").toBool() : true;
         _minimizeToTray = map.contains("minimizeToTray") ? map.value("minimizeToTray").toBool() : false;
         _lineNumbers = map.contains("lineNumbers") ? map.value("lineNumbers").toBool() : false;
@@ -263,6 +267,9 @@ namespace Robomongo
         if (_batchSize == 0)
             _batchSize = 50;
 
+        if (map.contains("resultMemoryBudgetMb"))
+            _resultMemoryBudgetMb = std::max(0, map.value("resultMemoryBudgetMb").toInt());
+
         if (map.contains("checkForUpdates"))
             _checkForUpdates = map.value("checkForUpdates").toBool();
 
@@ -339,6 +346,7 @@ namespace Robomongo
         // 4. Save view mode
         map.insert("viewMode", _viewMode);
         map.insert("autoExpand", _autoExpand);
+        map.insert("flattenTableColumns", _flattenTableColumns);
         map.insert("lineNumbers", _lineNumbers);
 
         // 5. Save Autocompletion mode
@@ -366,6 +374,7 @@ namespace Robomongo
 
         // 9. Save batchSize
         map.insert("batchSize", _batchSize);
+        map.insert("resultMemoryBudgetMb", _resultMemoryBudgetMb);
         map.insert("checkForUpdates", _checkForUpdates);
         map.insert("mongoTimeoutSec", _mongoTimeoutSec);
         map.insert("shellTimeoutSec", _shellTimeoutSec);
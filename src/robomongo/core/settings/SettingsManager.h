@@ -5,6 +5,7 @@
 #include <QSet>
 #include <QDir>
 
+#include <algorithm>
 #include <vector>
 #include <cstdlib>
 
@@ -113,6 +114,9 @@ namespace Robomongo
         void setAutoExpand(bool isExpand) { _autoExpand = isExpand; }
         bool autoExpand() const { return _autoExpand; }
 
+        void setFlattenTableColumns(bool isFlatten) { _flattenTableColumns = isFlatten; }
+        bool flattenTableColumns() const { return _flattenTableColumns; }
+
         void setAutoExec(bool isAutoExec) { _autoExec = isAutoExec; }
         bool autoExec() const { return _autoExec; }
 
@@ -142,6 +146,13 @@ namespace Robomongo
         void setBatchSize(int batchSize) { _batchSize = batchSize; }
         int batchSize() const { return _batchSize; }
 
+        /**
+         * @brief Memory (in MB) that results of all tabs may take, before hidden results
+         * are compacted and spilled to disk. Zero means no limit.
+         */
+        void setResultMemoryBudgetMb(int budget) { _resultMemoryBudgetMb = std::max(0, budget); }
+        int resultMemoryBudgetMb() const { return _resultMemoryBudgetMb; }
+
         QString currentStyle() const { return _currentStyle; }
         void setCurrentStyle(const QString& style);
 
@@ -214,6 +225,7 @@ namespace Robomongo
         AutocompletionMode _autocompletionMode;
         bool _loadMongoRcJs;
         bool _autoExpand;
+        bool _flattenTableColumns;
         bool _autoExec;
         bool _minimizeToTray;
         bool _lineNumbers;
@@ -224,6 +236,7 @@ namespace Robomongo
         QSet<QString> _acceptedEulaVersions;
         QSet<QString> _dbVersionsConnected;
         int _batchSize;
+        int _resultMemoryBudgetMb;
         bool _checkForUpdates = true;
         QString _currentStyle;
         QString _textFontFamily;
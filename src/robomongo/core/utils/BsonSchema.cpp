@@ -0,0 +1,140 @@
+#include "robomongo/core/utils/BsonSchema.h"
+
+namespace Robomongo
+{
+    bool BsonSchema::Field::isDocumentOnly() const
+    {
+        return count > 0 && types[typeSlot(mongo::Object)] == count;
+    }
+
+    BsonSchema::BsonSchema() :
+        _children(1),
+        _order(1),
+        _documentsCount(0)
+    {
+    }
+
+    int BsonSchema::typeSlot(mongo::BSONType type)
+    {
+        switch (type) {
+        case mongo::MinKey: return 0;
+        case mongo::MaxKey: return TypeSlotsCount - 1;
+        default:
+            // Regular types are in range [EOO..NumberDecimal] (0..19)
+            if (type >= 0 && type < TypeSlotsCount - 1)
+                return type;
+            return 0;
+        }
+    }
+
+    void BsonSchema::add(const mongo::BSONObj &document)
+    {
+        ++_documentsCount;
+        addObject(document, -1, _documentsCount);
+    }
+
+    void BsonSchema::addObject(const mongo::BSONObj &obj, int parent, unsigned generation)
+    {
+        mongo::BSONObjIterator iterator(obj);
+        while (iterator.more()) {
+            mongo::BSONElement element = iterator.next();
+
+            // Field name points into the BSON buffer, no copy is made here
+            int const index = findOrInsert(parent, std::string_view(element.fieldName(), element.fieldNameSize() - 1));
+
+            if (_lastSeen[index] != generation) {
+                _lastSeen[index] = generation;
+                ++_fields[index].count;
+            }
+            ++_fields[index].types[typeSlot(element.type())];
+
+            if (element.type() == mongo::Object)
+                addObject(element.Obj(), index, generation);
+        }
+    }
+
+    int BsonSchema::findOrInsert(int parent, std::string_view name)
+    {
+        const ChildrenType &children = _children[parent + 1];
+        ChildrenType::const_iterator it = children.find(name);
+        if (it != children.end())
+            return it->second;
+
+        int const index = _fields.size();
+
+        Field field;
+        field.name = std::string(name);
+        field.path = parent < 0 ? field.name : _fields[parent].path + "." + field.name;
+        field.parent = parent;
+        field.count = 0;
+        field.types.fill(0);
+
+        _fields.push_back(field);
+        _children.emplace_back();
+        _order.emplace_back();
+        _lastSeen.push_back(0);
+
+        // Note: "children" reference is invalidated by emplace_back() above
+        _children[parent + 1].emplace(field.name, index);
+        _order[parent + 1].push_back(index);
+        return index;
+    }
+
+    void BsonSchema::merge(const BsonSchema &other)
+    {
+        // Parents always precede their children in "_fields",
+        // so mapping of the parent is known when child is merged
+        std::vector<int> mapping(other._fields.size());
+        for (size_t i = 0; i < other._fields.size(); ++i) {
+            const Field &field = other._fields[i];
+            int const parent = field.parent < 0 ? -1 : mapping[field.parent];
+            int const index = findOrInsert(parent, field.name);
+            mapping[i] = index;
+
+            Field &mine = _fields[index];
+            mine.count += field.count;
+            for (int slot = 0; slot < TypeSlotsCount; ++slot)
+                mine.types[slot] += field.types[slot];
+        }
+        _documentsCount += other._documentsCount;
+    }
+
+    void BsonSchema::clear()
+    {
+        _fields.clear();
+        _children.assign(1, ChildrenType());
+        _order.assign(1, std::vector<int>());
+        _lastSeen.clear();
+        _documentsCount = 0;
+    }
+
+    double BsonSchema::presence(const Field &field) const
+    {
+        if (!_documentsCount)
+            return 0;
+
+        return double(field.count) / _documentsCount;
+    }
+
+    std::vector<std::string> BsonSchema::columns(bool flatten) const
+    {
+        std::vector<std::string> result;
+        appendColumns(-1, flatten, result);
+        return result;
+    }
+
+    void BsonSchema::appendColumns(int parent, bool flatten, std::vector<std::string> &result) const
+    {
+        for (int index : _order[parent + 1]) {
+            const Field &field = _fields[index];
+            bool const expand = flatten && !_order[index + 1].empty();
+
+            // Keep the column of subdocument if it sometimes has other type
+            if (!expand || !field.isDocumentOnly())
+                result.push_back(field.path);
+
+            if (expand)
+                appendColumns(index, flatten, result);
+        }
+    }
+}
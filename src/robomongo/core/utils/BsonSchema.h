@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <mongo/bson/bsonobj.h>
+
+namespace Robomongo
+{
+    /**
+     * @brief Schema of set of documents, inferred incrementally.
+     *
+     * For every dotted path (i.e. "a.b.c") keeps number of documents where the
+     * path is present and how many times each BSON type was seen. Documents are
+     * only borrowed: field names are looked up in place, and copied just once,
+     * when a path is met for the first time. Schemas of different batches
+     * (i.e. pages) can be merged.
+     *
+     * @threadsafe no
+     */
+    class BsonSchema
+    {
+    public:
+        enum { TypeSlotsCount = 22 };
+
+        struct Field
+        {
+            std::string path;
+            std::string name;
+            int parent;                 // index of parent field, -1 for top-level fields
+            unsigned count;             // number of documents where this field is present
+            std::array<unsigned, TypeSlotsCount> types;
+
+            unsigned typeCount(mongo::BSONType type) const { return types[typeSlot(type)]; }
+
+            // True if every value of this field is an embedded document
+            bool isDocumentOnly() const;
+        };
+
+        BsonSchema();
+
+        /**
+         * @brief Walks document and accounts all its (nested) fields
+         */
+        void add(const mongo::BSONObj &document);
+
+        /**
+         * @brief Adds fields and counters of other schema to this schema
+         */
+        void merge(const BsonSchema &other);
+
+        void clear();
+
+        unsigned documentsCount() const { return _documentsCount; }
+
+        /**
+         * @brief Fields in order of their first appearance, parents go before children
+         */
+        const std::vector<Field> &fields() const { return _fields; }
+
+        /**
+         * @returns share of documents (0..1) where field is present
+         */
+        double presence(const Field &field) const;
+
+        /**
+         * @brief Column paths for table view. When "flatten" is false only top-level
+         * fields are returned, otherwise fields that only contain embedded documents
+         * are replaced with their nested fields.
+         */
+        std::vector<std::string> columns(bool flatten) const;
+
+        static int typeSlot(mongo::BSONType type);
+
+    private:
+        typedef std::map<std::string, int, std::less<> > ChildrenType;
+
+        void addObject(const mongo::BSONObj &obj, int parent, unsigned generation);
+        int findOrInsert(int parent, std::string_view name);
+        void appendColumns(int parent, bool flatten, std::vector<std::string> &result) const;
+
+        std::vector<Field> _fields;
+
+        // Children lookup per field, _children[0] is for top-level fields
+        std::vector<ChildrenType> _children;
+
+        // Order of children per field, _order[0] is for top-level fields
+        std::vector<std::vector<int> > _order;
+
+        // Last document that touched field, to count every path once per document
+        std::vector<unsigned> _lastSeen;
+
+        unsigned _documentsCount;
+    };
+}
@@ -0,0 +1,118 @@
+#include "gtest/gtest.h"
+#include "robomongo/core/utils/BsonSchema.h"
+
+#include "robomongo/shell/bson/json.h"
+
+using namespace Robomongo;
+
+namespace
+{
+    const BsonSchema::Field *findField(const BsonSchema &schema, const std::string &path)
+    {
+        for (auto const& field : schema.fields()) {
+            if (field.path == path)
+                return &field;
+        }
+        return nullptr;
+    }
+
+    std::string join(const std::vector<std::string> &columns)
+    {
+        std::string result;
+        for (auto const& column : columns)
+            result += (result.empty() ? "" : ",") + column;
+        return result;
+    }
+}
+
+TEST(BsonSchemaTests, add_Documents_CountsPathsOncePerDocumentAndTypes)
+{
+    BsonSchema schema;
+    schema.add(mongo::Robomongo::fromjson("{ _id: 1, a: { b: 1, c: 'x' } }"));
+    schema.add(mongo::Robomongo::fromjson("{ _id: 2, a: 'text' }"));
+    schema.add(mongo::Robomongo::fromjson("{ _id: 3, a: { b: 2 }, d: [ 1, 2 ] }"));
+
+    EXPECT_EQ(3u, schema.documentsCount());
+
+    // Parents go before children, in order of the first appearance
+    ASSERT_EQ(5u, schema.fields().size());
+    EXPECT_EQ("_id", schema.fields()[0].path);
+    EXPECT_EQ("a", schema.fields()[1].path);
+    EXPECT_EQ("a.b", schema.fields()[2].path);
+    EXPECT_EQ("a.c", schema.fields()[3].path);
+    EXPECT_EQ("d", schema.fields()[4].path);
+
+    const BsonSchema::Field *a = findField(schema, "a");
+    ASSERT_TRUE(a != nullptr);
+    EXPECT_EQ(3u, a->count);
+    EXPECT_EQ(2u, a->typeCount(mongo::Object));
+    EXPECT_EQ(1u, a->typeCount(mongo::String));
+    EXPECT_TRUE(!a->isDocumentOnly());
+
+    const BsonSchema::Field *b = findField(schema, "a.b");
+    ASSERT_TRUE(b != nullptr);
+    EXPECT_EQ("b", b->name);
+    EXPECT_EQ(1, b->parent);
+    EXPECT_EQ(2u, b->count);
+    EXPECT_NEAR(2.0 / 3, schema.presence(*b), 1e-9);
+
+    // Elements of arrays are not paths
+    const BsonSchema::Field *d = findField(schema, "d");
+    ASSERT_TRUE(d != nullptr);
+    EXPECT_EQ(1u, d->count);
+    EXPECT_EQ(1u, d->typeCount(mongo::Array));
+}
+
+TEST(BsonSchemaTests, merge_TwoSchemas_SameAsOneSchemaOfAllDocuments)
+{
+    const char *const documents[] = {
+        "{ a: 1, s: { x: 1 } }",
+        "{ a: 'v', s: { y: 2 } }",
+        "{ b: true, s: { x: 3, y: 4 } }",
+        "{ a: 2 }"
+    };
+
+    BsonSchema all, first, second;
+    for (int i = 0; i < 4; ++i) {
+        all.add(mongo::Robomongo::fromjson(documents[i]));
+        (i < 2 ? first : second).add(mongo::Robomongo::fromjson(documents[i]));
+    }
+    first.merge(second);
+
+    EXPECT_EQ(all.documentsCount(), first.documentsCount());
+    ASSERT_EQ(all.fields().size(), first.fields().size());
+    for (auto const& expected : all.fields()) {
+        const BsonSchema::Field *merged = findField(first, expected.path);
+        ASSERT_TRUE(merged != nullptr);
+        EXPECT_EQ(expected.count, merged->count);
+        EXPECT_TRUE(expected.types == merged->types);
+    }
+}
+
+TEST(BsonSchemaTests, columns_Flatten_ExpandsOnlyDocumentOnlyFields)
+{
+    BsonSchema schema;
+    schema.add(mongo::Robomongo::fromjson("{ _id: 1, addr: { city: 'a', geo: { lat: 1 } }, mixed: { k: 1 } }"));
+    schema.add(mongo::Robomongo::fromjson("{ _id: 2, addr: { zip: 2 }, mixed: 5 }"));
+
+    EXPECT_EQ("_id,addr,mixed", join(schema.columns(false)));
+
+    // "mixed" is not always a document, so its own column is kept
+    EXPECT_EQ("_id,addr.city,addr.geo.lat,addr.zip,mixed,mixed.k", join(schema.columns(true)));
+}
+
+TEST(BsonSchemaTests, clear_Schema_ForgetsFieldsAndDocuments)
+{
+    BsonSchema schema;
+    schema.add(mongo::Robomongo::fromjson("{ a: { b: 1 } }"));
+    schema.clear();
+
+    EXPECT_EQ(0u, schema.documentsCount());
+    EXPECT_TRUE(schema.fields().empty());
+    EXPECT_TRUE(schema.columns(true).empty());
+
+    schema.add(mongo::Robomongo::fromjson("{ c: 1 }"));
+    ASSERT_EQ(1u, schema.fields().size());
+    EXPECT_EQ("c", schema.fields()[0].path);
+    EXPECT_EQ(1u, schema.fields()[0].count);
+}
@@ -1,12 +1,18 @@
 #include "robomongo/core/utils/BsonUtils.h"
 
+#include <algorithm>
+#include <charconv>
+#include <clocale>
+#include <cstdio>
+#include <string_view>
+
 #include <mongo/client/dbclient_base.h>
 //#include <mongo/bson/bsonobjiterator.h>
-#include "mongo/util/base64.h"
-#include "mongo/util/str.h"
 
+#include "robomongo/core/utils/DateUtils.h"
 #include "robomongo/core/utils/Logger.h"
 #include "robomongo/core/utils/QtUtils.h"
+#include "robomongo/core/utils/StringUtils.h"
 #include "robomongo/core/HexUtils.h"
 
 // v0.9
@@ -62,300 +68,449 @@ namespace Robomongo
             }
         }
 
-        std::string jsonString(const BSONObj &obj, JsonStringFormat format, int pretty, UUIDEncoding uuidEncoding, SupportedTimes timeFormat, bool isArray)
+        namespace
         {
-            using namespace std;
-
-            // Use of method, that is implemented in Robomongo Shell
-            // Method "isArray()" is not part of MongoDB.
-            // In order for this method to work, someone should
-            // explicetly call "markAsArray()" method on BSONObj.
-            // This is done in the Robomongo Shell (MongoDB fork)
-            if (obj.isArray()) {
-               isArray = true;
+            void appendIndent(std::string &out, int pretty)
+            {
+                if (pretty > 0)
+                    out.append(4 * pretty, ' ');
             }
 
-            if ( obj.isEmpty() ) {
-                return isArray? "[]" : "{}";
+            void appendInteger(std::string &out, long long value)
+            {
+                char buffer[24];
+                std::to_chars_result const result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+                out.append(buffer, result.ptr);
             }
 
-            StringBuilder s;
-            s << (isArray ? "[" : "{");
-            BSONObjIterator i(obj);
-            BSONElement e = i.next();
-
-            if ( !e.eoo() ) {
-                while ( 1 ) {
-                    if ( pretty ) {
-                        s << '\n';
-                        for( int x = 0; x < pretty; x++ ) {
-                            s << "    ";
-                        }
-                    }
-                    else {
-                        s << " ";
-                    }
+            void appendUnsigned(std::string &out, unsigned long long value)
+            {
+                char buffer[24];
+                std::to_chars_result const result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+                out.append(buffer, result.ptr);
+            }
 
-                    s << jsonString(e, format, true, pretty ? pretty + 1 : 0, uuidEncoding, timeFormat, isArray);
-                    e = i.next();
+            // Same as printf("%.15g") (or "%.15f" when "fixed" is true), but always with '.'
+            int printDouble(char *buffer, size_t size, double value, bool fixed)
+            {
+#if defined(__cpp_lib_to_chars)
+                std::to_chars_result const result = fixed ?
+                    std::to_chars(buffer, buffer + size, value, std::chars_format::fixed, 15) :
+                    std::to_chars(buffer, buffer + size, value, std::chars_format::general, 15);
+                return result.ptr - buffer;
+#else
+                int const length = snprintf(buffer, size, fixed ? "%.15f" : "%.15g", value);
+                char const point = localeconv()->decimal_point[0];
+                if (point != '.')
+                    std::replace(buffer, buffer + length, point, '.');
+                return length;
+#endif
+            }
 
-                    if (e.eoo()) {
-                        s << '\n';
-                        for( int x = 0; x < pretty - 1; x++ ) {
-                            s << "    ";
-                        }
-                        s << (isArray ? "]" : "}");
-                        break;
-                    }
+            // Finite double with 15 significant digits. Integral values keep
+            // trailing ".0", and scientific format is disabled for e+15/e+16.
+            void appendDouble(std::string &out, double value)
+            {
+                char buffer[64];
+                int length = printDouble(buffer, sizeof(buffer), value, false);
+                std::string_view const str(buffer, length);
+
+                if (str.find('e') == std::string_view::npos) {
+                    out.append(buffer, length);
+                    if (value == (long long)value)
+                        out.append(".0");
+                    return;
+                }
 
-                    s << ",";
+                if (str.size() > 4 && (str.substr(str.size() - 4) == "e+15" || str.substr(str.size() - 4) == "e+16")) {
+                    length = printDouble(buffer, sizeof(buffer), value, true);
+                    while (length > 2 && buffer[length - 1] == '0' && buffer[length - 2] == '0')
+                        --length;
                 }
+                out.append(buffer, length);
             }
-            return s.str();
-        }
 
-        std::string jsonString(const BSONElement &elem, JsonStringFormat format, bool includeFieldNames, 
-                               int pretty, UUIDEncoding uuidEncoding, SupportedTimes timeFormat, bool isArray)
-        {
-            using namespace std;
-            BSONType t = elem.type();            
+            void appendEscaped(std::string &out, mongo::StringData str, bool escapeSlash = false)
+            {
+                StringUtils::appendJsonEscaped(out, str.rawData(), str.size(), escapeSlash);
+            }
 
-            std::stringstream s;
-            if ( includeFieldNames && !isArray)
-                s << '"' << mongo::str::escape(elem.fieldName()) << "\" : ";
+            void appendObject(std::string &out, const BSONObj &obj, JsonStringFormat format, int pretty,
+                              UUIDEncoding uuidEncoding, SupportedTimes timeFormat, bool isArray);
 
-            switch ( t ) {
-            case Undefined:
-                s << "undefined";
-                break;
-            case mongo::String:
-            case Symbol:
-                s << '"' << mongo::str::escape(std::string(elem.valuestr(), elem.valuestrsize() - 1))
-                  << '"';
-                break;
-            case NumberLong:
-                s << "NumberLong(" << elem._numberLong() << ")";
-                break;
-            case NumberInt:
-                s << elem._numberInt();
-                break;
-            case NumberDouble:
-                {
-                    if ( elem.number() >= -std::numeric_limits< double >::max() &&
-                         elem.number() <= std::numeric_limits< double >::max() ) {
-                        std::stringstream ss;
-                        ss.precision(std::numeric_limits<double>::digits10);
-                        ss << elem.Double();
-                        std::string const str =
-                            reformatDoubleString(QString::fromStdString(ss.str()), elem.Double());
+            void appendElement(std::string &out, const BSONElement &elem, JsonStringFormat format, bool includeFieldNames,
+                               int pretty, UUIDEncoding uuidEncoding, SupportedTimes timeFormat, bool isArray)
+            {
+                BSONType t = elem.type();
 
-                        s << (str);
-                    }
-                    else if (std::isnan(elem.number()) ) {                        
-                        s << "NaN";
+                if ( includeFieldNames && !isArray) {
+                    out += '"';
+                    appendEscaped(out, elem.fieldName());
+                    out.append("\" : ");
+                }
+
+                switch ( t ) {
+                case Undefined:
+                    out.append("undefined");
+                    break;
+                case mongo::String:
+                case Symbol:
+                    out += '"';
+                    appendEscaped(out, mongo::StringData(elem.valuestr(), elem.valuestrsize() - 1));
+                    out += '"';
+                    break;
+                case NumberLong:
+                    out.append("NumberLong(");
+                    appendInteger(out, elem._numberLong());
+                    out += ')';
+                    break;
+                case NumberInt:
+                    appendInteger(out, elem._numberInt());
+                    break;
+                case NumberDouble:
+                    {
+                        double const value = elem._numberDouble();
+                        if ( value >= -std::numeric_limits< double >::max() &&
+                             value <= std::numeric_limits< double >::max() ) {
+                            appendDouble(out, value);
+                        }
+                        else if (std::isnan(value) ) {
+                            out.append("NaN");
+                        }
+                        else if (std::isinf(value) ) {
+                            out.append(value > 0 ? "Infinity" : "-Infinity");
+                        }
+                        break;
                     }
-                    else if (std::isinf(elem.number()) ) {
-                        s << (std::to_string(elem.number()) == "inf" ? "Infinity" : "-Infinity");
+                case NumberDecimal:
+                    out.append("NumberDecimal(\"");
+                    out.append(elem._numberDecimal().toString());
+                    out.append("\")");
+                    break;
+                case mongo::Bool:
+                    out.append( elem.boolean() ? "true" : "false" );
+                    break;
+                case jstNULL:
+                    out.append("null");
+                    break;
+                case Object:
+                    appendObject(out, elem.embeddedObject(), format, pretty, uuidEncoding, timeFormat, false);
+                    break;
+                case mongo::Array: {
+                    if ( elem.embeddedObject().isEmpty() ) {
+                        out.append("[]");
+                        break;
                     }
-                    else {
-                        StringBuilder ss;
-                        ss << "BsonUtils::jsonString(): Number " << elem.number() 
-                           << " cannot be represented in JSON";
-                        LOG_MSG(ss.str(), mongo::logger::LogSeverity::Error());
+                    out.append("[ ");
+                    BSONObjIterator i( elem.embeddedObject() );
+                    BSONElement e = i.next();
+                    if ( !e.eoo() ) {
+                        int count = 0;
+                        while ( 1 ) {
+                            if ( pretty ) {
+                                out += '\n';
+                                appendIndent(out, pretty);
+                            }
+
+                            if (strtol(e.fieldName(), 0, 10) > count) {
+                                out.append("undefined");
+                            }
+                            else {
+                                appendElement(out, e, format, false, pretty ? pretty + 1 : 0, uuidEncoding, timeFormat, true);
+                                e = i.next();
+                            }
+                            count++;
+                            if ( e.eoo() ) {
+                                out += '\n';
+                                appendIndent(out, pretty - 1);
+                                out += ']';
+                                break;
+                            }
+                            out.append(", ");
+                        }
                     }
                     break;
                 }
-            case NumberDecimal:
-                s << "NumberDecimal(\"" << elem._numberDecimal().toString() << "\")";
-                break;
-            case mongo::Bool:
-                s << ( elem.boolean() ? "true" : "false" );
-                break;
-            case jstNULL:
-                s << "null";
-                break;
-            case Object: {
-                BSONObj obj = elem.embeddedObject();
-                s << jsonString(obj, format, pretty, uuidEncoding, timeFormat);
+                case DBRef: {
+                    mongo::OID *x = (mongo::OID *) (elem.valuestr() + elem.valuestrsize());
+                    if ( format == TenGen )
+                        out.append("DBRef(");
+                    else
+                        out.append("{ \"$ref\" : ");
+                    out += '"';
+                    out.append(elem.valuestr());
+                    out.append("\", ");
+                    if ( format != TenGen )
+                        out.append("\"$id\" : ");
+                    out += '"';
+                    out.append(x->toString());
+                    out += '"';
+                    out += format == TenGen ? ')' : '}';
+                    break;
                 }
-                break;
-            case mongo::Array: {
-                if ( elem.embeddedObject().isEmpty() ) {
-                    s << "[]";
+                case jstOID:
+                    out.append(format == TenGen ? "ObjectId(\"" : "{ \"$oid\" : \"");
+                    out.append(elem.__oid().toString());
+                    out.append(format == TenGen ? "\")" : "\" }");
+                    break;
+                case BinData: {
+                    int len = *(int *)( elem.value() );
+                    BinDataType type = BinDataType( *(char *)( (int *)( elem.value() ) + 1 ) );
+
+                    if (type == mongo::bdtUUID || type == mongo::newUUID) {
+                        char uuid[HexUtils::UuidBufferSize];
+                        size_t const size = HexUtils::formatUuid(elem, uuidEncoding, uuid);
+                        if (size)
+                            out.append(uuid, size);
+                        else
+                            out.append(HexUtils::formatUuid(elem, uuidEncoding));
+                        break;
+                    }
+
+                    const char *start = elem.value() + sizeof( int ) + 1;
+
+                    // Encode straight into the output
+                    out.append("{ \"$binary\" : \"");
+                    size_t const offset = out.size();
+                    out.resize(offset + HexUtils::base64Size(len));
+                    HexUtils::toBase64(start, len, &out[offset]);
+
+                    char const typeHex[2] = { static_cast<char>(type) };
+                    out.append("\", \"$type\" : \"");
+                    size_t const typeOffset = out.size();
+                    out.resize(typeOffset + 2);
+                    HexUtils::toHexLower(typeHex, 1, &out[typeOffset]);
+                    out.append("\" }");
                     break;
                 }
-                s << "[ ";
-                BSONObjIterator i( elem.embeddedObject() );
-                BSONElement e = i.next();
-                if ( !e.eoo() ) {
-                    int count = 0;
-                    while ( 1 ) {
-                        if ( pretty ) {
-                            s << '\n';
-                            for( int x = 0; x < pretty; x++ )
-                                s << "    ";
+                case mongo::Date:
+                    {
+                        Date_t d = elem.date();
+                        long long ms = d.toMillisSinceEpoch();
+                        bool isSupportedDate = miutil::minDate < ms && ms < miutil::maxDate;
+
+                        if ( format == Strict )
+                            out.append("{ \"$date\" : ");
+                        else
+                            out.append(isSupportedDate ? "ISODate(" : "Date(");
+
+                        if ( pretty && isSupportedDate) {
+                            out += '"';
+                            DateUtils::appendIsoDate(out, ms, true, timeFormat == LocalTime);
+                            out += '"';
                         }
+                        else
+                            appendInteger(out, ms);
 
-                        if (strtol(e.fieldName(), 0, 10) > count) {
-                            s << "undefined";
-                        }
-                        else {
-                            s << jsonString(e, format, false, pretty ? pretty + 1 : 0, uuidEncoding, timeFormat, true);
-                            e = i.next();
-                        }
-                        count++;
-                        if ( e.eoo() ) {
-                            s << '\n';
-                            for( int x = 0; x < pretty - 1; x++ )
-                                s << "    ";
-                            s << "]";
-                            break;
+                        out.append(format == Strict ? " }" : ")");
+                        break;
+                    }
+                case RegEx:
+                    if ( format == Strict ) {
+                        out.append("{ \"$regex\" : \"");
+                        appendEscaped(out, elem.regex());
+                        out.append("\", \"$options\" : \"");
+                        out.append(elem.regexFlags());
+                        out.append("\" }");
+                    }
+                    else {
+                        out += '/';
+                        appendEscaped(out, elem.regex(), true);
+                        out += '/';
+                        // FIXME Worry about alpha order?
+                        for ( const char *f = elem.regexFlags(); *f; ++f ) {
+                            switch ( *f ) {
+                            case 'g':
+                            case 'i':
+                            case 'm':
+                                out += *f;
+                            default:
+                                break;
+                            }
                         }
-                        s << ", ";
+                    }
+                    break;
+
+                case CodeWScope: {
+                    BSONObj scope = elem.codeWScopeObject();
+                    if ( ! scope.isEmpty() ) {
+                        out.append("{ \"$code\" : ");
+                        out.append(elem._asCode());
+                        out.append(" ,  \"$scope\" : ");
+                        out.append(scope.jsonString());
+                        out.append(" }");
+                        break;
                     }
                 }
-                //s << " ]";
-                break;
-            }
-            case DBRef: {
-                mongo::OID *x = (mongo::OID *) (elem.valuestr() + elem.valuestrsize());
-                if ( format == TenGen )
-                    s << "DBRef(";
-                else
-                    s << "{ \"$ref\" : ";
-                s << '"' << elem.valuestr() << "\", ";
-                if ( format != TenGen )
-                    s << "\"$id\" : ";
-                s << '"' << *x << "\"";
-                if ( format == TenGen )
-                    s << ')';
-                else
-                    s << '}';
-                break;
-            }
-            case jstOID:
-                if ( format == TenGen ) {
-                    s << "ObjectId(";
-                }
-                else {
-                    s << "{ \"$oid\" : ";
-                }
-                s << '"' << elem.__oid() << '"';
-                if ( format == TenGen ) {
-                    s << ")";
+
+                case Code:
+                    out.append(elem._asCode());
+                    break;
+
+                case bsonTimestamp:
+                    if ( format == TenGen ) {
+                        out.append("Timestamp(");
+                        appendUnsigned(out, elem.timestamp().getSecs());
+                        out.append(", ");
+                        appendUnsigned(out, elem.timestampInc());
+                        out += ')';
+                    }
+                    else {
+                        out.append("{ \"$timestamp\" : { \"t\" : ");
+                        appendUnsigned(out, elem.timestamp().getSecs());
+                        out.append(", \"i\" : ");
+                        appendUnsigned(out, elem.timestampInc());
+                        out.append(" } }");
+                    }
+                    break;
+
+                case MinKey:
+                    out.append("{ \"$minKey\" : 1 }");
+                    break;
+
+                case MaxKey:
+                    out.append("{ \"$maxKey\" : 1 }");
+                    break;
+
+                default:
+                    // Cannot create a properly formatted JSON string with this element
+                    break;
                 }
-                else {
-                    s << " }";
+            }
+
+            void appendObject(std::string &out, const BSONObj &obj, JsonStringFormat format, int pretty,
+                              UUIDEncoding uuidEncoding, SupportedTimes timeFormat, bool isArray)
+            {
+                // Use of method, that is implemented in Robomongo Shell
+                // Method "isArray()" is not part of MongoDB.
+                // In order for this method to work, someone should
+                // explicetly call "markAsArray()" method on BSONObj.
+                // This is done in the Robomongo Shell (MongoDB fork)
+                if (obj.isArray()) {
+                   isArray = true;
                 }
-                break;
-            case BinData: {
-                int len = *(int *)( elem.value() );
-                BinDataType type = BinDataType( *(char *)( (int *)( elem.value() ) + 1 ) );
 
-                if (type == mongo::bdtUUID || type == mongo::newUUID) {
-                    s << HexUtils::formatUuid(elem, uuidEncoding);
-                    break;
+                if ( obj.isEmpty() ) {
+                    out.append(isArray ? "[]" : "{}");
+                    return;
                 }
 
-                s << "{ \"$binary\" : \"";
-                char *start = ( char * )( elem.value() ) + sizeof( int ) + 1;
-                base64::encode( s , start , len );
-                s << "\", \"$type\" : \"" << hex;
-                s.width( 2 );
-                s.fill( '0' );
-                s << type << dec;
-                s << "\" }";
-                break;
-            }
-            case mongo::Date:
-                {
-                    Date_t d = elem.date();
-                    long long ms = d.toMillisSinceEpoch(); //static_cast<long long>(d.millis);
-                    bool isSupportedDate = miutil::minDate < ms && ms < miutil::maxDate;
+                out += isArray ? '[' : '{';
+                BSONObjIterator i(obj);
+                BSONElement e = i.next();
 
-                    if ( format == Strict )
-                        s << "{ \"$date\" : ";
-                    else{
-                        if (isSupportedDate) {
-                            s << "ISODate(";
+                if ( !e.eoo() ) {
+                    while ( 1 ) {
+                        if ( pretty ) {
+                            out += '\n';
+                            appendIndent(out, pretty);
                         }
-                        else{
-                            s << "Date(";
+                        else {
+                            out += ' ';
                         }
-                    }
 
-                    if ( pretty && isSupportedDate) {
-                        boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
-                        boost::posix_time::time_duration diff = boost::posix_time::millisec(ms);
-                        boost::posix_time::ptime time = epoch + diff;
-                        std::string timestr = miutil::isotimeString(time, true, timeFormat == LocalTime);
-                        s << '"' << timestr << '"';
-                    }
-                    else
-                        s << ms;
+                        appendElement(out, e, format, true, pretty ? pretty + 1 : 0, uuidEncoding, timeFormat, isArray);
+                        e = i.next();
 
-                    if ( format == Strict )
-                        s << " }";
-                    else
-                        s << ")";
-                    break;
-                }
-            case RegEx:
-                if ( format == Strict ) {
-                    s << "{ \"$regex\" : \"" << mongo::str::escape(elem.regex());
-                    s << "\", \"$options\" : \"" << elem.regexFlags() << "\" }";
-                }
-                else {
-                    s << "/" << mongo::str::escape(elem.regex(), true) << "/";
-                    // FIXME Worry about alpha order?
-                    for ( const char *f = elem.regexFlags(); *f; ++f ) {
-                        switch ( *f ) {
-                        case 'g':
-                        case 'i':
-                        case 'm':
-                            s << *f;
-                        default:
+                        if (e.eoo()) {
+                            out += '\n';
+                            appendIndent(out, pretty - 1);
+                            out += isArray ? ']' : '}';
                             break;
                         }
-                    }
-                }
-                break;
 
-            case CodeWScope: {
-                BSONObj scope = elem.codeWScopeObject();
-                if ( ! scope.isEmpty() ) {
-                    s << "{ \"$code\" : " << elem._asCode() << " , "
-                      << " \"$scope\" : " << scope.jsonString() << " }";
-                    break;
+                        out += ',';
+                    }
                 }
             }
+        }
 
-            case Code:
-                s << elem._asCode();
-                break;
+        void appendJsonString(std::string &out, const BSONObj &obj, JsonStringFormat format, int pretty,
+                              UUIDEncoding uuidEncoding, SupportedTimes timeFormat, bool isArray)
+        {
+            appendObject(out, obj, format, pretty, uuidEncoding, timeFormat, isArray);
+        }
 
-            case bsonTimestamp:
-                if ( format == TenGen )
-                    s << "Timestamp(" << elem.timestamp().getSecs() << ", " << elem.timestampInc() << ")";
-                else 
-                    s << "{ \"$timestamp\" : { \"t\" : " << elem.timestamp().getSecs() << ", \"i\" : " 
-                      << elem.timestampInc() << " } }";
-                break;
+        std::string jsonString(const BSONObj &obj, JsonStringFormat format, int pretty, UUIDEncoding uuidEncoding, SupportedTimes timeFormat, bool isArray)
+        {
+            // Pretty printed JSON is usually about twice as large as BSON
+            std::string out;
+            out.reserve(obj.objsize() * 2);
+            appendObject(out, obj, format, pretty, uuidEncoding, timeFormat, isArray);
+            return out;
+        }
 
-            case MinKey:
-                s << "{ \"$minKey\" : 1 }";
-                break;
+        std::string jsonString(const BSONElement &elem, JsonStringFormat format, bool includeFieldNames, 
+                               int pretty, UUIDEncoding uuidEncoding, SupportedTimes timeFormat, bool isArray)
+        {
+            std::string out;
+            appendElement(out, elem, format, includeFieldNames, pretty, uuidEncoding, timeFormat, isArray);
+            return out;
+        }
 
-            case MaxKey:
-                s << "{ \"$maxKey\" : 1 }";
-                break;
+        namespace
+        {
+            int newlinesCount(const std::string &text)
+            {
+                return std::count(text.begin(), text.end(), '\n');
+            }
 
-            default:
-                StringBuilder ss;
-                ss << "Cannot create a properly formatted JSON string with "
-                   << "element: " << elem.toString() << " of type: " << elem.type();
+            int newlinesCount(const BSONObj &obj, bool isArray);
+
+            // Mirrors jsonString(BSONElement): only nested documents and code
+            // can span several lines, all other values are single-line
+            int newlinesCount(const BSONElement &elem)
+            {
+                switch (elem.type()) {
+                case Object:
+                    return newlinesCount(elem.embeddedObject(), false);
+                case mongo::Array:
+                    return newlinesCount(elem.embeddedObject(), true);
+                case CodeWScope: {
+                    BSONObj scope = elem.codeWScopeObject();
+                    if (!scope.isEmpty())
+                        return newlinesCount(elem._asCode()) + newlinesCount(scope.jsonString());
+                    return newlinesCount(elem._asCode());
+                }
+                case Code:
+                    return newlinesCount(elem._asCode());
+                default:
+                    return 0;
+                }
+            }
+
+            int newlinesCount(const BSONObj &obj, bool isArray)
+            {
+                if (obj.isEmpty())
+                    return 0;
+
+                // Every element starts on new line, closing bracket too
+                int count = 1;
+                int position = 0;
+                BSONObjIterator i(obj);
+                while (i.more()) {
+                    BSONElement e = i.next();
+
+                    // Missing array elements are printed as "undefined", one per line
+                    if (isArray) {
+                        int const index = strtol(e.fieldName(), 0, 10);
+                        if (index > position) {
+                            count += index - position;
+                            position = index;
+                        }
+                        ++position;
+                    }
+
+                    count += 1 + newlinesCount(e);
+                }
+                return count;
             }
-            return s.str();
+        }
+
+        int jsonLinesCount(const mongo::BSONObj &obj)
+        {
+            // Top-level document is never printed with "undefined" holes
+            return newlinesCount(obj, false) + 1;
         }
     
         bool isArray(const mongo::BSONElement &elem)
@@ -586,13 +741,7 @@ namespace Robomongo
                 {
                     if (elem.number() >= -std::numeric_limits< double >::max() &&
                         elem.number() <= std::numeric_limits< double >::max()) {
-                        std::stringstream ss;
-                        ss.precision(std::numeric_limits<double>::digits10);
-                        ss << elem.Double();          
-                        std::string const str = 
-                            reformatDoubleString(QString::fromStdString(ss.str()), elem.Double());
-
-                        con.append(str);
+                        appendDouble(con, elem.Double());
                     }
                     else if (std::isnan(elem.number())) {
                         con.append("NaN");
@@ -627,8 +776,12 @@ namespace Robomongo
                 {
                     mongo::BinDataType binType = elem.binDataType();
                     if (binType == mongo::newUUID || binType == mongo::bdtUUID) {
-                        std::string uu = HexUtils::formatUuid(elem, uuid);
-                        con.append(uu);
+                        char buffer[HexUtils::UuidBufferSize];
+                        size_t const size = HexUtils::formatUuid(elem, uuid, buffer);
+                        if (size)
+                            con.append(buffer, size);
+                        else
+                            con.append(HexUtils::formatUuid(elem, uuid));
                         break;
                     }
                     con.append("<binary>");
@@ -653,17 +806,10 @@ namespace Robomongo
                     long long ms = (long long) elem.Date().toMillisSinceEpoch();
                     bool isSupportedDate = miutil::minDate < ms && ms < miutil::maxDate;
 
-                    boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
-                    boost::posix_time::time_duration diff = boost::posix_time::millisec(ms);
-                    boost::posix_time::ptime time = epoch + diff;
-
-                    std::string date;
                     if (isSupportedDate)
-                        date = miutil::isotimeString(time, false, tz == LocalTime);
+                        DateUtils::appendIsoDate(con, ms, false, tz == LocalTime);
                     else
-                        date = boost::lexical_cast<std::string>(ms);
-
-                    con.append(date);
+                        appendInteger(con, ms);
                     break;
                 }
             case jstNULL:
@@ -762,25 +908,5 @@ namespace Robomongo
             return i;
         }
 
-        std::string reformatDoubleString(QString str, double elemDouble)
-        {
-            // Leave trailing zero if needed
-            if (!str.contains("e+", Qt::CaseInsensitive) && 
-                !str.contains("e-", Qt::CaseInsensitive) && elemDouble == (long long)elemDouble)
-                str.append(".0");          
-            else if (str.endsWith("e+15", Qt::CaseInsensitive) || 
-                     str.endsWith("e+16", Qt::CaseInsensitive)) {
-                // Disable scientific format
-                std::stringstream ss2;
-                ss2.precision(std::numeric_limits<double>::digits10);
-                ss2 << std::fixed << elemDouble;
-                str = QString::fromStdString(ss2.str());
-                while (str.contains('.') && str.endsWith("00"))
-                    str.chop(1);
-            }
-
-            return str.toStdString();
-        }
-
     } // BsonUtils
 } // Robomongo
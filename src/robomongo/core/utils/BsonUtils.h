@@ -84,12 +84,24 @@ namespace Robomongo
             return bsonelement_cast<typename detail::bson_convert_traits<BSONType_t>::type>(elem);
         }
 
+        /**
+         * @brief Appends JSON of document to "out", same text as jsonString() returns
+         */
+        void appendJsonString(std::string &out, const mongo::BSONObj &obj, mongo::JsonStringFormat format, int pretty,
+            UUIDEncoding uuidEncoding, SupportedTimes timeFormat, bool isArray = false);
+
         std::string jsonString(const mongo::BSONObj &obj, mongo::JsonStringFormat format, int pretty,
             UUIDEncoding uuidEncoding, SupportedTimes timeFormat, bool isArray = false);
 
         std::string jsonString(const mongo::BSONElement &elem, mongo::JsonStringFormat format, bool includeFieldNames, int pretty,
             UUIDEncoding uuidEncoding, SupportedTimes timeFormat, bool isArray = false);
 
+        /**
+         * @brief Number of lines in pretty printed JSON of document (pretty = 1),
+         * counted by walking BSON without formatting any values.
+         */
+        int jsonLinesCount(const mongo::BSONObj &obj);
+
         bool isArray(const mongo::BSONElement &elem);
         bool isArray(mongo::BSONType type);
         bool isDocument(const mongo::BSONElement &elem);
@@ -108,7 +120,6 @@ namespace Robomongo
         mongo::BSONElement indexOf(const mongo::BSONObj &doc, int index);
         int elementsCount(const mongo::BSONObj &doc);
 
-        std::string reformatDoubleString(QString str, double elemDouble);
     }
 }
 
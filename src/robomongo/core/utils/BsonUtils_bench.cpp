@@ -0,0 +1,51 @@
+#include "gtest/gtest.h"
+#include "robomongo/core/utils/BsonUtils.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <mongo/bson/bsonobjbuilder.h>
+
+using namespace Robomongo;
+
+namespace
+{
+    std::string pretty(const mongo::BSONObj &obj)
+    {
+        return BsonUtils::jsonString(obj, mongo::TenGen, 1, DefaultEncoding, Utc);
+    }
+}
+
+TEST(BsonUtilsBench, jsonString_TenThousandDocuments_Throughput)
+{
+    std::vector<mongo::BSONObj> documents;
+    for (int i = 0; i < 10000; ++i) {
+        mongo::BSONObjBuilder inner;
+        inner.append("city", "Amsterdam");
+        inner.append("zip", i);
+
+        mongo::BSONObjBuilder builder;
+        builder.append("_id", mongo::OID::gen());
+        builder.append("name", "Document number " + std::to_string(i));
+        builder.append("price", i * 1.25);
+        builder.append("count", (long long)i * 1000);
+        builder.appendDate("created", mongo::Date_t::fromMillisSinceEpoch(1500000000000LL + i));
+        builder.append("address", inner.obj());
+        documents.push_back(builder.obj());
+    }
+
+    auto const start = std::chrono::steady_clock::now();
+    size_t bytes = 0;
+    for (auto const &doc : documents)
+        bytes += pretty(doc).size();
+    auto const finish = std::chrono::steady_clock::now();
+
+    double const ms = std::chrono::duration<double, std::milli>(finish - start).count();
+    std::cout << "[ BENCH    ] " << documents.size() << " documents, "
+              << bytes / 1024 << " KB of JSON in " << ms << " ms ("
+              << (ms > 0 ? bytes / 1024.0 / 1024.0 / (ms / 1000) : 0) << " MB/s)"
+              << std::endl;
+    EXPECT_GT(bytes, 0u);
+}
@@ -0,0 +1,174 @@
+#include "gtest/gtest.h"
+#include "robomongo/core/utils/BsonUtils.h"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+
+#include <mongo/bson/bsonobjbuilder.h>
+
+using namespace Robomongo;
+
+namespace
+{
+    // Single-field document, as it is printed with pretty = 1
+    std::string prettyField(const std::string &name, const std::string &value)
+    {
+        return "{\n    \"" + name + "\" : " + value + "\n}";
+    }
+
+    std::string pretty(const mongo::BSONObj &obj)
+    {
+        return BsonUtils::jsonString(obj, mongo::TenGen, 1, DefaultEncoding, Utc);
+    }
+
+    int formattedLinesCount(const mongo::BSONObj &obj)
+    {
+        std::string const json = BsonUtils::jsonString(obj, mongo::TenGen, 1, DefaultEncoding, Utc);
+        return std::count(json.begin(), json.end(), '\n') + 1;
+    }
+}
+
+TEST(BsonUtilsTests, jsonLinesCount_NestedDocumentsAndArrays_MatchesFormattedText)
+{
+    mongo::BSONObjBuilder inner;
+    inner.append("x", 1);
+    inner.append("y", mongo::BSONObj());
+
+    mongo::BSONArrayBuilder array;
+    array.append(1);
+    array.append(inner.obj());
+    array.append(mongo::BSONArray());
+
+    mongo::BSONObjBuilder builder;
+    builder.append("_id", 42);
+    builder.append("text", "line\nbreak");
+    builder.append("array", array.arr());
+    builder.appendCode("code", "function() {\n    return 1;\n}");
+    mongo::BSONObj const obj = builder.obj();
+
+    EXPECT_EQ(formattedLinesCount(obj), BsonUtils::jsonLinesCount(obj));
+    EXPECT_EQ(1, BsonUtils::jsonLinesCount(mongo::BSONObj()));
+}
+
+// Golden values are the output of the stringstream based implementation
+TEST(BsonUtilsTests, jsonString_Doubles_MatchGoldenOutput)
+{
+    struct { double value; const char *json; } const cases[] = {
+        { 1.0, "1.0" },
+        { -0.0, "-0.0" },
+        { 0.1, "0.1" },
+        { 1.5, "1.5" },
+        { 0.1 + 0.2, "0.3" },
+        { 123456789012345.0, "123456789012345.0" },
+        { 1e15, "1000000000000000.0" },
+        { 1e16, "10000000000000000.0" },
+        { 1e17, "1e+17" },
+        { 1.23e-7, "1.23e-07" },
+        { std::numeric_limits<double>::quiet_NaN(), "NaN" },
+        { std::numeric_limits<double>::infinity(), "Infinity" },
+        { -std::numeric_limits<double>::infinity(), "-Infinity" }
+    };
+
+    for (auto const &c : cases) {
+        mongo::BSONObjBuilder builder;
+        builder.append("d", c.value);
+        EXPECT_EQ(prettyField("d", c.json), pretty(builder.obj()));
+    }
+}
+
+TEST(BsonUtilsTests, jsonString_ScalarTypes_MatchGoldenOutput)
+{
+    mongo::OID const oid("5a1b2c3d4e5f60718293a4b5");
+
+    mongo::BSONObjBuilder builder;
+    builder.append("int", -7);
+    builder.append("long", 5LL);
+    builder.append("text", "a\"b\nc");
+    builder.append("flag", true);
+    builder.appendNull("none");
+    builder.append("oid", oid);
+    builder.append("ts", mongo::Timestamp(100, 2));
+    builder.appendDate("date", mongo::Date_t::fromMillisSinceEpoch(0));
+    builder.appendRegex("re", "a/b", "gix");
+    builder.appendBinData("bin", 3, mongo::BinDataGeneral, "abc");
+    builder.appendDBRef("ref", "coll", oid);
+    builder.appendMinKey("min");
+    builder.appendCode("code", "x\ny");
+
+    EXPECT_EQ("{\n"
+              "    \"int\" : -7,\n"
+              "    \"long\" : NumberLong(5),\n"
+              "    \"text\" : \"a\\\"b\\nc\",\n"
+              "    \"flag\" : true,\n"
+              "    \"none\" : null,\n"
+              "    \"oid\" : ObjectId(\"5a1b2c3d4e5f60718293a4b5\"),\n"
+              "    \"ts\" : Timestamp(100, 2),\n"
+              "    \"date\" : ISODate(\"1970-01-01T00:00:00.000Z\"),\n"
+              "    \"re\" : /a\\/b/gi,\n"
+              "    \"bin\" : { \"$binary\" : \"YWJj\", \"$type\" : \"00\" },\n"
+              "    \"ref\" : DBRef(\"coll\", \"5a1b2c3d4e5f60718293a4b5\"),\n"
+              "    \"min\" : { \"$minKey\" : 1 },\n"
+              "    \"code\" : x\ny\n"
+              "}", pretty(builder.obj()));
+}
+
+// User defined subtypes (0x80 and above) are printed as one byte, not as sign-extended int
+TEST(BsonUtilsTests, jsonString_BinDataUserSubtype_TypeIsOneByte)
+{
+    mongo::BSONObjBuilder builder;
+    builder.appendBinData("custom", 3, mongo::bdtCustom, "abc");
+    builder.appendBinData("last", 1, static_cast<mongo::BinDataType>(0xff), "a");
+
+    EXPECT_EQ("{\n"
+              "    \"custom\" : { \"$binary\" : \"YWJj\", \"$type\" : \"80\" },\n"
+              "    \"last\" : { \"$binary\" : \"YQ==\", \"$type\" : \"ff\" }\n"
+              "}", pretty(builder.obj()));
+}
+
+TEST(BsonUtilsTests, jsonString_NestedAndSparse_MatchGoldenOutput)
+{
+    mongo::BSONObjBuilder inner;
+    inner.append("b", 1);
+
+    mongo::BSONArrayBuilder array;
+    array.append(1);
+    array.append("x");
+
+    // Array with missing element "1"
+    mongo::BSONObjBuilder sparse;
+    sparse.append("0", 1);
+    sparse.append("2", 3);
+
+    mongo::BSONObjBuilder builder;
+    builder.append("a", inner.obj());
+    builder.append("c", array.arr());
+    builder.append("e", mongo::BSONObj());
+    builder.append("f", mongo::BSONArray());
+    builder.appendArray("s", sparse.obj());
+    mongo::BSONObj const obj = builder.obj();
+
+    EXPECT_EQ("{\n"
+              "    \"a\" : {\n"
+              "        \"b\" : 1\n"
+              "    },\n"
+              "    \"c\" : [ \n"
+              "        1, \n"
+              "        \"x\"\n"
+              "    ],\n"
+              "    \"e\" : {},\n"
+              "    \"f\" : [],\n"
+              "    \"s\" : [ \n"
+              "        1, \n"
+              "        undefined, \n"
+              "        3\n"
+              "    ]\n"
+              "}", pretty(obj));
+
+    // Not pretty printed output keeps line breaks before closing brackets
+    mongo::BSONObjBuilder flat;
+    flat.append("a", 1);
+    flat.append("c", array.arr());
+    EXPECT_EQ("{ \"a\" : 1, \"c\" : [ 1, \"x\"\n]\n}",
+              BsonUtils::jsonString(flat.obj(), mongo::TenGen, 0, DefaultEncoding, Utc));
+}
@@ -0,0 +1,154 @@
+#include "robomongo/core/utils/DateUtils.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+namespace
+{
+    const long long millisPerDay = 24LL * 60 * 60 * 1000;
+
+    // Offsets are refreshed once a minute, to follow daylight saving time changes
+    const time_t offsetLifetime = 60;
+
+    struct LocalOffset
+    {
+        LocalOffset() : computedAt(0), millis(0), valid(false) {}
+
+        time_t computedAt;
+        long long millis;
+        char suffix[8];
+        bool valid;
+    };
+
+    // Current offset of local time, computed the same way as miutil::isotimeString() does
+    void computeOffset(LocalOffset &offset, time_t now)
+    {
+        struct tm utc, local;
+#ifdef _WIN32
+        gmtime_s(&utc, &now);
+        localtime_s(&local, &now);
+#else
+        gmtime_r(&now, &utc);
+        localtime_r(&now, &local);
+#endif
+
+        int diffH = local.tm_hour - utc.tm_hour;
+
+        // Time zone calculation
+        if (local.tm_mday < utc.tm_mday && diffH > 0)
+            diffH -= 24;
+        else if (local.tm_mday > utc.tm_mday && diffH < 0)
+            diffH += 24;
+
+        int const diffM = local.tm_min - utc.tm_min;
+
+        // Like boost::posix_time::time_duration(diffH, diffM, 0): the
+        // duration is negative if any of its components is negative
+        long long minutes = std::abs(diffH) * 60 + std::abs(diffM);
+        if (diffH < 0 || diffM < 0)
+            minutes = -minutes;
+
+        int const hours = static_cast<int>(minutes / 60);
+        snprintf(offset.suffix, sizeof(offset.suffix), hours >= 0 ? "+%02d:%02d" : "%03d:%02d", hours, std::abs(diffM));
+
+        offset.millis = minutes * 60 * 1000;
+        offset.computedAt = now;
+        offset.valid = true;
+    }
+
+    const LocalOffset &localOffset()
+    {
+        static thread_local LocalOffset offset;
+
+        time_t const now = time(NULL);
+        if (!offset.valid || now < offset.computedAt || now - offset.computedAt >= offsetLifetime)
+            computeOffset(offset, now);
+
+        return offset;
+    }
+
+    inline char *writeTwoDigits(char *p, unsigned value)
+    {
+        p[0] = '0' + value / 10;
+        p[1] = '0' + value % 10;
+        return p + 2;
+    }
+}
+
+namespace Robomongo
+{
+    namespace DateUtils
+    {
+        void civilFromDays(long long days, int &year, unsigned &month, unsigned &day)
+        {
+            // http://howardhinnant.github.io/date_algorithms.html#civil_from_days
+            days += 719468;
+            long long const era = (days >= 0 ? days : days - 146096) / 146097;
+            unsigned const doe = static_cast<unsigned>(days - era * 146097);                // [0, 146096]
+            unsigned const yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;   // [0, 399]
+            unsigned const doy = doe - (365 * yoe + yoe / 4 - yoe / 100);                 // [0, 365]
+            unsigned const mp = (5 * doy + 2) / 153;                                      // [0, 11]
+            day = doy - (153 * mp + 2) / 5 + 1;
+            month = mp < 10 ? mp + 3 : mp - 9;
+            year = static_cast<int>(yoe + era * 400) + (month <= 2);
+        }
+
+        void appendIsoDate(std::string &out, long long millis, bool useTseparator, bool isLocalFormat)
+        {
+            const LocalOffset *offset = isLocalFormat ? &localOffset() : NULL;
+            if (offset)
+                millis += offset->millis;
+
+            long long days = millis / millisPerDay;
+            long long msOfDay = millis % millisPerDay;
+            if (msOfDay < 0) {
+                msOfDay += millisPerDay;
+                --days;
+            }
+
+            int year;
+            unsigned month, day;
+            civilFromDays(days, year, month, day);
+
+            unsigned const ms = static_cast<unsigned>(msOfDay % 1000);
+            unsigned const secs = static_cast<unsigned>(msOfDay / 1000);
+
+            char buffer[64];
+            char *p = buffer;
+            if (0 <= year && year <= 9999) {
+                p = writeTwoDigits(p, year / 100);
+                p = writeTwoDigits(p, year % 100);
+            }
+            else {
+                p += snprintf(p, 16, "%04d", year);
+            }
+            *p++ = '-';
+            p = writeTwoDigits(p, month);
+            *p++ = '-';
+            p = writeTwoDigits(p, day);
+            *p++ = useTseparator ? 'T' : ' ';
+            p = writeTwoDigits(p, secs / 3600);
+            *p++ = ':';
+            p = writeTwoDigits(p, secs / 60 % 60);
+            *p++ = ':';
+            p = writeTwoDigits(p, secs % 60);
+            *p++ = '.';
+            *p++ = '0' + ms / 100;
+            p = writeTwoDigits(p, ms % 100);
+
+            out.append(buffer, p);
+            if (offset)
+                out.append(offset->suffix);
+            else
+                out += 'Z';
+        }
+
+        std::string isoDateString(long long millis, bool useTseparator, bool isLocalFormat)
+        {
+            std::string result;
+            appendIsoDate(result, millis, useTseparator, isLocalFormat);
+            return result;
+        }
+    }
+}
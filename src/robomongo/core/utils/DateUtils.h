@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+
+namespace Robomongo
+{
+    /**
+     * @brief Formatting of BSON dates (milliseconds since Unix epoch) without
+     * boost::posix_time. Output is the same as of miutil::isotimeString():
+     *
+     *  - YYYY-MM-DD hh:mm:ss.mmmZ         (UTC)
+     *  - YYYY-MM-DDThh:mm:ss.mmm+hh:mm    (local time)
+     *
+     * Local time uses the current UTC offset, which is cached per thread
+     * and refreshed once a minute.
+     */
+    namespace DateUtils
+    {
+        void appendIsoDate(std::string &out, long long millis, bool useTseparator, bool isLocalFormat);
+        std::string isoDateString(long long millis, bool useTseparator, bool isLocalFormat);
+
+        /**
+         * @brief Converts days since Unix epoch to proleptic Gregorian calendar date
+         */
+        void civilFromDays(long long days, int &year, unsigned &month, unsigned &day);
+    }
+}
@@ -0,0 +1,60 @@
+#include "gtest/gtest.h"
+#include "robomongo/core/utils/DateUtils.h"
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "robomongo/shell/db/ptimeutil.h"
+
+using namespace Robomongo;
+
+namespace
+{
+    std::string boostIsoDate(long long millis, bool useTseparator, bool isLocalFormat)
+    {
+        boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+        boost::posix_time::ptime time = epoch + boost::posix_time::millisec(millis);
+        return miutil::isotimeString(time, useTseparator, isLocalFormat);
+    }
+
+    // Evenly spread dates over the whole supported range
+    std::vector<long long> sampleDates()
+    {
+        std::vector<long long> dates;
+        long long const step = 86400000LL + 3600000LL * 7 + 60000LL * 13 + 1234;
+        for (long long ms = miutil::minDate + 1; ms < miutil::maxDate; ms += step)
+            dates.push_back(ms);
+
+        return dates;
+    }
+}
+
+TEST(DateUtilsBench, appendIsoDate_SupportedRange_Throughput)
+{
+    std::vector<long long> const dates = sampleDates();
+    using std::chrono::steady_clock;
+
+    auto const start = steady_clock::now();
+    size_t bytes = 0;
+    for (long long ms : dates)
+        bytes += boostIsoDate(ms, true, false).size();
+    auto const boostDone = steady_clock::now();
+
+    std::string out;
+    for (long long ms : dates) {
+        out.clear();
+        DateUtils::appendIsoDate(out, ms, true, false);
+        bytes -= out.size();
+    }
+    auto const done = steady_clock::now();
+
+    EXPECT_EQ(0u, bytes);
+
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    std::cout << "[ BENCH    ] " << dates.size() << " dates; "
+              << "isotimeString " << duration_cast<microseconds>(boostDone - start).count() << " us, "
+              << "appendIsoDate " << duration_cast<microseconds>(done - boostDone).count() << " us"
+              << std::endl;
+}
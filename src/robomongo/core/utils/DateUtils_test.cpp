@@ -0,0 +1,44 @@
+#include "gtest/gtest.h"
+#include "robomongo/core/utils/DateUtils.h"
+
+#include <vector>
+
+#include "robomongo/shell/db/ptimeutil.h"
+
+using namespace Robomongo;
+
+namespace
+{
+    std::string boostIsoDate(long long millis, bool useTseparator, bool isLocalFormat)
+    {
+        boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+        boost::posix_time::ptime time = epoch + boost::posix_time::millisec(millis);
+        return miutil::isotimeString(time, useTseparator, isLocalFormat);
+    }
+
+    // Edge cases and evenly spread dates over the whole supported range
+    std::vector<long long> sampleDates()
+    {
+        std::vector<long long> dates = {
+            miutil::minDate + 1, miutil::maxDate - 1, 0, -1, 1, 999, -999,
+            951782400000LL,     // 2000-02-29 (leap day)
+            -2203891200001LL,   // 1900-03-01 minus 1 ms (not a leap year)
+            4107542399999LL     // 2100-02-28T23:59:59.999
+        };
+
+        long long const step = 86400000LL + 3600000LL * 7 + 60000LL * 13 + 1234;
+        for (long long ms = miutil::minDate + 1; ms < miutil::maxDate; ms += step)
+            dates.push_back(ms);
+
+        return dates;
+    }
+}
+
+TEST(DateUtilsTests, isoDateString_SupportedRange_MatchesIsotimeString)
+{
+    for (long long ms : sampleDates()) {
+        ASSERT_EQ(boostIsoDate(ms, true, false), DateUtils::isoDateString(ms, true, false)) << ms;
+        ASSERT_EQ(boostIsoDate(ms, false, false), DateUtils::isoDateString(ms, false, false)) << ms;
+        ASSERT_EQ(boostIsoDate(ms, true, true), DateUtils::isoDateString(ms, true, true)) << ms;
+    }
+}
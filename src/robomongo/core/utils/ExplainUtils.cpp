@@ -0,0 +1,285 @@
+#include "robomongo/core/utils/ExplainUtils.h"
+
+#include <algorithm>
+
+#include <mongo/bson/bsonobjbuilder.h>
+
+#include "robomongo/core/domain/PipelineProfile.h"
+
+namespace
+{
+    void collectAccessPaths(const mongo::BSONObj &plan, std::vector<std::string> &paths)
+    {
+        bool hasInput = false;
+
+        mongo::BSONElement const input = plan["inputStage"];
+        if (input.isABSONObj()) {
+            collectAccessPaths(input.Obj(), paths);
+            hasInput = true;
+        }
+
+        mongo::BSONElement const inputs = plan["inputStages"];
+        if (inputs.isABSONObj()) {
+            for (mongo::BSONObjIterator it(inputs.Obj()); it.more(); ) {
+                mongo::BSONElement const stage = it.next();
+                if (stage.isABSONObj())
+                    collectAccessPaths(stage.Obj(), paths);
+            }
+            hasInput = true;
+        }
+
+        if (hasInput)
+            return;
+
+        std::string path = plan.getStringField("stage");
+        if (plan["keyPattern"].isABSONObj())
+            path += " " + plan.getObjectField("keyPattern").toString();
+
+        if (!path.empty() && std::find(paths.begin(), paths.end(), path) == paths.end())
+            paths.push_back(path);
+    }
+
+    // Stats of the part run by query engine, from object with "queryPlanner" and "executionStats"
+    void readQueryStats(const mongo::BSONObj &obj, Robomongo::PipelineStageProfile &stage,
+                        Robomongo::PipelineProfile &profile)
+    {
+        mongo::BSONObj const queryPlanner = obj.getObjectField("queryPlanner");
+        std::string const summary = Robomongo::ExplainUtils::planSummary(queryPlanner.getObjectField("winningPlan"));
+        stage.details = summary;
+        if (profile.planSummary.empty())
+            profile.planSummary = summary;
+
+        mongo::BSONObj const stats = obj.getObjectField("executionStats");
+        if (stats.isEmpty())
+            return;
+
+        stage.docsOut = stats["nReturned"].safeNumberLong();
+        stage.timeMillis = stats["executionTimeMillis"].safeNumberLong();
+
+        // Covered queries read only keys
+        long long const docs = stats["totalDocsExamined"].safeNumberLong();
+        stage.docsIn = docs ? docs : stats["totalKeysExamined"].safeNumberLong();
+    }
+
+    void readMemoryStats(const mongo::BSONObj &obj, Robomongo::PipelineStageProfile &stage)
+    {
+        mongo::BSONElement const accumulators = obj["maxAccumulatorMemoryUsageBytes"];
+        if (accumulators.isABSONObj()) {
+            stage.memoryBytes = 0;
+            for (mongo::BSONObjIterator it(accumulators.Obj()); it.more(); )
+                stage.memoryBytes += it.next().safeNumberLong();
+        }
+        else if (obj.hasField("totalDataSizeSortedBytesEstimate")) {
+            stage.memoryBytes = obj["totalDataSizeSortedBytesEstimate"].safeNumberLong();
+        }
+        else if (obj.hasField("peakTrackedMemBytes")) {
+            stage.memoryBytes = obj["peakTrackedMemBytes"].safeNumberLong();
+        }
+
+        stage.spilled = obj["usedDisk"].trueValue() || obj["spills"].safeNumberLong() > 0;
+    }
+
+    // Adds statistics of the same stages on other shard
+    void mergeShard(Robomongo::PipelineProfile &profile, const Robomongo::PipelineProfile &shard)
+    {
+        if (profile.stages.empty()) {
+            profile.stages = shard.stages;
+            profile.planSummary = shard.planSummary;
+            return;
+        }
+
+        size_t const count = std::min(profile.stages.size(), shard.stages.size());
+        for (size_t i = 0; i < count; ++i) {
+            Robomongo::PipelineStageProfile &stage = profile.stages[i];
+            Robomongo::PipelineStageProfile const &other = shard.stages[i];
+
+            // Shards run in parallel, so the slowest one takes the time
+            stage.timeMillis = std::max(stage.timeMillis, other.timeMillis);
+            if (other.docsIn >= 0)
+                stage.docsIn = std::max(stage.docsIn, 0LL) + other.docsIn;
+            if (other.docsOut >= 0)
+                stage.docsOut = std::max(stage.docsOut, 0LL) + other.docsOut;
+            stage.memoryBytes = std::max(stage.memoryBytes, other.memoryBytes);
+            stage.spilled = stage.spilled || other.spilled;
+        }
+    }
+
+    bool mustLeadPipeline(const std::string &stageName)
+    {
+        static const char *const names[] = {
+            "$geoNear", "$search", "$searchMeta", "$vectorSearch", "$collStats", "$indexStats",
+            "$currentOp", "$listSessions", "$listLocalSessions", "$changeStream", "$documents"
+        };
+
+        return std::find(std::begin(names), std::end(names), stageName) != std::end(names);
+    }
+}
+
+namespace Robomongo
+{
+    namespace ExplainUtils
+    {
+        std::string planSummary(const mongo::BSONObj &winningPlan)
+        {
+            std::vector<std::string> paths;
+            collectAccessPaths(classicPlan(winningPlan), paths);
+
+            std::string summary;
+            for (std::vector<std::string>::const_iterator it = paths.begin(); it != paths.end(); ++it) {
+                if (!summary.empty())
+                    summary += ", ";
+                summary += *it;
+            }
+            return summary;
+        }
+
+        bool isExplainOutput(const mongo::BSONObj &document)
+        {
+            if (document["queryPlanner"].isABSONObj())
+                return true;
+
+            // Aggregation, query part is in $cursor stage
+            mongo::BSONElement const stages = document["stages"];
+            if (stages.isABSONObj()) {
+                mongo::BSONObj const first = stages.Obj().firstElement().isABSONObj() ?
+                                             stages.Obj().firstElement().Obj() : mongo::BSONObj();
+                return first["$cursor"].isABSONObj();
+            }
+
+            // Sharded query or aggregation, every shard has its own explain
+            mongo::BSONElement const shards = document["shards"];
+            if (shards.isABSONObj() && !shards.Obj().isEmpty()) {
+                mongo::BSONElement const shard = shards.Obj().firstElement();
+                return shard.isABSONObj() && isExplainOutput(shard.Obj());
+            }
+
+            return false;
+        }
+
+        mongo::BSONObj classicPlan(const mongo::BSONObj &plan)
+        {
+            mongo::BSONElement const queryPlan = plan["queryPlan"];
+            return queryPlan.isABSONObj() ? queryPlan.Obj() : plan;
+        }
+
+        bool isBlockingSort(const mongo::BSONObj &stage)
+        {
+            std::string const name = stage.getStringField("stage");
+            return name == "SORT" || name == "sort";
+        }
+
+        bool isWasteful(long long examined, long long returned)
+        {
+            // Small scans are cheap whatever the ratio is
+            const long long minExamined = 1000;
+            const long long maxRatio = 10;
+
+            if (examined < minExamined)
+                return false;
+
+            return returned <= 0 || examined / returned >= maxRatio;
+        }
+
+        bool parsePipelineExplain(const mongo::BSONObj &explain, PipelineProfile &profile)
+        {
+            profile.stages.clear();
+
+            mongo::BSONElement const shards = explain["shards"];
+            if (shards.isABSONObj()) {
+                bool complete = true;
+                int count = 0;
+                for (mongo::BSONObjIterator it(shards.Obj()); it.more(); ++count) {
+                    mongo::BSONElement const shard = it.next();
+                    if (!shard.isABSONObj())
+                        continue;
+
+                    PipelineProfile shardProfile;
+                    complete = parsePipelineExplain(shard.Obj(), shardProfile) && complete;
+                    mergeShard(profile, shardProfile);
+                }
+
+                profile.note = std::to_string(count) + " shard(s), merging part of pipeline is not profiled";
+                return complete;
+            }
+
+            mongo::BSONElement const stages = explain["stages"];
+            if (!stages.isABSONObj()) {
+                // Whole pipeline was run by query engine
+                if (!explain.hasField("queryPlanner"))
+                    return false;
+
+                PipelineStageProfile stage;
+                stage.name = "$cursor";
+                readQueryStats(explain, stage, profile);
+                profile.stages.push_back(stage);
+                return false;
+            }
+
+            bool complete = true;
+            long long previousTime = 0;
+            long long previousDocs = -1;
+            for (mongo::BSONObjIterator it(stages.Obj()); it.more(); ) {
+                mongo::BSONElement const element = it.next();
+                if (!element.isABSONObj() || element.Obj().isEmpty())
+                    continue;
+
+                mongo::BSONObj const obj = element.Obj();
+                mongo::BSONElement const spec = obj.firstElement();
+
+                PipelineStageProfile stage;
+                stage.name = spec.fieldName();
+                if (stage.name == "$cursor" && spec.isABSONObj())
+                    readQueryStats(spec.Obj(), stage, profile);
+                else
+                    stage.docsIn = previousDocs;
+
+                if (obj.hasField("nReturned"))
+                    stage.docsOut = obj["nReturned"].safeNumberLong();
+                else if (stage.name != "$cursor")
+                    complete = false;
+
+                // Estimate is cumulative, it includes time of all preceding stages
+                if (obj.hasField("executionTimeMillisEstimate")) {
+                    long long const total = obj["executionTimeMillisEstimate"].safeNumberLong();
+                    stage.timeMillis = std::max(0LL, total - previousTime);
+                    previousTime = total;
+                }
+                else if (stage.name == "$cursor" && stage.timeMillis >= 0) {
+                    previousTime = stage.timeMillis;
+                }
+
+                readMemoryStats(obj, stage);
+                previousDocs = stage.docsOut;
+                profile.stages.push_back(stage);
+            }
+
+            return complete;
+        }
+
+        bool isOutputStage(const std::string &stageName)
+        {
+            return stageName == "$out" || stageName == "$merge";
+        }
+
+        mongo::BSONArray sampledPrefix(const mongo::BSONObj &pipeline, int stagesCount, int sampleSize)
+        {
+            mongo::BSONArrayBuilder prefix;
+            bool sampled = false;
+            int count = 0;
+            for (mongo::BSONObjIterator it(pipeline); it.more() && count < stagesCount; ++count) {
+                mongo::BSONElement const stage = it.next();
+                if (!sampled && !mustLeadPipeline(stage.Obj().firstElementFieldName())) {
+                    prefix.append(BSON("$limit" << sampleSize));
+                    sampled = true;
+                }
+                prefix.append(stage);
+            }
+
+            if (!sampled)
+                prefix.append(BSON("$limit" << sampleSize));
+
+            prefix.append(BSON("$count" << "n"));
+            return prefix.arr();
+        }
+    }
+}
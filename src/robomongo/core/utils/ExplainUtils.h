@@ -0,0 +1,59 @@
+#pragma once
+
+#include <string>
+
+#include <mongo/bson/bsonobj.h>
+
+namespace Robomongo
+{
+    struct PipelineProfile;
+
+    namespace ExplainUtils
+    {
+        /**
+         * @brief Access paths of query plan, like "planSummary" of server logs
+         * (i.e. "IXSCAN { a: 1 }, COLLSCAN"). Slot based plans are supported.
+         */
+        std::string planSummary(const mongo::BSONObj &winningPlan);
+
+        /**
+         * @brief True if document is output of explain() of query or aggregation
+         */
+        bool isExplainOutput(const mongo::BSONObj &document);
+
+        /**
+         * @brief Plan in classic form: slot based engine keeps it in "queryPlan"
+         */
+        mongo::BSONObj classicPlan(const mongo::BSONObj &plan);
+
+        /**
+         * @brief True for sort stages that read all input before returning anything
+         */
+        bool isBlockingSort(const mongo::BSONObj &stage);
+
+        /**
+         * @brief True when stage examines many more keys or documents than it returns.
+         * "examined" is the larger of keys and documents examined.
+         */
+        bool isWasteful(long long examined, long long returned);
+
+        /**
+         * @brief Fills "profile" with stages of "executionStats" explain of aggregation.
+         * Stages of sharded pipelines are summed up over shards.
+         * @returns false if server did not report statistics of every stage (i.e. before 4.4)
+         */
+        bool parsePipelineExplain(const mongo::BSONObj &explain, PipelineProfile &profile);
+
+        /**
+         * @brief True for stages which write results ($out, $merge), they are never profiled
+         */
+        bool isOutputStage(const std::string &stageName);
+
+        /**
+         * @brief First "stagesCount" stages of pipeline, run on at most "sampleSize" documents
+         * and followed by {$count: "n"}. Sample is taken right after stages that must lead
+         * pipeline (i.e. $geoNear).
+         */
+        mongo::BSONArray sampledPrefix(const mongo::BSONObj &pipeline, int stagesCount, int sampleSize);
+    }
+}
@@ -0,0 +1,120 @@
+#include "gtest/gtest.h"
+#include "robomongo/core/utils/ExplainUtils.h"
+
+#include <mongo/bson/bsonobjbuilder.h>
+
+#include "robomongo/core/domain/PipelineProfile.h"
+#include "robomongo/shell/bson/json.h"
+
+using namespace Robomongo;
+
+TEST(ExplainUtilsTests, planSummary_IndexAndCollectionScans_ListsAccessPaths)
+{
+    mongo::BSONObj const plan = mongo::Robomongo::fromjson(
+        "{ stage: 'SUBPLAN', inputStage: { stage: 'OR', inputStages: ["
+        "    { stage: 'FETCH', inputStage: { stage: 'IXSCAN', keyPattern: { a: 1 } } },"
+        "    { stage: 'COLLSCAN' } ] } }");
+
+    EXPECT_EQ("IXSCAN { a: 1 }, COLLSCAN", ExplainUtils::planSummary(plan));
+}
+
+TEST(ExplainUtilsTests, isExplainOutput_QueryAggregationAndShards_AreDetected)
+{
+    EXPECT_TRUE(ExplainUtils::isExplainOutput(mongo::Robomongo::fromjson(
+        "{ queryPlanner: { winningPlan: { stage: 'COLLSCAN' } }, ok: 1 }")));
+    EXPECT_TRUE(ExplainUtils::isExplainOutput(mongo::Robomongo::fromjson(
+        "{ stages: [ { $cursor: { queryPlanner: {} } }, { $group: { _id: 1 } } ] }")));
+    EXPECT_TRUE(ExplainUtils::isExplainOutput(mongo::Robomongo::fromjson(
+        "{ shards: { s0: { queryPlanner: {} } } }")));
+
+    EXPECT_FALSE(ExplainUtils::isExplainOutput(mongo::Robomongo::fromjson(
+        "{ stages: [ 'draft', 'final' ], shards: 2 }")));
+}
+
+TEST(ExplainUtilsTests, isWasteful_SmallOrSelectiveScans_AreFine)
+{
+    EXPECT_FALSE(ExplainUtils::isWasteful(500, 0));
+    EXPECT_FALSE(ExplainUtils::isWasteful(5000, 1000));
+    EXPECT_TRUE(ExplainUtils::isWasteful(5000, 100));
+    EXPECT_TRUE(ExplainUtils::isWasteful(5000, 0));
+}
+
+TEST(ExplainUtilsTests, parsePipelineExplain_StageStatistics_TimesAreNotCumulative)
+{
+    mongo::BSONObj const explain = mongo::Robomongo::fromjson(
+        "{ stages: ["
+        "    { $cursor: { queryPlanner: { winningPlan: { stage: 'COLLSCAN' } },"
+        "                 executionStats: { nReturned: 1000, executionTimeMillis: 12, totalDocsExamined: 5000 } },"
+        "      nReturned: 1000, executionTimeMillisEstimate: 10 },"
+        "    { $group: { _id: '$k' }, maxAccumulatorMemoryUsageBytes: { total: 300, items: 200 },"
+        "      usedDisk: true, nReturned: 10, executionTimeMillisEstimate: 25 },"
+        "    { $sort: { sortKey: { _id: 1 } }, totalDataSizeSortedBytesEstimate: 640,"
+        "      nReturned: 10, executionTimeMillisEstimate: 25 } ] }");
+
+    PipelineProfile profile;
+    EXPECT_TRUE(ExplainUtils::parsePipelineExplain(explain, profile));
+    ASSERT_EQ(3u, profile.stages.size());
+    EXPECT_EQ("COLLSCAN", profile.planSummary);
+
+    EXPECT_EQ("$cursor", profile.stages[0].name);
+    EXPECT_EQ(5000, profile.stages[0].docsIn);
+    EXPECT_EQ(1000, profile.stages[0].docsOut);
+    EXPECT_EQ(10, profile.stages[0].timeMillis);
+
+    EXPECT_EQ("$group", profile.stages[1].name);
+    EXPECT_EQ(1000, profile.stages[1].docsIn);
+    EXPECT_EQ(10, profile.stages[1].docsOut);
+    EXPECT_EQ(15, profile.stages[1].timeMillis);
+    EXPECT_EQ(500, profile.stages[1].memoryBytes);
+    EXPECT_TRUE(profile.stages[1].spilled);
+
+    EXPECT_EQ(0, profile.stages[2].timeMillis);
+    EXPECT_EQ(640, profile.stages[2].memoryBytes);
+    EXPECT_FALSE(profile.stages[2].spilled);
+}
+
+TEST(ExplainUtilsTests, parsePipelineExplain_NoStageStatistics_IsIncomplete)
+{
+    // Servers before 4.4 report statistics of the query part only
+    mongo::BSONObj const explain = mongo::Robomongo::fromjson(
+        "{ stages: ["
+        "    { $cursor: { queryPlanner: { winningPlan: { stage: 'FETCH', inputStage: { stage: 'IXSCAN', keyPattern: { b: -1 } } } },"
+        "                 executionStats: { nReturned: 7, executionTimeMillis: 3, totalDocsExamined: 7 } } },"
+        "    { $project: { b: true } } ] }");
+
+    PipelineProfile profile;
+    EXPECT_FALSE(ExplainUtils::parsePipelineExplain(explain, profile));
+    ASSERT_EQ(2u, profile.stages.size());
+    EXPECT_EQ("IXSCAN { b: -1 }", profile.planSummary);
+    EXPECT_EQ(3, profile.stages[0].timeMillis);
+    EXPECT_EQ(7, profile.stages[1].docsIn);
+    EXPECT_EQ(-1, profile.stages[1].docsOut);
+}
+
+TEST(ExplainUtilsTests, parsePipelineExplain_Shards_SumsDocumentsAndTakesSlowestTime)
+{
+    mongo::BSONObj const explain = mongo::Robomongo::fromjson(
+        "{ shards: {"
+        "    s0: { stages: [ { $match: { a: 1 }, nReturned: 4, executionTimeMillisEstimate: 2 } ] },"
+        "    s1: { stages: [ { $match: { a: 1 }, nReturned: 6, executionTimeMillisEstimate: 9 } ] } } }");
+
+    PipelineProfile profile;
+    EXPECT_TRUE(ExplainUtils::parsePipelineExplain(explain, profile));
+    ASSERT_EQ(1u, profile.stages.size());
+    EXPECT_EQ(10, profile.stages[0].docsOut);
+    EXPECT_EQ(9, profile.stages[0].timeMillis);
+    EXPECT_FALSE(profile.note.empty());
+}
+
+TEST(ExplainUtilsTests, sampledPrefix_LeadingGeoNear_SampleGoesAfterIt)
+{
+    mongo::BSONObj const pipeline = mongo::Robomongo::fromjson(
+        "{ '0': { $geoNear: { near: [0, 0] } }, '1': { $match: { a: 1 } }, '2': { $sort: { a: 1 } } }");
+
+    mongo::BSONObj const prefix = ExplainUtils::sampledPrefix(pipeline, 2, 100);
+    ASSERT_EQ(4, prefix.nFields());
+    EXPECT_EQ(std::string("$geoNear"), prefix["0"].Obj().firstElementFieldName());
+    EXPECT_EQ(100, prefix["1"].Obj()["$limit"].safeNumberLong());
+    EXPECT_EQ(std::string("$match"), prefix["2"].Obj().firstElementFieldName());
+    EXPECT_EQ(std::string("$count"), prefix["3"].Obj().firstElementFieldName());
+}
@@ -0,0 +1,360 @@
+#include "robomongo/core/utils/IndexAdvisor.h"
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+
+#include <mongo/bson/bsonobjbuilder.h>
+
+#include "robomongo/core/utils/ExplainUtils.h"
+
+namespace
+{
+    typedef std::vector<std::pair<std::string, int> > KeyFields;
+
+    const char *const equalityOperators[] = { "$eq", "$in", "$all", "$elemMatch" };
+    const char *const rangeOperators[] = { "$gt", "$gte", "$lt", "$lte", "$regex", "$exists" };
+
+    bool contains(const char *const *begin, const char *const *end, const std::string &name)
+    {
+        return std::find(begin, end, name) != end;
+    }
+
+    bool contains(const std::vector<std::string> &fields, const std::string &field)
+    {
+        return std::find(fields.begin(), fields.end(), field) != fields.end();
+    }
+
+    void addField(std::vector<std::string> &fields, const std::string &field)
+    {
+        if (!contains(fields, field))
+            fields.push_back(field);
+    }
+
+    void readFilter(const mongo::BSONObj &filter, Robomongo::IndexAdvisor::QueryShape &shape)
+    {
+        for (mongo::BSONObjIterator it(filter); it.more(); ) {
+            mongo::BSONElement const elem = it.next();
+            std::string const name = elem.fieldName();
+
+            if (name == "$and" && elem.isABSONObj()) {
+                for (mongo::BSONObjIterator clauses(elem.Obj()); clauses.more(); ) {
+                    mongo::BSONElement const clause = clauses.next();
+                    if (clause.isABSONObj())
+                        readFilter(clause.Obj(), shape);
+                }
+                continue;
+            }
+
+            // $or, $nor, $expr, $text and $where are not served by one compound index
+            if (name[0] == '$')
+                continue;
+
+            if (elem.type() == mongo::RegEx) {
+                addField(shape.range, name);
+                continue;
+            }
+
+            mongo::BSONObj const operators = elem.type() == mongo::Object ? elem.Obj() : mongo::BSONObj();
+            if (operators.isEmpty() || operators.firstElementFieldName()[0] != '$') {
+                addField(shape.equality, name);
+                continue;
+            }
+
+            // $ne, $nin and $not are not selective, they do not make field worth indexing
+            bool equality = false, range = false;
+            for (mongo::BSONObjIterator ops(operators); ops.more(); ) {
+                std::string const op = ops.next().fieldName();
+                if (contains(std::begin(equalityOperators), std::end(equalityOperators), op))
+                    equality = true;
+                else if (contains(std::begin(rangeOperators), std::end(rangeOperators), op))
+                    range = true;
+            }
+
+            if (equality)
+                addField(shape.equality, name);
+            else if (range)
+                addField(shape.range, name);
+        }
+    }
+
+    void readSort(const mongo::BSONObj &sort, Robomongo::IndexAdvisor::QueryShape &shape)
+    {
+        for (mongo::BSONObjIterator it(sort); it.more(); ) {
+            mongo::BSONElement const elem = it.next();
+
+            // {$meta: "textScore"} is not an index order
+            if (elem.isNumber())
+                shape.sort.push_back(std::make_pair(std::string(elem.fieldName()), elem.numberDouble() < 0 ? -1 : 1));
+        }
+    }
+
+    void readPipeline(const mongo::BSONObj &pipeline, Robomongo::IndexAdvisor::QueryShape &shape)
+    {
+        for (mongo::BSONObjIterator it(pipeline); it.more(); ) {
+            mongo::BSONElement const stage = it.next();
+            if (!stage.isABSONObj())
+                break;
+
+            mongo::BSONObj const spec = stage.Obj();
+            std::string const name = spec.firstElementFieldName();
+            if (name == "$match")
+                readFilter(spec.getObjectField("$match"), shape);
+            else if (name == "$sort")
+                readSort(spec.getObjectField("$sort"), shape);
+            else
+                break;
+        }
+    }
+
+    // Query before 3.2 profiler format was recorded as filter itself or {$query, orderby}
+    void readLegacyQuery(const mongo::BSONObj &query, Robomongo::IndexAdvisor::QueryShape &shape)
+    {
+        if (query.hasField("filter")) {
+            readFilter(query.getObjectField("filter"), shape);
+            readSort(query.getObjectField("sort"), shape);
+        }
+        else if (query.hasField("$query")) {
+            readFilter(query.getObjectField("$query"), shape);
+            readSort(query.getObjectField("orderby"), shape);
+        }
+        else {
+            readFilter(query, shape);
+        }
+    }
+
+    KeyFields keyFields(const mongo::BSONObj &key)
+    {
+        KeyFields fields;
+        for (mongo::BSONObjIterator it(key); it.more(); ) {
+            mongo::BSONElement const elem = it.next();
+            fields.push_back(std::make_pair(std::string(elem.fieldName()), elem.numberDouble() < 0 ? -1 : 1));
+        }
+        return fields;
+    }
+
+    // Index may be scanned backwards, so {a: 1, b: -1} also serves {a: -1, b: 1}
+    bool isPrefix(const KeyFields &prefix, const KeyFields &key)
+    {
+        if (prefix.empty() || prefix.size() > key.size())
+            return false;
+
+        bool forward = true, backward = true;
+        for (size_t i = 0; i < prefix.size(); ++i) {
+            if (prefix[i].first != key[i].first)
+                return false;
+
+            forward = forward && prefix[i].second == key[i].second;
+            backward = backward && prefix[i].second != key[i].second;
+        }
+        return forward || backward;
+    }
+
+    // Equality fields may go in any order, range fields follow sort fields in any order
+    bool isServedBy(const Robomongo::IndexAdvisor::QueryShape &shape, const KeyFields &key)
+    {
+        size_t const count = shape.equality.size() + shape.sort.size() + shape.range.size();
+        if (key.size() < count)
+            return false;
+
+        size_t i = 0;
+        for (; i < shape.equality.size(); ++i) {
+            if (!contains(shape.equality, key[i].first))
+                return false;
+        }
+
+        KeyFields const sortKey(key.begin() + i, key.begin() + i + shape.sort.size());
+        if (!shape.sort.empty() && !isPrefix(shape.sort, sortKey))
+            return false;
+        i += shape.sort.size();
+
+        for (; i < count; ++i) {
+            if (!contains(shape.range, key[i].first))
+                return false;
+        }
+        return true;
+    }
+
+    std::string describe(const Robomongo::IndexAdvisor::QueryShape &shape)
+    {
+        std::string result;
+        if (!shape.equality.empty()) {
+            result += "equality:";
+            for (size_t i = 0; i < shape.equality.size(); ++i)
+                result += (i ? ", " : " ") + shape.equality[i];
+        }
+        if (!shape.sort.empty()) {
+            result += result.empty() ? "sort:" : "; sort:";
+            for (size_t i = 0; i < shape.sort.size(); ++i)
+                result += (i ? ", " : " ") + shape.sort[i].first + (shape.sort[i].second < 0 ? " -1" : " 1");
+        }
+        if (!shape.range.empty()) {
+            result += result.empty() ? "range:" : "; range:";
+            for (size_t i = 0; i < shape.range.size(); ++i)
+                result += (i ? ", " : " ") + shape.range[i];
+        }
+        return result;
+    }
+}
+
+namespace Robomongo
+{
+    namespace IndexAdvisor
+    {
+        QueryShape queryShape(const mongo::BSONObj &profileEntry)
+        {
+            QueryShape shape;
+
+            mongo::BSONObj command = profileEntry.getObjectField("command");
+            if (command.hasField("getMore"))
+                command = profileEntry.getObjectField("originatingCommand");
+
+            std::string const name = command.firstElementFieldName();
+            if (name == "find") {
+                readFilter(command.getObjectField("filter"), shape);
+                readSort(command.getObjectField("sort"), shape);
+            }
+            else if (name == "aggregate") {
+                readPipeline(command.getObjectField("pipeline"), shape);
+            }
+            else if (name == "count" || name == "distinct") {
+                readFilter(command.getObjectField("query"), shape);
+            }
+            else if (name == "findAndModify" || name == "findandmodify") {
+                readFilter(command.getObjectField("query"), shape);
+                readSort(command.getObjectField("sort"), shape);
+            }
+            else if (command.hasField("q")) {
+                // Statement of update or delete
+                readFilter(command.getObjectField("q"), shape);
+            }
+            else if (command.isEmpty() && profileEntry["query"].isABSONObj()) {
+                readLegacyQuery(profileEntry.getObjectField("query"), shape);
+            }
+
+            // Equality makes sort on the field trivial, sorted range is served in sort position
+            for (size_t i = 0; i < shape.sort.size(); ) {
+                if (contains(shape.equality, shape.sort[i].first))
+                    shape.sort.erase(shape.sort.begin() + i);
+                else
+                    ++i;
+            }
+            for (size_t i = 0; i < shape.range.size(); ) {
+                bool const isSorted = std::find_if(shape.sort.begin(), shape.sort.end(),
+                    [&shape, i](const std::pair<std::string, int> &field) { return field.first == shape.range[i]; }) != shape.sort.end();
+                if (isSorted || contains(shape.equality, shape.range[i]))
+                    shape.range.erase(shape.range.begin() + i);
+                else
+                    ++i;
+            }
+
+            // Same queries written with different field order give the same shape
+            std::sort(shape.equality.begin(), shape.equality.end());
+            std::sort(shape.range.begin(), shape.range.end());
+            return shape;
+        }
+
+        mongo::BSONObj suggestedKey(const QueryShape &shape)
+        {
+            mongo::BSONObjBuilder builder;
+            for (size_t i = 0; i < shape.equality.size(); ++i)
+                builder.append(shape.equality[i], 1);
+            for (size_t i = 0; i < shape.sort.size(); ++i)
+                builder.append(shape.sort[i].first, shape.sort[i].second);
+            for (size_t i = 0; i < shape.range.size(); ++i)
+                builder.append(shape.range[i], 1);
+            return builder.obj();
+        }
+
+        void markUnusedAndRedundant(std::vector<IndexUsageInfo> &indexes)
+        {
+            std::vector<KeyFields> keys;
+            for (size_t i = 0; i < indexes.size(); ++i)
+                keys.push_back(keyFields(indexes[i].key));
+
+            for (size_t i = 0; i < indexes.size(); ++i) {
+                IndexUsageInfo &index = indexes[i];
+                index.unused = false;
+                index.redundantWith.clear();
+
+                // Such indexes cannot be dropped without changing behavior
+                if (index.name == "_id_" || index.unique || index.ttl)
+                    continue;
+
+                index.unused = index.accesses == 0;
+
+                if (index.special)
+                    continue;
+
+                for (size_t j = 0; j < indexes.size(); ++j) {
+                    if (j == i || indexes[j].special || keys[j].size() <= keys[i].size())
+                        continue;
+
+                    if (isPrefix(keys[i], keys[j])) {
+                        index.redundantWith = indexes[j].name;
+                        break;
+                    }
+                }
+            }
+        }
+
+        std::vector<IndexSuggestion> suggestIndexes(const std::vector<mongo::BSONObj> &profileEntries,
+                                                    const std::vector<IndexUsageInfo> &indexes)
+        {
+            std::vector<KeyFields> keys;
+            for (size_t i = 0; i < indexes.size(); ++i) {
+                if (!indexes[i].special)
+                    keys.push_back(keyFields(indexes[i].key));
+            }
+
+            std::vector<IndexSuggestion> suggestions;
+            std::map<std::string, size_t> positions;
+
+            for (size_t i = 0; i < profileEntries.size(); ++i) {
+                mongo::BSONObj const &entry = profileEntries[i];
+
+                long long const examined = entry["docsExamined"].safeNumberLong();
+                long long const returned = entry.hasField("nreturned") ? entry["nreturned"].safeNumberLong()
+                    : entry["nMatched"].safeNumberLong() + entry["ndeleted"].safeNumberLong();
+
+                bool const isScan = std::string(entry.getStringField("planSummary")).find("COLLSCAN") != std::string::npos;
+                if (!isScan && !ExplainUtils::isWasteful(examined, returned))
+                    continue;
+
+                QueryShape const shape = queryShape(entry);
+                if (shape.isEmpty())
+                    continue;
+
+                bool served = false;
+                for (size_t k = 0; k < keys.size() && !served; ++k)
+                    served = isServedBy(shape, keys[k]);
+                if (served)
+                    continue;
+
+                mongo::BSONObj const key = suggestedKey(shape);
+                std::string const id = key.toString();
+
+                std::map<std::string, size_t>::const_iterator const found = positions.find(id);
+                if (found == positions.end()) {
+                    positions[id] = suggestions.size();
+                    IndexSuggestion suggestion;
+                    suggestion.key = key;
+                    suggestion.shape = describe(shape);
+                    suggestions.push_back(suggestion);
+                }
+
+                IndexSuggestion &suggestion = suggestions[positions[id]];
+                suggestion.queries++;
+                suggestion.docsExamined += examined;
+                suggestion.millis += entry["millis"].safeNumberLong();
+            }
+
+            std::stable_sort(suggestions.begin(), suggestions.end(),
+                             [](const IndexSuggestion &left, const IndexSuggestion &right) {
+                                 return left.queries > right.queries ||
+                                        (left.queries == right.queries && left.docsExamined > right.docsExamined);
+                             });
+            return suggestions;
+        }
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <mongo/bson/bsonobj.h>
+
+#include "robomongo/core/domain/IndexHealth.h"
+
+namespace Robomongo
+{
+    namespace IndexAdvisor
+    {
+        /**
+         * @brief Fields of query by the way index can serve them
+         */
+        struct QueryShape
+        {
+            std::vector<std::string> equality;
+            std::vector<std::pair<std::string, int> > sort;
+            std::vector<std::string> range;
+
+            bool isEmpty() const { return equality.empty() && sort.empty() && range.empty(); }
+        };
+
+        /**
+         * @brief Shape of query recorded in system.profile (find, aggregate with leading
+         * $match and $sort, count, distinct, update, delete, findAndModify)
+         */
+        QueryShape queryShape(const mongo::BSONObj &profileEntry);
+
+        /**
+         * @brief Index for the shape, fields go in equality, sort, range order
+         */
+        mongo::BSONObj suggestedKey(const QueryShape &shape);
+
+        /**
+         * @brief Marks indexes never accessed and indexes whose key is a prefix of
+         * another index key. _id, unique and TTL indexes are never reported.
+         */
+        void markUnusedAndRedundant(std::vector<IndexUsageInfo> &indexes);
+
+        /**
+         * @brief Indexes for slow queries (collection scans, or examining many more
+         * documents than returned), grouped by key and most frequent first. Keys already
+         * served by existing indexes are skipped.
+         */
+        std::vector<IndexSuggestion> suggestIndexes(const std::vector<mongo::BSONObj> &profileEntries,
+                                                    const std::vector<IndexUsageInfo> &indexes);
+    }
+}
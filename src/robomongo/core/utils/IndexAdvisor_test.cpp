@@ -0,0 +1,81 @@
+#include "gtest/gtest.h"
+#include "robomongo/core/utils/IndexAdvisor.h"
+
+#include "robomongo/shell/bson/json.h"
+
+using namespace Robomongo;
+
+namespace
+{
+    IndexUsageInfo index(const std::string &name, const char *key, long long accesses)
+    {
+        IndexUsageInfo info;
+        info.name = name;
+        info.key = mongo::Robomongo::fromjson(key);
+        info.accesses = accesses;
+        return info;
+    }
+}
+
+TEST(IndexAdvisorTests, queryShape_FindWithSortAndRange_IsInEqualitySortRangeOrder)
+{
+    mongo::BSONObj const entry = mongo::Robomongo::fromjson(
+        "{ command: { find: 'orders', filter: { age: { $gte: 21 }, status: 'A', $or: [ { a: 1 }, { b: 2 } ],"
+        "  tags: { $in: [ 'x' ] }, name: { $ne: 'z' } }, sort: { ts: -1, status: 1 } } }");
+
+    IndexAdvisor::QueryShape const shape = IndexAdvisor::queryShape(entry);
+    EXPECT_EQ("{ status: 1, tags: 1, ts: -1, age: 1 }", IndexAdvisor::suggestedKey(shape).toString());
+}
+
+TEST(IndexAdvisorTests, markUnusedAndRedundant_PrefixIndexes_AreRedundant)
+{
+    std::vector<IndexUsageInfo> indexes;
+    indexes.push_back(index("_id_", "{ _id: 1 }", 0));
+    indexes.push_back(index("a_1", "{ a: 1 }", 0));
+    indexes.push_back(index("a_-1_b_1", "{ a: -1, b: 1 }", 10));
+    indexes.push_back(index("b_1", "{ b: 1 }", 3));
+    indexes.push_back(index("email_1", "{ email: 1 }", 0));
+    indexes.back().unique = true;
+
+    IndexAdvisor::markUnusedAndRedundant(indexes);
+
+    EXPECT_FALSE(indexes[0].unused);
+    EXPECT_TRUE(indexes[1].unused);
+    EXPECT_EQ("a_-1_b_1", indexes[1].redundantWith);
+    EXPECT_TRUE(indexes[2].redundantWith.empty());
+    EXPECT_TRUE(indexes[3].redundantWith.empty());
+    EXPECT_FALSE(indexes[4].unused);
+}
+
+TEST(IndexAdvisorTests, suggestIndexes_CollectionScans_AreGroupedAndServedOnesSkipped)
+{
+    std::vector<mongo::BSONObj> entries;
+    entries.push_back(mongo::Robomongo::fromjson(
+        "{ planSummary: 'COLLSCAN', docsExamined: 5000, nreturned: 10, millis: 40,"
+        "  command: { find: 'c', filter: { b: 1, a: 2 } } }"));
+    entries.push_back(mongo::Robomongo::fromjson(
+        "{ planSummary: 'COLLSCAN', docsExamined: 7000, nreturned: 1, millis: 60,"
+        "  command: { aggregate: 'c', pipeline: [ { $match: { a: 5, b: 6 } }, { $group: { _id: '$a' } } ] } }"));
+    entries.push_back(mongo::Robomongo::fromjson(
+        "{ planSummary: 'COLLSCAN', docsExamined: 100, nreturned: 100, millis: 1,"
+        "  command: { q: { c: 1 }, u: { $set: { d: 1 } } } }"));
+    entries.push_back(mongo::Robomongo::fromjson(
+        "{ planSummary: 'COLLSCAN', docsExamined: 100, nreturned: 100, millis: 1,"
+        "  command: { count: 'c', query: { x: 1, y: { $gt: 2 } } } }"));
+    entries.push_back(mongo::Robomongo::fromjson(
+        "{ planSummary: 'IXSCAN { a: 1 }', docsExamined: 10, nreturned: 10, millis: 1,"
+        "  command: { find: 'c', filter: { a: 1, z: 1 } } }"));
+
+    std::vector<IndexUsageInfo> indexes;
+    indexes.push_back(index("y_1_x_1", "{ x: 1, y: -1 }", 5));
+
+    std::vector<IndexSuggestion> const suggestions = IndexAdvisor::suggestIndexes(entries, indexes);
+
+    ASSERT_EQ(2u, suggestions.size());
+    EXPECT_EQ("{ a: 1, b: 1 }", suggestions[0].key.toString());
+    EXPECT_EQ("equality: a, b", suggestions[0].shape);
+    EXPECT_EQ(2, suggestions[0].queries);
+    EXPECT_EQ(12000, suggestions[0].docsExamined);
+    EXPECT_EQ(100, suggestions[0].millis);
+    EXPECT_EQ("{ c: 1 }", suggestions[1].key.toString());
+}
@@ -0,0 +1,308 @@
+#include "robomongo/core/utils/SchemaAnalyzer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "robomongo/core/utils/BsonUtils.h"
+
+namespace
+{
+    const int precision = 10;
+    const size_t registersCount = size_t(1) << precision;
+
+    // Deeper documents are counted, but their fields are not walked
+    const int maxDepth = 20;
+
+    const size_t maxStringLength = 64;
+
+    uint64_t hashValue(const mongo::BSONElement &elem)
+    {
+        // FNV-1a of type and value bytes, then finalizer of MurmurHash3 to spread bits
+        uint64_t hash = 14695981039346656037ULL;
+        hash = (hash ^ static_cast<unsigned char>(elem.type())) * 1099511628211ULL;
+
+        const unsigned char *data = reinterpret_cast<const unsigned char *>(elem.value());
+        int const size = elem.valuesize();
+        for (int i = 0; i < size; ++i)
+            hash = (hash ^ data[i]) * 1099511628211ULL;
+
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+        hash *= 0xc4ceb9fe1a85ec53ULL;
+        hash ^= hash >> 33;
+        return hash;
+    }
+
+    // Prefix of at most maxStringLength bytes, not splitting UTF-8 sequence
+    std::string shorten(const char *data, size_t size)
+    {
+        if (size <= maxStringLength)
+            return std::string(data, size);
+
+        size_t length = maxStringLength;
+        while (length > 0 && (static_cast<unsigned char>(data[length]) & 0xc0) == 0x80)
+            --length;
+        return std::string(data, length);
+    }
+
+    int arrayLengthBucket(int length)
+    {
+        if (length <= 1)
+            return length;
+        if (length < 5)
+            return 2;
+        if (length < 10)
+            return 3;
+        if (length < 50)
+            return 4;
+        if (length < 100)
+            return 5;
+        return 6;
+    }
+
+    void addType(Robomongo::SchemaField &field, int type, long long count)
+    {
+        for (auto &typeCount : field.types) {
+            if (typeCount.first == type) {
+                typeCount.second += count;
+                return;
+            }
+        }
+        field.types.push_back(std::make_pair(type, count));
+    }
+}
+
+namespace Robomongo
+{
+    HyperLogLog::HyperLogLog() :
+        _registers(registersCount, 0)
+    {
+    }
+
+    void HyperLogLog::add(uint64_t hash)
+    {
+        size_t const index = static_cast<size_t>(hash >> (64 - precision));
+        uint64_t const rest = hash << precision;
+
+        // Position of the first set bit in the remaining bits
+        uint8_t rank = 1;
+        for (uint64_t bit = uint64_t(1) << 63; rank <= 64 - precision && !(rest & bit); bit >>= 1)
+            ++rank;
+
+        _registers[index] = std::max(_registers[index], rank);
+    }
+
+    void HyperLogLog::merge(const HyperLogLog &other)
+    {
+        for (size_t i = 0; i < registersCount; ++i)
+            _registers[i] = std::max(_registers[i], other._registers[i]);
+    }
+
+    double HyperLogLog::estimate() const
+    {
+        double const m = static_cast<double>(registersCount);
+        double sum = 0;
+        size_t zeros = 0;
+        for (uint8_t const value : _registers) {
+            sum += std::ldexp(1.0, -value);
+            if (value == 0)
+                ++zeros;
+        }
+
+        double const estimate = 0.7213 / (1 + 1.079 / m) * m * m / sum;
+
+        // Linear counting is more accurate for small cardinalities
+        if (estimate <= 2.5 * m && zeros > 0)
+            return m * std::log(m / zeros);
+
+        return estimate;
+    }
+
+    SchemaAnalyzer::SchemaAnalyzer(size_t maxFields) :
+        _maxFields(maxFields),
+        _documents(0),
+        _skippedValues(0)
+    {
+    }
+
+    void SchemaAnalyzer::add(const mongo::BSONObj &document)
+    {
+        ++_documents;
+
+        std::string path;
+        addObject(document, path, 0);
+    }
+
+    void SchemaAnalyzer::addObject(const mongo::BSONObj &obj, std::string &path, int depth)
+    {
+        for (mongo::BSONObjIterator it(obj); it.more(); ) {
+            mongo::BSONElement const elem = it.next();
+            size_t const length = path.size();
+
+            if (!path.empty())
+                path += '.';
+            path += elem.fieldName();
+            addValue(elem, path, depth);
+
+            path.resize(length);
+        }
+    }
+
+    void SchemaAnalyzer::addValue(const mongo::BSONElement &elem, std::string &path, int depth)
+    {
+        FieldStats *stats = fieldStats(path);
+        if (!stats) {
+            ++_skippedValues;
+            return;
+        }
+
+        SchemaField &field = stats->field;
+        if (stats->lastDocument != _documents) {
+            stats->lastDocument = _documents;
+            ++field.documents;
+        }
+        ++field.values;
+        addType(field, elem.type(), 1);
+
+        if (BsonUtils::isArray(elem.type())) {
+            std::vector<mongo::BSONElement> elements;
+            for (mongo::BSONObjIterator it(elem.embeddedObject()); it.more(); )
+                elements.push_back(it.next());
+            ++field.arrayLengths[arrayLengthBucket(static_cast<int>(elements.size()))];
+
+            if (depth < maxDepth) {
+                size_t const length = path.size();
+                path += "[]";
+                for (auto const& element : elements)
+                    addValue(element, path, depth + 1);
+                path.resize(length);
+            }
+            return;
+        }
+
+        if (BsonUtils::isDocument(elem.type())) {
+            if (depth < maxDepth)
+                addObject(elem.embeddedObject(), path, depth + 1);
+            return;
+        }
+
+        stats->distinct.add(hashValue(elem));
+
+        if (elem.isNumber()) {
+            double const value = elem.numberDouble();
+            if (!field.hasNumbers || value < field.minNumber)
+                field.minNumber = value;
+            if (!field.hasNumbers || value > field.maxNumber)
+                field.maxNumber = value;
+            field.hasNumbers = true;
+        }
+        else if (elem.type() == mongo::Date) {
+            long long const value = elem.date().toMillisSinceEpoch();
+            if (!field.hasDates || value < field.minDate)
+                field.minDate = value;
+            if (!field.hasDates || value > field.maxDate)
+                field.maxDate = value;
+            field.hasDates = true;
+        }
+        else if (elem.type() == mongo::String) {
+            const char *const data = elem.valuestr();
+            size_t const size = static_cast<size_t>(elem.valuestrsize() - 1);
+            if (!field.hasStrings || field.minString.compare(0, std::string::npos, data, size) > 0)
+                field.minString = shorten(data, size);
+            if (!field.hasStrings || field.maxString.compare(0, std::string::npos, data, size) < 0)
+                field.maxString = shorten(data, size);
+            field.hasStrings = true;
+        }
+    }
+
+    SchemaAnalyzer::FieldStats *SchemaAnalyzer::fieldStats(const std::string &path)
+    {
+        std::unordered_map<std::string, size_t>::const_iterator const it = _index.find(path);
+        if (it != _index.end())
+            return &_fields[it->second];
+
+        if (_fields.size() >= _maxFields)
+            return nullptr;
+
+        _index[path] = _fields.size();
+        _fields.push_back(FieldStats());
+        _fields.back().field.path = path;
+        return &_fields.back();
+    }
+
+    void SchemaAnalyzer::merge(const SchemaAnalyzer &other)
+    {
+        _documents += other._documents;
+        _skippedValues += other._skippedValues;
+
+        for (auto const& otherStats : other._fields) {
+            SchemaField const &from = otherStats.field;
+            FieldStats *stats = fieldStats(from.path);
+            if (!stats) {
+                _skippedValues += from.values;
+                continue;
+            }
+
+            SchemaField &field = stats->field;
+            field.documents += from.documents;
+            field.values += from.values;
+            for (auto const& typeCount : from.types)
+                addType(field, typeCount.first, typeCount.second);
+            for (int i = 0; i < SchemaField::ArrayLengthBuckets; ++i)
+                field.arrayLengths[i] += from.arrayLengths[i];
+            stats->distinct.merge(otherStats.distinct);
+
+            if (from.hasNumbers) {
+                field.minNumber = field.hasNumbers ? std::min(field.minNumber, from.minNumber) : from.minNumber;
+                field.maxNumber = field.hasNumbers ? std::max(field.maxNumber, from.maxNumber) : from.maxNumber;
+                field.hasNumbers = true;
+            }
+            if (from.hasDates) {
+                field.minDate = field.hasDates ? std::min(field.minDate, from.minDate) : from.minDate;
+                field.maxDate = field.hasDates ? std::max(field.maxDate, from.maxDate) : from.maxDate;
+                field.hasDates = true;
+            }
+            if (from.hasStrings) {
+                field.minString = field.hasStrings ? std::min(field.minString, from.minString) : from.minString;
+                field.maxString = field.hasStrings ? std::max(field.maxString, from.maxString) : from.maxString;
+                field.hasStrings = true;
+            }
+        }
+    }
+
+    void SchemaAnalyzer::fillReport(SchemaReport &report) const
+    {
+        report.documents = _documents;
+        report.maxFields = _maxFields;
+        report.skippedValues = _skippedValues;
+
+        report.fields.clear();
+        for (auto const& stats : _fields) {
+            SchemaField field = stats.field;
+            std::stable_sort(field.types.begin(), field.types.end(),
+                             [](const std::pair<int, long long> &left, const std::pair<int, long long> &right) {
+                                 return left.second > right.second;
+                             });
+
+            bool const hasScalars = field.hasNumbers || field.hasDates || field.hasStrings ||
+                                    std::any_of(field.types.begin(), field.types.end(),
+                                                [](const std::pair<int, long long> &type) {
+                                                    return !BsonUtils::isDocument(static_cast<mongo::BSONType>(type.first));
+                                                });
+            if (hasScalars)
+                field.distinct = std::llround(stats.distinct.estimate());
+
+            report.fields.push_back(field);
+        }
+
+        std::sort(report.fields.begin(), report.fields.end(),
+                  [](const SchemaField &left, const SchemaField &right) { return left.path < right.path; });
+    }
+
+    const char *SchemaAnalyzer::arrayLengthBucketName(int bucket)
+    {
+        const char *const names[SchemaField::ArrayLengthBuckets] = { "0", "1", "2-4", "5-9", "10-49", "50-99", "100+" };
+        return bucket >= 0 && bucket < SchemaField::ArrayLengthBuckets ? names[bucket] : "";
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <mongo/bson/bsonobj.h>
+
+#include "robomongo/core/domain/SchemaReport.h"
+
+namespace Robomongo
+{
+    /**
+     * @brief Cardinality estimator with 1024 one-byte registers (about 3% standard error)
+     */
+    class HyperLogLog
+    {
+    public:
+        HyperLogLog();
+
+        void add(uint64_t hash);
+        void merge(const HyperLogLog &other);
+        double estimate() const;
+
+    private:
+        std::vector<uint8_t> _registers;
+    };
+
+    /**
+     * @brief Collects statistics of field paths of documents. Memory does not depend on number
+     * of documents: at most "maxFields" paths are tracked and every path has fixed-size state.
+     * Analyzers fed by different threads are combined with merge().
+     *
+     * @threadsafe no
+     */
+    class SchemaAnalyzer
+    {
+    public:
+        explicit SchemaAnalyzer(size_t maxFields = 2000);
+
+        void add(const mongo::BSONObj &document);
+        void merge(const SchemaAnalyzer &other);
+
+        /**
+         * @brief Fills documents, fields and limits of "report"
+         */
+        void fillReport(SchemaReport &report) const;
+
+        long long documentsCount() const { return _documents; }
+
+        static const char *arrayLengthBucketName(int bucket);
+
+    private:
+        struct FieldStats
+        {
+            SchemaField field;
+            HyperLogLog distinct;
+            long long lastDocument = 0;     // counts documents once for paths inside arrays
+        };
+
+        void addObject(const mongo::BSONObj &obj, std::string &path, int depth);
+        void addValue(const mongo::BSONElement &elem, std::string &path, int depth);
+        FieldStats *fieldStats(const std::string &path);
+
+        const size_t _maxFields;
+        std::vector<FieldStats> _fields;
+        std::unordered_map<std::string, size_t> _index;
+        long long _documents;
+        long long _skippedValues;
+    };
+}
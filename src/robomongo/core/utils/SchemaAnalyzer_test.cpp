@@ -0,0 +1,73 @@
+#include "gtest/gtest.h"
+#include "robomongo/core/utils/SchemaAnalyzer.h"
+
+#include "robomongo/shell/bson/json.h"
+
+using namespace Robomongo;
+
+namespace
+{
+    const SchemaField *findField(const SchemaReport &report, const std::string &path)
+    {
+        for (auto const& field : report.fields) {
+            if (field.path == path)
+                return &field;
+        }
+        return nullptr;
+    }
+}
+
+TEST(SchemaAnalyzerTests, fillReport_MergedAnalyzers_ReportPathsTypesAndRanges)
+{
+    SchemaAnalyzer first, second;
+    for (int i = 0; i < 100; ++i) {
+        SchemaAnalyzer &analyzer = i % 2 ? second : first;
+        analyzer.add(mongo::Robomongo::fromjson(
+            "{ n: " + std::to_string(i) + ", s: '" + (i % 10 ? "v" + std::to_string(i % 5) : "") + "',"
+            "  items: [ { sku: 'a' }, { sku: 'b', qty: 1 } ] }"));
+    }
+    first.add(mongo::Robomongo::fromjson("{ n: 'text', items: [] }"));
+    first.merge(second);
+
+    SchemaReport report;
+    first.fillReport(report);
+    EXPECT_EQ(101, report.documents);
+
+    const SchemaField *n = findField(report, "n");
+    ASSERT_TRUE(n != nullptr);
+    EXPECT_EQ(101, n->documents);
+    ASSERT_EQ(2u, n->types.size());
+    EXPECT_EQ(mongo::NumberInt, n->types[0].first);
+    EXPECT_EQ(0, n->minNumber);
+    EXPECT_EQ(99, n->maxNumber);
+    EXPECT_NEAR(101, n->distinct, 3);
+
+    const SchemaField *s = findField(report, "s");
+    ASSERT_TRUE(s != nullptr);
+    EXPECT_EQ(100, s->documents);
+    EXPECT_EQ("", s->minString);
+    EXPECT_EQ("v4", s->maxString);
+    EXPECT_EQ(6, s->distinct);
+
+    const SchemaField *sku = findField(report, "items[].sku");
+    ASSERT_TRUE(sku != nullptr);
+    EXPECT_EQ(100, sku->documents);
+    EXPECT_EQ(200, sku->values);
+
+    const SchemaField *items = findField(report, "items");
+    ASSERT_TRUE(items != nullptr);
+    EXPECT_EQ(1, items->arrayLengths[0]);
+    EXPECT_EQ(100, items->arrayLengths[2]);
+    EXPECT_EQ(-1, items->distinct);
+}
+
+TEST(SchemaAnalyzerTests, add_ManyPaths_AreBounded)
+{
+    SchemaAnalyzer analyzer(3);
+    analyzer.add(mongo::Robomongo::fromjson("{ a: 1, b: 2, c: 3, d: 4, e: 5 }"));
+
+    SchemaReport report;
+    analyzer.fillReport(report);
+    EXPECT_EQ(3u, report.fields.size());
+    EXPECT_EQ(2, report.skippedValues);
+}
@@ -0,0 +1,232 @@
+#include "robomongo/core/utils/StringUtils.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define ROBOMONGO_STRING_AVX2
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ROBOMONGO_STRING_SSE2
+#endif
+
+namespace
+{
+    const char hexDigits[] = "0123456789abcdef";
+
+    inline bool needsEscape(unsigned char c, unsigned char extra)
+    {
+        return c < 0x20 || c == '"' || c == '\\' || c == extra;
+    }
+
+    inline bool isWhitespace(char c)
+    {
+        return c == ' ' || (c >= '\t' && c <= '\r');
+    }
+
+    // Index of the lowest set bit of non-zero mask
+    inline unsigned firstBit(unsigned mask)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return index;
+#else
+        return __builtin_ctz(mask);
+#endif
+    }
+
+    // Length of the prefix of ASCII characters (except NUL)
+    size_t asciiPrefix(const char *data, size_t size)
+    {
+        size_t i = 0;
+
+#ifdef ROBOMONGO_STRING_SSE2
+        for (; i + 16 <= size; i += 16) {
+            __m128i const v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+            __m128i const nul = _mm_cmpeq_epi8(v, _mm_setzero_si128());
+            if (_mm_movemask_epi8(_mm_or_si128(v, nul)))
+                break;
+        }
+#endif
+
+        for (; i < size; ++i) {
+            if (data[i] == 0 || static_cast<unsigned char>(data[i]) >= 0x80)
+                break;
+        }
+        return i;
+    }
+}
+
+namespace Robomongo
+{
+    namespace StringUtils
+    {
+        size_t jsonPlainPrefix(const char *data, size_t size, char extra)
+        {
+            size_t i = 0;
+
+#ifdef ROBOMONGO_STRING_AVX2
+            __m256i const quote32 = _mm256_set1_epi8('"');
+            __m256i const backslash32 = _mm256_set1_epi8('\\');
+            __m256i const extra32 = _mm256_set1_epi8(extra);
+            __m256i const control32 = _mm256_set1_epi8(0x1f);
+            for (; i + 32 <= size; i += 32) {
+                __m256i const v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+
+                // Unsigned v <= 0x1f, when saturated subtraction gives zero
+                __m256i special = _mm256_cmpeq_epi8(_mm256_subs_epu8(v, control32), _mm256_setzero_si256());
+                special = _mm256_or_si256(special, _mm256_cmpeq_epi8(v, quote32));
+                special = _mm256_or_si256(special, _mm256_cmpeq_epi8(v, backslash32));
+                special = _mm256_or_si256(special, _mm256_cmpeq_epi8(v, extra32));
+
+                unsigned const mask = static_cast<unsigned>(_mm256_movemask_epi8(special));
+                if (mask)
+                    return i + firstBit(mask);
+            }
+#endif
+
+#ifdef ROBOMONGO_STRING_SSE2
+            __m128i const quote16 = _mm_set1_epi8('"');
+            __m128i const backslash16 = _mm_set1_epi8('\\');
+            __m128i const extra16 = _mm_set1_epi8(extra);
+            __m128i const control16 = _mm_set1_epi8(0x1f);
+            for (; i + 16 <= size; i += 16) {
+                __m128i const v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+
+                __m128i special = _mm_cmpeq_epi8(_mm_subs_epu8(v, control16), _mm_setzero_si128());
+                special = _mm_or_si128(special, _mm_cmpeq_epi8(v, quote16));
+                special = _mm_or_si128(special, _mm_cmpeq_epi8(v, backslash16));
+                special = _mm_or_si128(special, _mm_cmpeq_epi8(v, extra16));
+
+                unsigned const mask = static_cast<unsigned>(_mm_movemask_epi8(special));
+                if (mask)
+                    return i + firstBit(mask);
+            }
+#endif
+
+            for (; i < size; ++i) {
+                if (needsEscape(static_cast<unsigned char>(data[i]), static_cast<unsigned char>(extra)))
+                    break;
+            }
+            return i;
+        }
+
+        size_t whitespacePrefix(const char *data, size_t size)
+        {
+            size_t i = 0;
+
+#ifdef ROBOMONGO_STRING_SSE2
+            for (; i + 16 <= size; i += 16) {
+                __m128i const v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+
+                // Space, or \t \n \v \f \r which are 0x09..0x0d
+                __m128i const space = _mm_cmpeq_epi8(v, _mm_set1_epi8(' '));
+                __m128i const shifted = _mm_sub_epi8(v, _mm_set1_epi8(0x09));
+                __m128i const control = _mm_cmpeq_epi8(_mm_subs_epu8(shifted, _mm_set1_epi8(0x04)), _mm_setzero_si128());
+                unsigned const mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(space, control))) ^ 0xffff;
+                if (mask)
+                    return i + firstBit(mask);
+            }
+#endif
+
+            for (; i < size; ++i) {
+                if (!isWhitespace(data[i]))
+                    break;
+            }
+            return i;
+        }
+
+        void appendJsonEscaped(std::string &out, const char *data, size_t size, bool escapeSlash)
+        {
+            // When slash is not escaped, it is looked for as a quote (that is, never found twice)
+            char const slash = escapeSlash ? '/' : '"';
+            out.reserve(out.size() + size);
+
+            while (size > 0) {
+                size_t const plain = jsonPlainPrefix(data, size, slash);
+                out.append(data, plain);
+                data += plain;
+                size -= plain;
+                if (size == 0)
+                    break;
+
+                unsigned char const c = static_cast<unsigned char>(*data);
+                switch (c) {
+                case '"':  out.append("\\\""); break;
+                case '\\': out.append("\\\\"); break;
+                case '/':  out.append("\\/"); break;
+                case '\b': out.append("\\b"); break;
+                case '\f': out.append("\\f"); break;
+                case '\n': out.append("\\n"); break;
+                case '\r': out.append("\\r"); break;
+                case '\t': out.append("\\t"); break;
+                default: {
+                    char const unicode[] = { '\\', 'u', '0', '0', hexDigits[c >> 4], hexDigits[c & 0x0f] };
+                    out.append(unicode, sizeof(unicode));
+                    break;
+                }
+                }
+
+                ++data;
+                --size;
+            }
+        }
+
+        bool isValidUtf8(const char *data, size_t size)
+        {
+            const unsigned char *p = reinterpret_cast<const unsigned char *>(data);
+            const unsigned char *const end = p + size;
+
+            while (p < end) {
+                p += asciiPrefix(reinterpret_cast<const char *>(p), end - p);
+                if (p == end)
+                    break;
+
+                unsigned char const c = *p;
+                if (c == 0)
+                    return false;
+
+                // Lead byte gives sequence length and allowed range of the second byte
+                size_t length;
+                unsigned char low = 0x80, high = 0xbf;
+                if (c >= 0xc2 && c <= 0xdf) {
+                    length = 2;
+                } else if (c >= 0xe0 && c <= 0xef) {
+                    length = 3;
+                    if (c == 0xe0)
+                        low = 0xa0;     // overlong
+                    else if (c == 0xed)
+                        high = 0x9f;    // surrogates
+                } else if (c >= 0xf0 && c <= 0xf4) {
+                    length = 4;
+                    if (c == 0xf0)
+                        low = 0x90;     // overlong
+                    else if (c == 0xf4)
+                        high = 0x8f;    // above U+10FFFF
+                } else {
+                    return false;
+                }
+
+                if (static_cast<size_t>(end - p) < length)
+                    return false;
+
+                if (p[1] < low || p[1] > high)
+                    return false;
+
+                for (size_t i = 2; i < length; ++i) {
+                    if ((p[i] & 0xc0) != 0x80)
+                        return false;
+                }
+
+                p += length;
+            }
+
+            return true;
+        }
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+
+namespace Robomongo
+{
+    /**
+     * @brief Byte-level string helpers for rendering of results. Long runs
+     * of plain characters are processed 16 (SSE2) or 32 (AVX2) bytes at once.
+     */
+    namespace StringUtils
+    {
+        /**
+         * @brief Appends string escaped for JSON, exactly as mongo::str::escape() does:
+         * quote, backslash and control characters are escaped, other bytes are copied.
+         * @param escapeSlash: escape '/' too (used for regular expressions).
+         */
+        void appendJsonEscaped(std::string &out, const char *data, size_t size, bool escapeSlash = false);
+
+        /**
+         * @brief Returns length of the prefix that needs no JSON escaping, that is, up to the
+         * first control character, quote, backslash or "extra" character.
+         */
+        size_t jsonPlainPrefix(const char *data, size_t size, char extra);
+
+        /**
+         * @brief Returns length of the prefix of ASCII whitespace (as of isspace() in "C" locale).
+         */
+        size_t whitespacePrefix(const char *data, size_t size);
+
+        /**
+         * @brief Returns true if data is well-formed UTF-8 (no overlong forms,
+         * surrogates or code points above U+10FFFF) without NUL bytes.
+         */
+        bool isValidUtf8(const char *data, size_t size);
+    }
+}
@@ -0,0 +1,45 @@
+#include "gtest/gtest.h"
+#include "robomongo/core/utils/StringUtils.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "mongo/util/str.h"
+
+using namespace Robomongo;
+
+namespace
+{
+    std::string escaped(const std::string &text, bool escapeSlash)
+    {
+        std::string out;
+        StringUtils::appendJsonEscaped(out, text.data(), text.size(), escapeSlash);
+        return out;
+    }
+}
+
+TEST(StringUtilsBench, appendJsonEscaped_LongStrings_Throughput)
+{
+    // Log-like lines: long runs of plain text with a few quotes and tabs
+    std::string line = "2024-01-01T00:00:00.000Z I NETWORK [conn42] end connection 10.0.0.1:5000 (\"slow\" query)\t";
+    std::string text;
+    while (text.size() < 16 * 1024 * 1024)
+        text += line;
+
+    using std::chrono::steady_clock;
+    auto const start = steady_clock::now();
+    std::string const expected = mongo::str::escape(text, false);
+    auto const mongoDone = steady_clock::now();
+    std::string const actual = escaped(text, false);
+    auto const done = steady_clock::now();
+
+    EXPECT_EQ(expected, actual);
+
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    std::cout << "[ BENCH    ] " << text.size() << " bytes; "
+              << "str::escape " << duration_cast<microseconds>(mongoDone - start).count() << " us, "
+              << "appendJsonEscaped " << duration_cast<microseconds>(done - mongoDone).count() << " us"
+              << std::endl;
+}
@@ -0,0 +1,62 @@
+#include "gtest/gtest.h"
+#include "robomongo/core/utils/StringUtils.h"
+
+#include <string>
+
+#include "mongo/util/str.h"
+
+using namespace Robomongo;
+
+namespace
+{
+    // Mostly letters, with some punctuation, control and non-ASCII bytes
+    std::string randomText(size_t size, unsigned seed)
+    {
+        std::string text(size, '\0');
+        for (size_t i = 0; i < size; ++i) {
+            seed = seed * 1103515245 + 12345;
+            unsigned const r = seed >> 16;
+            text[i] = r % 8 ? static_cast<char>('a' + r % 26) : static_cast<char>(r >> 3);
+        }
+        return text;
+    }
+
+    std::string escaped(const std::string &text, bool escapeSlash)
+    {
+        std::string out;
+        StringUtils::appendJsonEscaped(out, text.data(), text.size(), escapeSlash);
+        return out;
+    }
+}
+
+TEST(StringUtilsTests, appendJsonEscaped_AllBytes_MatchesMongoEscape)
+{
+    std::string allBytes;
+    for (int c = 0; c < 256; ++c)
+        allBytes += static_cast<char>(c);
+
+    EXPECT_EQ(mongo::str::escape(allBytes, false), escaped(allBytes, false));
+    EXPECT_EQ(mongo::str::escape(allBytes, true), escaped(allBytes, true));
+
+    for (size_t size = 0; size < 200; ++size) {
+        std::string const text = randomText(size, static_cast<unsigned>(size));
+        ASSERT_EQ(mongo::str::escape(text, false), escaped(text, false)) << size;
+        ASSERT_EQ(mongo::str::escape(text, true), escaped(text, true)) << size;
+    }
+}
+
+TEST(StringUtilsTests, isValidUtf8_Sequences)
+{
+    EXPECT_TRUE(StringUtils::isValidUtf8("", 0));
+    EXPECT_TRUE(StringUtils::isValidUtf8("plain ascii text, longer than one vector", 40));
+    EXPECT_TRUE(StringUtils::isValidUtf8("caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80", 14));
+    EXPECT_TRUE(StringUtils::isValidUtf8("\xef\xbf\xbf\xf4\x8f\xbf\xbf", 7));
+
+    EXPECT_FALSE(StringUtils::isValidUtf8("a\0b", 3));               // NUL
+    EXPECT_FALSE(StringUtils::isValidUtf8("\xc0\x80", 2));           // overlong
+    EXPECT_FALSE(StringUtils::isValidUtf8("\xe0\x80\xaf", 3));       // overlong
+    EXPECT_FALSE(StringUtils::isValidUtf8("\xed\xa0\x80", 3));       // surrogate
+    EXPECT_FALSE(StringUtils::isValidUtf8("\xf4\x90\x80\x80", 4));   // above U+10FFFF
+    EXPECT_FALSE(StringUtils::isValidUtf8("\xe2\x82", 2));           // truncated
+    EXPECT_FALSE(StringUtils::isValidUtf8("0123456789abcdef\x80", 17));
+}
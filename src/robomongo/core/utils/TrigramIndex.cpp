@@ -0,0 +1,178 @@
+#include "robomongo/core/utils/TrigramIndex.h"
+
+#include <algorithm>
+#include <string_view>
+
+#include "robomongo/core/utils/BsonUtils.h"
+
+namespace
+{
+    inline char foldCase(char c)
+    {
+        // NUL separates terms, so it is never a part of them
+        if (c == 0)
+            return ' ';
+
+        return (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+    }
+
+    inline unsigned trigram(const char *p)
+    {
+        return (static_cast<unsigned char>(p[0]) << 16) |
+               (static_cast<unsigned char>(p[1]) << 8) |
+                static_cast<unsigned char>(p[2]);
+    }
+
+    // Keeps in "result" only documents that are present in "other", both are sorted
+    void intersect(std::vector<unsigned> &result, const std::vector<unsigned> &other)
+    {
+        std::vector<unsigned>::iterator out = result.begin();
+        std::vector<unsigned>::const_iterator it = other.begin();
+        for (std::vector<unsigned>::const_iterator cur = result.begin(); cur != result.end(); ++cur) {
+            it = std::lower_bound(it, other.end(), *cur);
+            if (it == other.end())
+                break;
+
+            if (*it == *cur)
+                *out++ = *cur;
+        }
+        result.erase(out, result.end());
+    }
+}
+
+namespace Robomongo
+{
+    TrigramIndex::TrigramIndex(UUIDEncoding uuidEncoding, SupportedTimes timeZone) :
+        _uuidEncoding(uuidEncoding),
+        _timeZone(timeZone)
+    {
+        _offsets.push_back(0);
+    }
+
+    void TrigramIndex::add(const mongo::BSONObj &document)
+    {
+        unsigned const number = documentsCount();
+        size_t const begin = _text.size();
+
+        std::string path;
+        addObject(document, path, false);
+        _offsets.push_back(_text.size());
+
+        const char *const text = _text.data();
+        for (size_t i = begin; i + 3 <= _text.size(); ++i) {
+            // Trigrams across terms are not indexed
+            if (text[i + 2] == 0) {
+                i += 2;
+                continue;
+            }
+            if (text[i] == 0 || text[i + 1] == 0)
+                continue;
+
+            std::vector<unsigned> &documents = _postings[trigram(text + i)];
+            if (documents.empty() || documents.back() != number)
+                documents.push_back(number);
+        }
+    }
+
+    void TrigramIndex::addObject(const mongo::BSONObj &obj, std::string &path, bool isArray)
+    {
+        for (mongo::BSONObjIterator it(obj); it.more(); ) {
+            mongo::BSONElement const elem = it.next();
+            size_t const length = path.size();
+
+            // Elements of arrays are found by path of the array, like in queries
+            if (!isArray) {
+                if (!path.empty())
+                    path += '.';
+                path += elem.fieldName();
+                appendTerm(path.data(), path.size());
+            }
+
+            if (BsonUtils::isDocument(elem.type())) {
+                addObject(elem.embeddedObject(), path, BsonUtils::isArray(elem.type()));
+            }
+            else {
+                _value.clear();
+                BsonUtils::buildJsonString(elem, _value, _uuidEncoding, _timeZone);
+                appendTerm(_value.data(), _value.size());
+            }
+
+            path.resize(length);
+        }
+    }
+
+    void TrigramIndex::appendTerm(const char *data, size_t size)
+    {
+        size_t const begin = _text.size();
+        _text.resize(begin + size + 1);
+
+        char *out = &_text[begin];
+        for (size_t i = 0; i < size; ++i)
+            out[i] = foldCase(data[i]);
+        out[size] = 0;
+    }
+
+    bool TrigramIndex::contains(unsigned document, const std::string &query) const
+    {
+        std::string_view const text(_text.data() + _offsets[document], _offsets[document + 1] - _offsets[document]);
+        return text.find(query) != std::string_view::npos;
+    }
+
+    std::vector<unsigned> TrigramIndex::search(const std::string &query) const
+    {
+        std::string folded(query);
+        std::transform(folded.begin(), folded.end(), folded.begin(), foldCase);
+
+        std::vector<unsigned> result;
+
+        if (folded.size() < 3) {
+            // Too short to have trigrams, text of all documents is scanned at once
+            size_t pos = folded.empty() ? std::string::npos : _text.find(folded);
+            while (pos != std::string::npos) {
+                std::vector<size_t>::const_iterator const next = std::upper_bound(_offsets.begin(), _offsets.end(), pos);
+                result.push_back(static_cast<unsigned>(next - _offsets.begin() - 1));
+                pos = _text.find(folded, *next);
+            }
+            return result;
+        }
+
+        std::vector<const std::vector<unsigned> *> lists;
+        for (size_t i = 0; i + 3 <= folded.size(); ++i) {
+            PostingsType::const_iterator const it = _postings.find(trigram(folded.data() + i));
+            if (it == _postings.end())
+                return result;
+
+            lists.push_back(&it->second);
+        }
+
+        // Rare trigrams go first, so candidates shrink as early as possible
+        std::sort(lists.begin(), lists.end(),
+                  [](const std::vector<unsigned> *left, const std::vector<unsigned> *right) {
+                      return left->size() < right->size() || (left->size() == right->size() && left < right);
+                  });
+        lists.erase(std::unique(lists.begin(), lists.end()), lists.end());
+
+        std::vector<unsigned> candidates(*lists.front());
+        for (size_t i = 1; i < lists.size() && !candidates.empty(); ++i)
+            intersect(candidates, *lists[i]);
+
+        // Trigrams may be present in different terms of a candidate
+        for (std::vector<unsigned>::const_iterator it = candidates.begin(); it != candidates.end(); ++it) {
+            if (contains(*it, folded))
+                result.push_back(*it);
+        }
+
+        return result;
+    }
+
+    size_t TrigramIndex::memoryUsage() const
+    {
+        size_t usage = _text.capacity() + _offsets.capacity() * sizeof(size_t) +
+                       _postings.bucket_count() * sizeof(void *);
+
+        for (PostingsType::const_iterator it = _postings.begin(); it != _postings.end(); ++it)
+            usage += sizeof(*it) + sizeof(void *) + it->second.capacity() * sizeof(unsigned);
+
+        return usage;
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <mongo/bson/bsonobj.h>
+
+#include "robomongo/core/Enums.h"
+
+namespace Robomongo
+{
+    /**
+     * @brief Substring search index over field paths and scalar values of documents.
+     *
+     * Every document is rendered once into a compact searchable text: dotted path
+     * of every field (i.e. "address.city", array positions are omitted) followed by
+     * the value as the tree view shows it. For every trigram (three consecutive bytes)
+     * of the text the index keeps the sorted list of documents where it occurs.
+     * Queries intersect lists of their trigrams, then candidates are verified against
+     * the text, so no document is read again.
+     *
+     * Matching is case-insensitive for ASCII letters, other bytes are compared as is.
+     *
+     * @threadsafe no, but built index may be searched from any thread
+     */
+    class TrigramIndex
+    {
+    public:
+        TrigramIndex(UUIDEncoding uuidEncoding, SupportedTimes timeZone);
+
+        /**
+         * @brief Indexes document, documents are numbered in order of addition
+         */
+        void add(const mongo::BSONObj &document);
+
+        /**
+         * @returns sorted numbers of documents where any field path or value contains "query"
+         */
+        std::vector<unsigned> search(const std::string &query) const;
+
+        unsigned documentsCount() const { return static_cast<unsigned>(_offsets.size() - 1); }
+
+        /**
+         * @brief Bytes taken by text and lists of the index
+         */
+        size_t memoryUsage() const;
+
+    private:
+        typedef std::unordered_map<unsigned, std::vector<unsigned> > PostingsType;
+
+        void addObject(const mongo::BSONObj &obj, std::string &path, bool isArray);
+        void appendTerm(const char *data, size_t size);
+        bool contains(unsigned document, const std::string &query) const;
+
+        const UUIDEncoding _uuidEncoding;
+        const SupportedTimes _timeZone;
+
+        // Lower-cased paths and values, terms are separated with NUL bytes
+        std::string _text;
+
+        // Text of document "i" is located in [_offsets[i], _offsets[i + 1])
+        std::vector<size_t> _offsets;
+
+        // Trigram -> documents where it occurs, in ascending order
+        PostingsType _postings;
+
+        // Value buffer, reused for all fields
+        std::string _value;
+    };
+}
@@ -0,0 +1,45 @@
+#include "gtest/gtest.h"
+#include "robomongo/core/utils/TrigramIndex.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <mongo/bson/bsonobjbuilder.h>
+
+using namespace Robomongo;
+
+TEST(TrigramIndexBench, search_100kDocuments_Throughput)
+{
+    int const count = 100000;
+    std::vector<mongo::BSONObj> documents;
+    documents.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        documents.push_back(BSON("_id" << i << "name" << ("user" + std::to_string(i * 7919 % count)) <<
+                                 "address" << BSON("city" << ("city" + std::to_string(i % 1000)) << "zip" << i % 90000)));
+    }
+
+    using std::chrono::steady_clock;
+    auto const start = steady_clock::now();
+    TrigramIndex index(DefaultEncoding, Utc);
+    for (const mongo::BSONObj &document : documents)
+        index.add(document);
+    auto const built = steady_clock::now();
+
+    std::vector<unsigned> const found = index.search("user4242");
+    auto const searched = steady_clock::now();
+
+    // Names are a permutation: user4242 and user42420..user42429
+    EXPECT_EQ(11u, found.size());
+
+    // Cities city42 and city420..city429, 100 documents each
+    EXPECT_EQ(1100u, index.search("City42").size());
+
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    std::cout << "[ BENCH    ] " << count << " documents; "
+              << "build " << duration_cast<microseconds>(built - start).count() << " us, "
+              << "search " << duration_cast<microseconds>(searched - built).count() << " us, "
+              << index.memoryUsage() / 1024 << " KB"
+              << std::endl;
+}
@@ -0,0 +1,44 @@
+#include "gtest/gtest.h"
+#include "robomongo/core/utils/TrigramIndex.h"
+
+#include <string>
+
+#include <mongo/bson/bsonobjbuilder.h>
+
+using namespace Robomongo;
+
+namespace
+{
+    std::vector<unsigned> numbers(std::initializer_list<unsigned> values)
+    {
+        return std::vector<unsigned>(values);
+    }
+}
+
+TEST(TrigramIndexTests, search_PathsAndValues_FindsMatchingDocuments)
+{
+    TrigramIndex index(DefaultEncoding, Utc);
+    index.add(BSON("name" << "Alice" << "address" << BSON("city" << "Berlin")));
+    index.add(BSON("name" << "Bob" << "tags" << BSON_ARRAY(BSON("label" << "admin") << "berliner")));
+    index.add(BSON("count" << 12345 << "active" << true));
+
+    EXPECT_EQ(numbers({ 0, 1 }), index.search("BERLIN"));
+    EXPECT_EQ(numbers({ 0 }), index.search("address.city"));
+    EXPECT_EQ(numbers({ 1 }), index.search("tags.label"));
+    EXPECT_EQ(numbers({ 2 }), index.search("234"));
+    EXPECT_EQ(numbers({ 2 }), index.search("true"));
+    EXPECT_EQ(numbers({ 1, 2 }), index.search("o"));
+    EXPECT_TRUE(index.search("alice berlin").empty());
+    EXPECT_TRUE(index.search("").empty());
+}
+
+TEST(TrigramIndexTests, search_TermsAreNotJoined_NoFalseMatches)
+{
+    TrigramIndex index(DefaultEncoding, Utc);
+    index.add(BSON("ab" << "cd"));
+
+    // "b" of the path and "c" of the value belong to different terms
+    EXPECT_TRUE(index.search("bc").empty());
+    EXPECT_TRUE(index.search("abcd").empty());
+    EXPECT_EQ(numbers({ 0 }), index.search("cd"));
+}
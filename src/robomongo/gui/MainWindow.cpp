@@ -74,6 +74,12 @@ namespace
         Robomongo::AppRegistry::instance().settingsManager()->save();
     }
     
+    void saveFlattenTableColumns(bool isFlatten)
+    {
+        Robomongo::AppRegistry::instance().settingsManager()->setFlattenTableColumns(isFlatten);
+        Robomongo::AppRegistry::instance().settingsManager()->save();
+    }
+    
     void saveAutoExec(bool isAutoExec)
     {
         Robomongo::AppRegistry::instance().settingsManager()->setAutoExec(isAutoExec);
@@ -419,6 +425,12 @@ namespace Robomongo
         VERIFY(connect(autoExpand, SIGNAL(triggered()), this, SLOT(toggleAutoExpand())));
         optionsMenu->addAction(autoExpand);
 
+        QAction *flattenTableColumns = new QAction("Flatten Subdocuments In Table Mode", this);
+        flattenTableColumns->setCheckable(true);
+        flattenTableColumns->setChecked(AppRegistry::instance().settingsManager()->flattenTableColumns());
+        VERIFY(connect(flattenTableColumns, SIGNAL(triggered()), this, SLOT(toggleFlattenTableColumns())));
+        optionsMenu->addAction(flattenTableColumns);
+
         QAction *showLineNumbers = new QAction("Show Line Numbers By Default", this);
         showLineNumbers->setCheckable(true);
         showLineNumbers->setChecked(AppRegistry::instance().settingsManager()->lineNumbers());
@@ -946,6 +958,18 @@ namespace Robomongo
         saveAutoExpand(send->isChecked());
     }
     
+    void MainWindow::toggleFlattenTableColumns()
+    {
+        QAction *send = qobject_cast<QAction*>(sender());
+        saveFlattenTableColumns(send->isChecked());
+
+        // Tables of all open tabs follow the setting, not only new results
+        for (int index = 0; index < _workArea->count(); ++index) {
+            if (QueryWidget *widget = _workArea->queryWidget(index))
+                widget->applyTableColumnsSettings();
+        }
+    }
+    
     void MainWindow::toggleAutoExec()
     {
         QAction *send = qobject_cast<QAction*>(sender());
@@ -48,6 +48,7 @@ namespace Robomongo
         void enterTableMode();
         void enterCustomMode();
         void toggleAutoExpand();
+        void toggleFlattenTableColumns();
         void toggleAutoExec();
         void toggleLineNumbers();
         void executeScript();
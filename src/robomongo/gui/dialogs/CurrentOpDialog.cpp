@@ -0,0 +1,273 @@
+#include "robomongo/gui/dialogs/CurrentOpDialog.h"
+
+#include <QCheckBox>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QTimer>
+#include <QToolButton>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+#include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/EventBus.h"
+#include "robomongo/core/domain/MongoServer.h"
+#include "robomongo/core/events/MongoEvents.h"
+#include "robomongo/core/utils/QtUtils.h"
+
+namespace
+{
+    const int defaultIntervalSec = 2;
+
+    // Property of kill buttons with id of their operation
+    const char *const operationIdProperty = "operationId";
+
+    QString stateName(Robomongo::CurrentOperation::State state)
+    {
+        switch (state) {
+        case Robomongo::CurrentOperation::New: return "New";
+        case Robomongo::CurrentOperation::Running: return "Running";
+        case Robomongo::CurrentOperation::Finished: return "Finished";
+        }
+        return QString();
+    }
+}
+
+namespace Robomongo
+{
+    CurrentOpDialog::CurrentOpDialog(MongoServer *server, const std::string &database, QWidget *parent) :
+        QDialog(parent),
+        _server(server),
+        _database(database),
+        _loading(false)
+    {
+        AppRegistry::instance().bus()->subscribe(this, CurrentOpResponse::Type, server);
+        AppRegistry::instance().bus()->subscribe(this, KillOpResponse::Type, server);
+
+        setWindowTitle(database.empty() ? QString("Current Operations")
+                                        : "Current Operations: " + QtUtils::toQString(database));
+        setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint); // Remove help button (?)
+        setAttribute(Qt::WA_DeleteOnClose);
+
+        _intervalSpinBox = new QSpinBox;
+        _intervalSpinBox->setRange(1, 60);
+        _intervalSpinBox->setValue(defaultIntervalSec);
+        _intervalSpinBox->setSuffix(" s");
+        VERIFY(connect(_intervalSpinBox, SIGNAL(valueChanged(int)), this, SLOT(intervalChanged(int))));
+
+        _pauseCheckBox = new QCheckBox("&Pause");
+        VERIFY(connect(_pauseCheckBox, SIGNAL(toggled(bool)), this, SLOT(pauseToggled(bool))));
+        _showFinishedCheckBox = new QCheckBox("Show &finished");
+        _showFinishedCheckBox->setChecked(true);
+        VERIFY(connect(_showFinishedCheckBox, SIGNAL(toggled(bool)), this, SLOT(showFinishedToggled(bool))));
+        QPushButton *refreshButton = new QPushButton("Re&fresh");
+        VERIFY(connect(refreshButton, SIGNAL(clicked()), this, SLOT(refresh())));
+
+        _refreshTimer = new QTimer(this);
+        _refreshTimer->setInterval(defaultIntervalSec * 1000);
+        VERIFY(connect(_refreshTimer, SIGNAL(timeout()), this, SLOT(refresh())));
+
+        QHBoxLayout *controlsLayout = new QHBoxLayout;
+        controlsLayout->addWidget(new QLabel("Sample every:"));
+        controlsLayout->addWidget(_intervalSpinBox);
+        controlsLayout->addWidget(_pauseCheckBox);
+        controlsLayout->addWidget(_showFinishedCheckBox);
+        controlsLayout->addStretch(1);
+        controlsLayout->addWidget(refreshButton);
+
+        _statusLabel = new QLabel;
+        _statusLabel->setWordWrap(true);
+        _statusLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+
+        _operationsTree = new QTreeWidget;
+        _operationsTree->setRootIsDecorated(false);
+        _operationsTree->setAlternatingRowColors(true);
+        _operationsTree->setSortingEnabled(true);
+        _operationsTree->setHeaderLabels(QStringList() << "Op Id" << "State" << "Elapsed, ms" << "Operation"
+                                                       << "Namespace" << "Client" << "Application" << "Plan"
+                                                       << "Details" << "");
+        _operationsTree->sortByColumn(ElapsedColumn, Qt::DescendingOrder);
+
+        QPushButton *closeButton = new QPushButton("&Close");
+        VERIFY(connect(closeButton, SIGNAL(clicked()), this, SLOT(accept())));
+        QHBoxLayout *buttons = new QHBoxLayout;
+        buttons->addStretch(1);
+        buttons->addWidget(closeButton);
+
+        QVBoxLayout *layout = new QVBoxLayout;
+        layout->addLayout(controlsLayout);
+        layout->addWidget(_statusLabel);
+        layout->addWidget(_operationsTree, 1);
+        layout->addLayout(buttons);
+        setLayout(layout);
+        resize(1100, 520);
+
+        refresh();
+        _refreshTimer->start();
+    }
+
+    void CurrentOpDialog::refresh()
+    {
+        // Tracker goes to worker and back, so only one sample is in flight
+        if (_loading)
+            return;
+
+        _loading = true;
+        _server->loadCurrentOps(_database, _tracker);
+    }
+
+    void CurrentOpDialog::intervalChanged(int seconds)
+    {
+        _refreshTimer->setInterval(seconds * 1000);
+    }
+
+    void CurrentOpDialog::pauseToggled(bool checked)
+    {
+        if (checked)
+            _refreshTimer->stop();
+        else
+            _refreshTimer->start();
+    }
+
+    void CurrentOpDialog::showFinishedToggled(bool)
+    {
+        showOperations();
+    }
+
+    void CurrentOpDialog::killClicked()
+    {
+        QToolButton *button = qobject_cast<QToolButton *>(sender());
+        if (!button)
+            return;
+
+        std::string const id = QtUtils::toStdString(button->property(operationIdProperty).toString());
+        for (auto const& operation : _tracker.operations()) {
+            if (operation.id == id && operation.state != CurrentOperation::Finished) {
+                button->setEnabled(false);
+                _server->killOp(operation.opid, id);
+                return;
+            }
+        }
+    }
+
+    void CurrentOpDialog::handle(CurrentOpResponse *event)
+    {
+        if (event->database() != _database)
+            return;
+
+        _loading = false;
+
+        if (event->isError()) {
+            _statusLabel->setText("Failed to read current operations: " +
+                                  QtUtils::toQString(event->error().errorMessage()).toHtmlEscaped());
+            return;
+        }
+
+        _tracker = event->tracker();
+        showOperations();
+    }
+
+    void CurrentOpDialog::handle(KillOpResponse *event)
+    {
+        QString const id = QtUtils::toQString(event->id());
+        if (event->isError()) {
+            _statusLabel->setText("Failed to kill operation " + id + ": " +
+                                  QtUtils::toQString(event->error().errorMessage()).toHtmlEscaped());
+
+            std::map<std::string, QTreeWidgetItem *>::const_iterator const it = _items.find(event->id());
+            if (it != _items.end()) {
+                if (QWidget *button = _operationsTree->itemWidget(it->second, KillColumn))
+                    button->setEnabled(true);
+            }
+            return;
+        }
+
+        // Operation is shown as finished by the next sample
+        _statusLabel->setText("Operation " + id + " is killed.");
+        refresh();
+    }
+
+    void CurrentOpDialog::showOperations()
+    {
+        bool const showFinished = _showFinishedCheckBox->isChecked();
+        int running = 0, finished = 0;
+
+        _operationsTree->setSortingEnabled(false);
+
+        std::map<std::string, QTreeWidgetItem *> items;
+        for (auto const& operation : _tracker.operations()) {
+            if (operation.state == CurrentOperation::Finished) {
+                ++finished;
+                if (!showFinished)
+                    continue;
+            }
+            else {
+                ++running;
+            }
+
+            QTreeWidgetItem *item = nullptr;
+            std::map<std::string, QTreeWidgetItem *>::iterator const it = _items.find(operation.id);
+            if (it != _items.end()) {
+                item = it->second;
+                _items.erase(it);
+            }
+            else {
+                item = new QTreeWidgetItem;
+                _operationsTree->addTopLevelItem(item);
+
+                QToolButton *killButton = new QToolButton;
+                killButton->setText("Kill");
+                killButton->setAutoRaise(true);
+                killButton->setProperty(operationIdProperty, QtUtils::toQString(operation.id));
+                VERIFY(connect(killButton, SIGNAL(clicked()), this, SLOT(killClicked())));
+                _operationsTree->setItemWidget(item, KillColumn, killButton);
+            }
+
+            updateItem(item, operation);
+            items[operation.id] = item;
+        }
+
+        // Operations no longer tracked, or hidden finished ones
+        for (auto const& it : _items)
+            delete it.second;
+        _items.swap(items);
+
+        _operationsTree->setSortingEnabled(true);
+
+        for (int column = OpIdColumn; column < DetailsColumn; ++column)
+            _operationsTree->resizeColumnToContents(column);
+
+        _statusLabel->setText(QString("%1 operations in progress, %2 finished in the last %3 seconds.")
+                              .arg(running).arg(finished).arg(_tracker.finishedRetentionMs() / 1000));
+    }
+
+    void CurrentOpDialog::updateItem(QTreeWidgetItem *item, const CurrentOperation &operation)
+    {
+        item->setText(OpIdColumn, QtUtils::toQString(operation.id));
+        item->setText(StateColumn, stateName(operation.state) + (operation.waitingForLock ? ", waiting for lock" : ""));
+        item->setData(ElapsedColumn, Qt::DisplayRole, static_cast<qlonglong>(operation.micros / 1000));
+        item->setTextAlignment(ElapsedColumn, Qt::AlignRight | Qt::AlignVCenter);
+        item->setText(OperationColumn, QtUtils::toQString(operation.op));
+        item->setText(NamespaceColumn, QtUtils::toQString(operation.ns));
+        item->setText(ClientColumn, QtUtils::toQString(operation.client));
+        item->setText(ApplicationColumn, QtUtils::toQString(operation.appName));
+        item->setText(PlanColumn, QtUtils::toQString(operation.planSummary));
+        item->setText(DetailsColumn, QtUtils::toQString(operation.details));
+        item->setToolTip(DetailsColumn, item->text(DetailsColumn));
+
+        QBrush const foreground = operation.state == CurrentOperation::New ? QBrush(Qt::darkGreen) :
+                                  operation.state == CurrentOperation::Finished ? QBrush(Qt::gray) : QBrush();
+        for (int column = OpIdColumn; column < KillColumn; ++column)
+            item->setForeground(column, foreground);
+
+        if (operation.planSummary.find("COLLSCAN") != std::string::npos)
+            item->setForeground(PlanColumn, Qt::red);
+
+        if (operation.state == CurrentOperation::Finished) {
+            if (QWidget *button = _operationsTree->itemWidget(item, KillColumn))
+                button->setEnabled(false);
+        }
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <map>
+
+#include <QDialog>
+
+#include "robomongo/core/domain/CurrentOpTracker.h"
+
+QT_BEGIN_NAMESPACE
+class QCheckBox;
+class QLabel;
+class QSpinBox;
+class QTimer;
+class QTreeWidget;
+class QTreeWidgetItem;
+QT_END_NAMESPACE
+
+namespace Robomongo
+{
+    class MongoServer;
+    class CurrentOpResponse;
+    class KillOpResponse;
+
+    /**
+     * @brief Operations in progress on server, sampled at fixed interval on a separate
+     * connection. Operations finished since previous samples stay visible for a while.
+     */
+    class CurrentOpDialog : public QDialog
+    {
+        Q_OBJECT
+
+    public:
+        /**
+         * @param database: operations of this database are shown, empty means all databases
+         */
+        CurrentOpDialog(MongoServer *server, const std::string &database, QWidget *parent = 0);
+
+    protected Q_SLOTS:
+        void handle(CurrentOpResponse *event);
+        void handle(KillOpResponse *event);
+        void refresh();
+        void intervalChanged(int seconds);
+        void pauseToggled(bool checked);
+        void showFinishedToggled(bool checked);
+        void killClicked();
+
+    private:
+        void showOperations();
+        void updateItem(QTreeWidgetItem *item, const CurrentOperation &operation);
+
+        enum Column
+        {
+            OpIdColumn,
+            StateColumn,
+            ElapsedColumn,
+            OperationColumn,
+            NamespaceColumn,
+            ClientColumn,
+            ApplicationColumn,
+            PlanColumn,
+            DetailsColumn,
+            KillColumn
+        };
+
+        MongoServer *_server;
+        std::string _database;
+        CurrentOpTracker _tracker;
+        bool _loading;
+
+        // Items of shown operations by opid, updated in place on every sample
+        std::map<std::string, QTreeWidgetItem *> _items;
+
+        QSpinBox *_intervalSpinBox;
+        QCheckBox *_pauseCheckBox;
+        QCheckBox *_showFinishedCheckBox;
+        QTimer *_refreshTimer;
+        QLabel *_statusLabel;
+        QTreeWidget *_operationsTree;
+    };
+}
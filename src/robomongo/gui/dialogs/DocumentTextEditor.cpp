@@ -7,10 +7,13 @@
 #include <QDialogButtonBox>
 #include <QDesktopWidget>
 #include <QSettings>
+#include <QTimer>
 #include <Qsci/qscilexerjavascript.h>
+#include <Qsci/qscistyle.h>
 
 #include <mongo/client/dbclient_base.h>
 
+#include "robomongo/gui/dialogs/JsonValidationThread.h"
 #include "robomongo/gui/editors/JSLexer.h"
 #include "robomongo/gui/editors/FindFrame.h"
 #include "robomongo/gui/editors/PlainJavaScriptEditor.h"
@@ -18,8 +21,12 @@
 #include "robomongo/gui/GuiRegistry.h"
 
 #include "robomongo/core/utils/QtUtils.h"
-#include "robomongo/shell/bson/json.h"
 
+namespace
+{
+    // Delay after the last keystroke, before text is validated
+    const int validationDelay = 300;
+}
 
 namespace Robomongo
 {
@@ -28,7 +35,12 @@ namespace Robomongo
     DocumentTextEditor::DocumentTextEditor(const CollectionInfo &info, const QString &json, bool readonly /* = false */, QWidget *parent) :
         QDialog(parent),
         _info(info),
-        _readonly(readonly)
+        _readonly(readonly),
+        _validationTimer(new QTimer(this)),
+        _validationThread(NULL),
+        _validationPending(false),
+        _textGeneration(0),
+        _validGeneration(-1)
     {
         QRect screenGeometry = QApplication::desktop()->availableGeometry();
         int horizontalMargin = (int)(screenGeometry.width() * 0.35);
@@ -64,6 +76,10 @@ namespace Robomongo
 
         VERIFY(connect(_queryText->sciScintilla(), SIGNAL(textChanged()), this, SLOT(onQueryTextChanged())));
 
+        _validationTimer->setSingleShot(true);
+        _validationTimer->setInterval(validationDelay);
+        VERIFY(connect(_validationTimer, SIGNAL(timeout()), this, SLOT(startValidation())));
+
         QHBoxLayout *hlayout = new QHBoxLayout();
         hlayout->setContentsMargins(2, 0, 5, 1);
         hlayout->setSpacing(0);
@@ -97,6 +113,20 @@ namespace Robomongo
             validate->hide();
             buttonBox->button(QDialogButtonBox::Save)->hide();
             _queryText->sciScintilla()->setReadOnly(true);
+        } else {
+            // Validate initial text in background, so that save doesn't wait for parsing
+            _validationTimer->start();
+        }
+    }
+
+    DocumentTextEditor::~DocumentTextEditor()
+    {
+        // Stopped threads return at the next object or array, and delete themselves
+        for (std::set<JsonValidationThread *>::const_iterator it = _validationThreads.begin(); it != _validationThreads.end(); ++it) {
+            (*it)->stop();
+        }
+        for (std::set<JsonValidationThread *>::const_iterator it = _validationThreads.begin(); it != _validationThreads.end(); ++it) {
+            (*it)->wait();
         }
     }
 
@@ -146,39 +176,28 @@ namespace Robomongo
 
     bool DocumentTextEditor::validate(bool silentOnSuccess /* = true */)
     {
-        QString text = jsonText();
-        int len = 0;
-        try {
-            std::string textString = QtUtils::toStdString(text);
-            const char *json = textString.c_str();
-            int jsonLen = textString.length();
+        // Text may be already validated in background
+        if (_validGeneration != _textGeneration) {
+            std::vector<mongo::BSONObj> documents;
             int offset = 0;
-            _obj.clear();
-            while (offset != jsonLen)
-            {
-                mongo::BSONObj doc = mongo::Robomongo::fromjson(json+offset, &len);
-                _obj.push_back(doc);
-                offset += len;
+            std::string reason;
+            if (!JsonValidationThread::parse(editorText(), documents, offset, reason)) {
+                int line = 0, pos = 0;
+                QString message = QtUtils::toQString(reason);
+                showValidationError(offset, message, line, pos);
+                _queryText->sciScintilla()->setCursorPosition(line, pos);
+
+                message = QString("Unable to parse JSON:<br /> <b>%1</b>, at (%2, %3).")
+                    .arg(message).arg(line + 1).arg(pos + 1);
+
+                QMessageBox::critical(NULL, "Parsing error", message);
+                _queryText->setFocus();
+                activateWindow();
+                return false;
             }
-        } catch (const mongo::Robomongo::ParseMsgAssertionException &ex) {
-//            v0.9
-            QString message = QtUtils::toQString(ex.reason());
-            int offset = ex.offset();
-
-            int line = 0, pos = 0;
-            _queryText->sciScintilla()->lineIndexFromPosition(offset, &line, &pos);
-            _queryText->sciScintilla()->setCursorPosition(line, pos);
-
-            int lineHeight = _queryText->sciScintilla()->lineLength(line);
-            _queryText->sciScintilla()->fillIndicatorRange(line, pos, line, lineHeight, 0);
-
-            message = QString("Unable to parse JSON:<br /> <b>%1</b>, at (%2, %3).")
-                .arg(message).arg(line + 1).arg(pos + 1);
 
-            QMessageBox::critical(NULL, "Parsing error", message);
-            _queryText->setFocus();
-            activateWindow();
-            return false;
+            _obj = documents;
+            _validGeneration = _textGeneration;
         }
 
         if (!silentOnSuccess) {
@@ -190,9 +209,84 @@ namespace Robomongo
         return true;
     }
 
+    std::string DocumentTextEditor::editorText() const
+    {
+        // Copy of editor buffer, without conversion to QString and back
+        RoboScintilla *editor = _queryText->sciScintilla();
+        int const length = editor->SendScintilla(QsciScintilla::SCI_GETLENGTH);
+        std::string text(length + 1, '\0');
+        editor->SendScintilla(QsciScintilla::SCI_GETTEXT, static_cast<unsigned long>(length + 1), &text[0]);
+        text.resize(length);
+        return text;
+    }
+
+    void DocumentTextEditor::showValidationError(int offset, const QString &message, int &line, int &index)
+    {
+        RoboScintilla *editor = _queryText->sciScintilla();
+        editor->lineIndexFromPosition(offset, &line, &index);
+
+        int lineLength = editor->lineLength(line);
+        editor->fillIndicatorRange(line, index, line, lineLength, 0);
+
+        static QsciStyle const errorStyle(-1, "Validation error", QColor(255, 210, 210), QColor(110, 40, 40),
+                                          GuiRegistry::instance().font());
+        editor->clearAnnotations();
+        editor->annotate(line, QString("%1^ %2").arg(QString(index, ' ')).arg(message), errorStyle);
+    }
+
     void DocumentTextEditor::onQueryTextChanged()
     {
         _queryText->sciScintilla()->clearIndicatorRange(0, 0, _queryText->sciScintilla()->lines(), 40, 0);
+
+        // Result of running validation is outdated, new one starts when user stops typing
+        ++_textGeneration;
+        if (_validationThread) {
+            _validationThread->stop();
+            _validationThread = NULL;
+        }
+
+        if (!_readonly)
+            _validationTimer->start();
+    }
+
+    void DocumentTextEditor::startValidation()
+    {
+        if (!_validationThreads.empty()) {
+            _validationPending = true;
+            return;
+        }
+
+        _validationThread = new JsonValidationThread(editorText(), _textGeneration);
+        _validationThreads.insert(_validationThread);
+        VERIFY(connect(_validationThread, SIGNAL(finished()), this, SLOT(validationFinished())));
+        VERIFY(connect(_validationThread, SIGNAL(finished()), _validationThread, SLOT(deleteLater())));
+        _validationThread->start();
+    }
+
+    void DocumentTextEditor::validationFinished()
+    {
+        JsonValidationThread *thread = static_cast<JsonValidationThread *>(sender());
+
+        _validationThreads.erase(thread);
+        if (_validationPending) {
+            _validationPending = false;
+            startValidation();
+        }
+
+        if (thread != _validationThread || thread->generation() != _textGeneration)
+            return;
+
+        _validationThread = NULL;
+
+        if (!thread->isValid()) {
+            int line = 0, index = 0;
+            showValidationError(thread->errorOffset(), QtUtils::toQString(thread->errorMessage()), line, index);
+            return;
+        }
+
+        _queryText->sciScintilla()->clearAnnotations();
+        _obj = thread->documents();
+        _validGeneration = thread->generation();
     }
 
     void DocumentTextEditor::onValidateButtonClicked()
@@ -221,6 +315,7 @@ namespace Robomongo
         _queryText->sciScintilla()->setWrapMode((QsciScintilla::WrapMode)QsciScintilla::SC_WRAP_WORD);
         _queryText->sciScintilla()->setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
         _queryText->sciScintilla()->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+        _queryText->sciScintilla()->setAnnotationDisplay(QsciScintilla::AnnotationBoxed);
 
         _queryText->sciScintilla()->setStyleSheet("QFrame { background-color: rgb(73, 76, 78); border: 1px solid #c7c5c4; border-radius: 4px; margin: 0px; padding: 0px;}");
     }
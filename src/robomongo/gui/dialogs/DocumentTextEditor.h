@@ -1,12 +1,19 @@
 #pragma once
 
 #include <QDialog>
+#include <set>
+#include <string>
 #include <mongo/bson/bsonobj.h>
 #include "robomongo/core/domain/MongoQueryInfo.h"
 
+QT_BEGIN_NAMESPACE
+class QTimer;
+QT_END_NAMESPACE
+
 namespace Robomongo
 {
     class FindFrame;
+    class JsonValidationThread;
 
     class DocumentTextEditor : public QDialog
     {
@@ -17,6 +24,7 @@ namespace Robomongo
         static const QSize minimumSize;
 
         explicit DocumentTextEditor(const CollectionInfo &info, const QString &json, bool readonly = false, QWidget *parent = 0);
+        ~DocumentTextEditor();
 
         QString jsonText() const;
 
@@ -35,6 +43,8 @@ namespace Robomongo
     private Q_SLOTS:
         void onQueryTextChanged();
         void onValidateButtonClicked();
+        void startValidation();
+        void validationFinished();
 
     protected:
         /**
@@ -45,6 +55,17 @@ namespace Robomongo
     private:
         void _configureQueryText();
 
+        /**
+        * @brief UTF-8 text of the editor, as is (positions in it are editor positions)
+        */
+        std::string editorText() const;
+
+        /**
+        * @brief Highlights the error and shows its message below the line
+        * @return line and index of the error
+        */
+        void showValidationError(int offset, const QString &message, int &line, int &index);
+
         /**
         * @brief Restore window settings from system registry
         */
@@ -59,6 +80,19 @@ namespace Robomongo
         FindFrame *_queryText;
         bool _readonly;
         ReturnType _obj;
+
+        // Text is validated in background, after user stops typing
+        QTimer *_validationTimer;
+        JsonValidationThread *_validationThread;
+
+        // Threads that are still running, including stopped ones. Only one thread parses
+        // at a time: validation of the latest text waits for the stopped one to finish
+        std::set<JsonValidationThread *> _validationThreads;
+        bool _validationPending;
+
+        // Version of the text (incremented on every change), and version of valid text in _obj
+        int _textGeneration;
+        int _validGeneration;
     };
 }
 
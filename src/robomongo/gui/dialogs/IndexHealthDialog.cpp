@@ -0,0 +1,166 @@
+#include "robomongo/gui/dialogs/IndexHealthDialog.h"
+
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QPushButton>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+#include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/EventBus.h"
+#include "robomongo/core/domain/IndexHealth.h"
+#include "robomongo/core/domain/MongoServer.h"
+#include "robomongo/core/domain/MongoUtils.h"
+#include "robomongo/core/events/MongoEvents.h"
+#include "robomongo/core/settings/SettingsManager.h"
+#include "robomongo/core/utils/DateUtils.h"
+#include "robomongo/core/utils/QtUtils.h"
+
+namespace
+{
+    QTreeWidget *createTree(const QStringList &labels)
+    {
+        QTreeWidget *tree = new QTreeWidget;
+        tree->setRootIsDecorated(false);
+        tree->setAlternatingRowColors(true);
+        tree->setHeaderLabels(labels);
+        tree->header()->setStretchLastSection(true);
+        return tree;
+    }
+
+    void resizeColumns(QTreeWidget *tree)
+    {
+        for (int column = 0; column < tree->columnCount() - 1; ++column)
+            tree->resizeColumnToContents(column);
+    }
+}
+
+namespace Robomongo
+{
+    IndexHealthDialog::IndexHealthDialog(MongoServer *server, const MongoCollectionInfo &collection, 
+                                         QWidget *parent) :
+        QDialog(parent),
+        _server(server),
+        _collection(collection)
+    {
+        AppRegistry::instance().bus()->subscribe(this, IndexHealthLoadedEvent::Type, server);
+
+        setWindowTitle("Index Health: " + QtUtils::toQString(collection.ns().toString()));
+        setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint); // Remove help button (?)
+        setAttribute(Qt::WA_DeleteOnClose);
+
+        _statusLabel = new QLabel;
+        _statusLabel->setWordWrap(true);
+        _statusLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+
+        _indexesTree = createTree(QStringList() << "Name" << "Key" << "Accesses" << "Since" 
+                                                << "Size" << "Status");
+        _suggestionsTree = createTree(QStringList() << "Suggested Key" << "Queries" << "Docs Examined" 
+                                                    << "Time, ms" << "Query Shape" << "Command");
+
+        _refreshButton = new QPushButton("&Refresh");
+        VERIFY(connect(_refreshButton, SIGNAL(clicked()), this, SLOT(refresh())));
+        QPushButton *closeButton = new QPushButton("&Close");
+        VERIFY(connect(closeButton, SIGNAL(clicked()), this, SLOT(accept())));
+
+        QHBoxLayout *buttons = new QHBoxLayout;
+        buttons->addStretch(1);
+        buttons->addWidget(_refreshButton);
+        buttons->addWidget(closeButton);
+
+        QVBoxLayout *layout = new QVBoxLayout;
+        layout->addWidget(_statusLabel);
+        layout->addWidget(new QLabel("<b>Indexes</b>"));
+        layout->addWidget(_indexesTree, 1);
+        layout->addWidget(new QLabel("<b>Suggested Indexes</b>"));
+        layout->addWidget(_suggestionsTree, 1);
+        layout->addLayout(buttons);
+        setLayout(layout);
+        resize(860, 520);
+
+        refresh();
+    }
+
+    void IndexHealthDialog::refresh()
+    {
+        _refreshButton->setEnabled(false);
+        _statusLabel->setText("Loading index statistics and profiled queries...");
+        _indexesTree->clear();
+        _suggestionsTree->clear();
+        _server->loadIndexHealth(_collection);
+    }
+
+    void IndexHealthDialog::handle(IndexHealthLoadedEvent *event)
+    {
+        if (event->ns() != _collection.ns().toString())
+            return;
+
+        _refreshButton->setEnabled(true);
+
+        if (event->isError()) {
+            _statusLabel->setText("Failed to load index health: " + 
+                                  QtUtils::toQString(event->error().errorMessage()).toHtmlEscaped());
+            return;
+        }
+
+        showHealth(event->health());
+    }
+
+    void IndexHealthDialog::showHealth(const IndexHealth &health)
+    {
+        QStringList status;
+        status << QString("%1 profiled slow queries analyzed.").arg(health.slowQueries);
+        for (auto const& note : health.notes)
+            status << QtUtils::toQString(note).toHtmlEscaped();
+        _statusLabel->setText(status.join("<br>"));
+
+        bool const isLocalTime = AppRegistry::instance().settingsManager()->timeZone() == LocalTime;
+
+        for (auto const& index : health.indexes) {
+            QTreeWidgetItem *item = new QTreeWidgetItem;
+            item->setText(NameColumn, QtUtils::toQString(index.name));
+            item->setText(KeyColumn, QtUtils::toQString(index.key.toString()));
+            if (index.accesses >= 0)
+                item->setText(AccessesColumn, QString::number(index.accesses));
+            if (index.since > 0)
+                item->setText(SinceColumn, QtUtils::toQString(DateUtils::isoDateString(index.since, false, isLocalTime)));
+            if (index.sizeBytes >= 0)
+                item->setText(SizeColumn, MongoUtils::buildNiceSizeString(index.sizeBytes));
+            item->setTextAlignment(AccessesColumn, Qt::AlignRight | Qt::AlignVCenter);
+            item->setTextAlignment(SizeColumn, Qt::AlignRight | Qt::AlignVCenter);
+
+            QStringList problems;
+            if (index.unused)
+                problems << "unused since counting started";
+            if (!index.redundantWith.empty())
+                problems << "redundant, prefix of " + QtUtils::toQString(index.redundantWith);
+            if (!problems.isEmpty()) {
+                item->setText(StatusColumn, problems.join("; "));
+                item->setForeground(StatusColumn, Qt::red);
+            }
+
+            _indexesTree->addTopLevelItem(item);
+        }
+
+        std::string const collection = _collection.ns().collectionName();
+        for (auto const& suggestion : health.suggestions) {
+            std::string const key = suggestion.key.toString();
+
+            QTreeWidgetItem *item = new QTreeWidgetItem;
+            item->setText(SuggestedKeyColumn, QtUtils::toQString(key));
+            item->setText(QueriesColumn, QString::number(suggestion.queries));
+            item->setText(DocsExaminedColumn, QString::number(suggestion.docsExamined));
+            item->setText(TimeColumn, QString::number(suggestion.millis));
+            item->setText(ShapeColumn, QtUtils::toQString(suggestion.shape));
+            item->setText(CommandColumn, QtUtils::toQString("db.getCollection('" + collection + "').createIndex(" + key + ")"));
+            for (int column = QueriesColumn; column <= TimeColumn; ++column)
+                item->setTextAlignment(column, Qt::AlignRight | Qt::AlignVCenter);
+
+            _suggestionsTree->addTopLevelItem(item);
+        }
+
+        resizeColumns(_indexesTree);
+        resizeColumns(_suggestionsTree);
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <QDialog>
+
+#include "robomongo/core/domain/MongoCollectionInfo.h"
+
+QT_BEGIN_NAMESPACE
+class QLabel;
+class QPushButton;
+class QTreeWidget;
+QT_END_NAMESPACE
+
+namespace Robomongo
+{
+    class MongoServer;
+    class IndexHealthLoadedEvent;
+    struct IndexHealth;
+
+    /**
+     * @brief Shows usage and size of collection indexes, unused and redundant ones,
+     * and compound indexes for slow queries recorded by database profiler.
+     * Loading starts when dialog is created.
+     */
+    class IndexHealthDialog : public QDialog
+    {
+        Q_OBJECT
+
+    public:
+        IndexHealthDialog(MongoServer *server, const MongoCollectionInfo &collection, QWidget *parent = 0);
+
+    protected Q_SLOTS:
+        void handle(IndexHealthLoadedEvent *event);
+        void refresh();
+
+    private:
+        void showHealth(const IndexHealth &health);
+
+        enum IndexColumn
+        {
+            NameColumn,
+            KeyColumn,
+            AccessesColumn,
+            SinceColumn,
+            SizeColumn,
+            StatusColumn
+        };
+
+        enum SuggestionColumn
+        {
+            SuggestedKeyColumn,
+            QueriesColumn,
+            DocsExaminedColumn,
+            TimeColumn,
+            ShapeColumn,
+            CommandColumn
+        };
+
+        MongoServer *_server;
+        MongoCollectionInfo _collection;
+
+        QLabel *_statusLabel;
+        QTreeWidget *_indexesTree;
+        QTreeWidget *_suggestionsTree;
+        QPushButton *_refreshButton;
+    };
+}
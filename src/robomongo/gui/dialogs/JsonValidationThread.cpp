@@ -0,0 +1,77 @@
+#include "robomongo/gui/dialogs/JsonValidationThread.h"
+
+#include "robomongo/shell/bson/json.h"
+
+namespace
+{
+    inline bool isWhitespace(char c)
+    {
+        return c == ' ' || (c >= '\t' && c <= '\r');
+    }
+}
+
+namespace Robomongo
+{
+    JsonValidationThread::JsonValidationThread(const std::string &json, int generation)
+        :_json(json),
+        _generation(generation),
+        _valid(false),
+        _errorOffset(0),
+        _stop(false)
+    {
+    }
+
+    void JsonValidationThread::stop()
+    {
+        _stop = true;
+    }
+
+    void JsonValidationThread::run()
+    {
+        _valid = parse(_json, _documents, _errorOffset, _errorMessage, &_stop);
+    }
+
+    bool JsonValidationThread::parse(const std::string &json, std::vector<mongo::BSONObj> &documents,
+                                     int &errorOffset, std::string &errorMessage, const std::atomic<bool> *stop)
+    {
+        documents.clear();
+
+        size_t begin = 0, end = json.size();
+        while (begin < end && isWhitespace(json[begin]))
+            ++begin;
+        while (end > begin && isWhitespace(json[end - 1]))
+            --end;
+
+        // Parser needs null-terminated text without trailing whitespace
+        std::string const text = json.substr(begin, end - begin);
+        int const length = static_cast<int>(text.size());
+        int offset = 0;
+
+        try {
+            while (offset != length) {
+                int len = 0;
+                documents.push_back(mongo::Robomongo::fromjson(text.c_str() + offset, &len, stop));
+                offset += len;
+            }
+        } catch (const mongo::Robomongo::ParseCancelledException &ex) {
+            errorOffset = begin + offset + ex.offset();
+            errorMessage.clear();
+            documents.clear();
+            return false;
+        } catch (const mongo::Robomongo::ParseMsgAssertionException &ex) {
+            // Offset of exception is relative to the document being parsed
+            errorOffset = begin + offset + ex.offset();
+            errorMessage = ex.reason();
+            documents.clear();
+            return false;
+        } catch (const std::exception &ex) {
+            // I.e. document exceeds maximum BSON size
+            errorOffset = begin + offset;
+            errorMessage = ex.what();
+            documents.clear();
+            return false;
+        }
+
+        return true;
+    }
+}
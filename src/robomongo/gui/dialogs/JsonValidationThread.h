@@ -0,0 +1,62 @@
+#pragma once
+
+#include <QThread>
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <mongo/bson/bsonobj.h>
+
+namespace Robomongo
+{
+    /*
+    ** In this thread we are parsing text of document editor, in order to
+    ** validate it while user types. Whole text is parsed every time. Thread
+    ** can be stopped at any object or array, results of stopped thread
+    ** should be ignored.
+    */
+    class JsonValidationThread : public QThread
+    {
+        Q_OBJECT
+
+    public:
+        /*
+        ** Constructor. "generation" identifies version of the text, which is validated
+        */
+        JsonValidationThread(const std::string &json, int generation);
+        void stop();
+
+        int generation() const { return _generation; }
+
+        /**
+         * @brief Results, available after thread is finished
+         */
+        bool isValid() const { return _valid; }
+        int errorOffset() const { return _errorOffset; }
+        const std::string &errorMessage() const { return _errorMessage; }
+        const std::vector<mongo::BSONObj> &documents() const { return _documents; }
+
+        /**
+         * @brief Parses all documents of the text (leading and trailing whitespace is ignored).
+         * @return true if text is valid. Otherwise, "errorOffset" is byte offset of the error
+         * in "json" and "errorMessage" is its reason (empty if parsing was stopped).
+         */
+        static bool parse(const std::string &json, std::vector<mongo::BSONObj> &documents,
+                          int &errorOffset, std::string &errorMessage, const std::atomic<bool> *stop = NULL);
+
+    protected:
+
+        /*
+        ** Overload function
+        */
+        virtual void run();
+    private:
+        const std::string _json;
+        const int _generation;
+        std::vector<mongo::BSONObj> _documents;
+        bool _valid;
+        int _errorOffset;
+        std::string _errorMessage;
+        std::atomic<bool> _stop;
+    };
+}
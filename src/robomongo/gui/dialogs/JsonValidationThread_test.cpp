@@ -0,0 +1,83 @@
+#include "gtest/gtest.h"
+#include "robomongo/gui/dialogs/JsonValidationThread.h"
+
+#include <atomic>
+
+#include "robomongo/shell/bson/json.h"
+
+using namespace Robomongo;
+
+namespace
+{
+    // Offset of the error reported by parser for the document alone
+    int documentErrorOffset(const std::string &document)
+    {
+        try {
+            mongo::Robomongo::fromjson(document);
+        } catch (const mongo::Robomongo::ParseMsgAssertionException &ex) {
+            return ex.offset();
+        }
+        return -1;
+    }
+}
+
+TEST(JsonValidationThreadTests, parse_DocumentsWithWhitespace_AllParsed)
+{
+    std::vector<mongo::BSONObj> documents;
+    int errorOffset = -1;
+    std::string errorMessage;
+
+    ASSERT_TRUE(JsonValidationThread::parse("\n  { a: 1 }\n\n{ b: 'x' } { c: [ 1, 2 ] }\t\n",
+                                            documents, errorOffset, errorMessage));
+    ASSERT_EQ(3u, documents.size());
+    EXPECT_EQ(1, documents[0].getIntField("a"));
+    EXPECT_EQ("x", std::string(documents[1].getStringField("b")));
+    EXPECT_TRUE(documents[2].hasField("c"));
+}
+
+TEST(JsonValidationThreadTests, parse_ErrorInFirstDocument_OffsetIncludesLeadingWhitespace)
+{
+    std::string const invalid = "{ a: 1, b: }";
+    int const expected = documentErrorOffset(invalid);
+    ASSERT_TRUE(expected >= 0);
+
+    std::string const json = "\n\n   " + invalid + "\n";
+    std::vector<mongo::BSONObj> documents;
+    int errorOffset = -1;
+    std::string errorMessage;
+
+    EXPECT_FALSE(JsonValidationThread::parse(json, documents, errorOffset, errorMessage));
+    EXPECT_EQ(5 + expected, errorOffset);
+    EXPECT_FALSE(errorMessage.empty());
+    EXPECT_TRUE(documents.empty());
+}
+
+TEST(JsonValidationThreadTests, parse_ErrorInLaterDocument_OffsetIsInWholeText)
+{
+    std::string const invalid = "{ c: [ 1, 2 }";
+    int const expected = documentErrorOffset(invalid);
+    ASSERT_TRUE(expected >= 0);
+
+    std::string const json = "  { a: 1 }\n{ b: { x: 'text' } }\n" + invalid + "\n{ d: 1 }";
+    std::vector<mongo::BSONObj> documents;
+    int errorOffset = -1;
+    std::string errorMessage;
+
+    EXPECT_FALSE(JsonValidationThread::parse(json, documents, errorOffset, errorMessage));
+    EXPECT_EQ(static_cast<int>(json.find(invalid)) + expected, errorOffset);
+    EXPECT_FALSE(errorMessage.empty());
+    EXPECT_TRUE(documents.empty());
+}
+
+TEST(JsonValidationThreadTests, parse_Stopped_FailsWithoutMessage)
+{
+    std::atomic<bool> const stop(true);
+    std::vector<mongo::BSONObj> documents;
+    int errorOffset = -1;
+    std::string errorMessage = "previous";
+
+    EXPECT_FALSE(JsonValidationThread::parse("  { a: 1 }", documents, errorOffset, errorMessage, &stop));
+    EXPECT_EQ(2, errorOffset);
+    EXPECT_TRUE(errorMessage.empty());
+    EXPECT_TRUE(documents.empty());
+}
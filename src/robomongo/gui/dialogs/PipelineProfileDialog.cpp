@@ -0,0 +1,150 @@
+#include "robomongo/gui/dialogs/PipelineProfileDialog.h"
+
+#include <algorithm>
+
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QPushButton>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+#include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/EventBus.h"
+#include "robomongo/core/domain/MongoShell.h"
+#include "robomongo/core/domain/MongoUtils.h"
+#include "robomongo/core/domain/PipelineProfile.h"
+#include "robomongo/core/events/MongoEvents.h"
+#include "robomongo/core/utils/QtUtils.h"
+
+namespace
+{
+    QString numberText(long long value)
+    {
+        return value < 0 ? QString() : QString::number(value);
+    }
+}
+
+namespace Robomongo
+{
+    PipelineProfileDialog::PipelineProfileDialog(MongoShell *shell, const AggrInfo &aggrInfo, 
+                                                 int resultIndex, QWidget *parent) :
+        QDialog(parent),
+        _shell(shell),
+        _aggrInfo(aggrInfo),
+        _resultIndex(resultIndex)
+    {
+        AppRegistry::instance().bus()->subscribe(this, PipelineProfiledEvent::Type, shell);
+
+        setWindowTitle("Profile Pipeline: " + QtUtils::toQString(aggrInfo.collectionName));
+        setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint); // Remove help button (?)
+        setAttribute(Qt::WA_DeleteOnClose);
+
+        _statusLabel = new QLabel;
+        _statusLabel->setWordWrap(true);
+        _statusLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+
+        _stagesTree = new QTreeWidget;
+        _stagesTree->setRootIsDecorated(false);
+        _stagesTree->setAlternatingRowColors(true);
+        _stagesTree->setHeaderLabels(QStringList() << "Stage" << "Time, ms" << "Share" << "Docs In" 
+                                                   << "Docs Out" << "Memory" << "Disk" << "Details");
+        _stagesTree->header()->setStretchLastSection(true);
+
+        _profileButton = new QPushButton("Profile &Again");
+        VERIFY(connect(_profileButton, SIGNAL(clicked()), this, SLOT(profile())));
+        QPushButton *closeButton = new QPushButton("&Close");
+        VERIFY(connect(closeButton, SIGNAL(clicked()), this, SLOT(accept())));
+
+        QHBoxLayout *buttons = new QHBoxLayout;
+        buttons->addStretch(1);
+        buttons->addWidget(_profileButton);
+        buttons->addWidget(closeButton);
+
+        QVBoxLayout *layout = new QVBoxLayout;
+        layout->addWidget(_statusLabel);
+        layout->addWidget(_stagesTree, 1);
+        layout->addLayout(buttons);
+        setLayout(layout);
+        resize(820, 360);
+
+        profile();
+    }
+
+    void PipelineProfileDialog::profile()
+    {
+        _profileButton->setEnabled(false);
+        _statusLabel->setText("Profiling pipeline...");
+        _stagesTree->clear();
+        _shell->profilePipeline(_resultIndex, _aggrInfo);
+    }
+
+    void PipelineProfileDialog::handle(PipelineProfiledEvent *event)
+    {
+        if (event->resultIndex() != _resultIndex)
+            return;
+
+        _profileButton->setEnabled(true);
+
+        if (event->isError()) {
+            _statusLabel->setText("Failed to profile pipeline: " + 
+                                  QtUtils::toQString(event->error().errorMessage()));
+            return;
+        }
+
+        showProfile(event->profile());
+    }
+
+    void PipelineProfileDialog::showProfile(const PipelineProfile &profile)
+    {
+        QStringList status;
+        if (!profile.planSummary.empty())
+            status << "Query engine: <b>" + QtUtils::toQString(profile.planSummary).toHtmlEscaped() + "</b>";
+        if (profile.sampleSize > 0)
+            status << QString("Server does not report statistics of every stage, so prefixes of pipeline "
+                              "were run on a sample of %1 documents. Numbers are estimates.").arg(profile.sampleSize);
+        if (!profile.note.empty())
+            status << QtUtils::toQString(profile.note).toHtmlEscaped();
+        _statusLabel->setText(status.join("<br>"));
+
+        long long total = 0;
+        long long slowest = -1;
+        for (auto const& stage : profile.stages) {
+            total += std::max(stage.timeMillis, 0LL);
+            slowest = std::max(slowest, stage.timeMillis);
+        }
+
+        for (auto const& stage : profile.stages) {
+            QTreeWidgetItem *item = new QTreeWidgetItem;
+            item->setText(StageColumn, QtUtils::toQString(stage.name));
+            item->setText(TimeColumn, numberText(stage.timeMillis));
+            if (total > 0 && stage.timeMillis >= 0)
+                item->setText(ShareColumn, QString("%1%").arg(100.0 * stage.timeMillis / total, 0, 'f', 1));
+            item->setText(DocsInColumn, numberText(stage.docsIn));
+            item->setText(DocsOutColumn, numberText(stage.docsOut));
+            if (stage.memoryBytes >= 0)
+                item->setText(MemoryColumn, MongoUtils::buildNiceSizeString(stage.memoryBytes));
+            if (stage.spilled) {
+                item->setText(DiskColumn, "spilled");
+                item->setForeground(DiskColumn, Qt::red);
+            }
+            item->setText(DetailsColumn, QtUtils::toQString(stage.details));
+
+            for (int column = TimeColumn; column <= MemoryColumn; ++column)
+                item->setTextAlignment(column, Qt::AlignRight | Qt::AlignVCenter);
+
+            // The most expensive stage stands out
+            if (slowest > 0 && stage.timeMillis == slowest) {
+                QFont font = item->font(StageColumn);
+                font.setBold(true);
+                for (int column = StageColumn; column <= DetailsColumn; ++column)
+                    item->setFont(column, font);
+            }
+
+            _stagesTree->addTopLevelItem(item);
+        }
+
+        for (int column = StageColumn; column < DetailsColumn; ++column)
+            _stagesTree->resizeColumnToContents(column);
+    }
+}
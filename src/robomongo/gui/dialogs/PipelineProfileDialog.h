@@ -0,0 +1,57 @@
+#pragma once
+
+#include <QDialog>
+
+#include "robomongo/core/domain/MongoAggregateInfo.h"
+
+QT_BEGIN_NAMESPACE
+class QLabel;
+class QPushButton;
+class QTreeWidget;
+QT_END_NAMESPACE
+
+namespace Robomongo
+{
+    class MongoShell;
+    class PipelineProfiledEvent;
+    struct PipelineProfile;
+
+    /**
+     * @brief Shows time, documents in and out, memory and disk use of every stage
+     * of aggregation pipeline. Profiling starts when dialog is created.
+     */
+    class PipelineProfileDialog : public QDialog
+    {
+        Q_OBJECT
+
+    public:
+        PipelineProfileDialog(MongoShell *shell, const AggrInfo &aggrInfo, int resultIndex, QWidget *parent = 0);
+
+    protected Q_SLOTS:
+        void handle(PipelineProfiledEvent *event);
+        void profile();
+
+    private:
+        void showProfile(const PipelineProfile &profile);
+
+        enum Column
+        {
+            StageColumn,
+            TimeColumn,
+            ShareColumn,
+            DocsInColumn,
+            DocsOutColumn,
+            MemoryColumn,
+            DiskColumn,
+            DetailsColumn
+        };
+
+        MongoShell *_shell;
+        AggrInfo _aggrInfo;
+        int _resultIndex;
+
+        QLabel *_statusLabel;
+        QTreeWidget *_stagesTree;
+        QPushButton *_profileButton;
+    };
+}
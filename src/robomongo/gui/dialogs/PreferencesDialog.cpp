@@ -7,10 +7,12 @@
 #include <QComboBox>
 #include <QPushButton>
 #include <QCheckBox>
+#include <QSpinBox>
 
 #include "robomongo/gui/GuiRegistry.h"
 #include "robomongo/gui/AppStyle.h"
 #include "robomongo/gui/utils/ComboBoxUtils.h"
+#include "robomongo/gui/widgets/workarea/ResultMemoryManager.h"
 #include "robomongo/core/utils/QtUtils.h"
 #include "robomongo/core/AppRegistry.h"
 #include "robomongo/core/settings/SettingsManager.h"
@@ -81,6 +83,18 @@ namespace Robomongo
         stylesLayout->addWidget(_stylesComboBox);
         layout->addLayout(stylesLayout);   
 
+        QHBoxLayout *resultMemoryLayout = new QHBoxLayout(this);
+        QLabel *resultMemoryLabel = new QLabel("Memory for results of all tabs:");
+        resultMemoryLabel->setToolTip("When exceeded, hidden results are compacted and restored when shown again");
+        resultMemoryLayout->addWidget(resultMemoryLabel);
+        _resultMemoryBudgetSpinBox = new QSpinBox();
+        _resultMemoryBudgetSpinBox->setRange(0, 1024 * 1024);
+        _resultMemoryBudgetSpinBox->setSingleStep(256);
+        _resultMemoryBudgetSpinBox->setSuffix(" MB");
+        _resultMemoryBudgetSpinBox->setSpecialValueText("Unlimited");
+        resultMemoryLayout->addWidget(_resultMemoryBudgetSpinBox);
+        layout->addLayout(resultMemoryLayout);
+
         QDialogButtonBox *buttonBox = new QDialogButtonBox(this);
         buttonBox->setOrientation(Qt::Horizontal);
         buttonBox->setStandardButtons(QDialogButtonBox::Cancel | QDialogButtonBox::Save);
@@ -101,6 +115,7 @@ namespace Robomongo
         _loadMongoRcJsCheckBox->setChecked(AppRegistry::instance().settingsManager()->loadMongoRcJs());
         _disabelConnectionShortcutsCheckBox->setChecked(AppRegistry::instance().settingsManager()->disableConnectionShortcuts());
         utils::setCurrentText(_stylesComboBox, Robomongo::AppRegistry::instance().settingsManager()->currentStyle());
+        _resultMemoryBudgetSpinBox->setValue(AppRegistry::instance().settingsManager()->resultMemoryBudgetMb());
     }
 
     void PreferencesDialog::accept()
@@ -118,6 +133,12 @@ namespace Robomongo
         AppRegistry::instance().settingsManager()->setDisableConnectionShortcuts(_disabelConnectionShortcutsCheckBox->isChecked());
         Robomongo::AppRegistry::instance().settingsManager()->setCurrentStyle(_stylesComboBox->currentText());
         AppStyleUtils::applyStyle(_stylesComboBox->currentText());
+
+        int const budgetMb = _resultMemoryBudgetSpinBox->value();
+        AppRegistry::instance().settingsManager()->setResultMemoryBudgetMb(budgetMb);
+        ResultMemoryManager::instance().setBudget(static_cast<size_t>(budgetMb) * 1024 * 1024);
+        ResultMemoryManager::instance().enforceBudget();
+
         Robomongo::AppRegistry::instance().settingsManager()->save();
 
         return BaseClass::accept();
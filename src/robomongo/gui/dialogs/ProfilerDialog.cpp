@@ -0,0 +1,221 @@
+#include "robomongo/gui/dialogs/ProfilerDialog.h"
+
+#include <QCheckBox>
+#include <QComboBox>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QTimer>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+#include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/EventBus.h"
+#include "robomongo/core/domain/MongoServer.h"
+#include "robomongo/core/events/MongoEvents.h"
+#include "robomongo/core/utils/QtUtils.h"
+
+namespace
+{
+    // Interval of reading new operations, when auto refresh is on
+    const int refreshIntervalMs = 5000;
+
+    QString average(long long total, int count)
+    {
+        return count > 0 ? QString::number(static_cast<double>(total) / count, 'f', 1) : QString();
+    }
+}
+
+namespace Robomongo
+{
+    ProfilerDialog::ProfilerDialog(MongoServer *server, const std::string &database, QWidget *parent) :
+        QDialog(parent),
+        _server(server),
+        _database(database),
+        _loading(false),
+        _clearPending(false)
+    {
+        AppRegistry::instance().bus()->subscribe(this, ProfilingLevelResponse::Type, server);
+        AppRegistry::instance().bus()->subscribe(this, LoadProfilerResponse::Type, server);
+
+        setWindowTitle("Profiler: " + QtUtils::toQString(database));
+        setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint); // Remove help button (?)
+        setAttribute(Qt::WA_DeleteOnClose);
+
+        _levelComboBox = new QComboBox;
+        _levelComboBox->addItems(QStringList() << "Off" << "Slow operations" << "All operations");
+        _slowMsSpinBox = new QSpinBox;
+        _slowMsSpinBox->setRange(0, 3600000);
+        _slowMsSpinBox->setValue(100);
+        _slowMsSpinBox->setSuffix(" ms");
+        _applyButton = new QPushButton("&Apply");
+        VERIFY(connect(_applyButton, SIGNAL(clicked()), this, SLOT(applyLevel())));
+
+        _autoRefreshCheckBox = new QCheckBox("Auto &refresh");
+        _autoRefreshCheckBox->setChecked(true);
+        VERIFY(connect(_autoRefreshCheckBox, SIGNAL(toggled(bool)), this, SLOT(autoRefreshToggled(bool))));
+        QPushButton *refreshButton = new QPushButton("Re&fresh");
+        VERIFY(connect(refreshButton, SIGNAL(clicked()), this, SLOT(refresh())));
+        QPushButton *clearButton = new QPushButton("C&lear");
+        VERIFY(connect(clearButton, SIGNAL(clicked()), this, SLOT(clear())));
+
+        _refreshTimer = new QTimer(this);
+        _refreshTimer->setInterval(refreshIntervalMs);
+        VERIFY(connect(_refreshTimer, SIGNAL(timeout()), this, SLOT(refresh())));
+
+        QHBoxLayout *levelLayout = new QHBoxLayout;
+        levelLayout->addWidget(new QLabel("Profiling:"));
+        levelLayout->addWidget(_levelComboBox);
+        levelLayout->addWidget(new QLabel("Slow operation threshold:"));
+        levelLayout->addWidget(_slowMsSpinBox);
+        levelLayout->addWidget(_applyButton);
+        levelLayout->addStretch(1);
+        levelLayout->addWidget(_autoRefreshCheckBox);
+        levelLayout->addWidget(refreshButton);
+        levelLayout->addWidget(clearButton);
+
+        _statusLabel = new QLabel;
+        _statusLabel->setWordWrap(true);
+        _statusLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+
+        _shapesTree = new QTreeWidget;
+        _shapesTree->setRootIsDecorated(false);
+        _shapesTree->setAlternatingRowColors(true);
+        _shapesTree->setSortingEnabled(true);
+        _shapesTree->setHeaderLabels(QStringList() << "Operation" << "Namespace" << "Count" << "p50, ms" 
+                                                   << "p95, ms" << "Max, ms" << "Total, ms" << "Docs Examined" 
+                                                   << "Returned" << "Plan" << "Query Shape");
+        _shapesTree->header()->setStretchLastSection(true);
+        _shapesTree->sortByColumn(TotalColumn, Qt::DescendingOrder);
+
+        QPushButton *closeButton = new QPushButton("&Close");
+        VERIFY(connect(closeButton, SIGNAL(clicked()), this, SLOT(accept())));
+        QHBoxLayout *buttons = new QHBoxLayout;
+        buttons->addStretch(1);
+        buttons->addWidget(closeButton);
+
+        QVBoxLayout *layout = new QVBoxLayout;
+        layout->addLayout(levelLayout);
+        layout->addWidget(_statusLabel);
+        layout->addWidget(_shapesTree, 1);
+        layout->addLayout(buttons);
+        setLayout(layout);
+        resize(1000, 520);
+
+        _server->setProfilingLevel(_database, -1, -1);
+        refresh();
+        _refreshTimer->start();
+    }
+
+    void ProfilerDialog::applyLevel()
+    {
+        _applyButton->setEnabled(false);
+        _server->setProfilingLevel(_database, _levelComboBox->currentIndex(), _slowMsSpinBox->value());
+    }
+
+    void ProfilerDialog::refresh()
+    {
+        // Window goes to worker and back, so only one read is in flight
+        if (_loading)
+            return;
+
+        _loading = true;
+        _server->loadProfiler(_database, _window);
+    }
+
+    void ProfilerDialog::clear()
+    {
+        _clearPending = _loading;
+        _window.clear();
+        showShapes(std::vector<QueryShapeStats>());
+    }
+
+    void ProfilerDialog::autoRefreshToggled(bool checked)
+    {
+        if (checked)
+            _refreshTimer->start();
+        else
+            _refreshTimer->stop();
+    }
+
+    void ProfilerDialog::handle(ProfilingLevelResponse *event)
+    {
+        if (event->database() != _database)
+            return;
+
+        _applyButton->setEnabled(true);
+
+        if (event->isError()) {
+            _statusLabel->setText("Failed to change profiling level: " + 
+                                  QtUtils::toQString(event->error().errorMessage()).toHtmlEscaped());
+            return;
+        }
+
+        _levelComboBox->setCurrentIndex(event->level());
+        _slowMsSpinBox->setValue(event->slowMs());
+    }
+
+    void ProfilerDialog::handle(LoadProfilerResponse *event)
+    {
+        if (event->database() != _database)
+            return;
+
+        _loading = false;
+        bool const isCleared = _clearPending;
+        _clearPending = false;
+
+        if (event->isError()) {
+            _statusLabel->setText("Failed to read profiled operations: " + 
+                                  QtUtils::toQString(event->error().errorMessage()).toHtmlEscaped());
+            return;
+        }
+
+        _window = event->window();
+
+        // Operations read before clear() are not shown again
+        if (isCleared) {
+            _window.clear();
+            showShapes(std::vector<QueryShapeStats>());
+            return;
+        }
+
+        showShapes(event->shapes());
+    }
+
+    void ProfilerDialog::showShapes(const std::vector<QueryShapeStats> &shapes)
+    {
+        _statusLabel->setText(QString("%1 latest operations are grouped (at most %2), %3 operations read.")
+                              .arg(_window.size()).arg(_window.capacity()).arg(_window.totalCount()));
+
+        _shapesTree->setSortingEnabled(false);
+        _shapesTree->clear();
+        for (auto const& stats : shapes) {
+            QTreeWidgetItem *item = new QTreeWidgetItem;
+            item->setText(OperationColumn, QtUtils::toQString(stats.op));
+            item->setText(NamespaceColumn, QtUtils::toQString(stats.ns));
+            item->setData(CountColumn, Qt::DisplayRole, stats.count);
+            item->setData(P50Column, Qt::DisplayRole, static_cast<qlonglong>(stats.p50));
+            item->setData(P95Column, Qt::DisplayRole, static_cast<qlonglong>(stats.p95));
+            item->setData(MaxColumn, Qt::DisplayRole, static_cast<qlonglong>(stats.max));
+            item->setData(TotalColumn, Qt::DisplayRole, static_cast<qlonglong>(stats.totalMillis));
+            item->setText(DocsExaminedColumn, average(stats.docsExamined, stats.count));
+            item->setText(ReturnedColumn, average(stats.returned, stats.count));
+            item->setText(PlanColumn, QtUtils::toQString(stats.planSummary));
+            item->setText(ShapeColumn, QtUtils::toQString(stats.shape));
+            item->setToolTip(ShapeColumn, item->text(ShapeColumn));
+            for (int column = CountColumn; column <= ReturnedColumn; ++column)
+                item->setTextAlignment(column, Qt::AlignRight | Qt::AlignVCenter);
+
+            if (stats.planSummary.find("COLLSCAN") != std::string::npos)
+                item->setForeground(PlanColumn, Qt::red);
+
+            _shapesTree->addTopLevelItem(item);
+        }
+        _shapesTree->setSortingEnabled(true);
+
+        for (int column = OperationColumn; column < ShapeColumn; ++column)
+            _shapesTree->resizeColumnToContents(column);
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <QDialog>
+
+#include "robomongo/core/domain/ProfilerWindow.h"
+
+QT_BEGIN_NAMESPACE
+class QCheckBox;
+class QComboBox;
+class QLabel;
+class QPushButton;
+class QSpinBox;
+class QTimer;
+class QTreeWidget;
+QT_END_NAMESPACE
+
+namespace Robomongo
+{
+    class MongoServer;
+    class ProfilingLevelResponse;
+    class LoadProfilerResponse;
+
+    /**
+     * @brief Slow operations of database recorded by profiler, grouped by query shape.
+     * System.profile is tailed while dialog is open, only the latest operations are kept.
+     */
+    class ProfilerDialog : public QDialog
+    {
+        Q_OBJECT
+
+    public:
+        ProfilerDialog(MongoServer *server, const std::string &database, QWidget *parent = 0);
+
+    protected Q_SLOTS:
+        void handle(ProfilingLevelResponse *event);
+        void handle(LoadProfilerResponse *event);
+        void applyLevel();
+        void refresh();
+        void clear();
+        void autoRefreshToggled(bool checked);
+
+    private:
+        void showShapes(const std::vector<QueryShapeStats> &shapes);
+
+        enum Column
+        {
+            OperationColumn,
+            NamespaceColumn,
+            CountColumn,
+            P50Column,
+            P95Column,
+            MaxColumn,
+            TotalColumn,
+            DocsExaminedColumn,
+            ReturnedColumn,
+            PlanColumn,
+            ShapeColumn
+        };
+
+        MongoServer *_server;
+        std::string _database;
+        ProfilerWindow _window;
+        bool _loading;
+        bool _clearPending;
+
+        QComboBox *_levelComboBox;
+        QSpinBox *_slowMsSpinBox;
+        QPushButton *_applyButton;
+        QCheckBox *_autoRefreshCheckBox;
+        QTimer *_refreshTimer;
+        QLabel *_statusLabel;
+        QTreeWidget *_shapesTree;
+    };
+}
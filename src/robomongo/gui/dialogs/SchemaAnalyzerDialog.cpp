@@ -0,0 +1,263 @@
+#include "robomongo/gui/dialogs/SchemaAnalyzerDialog.h"
+
+#include <map>
+
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QPainter>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QStyledItemDelegate>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+#include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/EventBus.h"
+#include "robomongo/core/domain/MongoServer.h"
+#include "robomongo/core/domain/SchemaReport.h"
+#include "robomongo/core/events/MongoEvents.h"
+#include "robomongo/core/settings/SettingsManager.h"
+#include "robomongo/core/utils/BsonUtils.h"
+#include "robomongo/core/utils/DateUtils.h"
+#include "robomongo/core/utils/QtUtils.h"
+#include "robomongo/core/utils/SchemaAnalyzer.h"
+
+namespace
+{
+    // Paints share of documents (stored in Qt::UserRole) as bar behind the text
+    class PresenceDelegate : public QStyledItemDelegate
+    {
+    public:
+        explicit PresenceDelegate(QObject *parent) : QStyledItemDelegate(parent) {}
+
+        void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override
+        {
+            double const share = index.data(Qt::UserRole).toDouble();
+            QRect bar = option.rect.adjusted(2, 3, -2, -3);
+            bar.setWidth(static_cast<int>(bar.width() * share));
+
+            painter->save();
+            painter->fillRect(bar, share < 1 ? QColor(240, 190, 90) : QColor(130, 190, 120));
+            painter->restore();
+
+            QStyledItemDelegate::paint(painter, option, index);
+        }
+    };
+
+    QString parentPath(const QString &path)
+    {
+        if (path.endsWith("[]"))
+            return path.left(path.size() - 2);
+
+        int const dot = path.lastIndexOf('.');
+        return dot < 0 ? QString() : path.left(dot);
+    }
+
+    QString typesText(const Robomongo::SchemaField &field)
+    {
+        QStringList types;
+        for (auto const& type : field.types) {
+            const char *name = Robomongo::BsonUtils::BSONTypeToString(static_cast<mongo::BSONType>(type.first),
+                                                                      mongo::BinDataGeneral, Robomongo::DefaultEncoding);
+            types << QString("%1 %2%").arg(name).arg(100.0 * type.second / field.values, 0, 'f', 0);
+        }
+        return types.join(", ");
+    }
+
+    QString rangeText(const Robomongo::SchemaField &field, bool isMin, bool isLocalTime)
+    {
+        QStringList values;
+        if (field.hasNumbers)
+            values << QString::number(isMin ? field.minNumber : field.maxNumber, 'g', 15);
+        if (field.hasDates)
+            values << Robomongo::QtUtils::toQString(
+                Robomongo::DateUtils::isoDateString(isMin ? field.minDate : field.maxDate, false, isLocalTime));
+        if (field.hasStrings)
+            values << "\"" + Robomongo::QtUtils::toQString(isMin ? field.minString : field.maxString) + "\"";
+        return values.join("; ");
+    }
+
+    QString arrayLengthsText(const Robomongo::SchemaField &field)
+    {
+        QStringList lengths;
+        for (int i = 0; i < Robomongo::SchemaField::ArrayLengthBuckets; ++i) {
+            if (field.arrayLengths[i] > 0)
+                lengths << QString("%1: %2").arg(Robomongo::SchemaAnalyzer::arrayLengthBucketName(i))
+                                            .arg(field.arrayLengths[i]);
+        }
+        return lengths.join(", ");
+    }
+}
+
+namespace Robomongo
+{
+    SchemaAnalyzerDialog::SchemaAnalyzerDialog(MongoServer *server, const MongoCollectionInfo &collection,
+                                               QWidget *parent) :
+        QDialog(parent),
+        _server(server),
+        _collection(collection),
+        _cancelledResponses(0)
+    {
+        AppRegistry::instance().bus()->subscribe(this, AnalyzeSchemaResponse::Type, server);
+
+        setWindowTitle("Schema: " + QtUtils::toQString(collection.ns().toString()));
+        setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint); // Remove help button (?)
+        setAttribute(Qt::WA_DeleteOnClose);
+
+        _sampleSizeSpin = new QSpinBox;
+        _sampleSizeSpin->setRange(100, 1000000);
+        _sampleSizeSpin->setSingleStep(1000);
+        _sampleSizeSpin->setValue(1000);
+        _sampleSizeSpin->setSuffix(" documents");
+
+        _analyzeButton = new QPushButton("&Analyze");
+        VERIFY(connect(_analyzeButton, SIGNAL(clicked()), this, SLOT(analyze())));
+
+        _cancelButton = new QPushButton("Ca&ncel");
+        _cancelButton->setEnabled(false);
+        VERIFY(connect(_cancelButton, SIGNAL(clicked()), this, SLOT(cancel())));
+
+        QHBoxLayout *controls = new QHBoxLayout;
+        controls->addWidget(new QLabel("Sample size:"));
+        controls->addWidget(_sampleSizeSpin);
+        controls->addWidget(_analyzeButton);
+        controls->addWidget(_cancelButton);
+        controls->addStretch(1);
+
+        _statusLabel = new QLabel;
+        _statusLabel->setWordWrap(true);
+        _statusLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+
+        _fieldsTree = new QTreeWidget;
+        _fieldsTree->setAlternatingRowColors(true);
+        _fieldsTree->setHeaderLabels(QStringList() << "Field" << "Presence" << "Types" << "Distinct"
+                                                   << "Min" << "Max" << "Array Lengths");
+        _fieldsTree->header()->setStretchLastSection(true);
+        _fieldsTree->setItemDelegateForColumn(PresenceColumn, new PresenceDelegate(_fieldsTree));
+
+        QPushButton *closeButton = new QPushButton("&Close");
+        VERIFY(connect(closeButton, SIGNAL(clicked()), this, SLOT(accept())));
+
+        QHBoxLayout *buttons = new QHBoxLayout;
+        buttons->addStretch(1);
+        buttons->addWidget(closeButton);
+
+        QVBoxLayout *layout = new QVBoxLayout;
+        layout->addLayout(controls);
+        layout->addWidget(_statusLabel);
+        layout->addWidget(_fieldsTree, 1);
+        layout->addLayout(buttons);
+        setLayout(layout);
+        resize(900, 560);
+
+        analyze();
+    }
+
+    SchemaAnalyzerDialog::~SchemaAnalyzerDialog()
+    {
+        // Sampling of closed dialog is not needed anymore
+        if (_cancel)
+            *_cancel = true;
+    }
+
+    void SchemaAnalyzerDialog::analyze()
+    {
+        _analyzeButton->setEnabled(false);
+        _cancelButton->setEnabled(true);
+        _statusLabel->setText(QString("Sampling %1 documents...").arg(_sampleSizeSpin->value()));
+        _fieldsTree->clear();
+        _cancel = std::make_shared<std::atomic<bool> >(false);
+        _server->analyzeSchema(_collection, _sampleSizeSpin->value(), _cancel);
+    }
+
+    void SchemaAnalyzerDialog::cancel()
+    {
+        if (!_cancel)
+            return;
+
+        *_cancel = true;
+        _cancel.reset();
+        ++_cancelledResponses;
+
+        _analyzeButton->setEnabled(true);
+        _cancelButton->setEnabled(false);
+        _statusLabel->setText("Analysis cancelled.");
+    }
+
+    void SchemaAnalyzerDialog::handle(AnalyzeSchemaResponse *event)
+    {
+        if (event->ns() != _collection.ns().toString())
+            return;
+
+        // Worker handles requests in order, so responses of cancelled analyses come first
+        if (_cancelledResponses > 0) {
+            --_cancelledResponses;
+            return;
+        }
+
+        _cancel.reset();
+        _analyzeButton->setEnabled(true);
+        _cancelButton->setEnabled(false);
+
+        if (event->isError()) {
+            _statusLabel->setText("Failed to analyze schema: " +
+                                  QtUtils::toQString(event->error().errorMessage()).toHtmlEscaped());
+            return;
+        }
+
+        showReport(event->report());
+    }
+
+    void SchemaAnalyzerDialog::showReport(const SchemaReport &report)
+    {
+        QStringList status;
+        status << QString("%1 documents analyzed in %2 ms by %3 threads.")
+                  .arg(report.documents).arg(report.millis).arg(report.threads);
+        if (report.skippedValues > 0)
+            status << QString("Only %1 field paths are tracked, %2 values of other paths were skipped.")
+                      .arg(report.maxFields).arg(report.skippedValues);
+        _statusLabel->setText(status.join("<br>"));
+
+        if (report.documents == 0)
+            return;
+
+        bool const isLocalTime = AppRegistry::instance().settingsManager()->timeZone() == LocalTime;
+
+        // Fields are sorted by path, so parent is always added before its children
+        std::map<QString, QTreeWidgetItem *> items;
+        for (auto const& field : report.fields) {
+            QString const path = QtUtils::toQString(field.path);
+            QString const parent = parentPath(path);
+            double const presence = static_cast<double>(field.documents) / report.documents;
+
+            QTreeWidgetItem *item = new QTreeWidgetItem;
+            item->setToolTip(FieldColumn, path);
+            item->setText(PresenceColumn, QString("%1%").arg(100 * presence, 0, 'f', 1));
+            item->setData(PresenceColumn, Qt::UserRole, presence);
+            item->setTextAlignment(PresenceColumn, Qt::AlignRight | Qt::AlignVCenter);
+            item->setText(TypesColumn, typesText(field));
+            if (field.distinct >= 0)
+                item->setText(DistinctColumn, QString("~%1").arg(field.distinct));
+            item->setTextAlignment(DistinctColumn, Qt::AlignRight | Qt::AlignVCenter);
+            item->setText(MinColumn, rangeText(field, true, isLocalTime));
+            item->setText(MaxColumn, rangeText(field, false, isLocalTime));
+            item->setText(ArrayLengthsColumn, arrayLengthsText(field));
+
+            std::map<QString, QTreeWidgetItem *>::const_iterator const it = items.find(parent);
+            if (it != items.end()) {
+                item->setText(FieldColumn, path.mid(parent.size() + (path.endsWith("[]") ? 0 : 1)));
+                it->second->addChild(item);
+            }
+            else {
+                item->setText(FieldColumn, path);
+                _fieldsTree->addTopLevelItem(item);
+            }
+            items[path] = item;
+        }
+
+        _fieldsTree->expandAll();
+        for (int column = 0; column < _fieldsTree->columnCount() - 1; ++column)
+            _fieldsTree->resizeColumnToContents(column);
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <QDialog>
+
+#include "robomongo/core/domain/MongoCollectionInfo.h"
+#include "robomongo/core/domain/SchemaReport.h"
+
+QT_BEGIN_NAMESPACE
+class QLabel;
+class QPushButton;
+class QSpinBox;
+class QTreeWidget;
+QT_END_NAMESPACE
+
+namespace Robomongo
+{
+    class MongoServer;
+    class AnalyzeSchemaResponse;
+
+    /**
+     * @brief Shows field paths of random sample of collection documents with presence,
+     * types, estimated number of distinct values, ranges and lengths of arrays.
+     *
+     * This is a dialog and not a custom mode of OutputItemContentWidget (like explain
+     * and collection stats): custom modes render documents that a shell statement has
+     * already returned, while the report is computed by the worker from a $sample of
+     * the whole collection. It has its own sample size and re-run, and is never part
+     * of shell results, so there is no result item to attach it to.
+     */
+    class SchemaAnalyzerDialog : public QDialog
+    {
+        Q_OBJECT
+
+    public:
+        SchemaAnalyzerDialog(MongoServer *server, const MongoCollectionInfo &collection, QWidget *parent = 0);
+        ~SchemaAnalyzerDialog();
+
+    protected Q_SLOTS:
+        void handle(AnalyzeSchemaResponse *event);
+        void analyze();
+        void cancel();
+
+    private:
+        void showReport(const SchemaReport &report);
+
+        enum Column
+        {
+            FieldColumn,
+            PresenceColumn,
+            TypesColumn,
+            DistinctColumn,
+            MinColumn,
+            MaxColumn,
+            ArrayLengthsColumn
+        };
+
+        MongoServer *_server;
+        MongoCollectionInfo _collection;
+
+        // Set while analysis is in progress
+        SchemaAnalysisCancel _cancel;
+
+        // Responses of cancelled analyses, that are still to come
+        int _cancelledResponses;
+
+        QSpinBox *_sampleSizeSpin;
+        QPushButton *_analyzeButton;
+        QPushButton *_cancelButton;
+        QLabel *_statusLabel;
+        QTreeWidget *_fieldsTree;
+    };
+}
@@ -0,0 +1,178 @@
+#include "robomongo/gui/dialogs/ServerDashboardDialog.h"
+
+#include <algorithm>
+
+#include <QCheckBox>
+#include <QGridLayout>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QTimer>
+#include <QVBoxLayout>
+
+#include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/EventBus.h"
+#include "robomongo/core/domain/MongoServer.h"
+#include "robomongo/core/events/MongoEvents.h"
+#include "robomongo/core/utils/QtUtils.h"
+
+namespace
+{
+    const int defaultIntervalSec = 5;
+
+    // Colors of lines, in order of addition to a chart
+    const Qt::GlobalColor lineColors[] = {
+        Qt::darkBlue, Qt::darkGreen, Qt::darkRed, Qt::darkMagenta, Qt::darkCyan, Qt::darkYellow
+    };
+
+    const size_t lineColorsCount = sizeof(lineColors) / sizeof(lineColors[0]);
+}
+
+namespace Robomongo
+{
+    ServerDashboardDialog::ServerDashboardDialog(MongoServer *server, QWidget *parent) :
+        QDialog(parent),
+        _server(server),
+        _loading(false)
+    {
+        AppRegistry::instance().bus()->subscribe(this, ServerStatusResponse::Type, server);
+
+        setWindowTitle("Performance: " + QtUtils::toQString(server->connectionRecord()->getFullAddress()));
+        setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint); // Remove help button (?)
+        setAttribute(Qt::WA_DeleteOnClose);
+
+        _intervalSpinBox = new QSpinBox;
+        _intervalSpinBox->setRange(1, 60);
+        _intervalSpinBox->setValue(defaultIntervalSec);
+        _intervalSpinBox->setSuffix(" s");
+        VERIFY(connect(_intervalSpinBox, SIGNAL(valueChanged(int)), this, SLOT(intervalChanged(int))));
+
+        _pauseCheckBox = new QCheckBox("&Pause");
+        VERIFY(connect(_pauseCheckBox, SIGNAL(toggled(bool)), this, SLOT(pauseToggled(bool))));
+        QPushButton *clearButton = new QPushButton("C&lear");
+        VERIFY(connect(clearButton, SIGNAL(clicked()), this, SLOT(clear())));
+
+        _refreshTimer = new QTimer(this);
+        _refreshTimer->setInterval(defaultIntervalSec * 1000);
+        VERIFY(connect(_refreshTimer, SIGNAL(timeout()), this, SLOT(refresh())));
+
+        QHBoxLayout *controlsLayout = new QHBoxLayout;
+        controlsLayout->addWidget(new QLabel("Sample every:"));
+        controlsLayout->addWidget(_intervalSpinBox);
+        controlsLayout->addWidget(_pauseCheckBox);
+        controlsLayout->addStretch(1);
+        controlsLayout->addWidget(clearButton);
+
+        _statusLabel = new QLabel;
+        _statusLabel->setWordWrap(true);
+        _statusLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+
+        QGridLayout *chartsLayout = new QGridLayout;
+        chartsLayout->addWidget(addChart("Operations/s", MetricChart::NumberFormat, {
+            ServerMetrics::Inserts, ServerMetrics::Queries, ServerMetrics::Updates,
+            ServerMetrics::Deletes, ServerMetrics::GetMores, ServerMetrics::Commands }), 0, 0);
+        chartsLayout->addWidget(addChart("Network/s", MetricChart::BytesFormat, {
+            ServerMetrics::NetworkIn, ServerMetrics::NetworkOut }), 0, 1);
+
+        MetricChart *cacheChart = addChart("WiredTiger Cache", MetricChart::PercentFormat, {
+            ServerMetrics::CacheUsed, ServerMetrics::CacheDirty });
+        cacheChart->setMaximum(100);
+        chartsLayout->addWidget(cacheChart, 1, 0);
+
+        _ticketsChart = addChart("Tickets", MetricChart::NumberFormat, {
+            ServerMetrics::ReadTicketsInUse, ServerMetrics::WriteTicketsInUse });
+        chartsLayout->addWidget(_ticketsChart, 1, 1);
+
+        chartsLayout->addWidget(addChart("Connections", MetricChart::NumberFormat, {
+            ServerMetrics::Connections }), 2, 0);
+        chartsLayout->addWidget(addChart("Page Faults/s", MetricChart::NumberFormat, {
+            ServerMetrics::PageFaults }), 2, 1);
+
+        QPushButton *closeButton = new QPushButton("&Close");
+        VERIFY(connect(closeButton, SIGNAL(clicked()), this, SLOT(accept())));
+        QHBoxLayout *buttons = new QHBoxLayout;
+        buttons->addStretch(1);
+        buttons->addWidget(closeButton);
+
+        QVBoxLayout *layout = new QVBoxLayout;
+        layout->addLayout(controlsLayout);
+        layout->addWidget(_statusLabel);
+        layout->addLayout(chartsLayout, 1);
+        layout->addLayout(buttons);
+        setLayout(layout);
+        resize(900, 640);
+
+        refresh();
+        _refreshTimer->start();
+    }
+
+    MetricChart *ServerDashboardDialog::addChart(const QString &title, MetricChart::ValueFormat format,
+                                                 const std::vector<ServerMetrics::Metric> &metrics)
+    {
+        MetricChart *chart = new MetricChart(title, format);
+        for (size_t i = 0; i < metrics.size(); ++i) {
+            ChartLine chartLine;
+            chartLine.metric = metrics[i];
+            chartLine.chart = chart;
+            chartLine.line = chart->addLine(ServerMetrics::name(metrics[i]), lineColors[i % lineColorsCount]);
+            _chartLines.push_back(chartLine);
+        }
+        return chart;
+    }
+
+    void ServerDashboardDialog::refresh()
+    {
+        // Slow server is not queued more requests than it answers
+        if (_loading)
+            return;
+
+        _loading = true;
+        _server->loadServerStatus();
+    }
+
+    void ServerDashboardDialog::intervalChanged(int seconds)
+    {
+        _refreshTimer->setInterval(seconds * 1000);
+    }
+
+    void ServerDashboardDialog::pauseToggled(bool checked)
+    {
+        if (checked)
+            _refreshTimer->stop();
+        else
+            _refreshTimer->start();
+    }
+
+    void ServerDashboardDialog::clear()
+    {
+        _metrics.clear();
+        showMetrics();
+    }
+
+    void ServerDashboardDialog::handle(ServerStatusResponse *event)
+    {
+        _loading = false;
+
+        if (event->isError()) {
+            _statusLabel->setText("Failed to read server status: " +
+                                  QtUtils::toQString(event->error().errorMessage()).toHtmlEscaped());
+            return;
+        }
+
+        _metrics.update(event->status(), event->timeMs());
+        _statusLabel->setText(QString("%1, MongoDB %2. The latest %3 samples are shown.")
+                              .arg(QtUtils::toQString(_metrics.host()))
+                              .arg(QtUtils::toQString(_metrics.version()))
+                              .arg(_metrics.series(ServerMetrics::Connections).capacity()));
+        showMetrics();
+    }
+
+    void ServerDashboardDialog::showMetrics()
+    {
+        for (auto const& chartLine : _chartLines)
+            chartLine.chart->setSeries(chartLine.line, _metrics.series(chartLine.metric));
+
+        _ticketsChart->setMaximum(std::max(_metrics.ticketsTotal(false), _metrics.ticketsTotal(true)));
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <vector>
+
+#include <QDialog>
+
+#include "robomongo/core/domain/ServerMetrics.h"
+#include "robomongo/gui/widgets/MetricChart.h"
+
+QT_BEGIN_NAMESPACE
+class QCheckBox;
+class QLabel;
+class QSpinBox;
+class QTimer;
+QT_END_NAMESPACE
+
+namespace Robomongo
+{
+    class MongoServer;
+    class ServerStatusResponse;
+
+    /**
+     * @brief Charts of server metrics, serverStatus is sampled at fixed interval
+     * on a separate connection. The latest samples are kept, older ones are dropped.
+     */
+    class ServerDashboardDialog : public QDialog
+    {
+        Q_OBJECT
+
+    public:
+        ServerDashboardDialog(MongoServer *server, QWidget *parent = 0);
+
+    protected Q_SLOTS:
+        void handle(ServerStatusResponse *event);
+        void refresh();
+        void intervalChanged(int seconds);
+        void pauseToggled(bool checked);
+        void clear();
+
+    private:
+        void showMetrics();
+
+        MetricChart *addChart(const QString &title, MetricChart::ValueFormat format,
+                              const std::vector<ServerMetrics::Metric> &metrics);
+
+        // Chart and line of every metric
+        struct ChartLine
+        {
+            ServerMetrics::Metric metric;
+            MetricChart *chart;
+            int line;
+        };
+
+        MongoServer *_server;
+        ServerMetrics _metrics;
+        bool _loading;
+        std::vector<ChartLine> _chartLines;
+
+        QSpinBox *_intervalSpinBox;
+        QCheckBox *_pauseCheckBox;
+        QTimer *_refreshTimer;
+        QLabel *_statusLabel;
+        MetricChart *_ticketsChart;
+    };
+}
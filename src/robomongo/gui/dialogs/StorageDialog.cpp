@@ -0,0 +1,174 @@
+#include "robomongo/gui/dialogs/StorageDialog.h"
+
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QPushButton>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+#include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/EventBus.h"
+#include "robomongo/core/domain/MongoServer.h"
+#include "robomongo/core/domain/MongoUtils.h"
+#include "robomongo/core/domain/StorageReport.h"
+#include "robomongo/core/events/MongoEvents.h"
+#include "robomongo/core/settings/SettingsManager.h"
+#include "robomongo/core/utils/DateUtils.h"
+#include "robomongo/core/utils/QtUtils.h"
+
+namespace
+{
+    // Sizes are shown as text, but sorted by number of bytes stored in Qt::UserRole
+    class StorageItem : public QTreeWidgetItem
+    {
+    public:
+        bool operator<(const QTreeWidgetItem &other) const override
+        {
+            int const column = treeWidget()->sortColumn();
+            QVariant const left = data(column, Qt::UserRole);
+            QVariant const right = other.data(column, Qt::UserRole);
+            if (left.isValid() && right.isValid())
+                return left.toDouble() < right.toDouble();
+
+            return QTreeWidgetItem::operator<(other);
+        }
+
+        void setNumber(int column, double value, const QString &text)
+        {
+            setText(column, text);
+            setData(column, Qt::UserRole, value);
+            setTextAlignment(column, Qt::AlignRight | Qt::AlignVCenter);
+        }
+
+        void setSize(int column, long long bytes)
+        {
+            setNumber(column, static_cast<double>(bytes), Robomongo::MongoUtils::buildNiceSizeString(bytes));
+        }
+    };
+}
+
+namespace Robomongo
+{
+    StorageDialog::StorageDialog(MongoServer *server, const std::string &database, QWidget *parent) :
+        QDialog(parent),
+        _server(server),
+        _database(database)
+    {
+        AppRegistry::instance().bus()->subscribe(this, StorageReportResponse::Type, server);
+
+        setWindowTitle("Storage: " + QtUtils::toQString(database));
+        setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint); // Remove help button (?)
+        setAttribute(Qt::WA_DeleteOnClose);
+
+        _statusLabel = new QLabel;
+        _statusLabel->setWordWrap(true);
+        _statusLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+
+        _collectionsTree = new QTreeWidget;
+        _collectionsTree->setAlternatingRowColors(true);
+        _collectionsTree->setHeaderLabels(QStringList() << "Name" << "Documents" << "Data Size" << "Storage Size"
+                                                        << "Compression" << "Index Size" << "Free" << "Total Size");
+        _collectionsTree->header()->setStretchLastSection(false);
+        _collectionsTree->setSortingEnabled(true);
+        _collectionsTree->sortByColumn(TotalSizeColumn, Qt::DescendingOrder);
+
+        _refreshButton = new QPushButton("&Refresh");
+        VERIFY(connect(_refreshButton, SIGNAL(clicked()), this, SLOT(refresh())));
+        QPushButton *closeButton = new QPushButton("&Close");
+        VERIFY(connect(closeButton, SIGNAL(clicked()), this, SLOT(accept())));
+
+        QHBoxLayout *buttons = new QHBoxLayout;
+        buttons->addStretch(1);
+        buttons->addWidget(_refreshButton);
+        buttons->addWidget(closeButton);
+
+        QVBoxLayout *layout = new QVBoxLayout;
+        layout->addWidget(_statusLabel);
+        layout->addWidget(_collectionsTree, 1);
+        layout->addLayout(buttons);
+        setLayout(layout);
+        resize(900, 520);
+
+        StorageReport const cached = server->storageReport(database);
+        if (cached.empty())
+            refresh();
+        else
+            showReport(cached);
+    }
+
+    void StorageDialog::refresh()
+    {
+        _refreshButton->setEnabled(false);
+        _statusLabel->setText("Loading statistics of collections...");
+        _server->loadStorageReport(_database);
+    }
+
+    void StorageDialog::handle(StorageReportResponse *event)
+    {
+        if (event->database() != _database)
+            return;
+
+        _refreshButton->setEnabled(true);
+
+        if (event->isError()) {
+            _statusLabel->setText("Failed to load storage statistics: " +
+                                  QtUtils::toQString(event->error().errorMessage()).toHtmlEscaped());
+            return;
+        }
+
+        showReport(event->report());
+    }
+
+    void StorageDialog::showReport(const StorageReport &report)
+    {
+        bool const isLocalTime = AppRegistry::instance().settingsManager()->timeZone() == LocalTime;
+        CollectionStorage const total = report.total();
+        _statusLabel->setText(QString("%1 collections: %2 of data in %3 of storage, %4 of indexes, %5 reusable. "
+                                      "Loaded at %6.")
+                              .arg(report.collections.size())
+                              .arg(MongoUtils::buildNiceSizeString(total.dataSize))
+                              .arg(MongoUtils::buildNiceSizeString(total.storageSize))
+                              .arg(MongoUtils::buildNiceSizeString(total.indexSize))
+                              .arg(MongoUtils::buildNiceSizeString(total.freeBytes + total.indexFreeBytes))
+                              .arg(QtUtils::toQString(DateUtils::isoDateString(report.timeMs, false, isLocalTime))));
+
+        _collectionsTree->setSortingEnabled(false);
+        _collectionsTree->clear();
+        for (auto const& collection : report.collections) {
+            StorageItem *item = new StorageItem;
+            item->setText(NameColumn, QtUtils::toQString(collection.name));
+
+            if (!collection.error.empty()) {
+                item->setToolTip(NameColumn, QtUtils::toQString(collection.error));
+                item->setForeground(NameColumn, Qt::red);
+                _collectionsTree->addTopLevelItem(item);
+                continue;
+            }
+
+            double const ratio = collection.compressionRatio();
+            item->setNumber(DocumentsColumn, static_cast<double>(collection.count), QString::number(collection.count));
+            item->setSize(DataSizeColumn, collection.dataSize);
+            item->setSize(StorageSizeColumn, collection.storageSize);
+            item->setNumber(CompressionColumn, ratio, ratio > 0 ? QString("%1x").arg(ratio, 0, 'f', 2) : QString());
+            item->setSize(IndexSizeColumn, collection.indexSize);
+            item->setSize(FreeColumn, collection.freeBytes + collection.indexFreeBytes);
+            item->setSize(TotalSizeColumn, collection.totalSize());
+
+            for (auto const& index : collection.indexes) {
+                StorageItem *indexItem = new StorageItem;
+                indexItem->setText(NameColumn, QtUtils::toQString(index.name));
+                indexItem->setSize(IndexSizeColumn, index.sizeBytes);
+                indexItem->setSize(FreeColumn, index.freeBytes);
+                indexItem->setSize(TotalSizeColumn, index.sizeBytes);
+                item->addChild(indexItem);
+            }
+
+            _collectionsTree->addTopLevelItem(item);
+        }
+        _collectionsTree->setSortingEnabled(true);
+
+        for (int column = NameColumn; column <= TotalSizeColumn; ++column)
+            _collectionsTree->resizeColumnToContents(column);
+    }
+}
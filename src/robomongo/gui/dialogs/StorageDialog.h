@@ -0,0 +1,55 @@
+#pragma once
+
+#include <QDialog>
+
+QT_BEGIN_NAMESPACE
+class QLabel;
+class QPushButton;
+class QTreeWidget;
+QT_END_NAMESPACE
+
+namespace Robomongo
+{
+    class MongoServer;
+    class StorageReportResponse;
+    struct StorageReport;
+
+    /**
+     * @brief Sortable sizes of all collections of database with their indexes.
+     * Report cached by server is shown when dialog opens, it is loaded only when
+     * there is none or on refresh.
+     */
+    class StorageDialog : public QDialog
+    {
+        Q_OBJECT
+
+    public:
+        StorageDialog(MongoServer *server, const std::string &database, QWidget *parent = 0);
+
+    protected Q_SLOTS:
+        void handle(StorageReportResponse *event);
+        void refresh();
+
+    private:
+        void showReport(const StorageReport &report);
+
+        enum Column
+        {
+            NameColumn,
+            DocumentsColumn,
+            DataSizeColumn,
+            StorageSizeColumn,
+            CompressionColumn,
+            IndexSizeColumn,
+            FreeColumn,
+            TotalSizeColumn
+        };
+
+        MongoServer *_server;
+        const std::string _database;
+
+        QLabel *_statusLabel;
+        QTreeWidget *_collectionsTree;
+        QPushButton *_refreshButton;
+    };
+}
@@ -105,6 +105,16 @@ namespace Robomongo
         findElement(false);
     }
 
+    QString FindFrame::findText() const
+    {
+        return _findLine->text();
+    }
+
+    bool FindFrame::isCaseSensitive() const
+    {
+        return _caseSensitive->checkState() == Qt::Checked;
+    }
+
     void FindFrame::findElement(bool forward)
     {
         const QString &text = _findLine->text();
@@ -35,12 +35,18 @@ namespace Robomongo
         virtual void wheelEvent(QWheelEvent *e);
         virtual void keyPressEvent(QKeyEvent *e);
 
+        /**
+         * @brief Searches text of find panel starting from cursor position
+         */
+        virtual void findElement(bool forward);
+        QString findText() const;
+        bool isCaseSensitive() const;
+
     private Q_SLOTS:
         void goToNextElement();
         void goToPrevElement();
 
     private:
-        void findElement(bool forward);
         void setLineComment(const int lineIndex, const bool commentOut);
         RoboScintilla *const _scin;
         QFrame *const _findPanel;
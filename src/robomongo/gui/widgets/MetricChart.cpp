@@ -0,0 +1,144 @@
+#include "robomongo/gui/widgets/MetricChart.h"
+
+#include <algorithm>
+
+#include <QPainter>
+#include <QPolygonF>
+
+namespace
+{
+    const int margin = 4;
+    const int gridLines = 4;
+}
+
+namespace Robomongo
+{
+    MetricChart::MetricChart(const QString &title, ValueFormat format, QWidget *parent) :
+        QWidget(parent),
+        _title(title),
+        _format(format),
+        _maximum(0)
+    {
+        setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+    }
+
+    int MetricChart::addLine(const QString &name, const QColor &color)
+    {
+        Line line;
+        line.name = name;
+        line.color = color;
+        _lines.push_back(line);
+        return static_cast<int>(_lines.size()) - 1;
+    }
+
+    void MetricChart::setSeries(int line, const MetricSeries &series)
+    {
+        _lines[line].series = series;
+        update();
+    }
+
+    void MetricChart::setMaximum(double maximum)
+    {
+        _maximum = maximum;
+        update();
+    }
+
+    QSize MetricChart::sizeHint() const
+    {
+        return QSize(360, 180);
+    }
+
+    QString MetricChart::formatValue(double value) const
+    {
+        switch (_format) {
+        case BytesFormat: {
+            const char *const units[] = { "B", "KB", "MB", "GB" };
+            int unit = 0;
+            while (value >= 1024 && unit < 3) {
+                value /= 1024;
+                ++unit;
+            }
+            return QString::number(value, 'f', unit == 0 ? 0 : 1) + " " + units[unit];
+        }
+        case PercentFormat:
+            return QString::number(value, 'f', 1) + "%";
+        case NumberFormat:
+            break;
+        }
+        return QString::number(value, 'f', value < 10 && value != static_cast<long long>(value) ? 1 : 0);
+    }
+
+    void MetricChart::paintEvent(QPaintEvent *)
+    {
+        QPainter painter(this);
+        painter.fillRect(rect(), palette().base());
+
+        QFontMetrics const metrics = painter.fontMetrics();
+        int const lineHeight = metrics.height();
+
+        // Title, then latest value of every line in its color
+        int x = margin;
+        painter.setPen(palette().color(QPalette::Text));
+        painter.drawText(x, margin + metrics.ascent(), _title);
+        x += metrics.width(_title) + 2 * margin;
+
+        bool hasSamples = false;
+        long long first = 0, last = 0;
+        double top = _maximum;
+        for (auto const& line : _lines) {
+            QString const text = line.name + ": " + (line.series.empty() ? QString("n/a")
+                                                                         : formatValue(line.series.last()));
+            painter.setPen(line.color);
+            painter.drawText(x, margin + metrics.ascent(), text);
+            x += metrics.width(text) + 2 * margin;
+
+            if (line.series.empty())
+                continue;
+
+            if (!hasSamples) {
+                hasSamples = true;
+                first = line.series.time(0);
+                last = line.series.time(line.series.size() - 1);
+            } else {
+                first = std::min(first, line.series.time(0));
+                last = std::max(last, line.series.time(line.series.size() - 1));
+            }
+            if (_maximum <= 0)
+                top = std::max(top, line.series.max());
+        }
+
+        if (top <= 0)
+            top = 1;
+
+        int const labelWidth = metrics.width(formatValue(top)) + margin;
+        QRectF const plot(margin + labelWidth, 2 * margin + lineHeight,
+                          width() - labelWidth - 2 * margin, height() - lineHeight - 3 * margin);
+        if (plot.width() <= 0 || plot.height() <= 0)
+            return;
+
+        painter.setPen(palette().color(QPalette::Mid));
+        for (int i = 0; i <= gridLines; ++i) {
+            qreal const y = plot.top() + plot.height() * i / gridLines;
+            painter.drawLine(QPointF(plot.left(), y), QPointF(plot.right(), y));
+            painter.drawText(QRectF(margin, y - lineHeight / 2, labelWidth - margin, lineHeight),
+                             Qt::AlignRight | Qt::AlignVCenter, formatValue(top * (gridLines - i) / gridLines));
+        }
+
+        painter.setRenderHint(QPainter::Antialiasing);
+        double const span = std::max(1LL, last - first);
+        for (auto const& line : _lines) {
+            QPolygonF points;
+            for (size_t i = 0; i < line.series.size(); ++i) {
+                qreal const px = plot.left() + plot.width() * (line.series.time(i) - first) / span;
+                qreal const py = plot.bottom() - plot.height() * std::min(line.series.value(i), top) / top;
+                points << QPointF(px, py);
+            }
+
+            painter.setPen(QPen(line.color, 1.5));
+            if (points.size() == 1)
+                painter.drawEllipse(points.front(), 1.5, 1.5);
+            else
+                painter.drawPolyline(points);
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vector>
+
+#include <QColor>
+#include <QWidget>
+
+#include "robomongo/core/domain/ServerMetrics.h"
+
+namespace Robomongo
+{
+    /**
+     * @brief Line chart of metric series, painted directly with QPainter.
+     * Samples of all lines are scaled to the time range of the buffered samples.
+     */
+    class MetricChart : public QWidget
+    {
+        Q_OBJECT
+
+    public:
+        enum ValueFormat
+        {
+            NumberFormat,
+            BytesFormat,
+            PercentFormat
+        };
+
+        MetricChart(const QString &title, ValueFormat format, QWidget *parent = 0);
+
+        /**
+         * @returns index of added line
+         */
+        int addLine(const QString &name, const QColor &color);
+        void setSeries(int line, const MetricSeries &series);
+
+        /**
+         * @brief Fixed top of value axis, zero scales it to the largest sample
+         */
+        void setMaximum(double maximum);
+
+        QSize sizeHint() const;
+
+    protected:
+        void paintEvent(QPaintEvent *event);
+
+    private:
+        QString formatValue(double value) const;
+
+        struct Line
+        {
+            QString name;
+            QColor color;
+            MetricSeries series;
+        };
+
+        QString _title;
+        ValueFormat _format;
+        double _maximum;
+        std::vector<Line> _lines;
+    };
+}
@@ -10,6 +10,8 @@
 #include "robomongo/gui/dialogs/CreateDatabaseDialog.h"
 #include "robomongo/gui/dialogs/CopyCollectionDialog.h"
 #include "robomongo/gui/dialogs/DocumentTextEditor.h"
+#include "robomongo/gui/dialogs/IndexHealthDialog.h"
+#include "robomongo/gui/dialogs/SchemaAnalyzerDialog.h"
 #include "robomongo/gui/GuiRegistry.h"
 #include "robomongo/gui/utils/DialogUtils.h"
 
@@ -55,6 +57,11 @@ namespace Robomongo
         QAction *collectionStats = new QAction("Statistics", this);
         VERIFY(connect(collectionStats, SIGNAL(triggered()), SLOT(ui_collectionStatistics())));
 
+        QAction *indexHealth = new QAction("Index Health", this);
+        VERIFY(connect(indexHealth, SIGNAL(triggered()), SLOT(ui_indexHealth())));
+        QAction *analyzeSchema = new QAction("Analyze Schema...", this);
+        VERIFY(connect(analyzeSchema, SIGNAL(triggered()), SLOT(ui_analyzeSchema())));
+
         QAction *storageSize = new QAction("Storage Size", this);
         VERIFY(connect(storageSize, SIGNAL(triggered()), SLOT(ui_storageSize())));
 
@@ -98,6 +105,8 @@ namespace Robomongo
         BaseClass::_contextMenu->addAction(dropCollection);
         BaseClass::_contextMenu->addSeparator();
         BaseClass::_contextMenu->addAction(collectionStats);
+        BaseClass::_contextMenu->addAction(indexHealth);
+        BaseClass::_contextMenu->addAction(analyzeSchema);
         BaseClass::_contextMenu->addSeparator();
         BaseClass::_contextMenu->addAction(shardVersion);
         BaseClass::_contextMenu->addAction(shardDistribution);
@@ -291,6 +300,20 @@ namespace Robomongo
         openCurrentCollectionShell("stats()");
     }
 
+    void ExplorerCollectionTreeItem::ui_indexHealth()
+    {
+        IndexHealthDialog *dialog = new IndexHealthDialog(_collection->database()->server(), 
+                                                          _collection->info(), treeWidget());
+        dialog->show();
+    }
+
+    void ExplorerCollectionTreeItem::ui_analyzeSchema()
+    {
+        SchemaAnalyzerDialog *dialog = new SchemaAnalyzerDialog(_collection->database()->server(),
+                                                                _collection->info(), treeWidget());
+        dialog->show();
+    }
+
     void ExplorerCollectionTreeItem::ui_dropCollection()
     {
         // Ask user
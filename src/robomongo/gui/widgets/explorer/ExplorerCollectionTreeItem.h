@@ -44,6 +44,8 @@ namespace Robomongo
         void ui_removeDocument();
         void ui_updateDocument();
         void ui_collectionStatistics();
+        void ui_indexHealth();
+        void ui_analyzeSchema();
         void ui_removeAllDocuments();
         void ui_storageSize();
         void ui_totalIndexSize();
@@ -19,6 +19,9 @@
 #include "robomongo/gui/widgets/explorer/ExplorerDatabaseCategoryTreeItem.h"
 #include "robomongo/gui/widgets/explorer/ExplorerUserTreeItem.h"
 #include "robomongo/gui/widgets/explorer/ExplorerFunctionTreeItem.h"
+#include "robomongo/gui/dialogs/CurrentOpDialog.h"
+#include "robomongo/gui/dialogs/ProfilerDialog.h"
+#include "robomongo/gui/dialogs/StorageDialog.h"
 #include "robomongo/gui/GuiRegistry.h"
 
 
@@ -64,6 +67,12 @@ namespace Robomongo
         QAction *dbCurrOps = new QAction("Current Operations", this);
         VERIFY(connect(dbCurrOps, SIGNAL(triggered()), SLOT(ui_dbCurrentOps())));
 
+        QAction *dbProfiler = new QAction("Profiler", this);
+        VERIFY(connect(dbProfiler, SIGNAL(triggered()), SLOT(ui_dbProfiler())));
+
+        QAction *dbStorage = new QAction("Storage", this);
+        VERIFY(connect(dbStorage, SIGNAL(triggered()), SLOT(ui_dbStorage())));
+
         QAction *dbKillOp = new QAction("Kill Operation...", this);
         VERIFY(connect(dbKillOp, SIGNAL(triggered()), SLOT(ui_dbKillOp())));
 
@@ -80,9 +89,11 @@ namespace Robomongo
         BaseClass::_contextMenu->addAction(refreshDatabase);
         BaseClass::_contextMenu->addSeparator();
         BaseClass::_contextMenu->addAction(dbStats);
+        BaseClass::_contextMenu->addAction(dbStorage);
         BaseClass::_contextMenu->addSeparator();
         BaseClass::_contextMenu->addAction(dbCurrOps);
         BaseClass::_contextMenu->addAction(dbKillOp);
+        BaseClass::_contextMenu->addAction(dbProfiler);
         BaseClass::_contextMenu->addSeparator();
         BaseClass::_contextMenu->addAction(dbRepair);
         BaseClass::_contextMenu->addAction(dbDrop);
@@ -280,9 +291,16 @@ namespace Robomongo
         openCurrentDatabaseShell(_database, "db.stats()");
     }
 
+    void ExplorerDatabaseTreeItem::ui_dbStorage()
+    {
+        StorageDialog *dialog = new StorageDialog(_database->server(), _database->name(), treeWidget());
+        dialog->show();
+    }
+
     void ExplorerDatabaseTreeItem::ui_dbCurrentOps()
     {
-        openCurrentDatabaseShell(_database, "db.currentOp()");
+        CurrentOpDialog *dialog = new CurrentOpDialog(_database->server(), _database->name(), treeWidget());
+        dialog->show();
     }
 
     void ExplorerDatabaseTreeItem::ui_dbKillOp()
@@ -290,6 +308,12 @@ namespace Robomongo
         openCurrentDatabaseShell(_database, "db.killOp()", false, CursorPosition(0, -1));
     }
 
+    void ExplorerDatabaseTreeItem::ui_dbProfiler()
+    {
+        ProfilerDialog *dialog = new ProfilerDialog(_database->server(), _database->name(), treeWidget());
+        dialog->show();
+    }
+
     void ExplorerDatabaseTreeItem::ui_dbDrop()
     {
         auto const& buff = QString("Drop <b>%1</b> database?").arg(QtUtils::toQString(_database->name()));
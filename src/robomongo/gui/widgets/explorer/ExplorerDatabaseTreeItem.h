@@ -51,8 +51,10 @@ namespace Robomongo
 
     private Q_SLOTS:
         void ui_dbStatistics();
+        void ui_dbStorage();
         void ui_dbCurrentOps();
         void ui_dbKillOp();
+        void ui_dbProfiler();
         void ui_dbDrop();
         void ui_dbRepair();
         void ui_dbOpenShell();
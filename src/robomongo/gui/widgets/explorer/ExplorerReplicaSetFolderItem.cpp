@@ -3,6 +3,8 @@
 #include <QAction>
 #include <QMenu>
 
+#include <algorithm>
+
 #include "robomongo/core/settings/ConnectionSettings.h"
 #include "robomongo/core/settings/ReplicaSetSettings.h"
 #include "robomongo/core/domain/MongoServer.h"
@@ -11,6 +13,7 @@
 #include "robomongo/core/EventBus.h"
 #include "robomongo/core/utils/QtUtils.h"
 #include "robomongo/core/utils/Logger.h"
+#include "robomongo/gui/widgets/explorer/ExplorerReplicaSetTreeItem.h"
 #include "robomongo/gui/GuiRegistry.h"
 
 namespace
@@ -85,9 +88,36 @@ namespace Robomongo
             return;
         }
 
+        // Members are kept up to date by replica set monitor, so no refresh is needed
+        if (!_server->replicaSetStatus().empty())
+            return;
+
         _server->tryRefreshReplicaSetFolder(true);
     }
 
+    void ExplorerReplicaSetFolderItem::applyStatus(const ReplicaSetStatus &status)
+    {
+        long long maxLagMs = -1;
+        for (int i = 0; i < childCount(); ++i) {
+            auto memberItem = dynamic_cast<ExplorerReplicaSetTreeItem *>(child(i));
+            if (!memberItem)
+                continue;
+
+            std::string const name = memberItem->hostAndPort().toString();
+            for (auto const& member : status.members) {
+                if (member.name != name)
+                    continue;
+
+                memberItem->applyStatus(member);
+                maxLagMs = std::max(maxLagMs, member.lagMs);
+                break;
+            }
+        }
+
+        setToolTip(0, maxLagMs < 0 ? QString() 
+                                   : "Maximum replication lag: " + QString::number(maxLagMs / 1000.0, 'f', 1) + " s");
+    }
+
     void ExplorerReplicaSetFolderItem::on_repSetStatus()
     {
         if (!_server->replicaSetInfo()->primary.empty()) {
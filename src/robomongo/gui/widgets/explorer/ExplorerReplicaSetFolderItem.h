@@ -6,6 +6,7 @@ namespace Robomongo
 {
     class MongoServer;
     struct ReplicaSetFolderLoading;
+    struct ReplicaSetStatus;
 
     class ExplorerReplicaSetFolderItem : public ExplorerTreeItem
     {
@@ -19,6 +20,11 @@ namespace Robomongo
         void updateText();
         void disableSomeContextMenuActions();
         void expand();
+
+        /**
+         * @brief Updates member items in place with status sampled by replica set monitor
+         */
+        void applyStatus(const ReplicaSetStatus &status);
         void setRefreshFlag(bool state) { _refreshFlag = state; }
         bool refreshFlag() const { return _refreshFlag; }
 
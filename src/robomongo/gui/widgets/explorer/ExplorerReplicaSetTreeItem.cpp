@@ -104,6 +104,29 @@ namespace Robomongo
                               : GuiRegistry::instance().serverSecondaryIcon());
     }
 
+    void ExplorerReplicaSetTreeItem::applyStatus(const ReplicaSetMember &member)
+    {
+        updateTextAndIcon(member.healthy, member.isPrimary);
+        if (!member.healthy)
+            return;
+
+        // i.e. "SECONDARY" is shown as "Secondary"
+        QString stateStr = QString::fromStdString(member.state).toLower();
+        if (!stateStr.isEmpty())
+            stateStr[0] = stateStr[0].toUpper();
+        if (!member.isPrimary && member.lagMs >= 0)
+            stateStr += QString(", %1 s behind").arg(member.lagMs / 1000);
+        setText(0, QString::fromStdString(_repMemberHostAndPort.toString()) + " [" + stateStr + "]");
+
+        QStringList tooltip;
+        tooltip << "State: " + QString::fromStdString(member.state);
+        if (member.lagMs >= 0)
+            tooltip << "Replication lag: " + QString::number(member.lagMs / 1000.0, 'f', 1) + " s";
+        if (member.pingMs >= 0)
+            tooltip << "Heartbeat latency: " + QString::number(member.pingMs) + " ms";
+        setToolTip(0, tooltip.join("\n"));
+    }
+
     void ExplorerReplicaSetTreeItem::ui_serverHostInfo()
     {
         openCurrentServerShell(_server, _connSettings.get(), "db.hostInfo()");
@@ -28,9 +28,16 @@ namespace Robomongo
         */
         void updateTextAndIcon(bool isUp, bool isPrimary);
 
+        /**
+        * @brief Updates text, icon and tooltip with state, replication lag and heartbeat
+        * latency sampled by replica set monitor
+        */
+        void applyStatus(const ReplicaSetMember &member);
+
         // Getters
         ConnectionSettings* connectionSettings() { return _connSettings.get(); }
         bool isUp() const { return _isUp; }
+        const mongo::HostAndPort &hostAndPort() const { return _repMemberHostAndPort; }
         MongoServer* server() const { return _server; }
 
     private Q_SLOTS:
@@ -17,6 +17,7 @@
 #include "robomongo/gui/widgets/explorer/ExplorerReplicaSetFolderItem.h"
 #include "robomongo/gui/widgets/explorer/ExplorerReplicaSetTreeItem.h"
 #include "robomongo/gui/dialogs/CreateDatabaseDialog.h"
+#include "robomongo/gui/dialogs/ServerDashboardDialog.h"
 #include "robomongo/gui/GuiRegistry.h"
 
 
@@ -53,6 +54,9 @@ namespace Robomongo
         QAction *serverStatus = new QAction("Server Status", this);
         VERIFY(connect(serverStatus, SIGNAL(triggered()), SLOT(ui_serverStatus())));
 
+        QAction *serverDashboard = new QAction("Performance Dashboard", this);
+        VERIFY(connect(serverDashboard, SIGNAL(triggered()), SLOT(ui_serverDashboard())));
+
         QAction *serverVersion = new QAction("MongoDB Version", this);
         VERIFY(connect(serverVersion, SIGNAL(triggered()), SLOT(ui_serverVersion())));
 
@@ -71,6 +75,7 @@ namespace Robomongo
         BaseClass::_contextMenu->addSeparator();
         BaseClass::_contextMenu->addAction(createDatabase);
         BaseClass::_contextMenu->addAction(serverStatus);
+        BaseClass::_contextMenu->addAction(serverDashboard);
         BaseClass::_contextMenu->addAction(serverHostInfo);
         BaseClass::_contextMenu->addAction(serverVersion);
         BaseClass::_contextMenu->addSeparator();
@@ -80,6 +85,7 @@ namespace Robomongo
         _bus->subscribe(this, DatabaseListLoadedEvent::Type, _server);
         _bus->subscribe(this, MongoServerLoadingDatabasesEvent::Type, _server);
         _bus->subscribe(this, ReplicaSetFolderRefreshed::Type, _server);
+        _bus->subscribe(this, ReplicaSetStatusChanged::Type, _server);
         _bus->subscribe(this, ConnectionEstablishedEvent::Type, _server);
         _bus->subscribe(this, ConnectionFailedEvent::Type, _server);
 
@@ -107,18 +113,19 @@ namespace Robomongo
 
     void ExplorerServerTreeItem::disableSomeContextMenuActions(bool disable)
     {
-        if (BaseClass::_contextMenu->actions().size() < 10 || 
+        if (BaseClass::_contextMenu->actions().size() < 11 || 
             !_server->connectionRecord()->isReplicaSet())
             return;
 
-        // [1]:Refresh and [9]:Disconnect are always enabled
+        // [1]:Refresh and [10]:Disconnect are always enabled
         BaseClass::_contextMenu->actions().at(0)->setDisabled(disable);
         BaseClass::_contextMenu->actions().at(2)->setDisabled(disable);
         BaseClass::_contextMenu->actions().at(3)->setDisabled(disable);
         BaseClass::_contextMenu->actions().at(4)->setDisabled(disable);
         BaseClass::_contextMenu->actions().at(5)->setDisabled(disable);
         BaseClass::_contextMenu->actions().at(6)->setDisabled(disable);
-        BaseClass::_contextMenu->actions().at(8)->setDisabled(disable);
+        BaseClass::_contextMenu->actions().at(7)->setDisabled(disable);
+        BaseClass::_contextMenu->actions().at(9)->setDisabled(disable);
     }
 
     void ExplorerServerTreeItem::databaseRefreshed(const QList<MongoDatabase *> &dbs)
@@ -210,6 +217,20 @@ namespace Robomongo
         replicaSetPrimaryReachable();
     }
 
+    void ExplorerServerTreeItem::handle(ReplicaSetStatusChanged *event)
+    {
+        if (!_replicaSetFolder)
+            return;
+
+        // Primary or members changed, connection settings and database items are updated by full refresh
+        if (event->topologyChanged()) {
+            _server->tryRefreshReplicaSetFolder(_replicaSetFolder->isExpanded(), false);
+            return;
+        }
+
+        _replicaSetFolder->applyStatus(event->status());
+    }
+
     void ExplorerServerTreeItem::handle(ConnectionEstablishedEvent *event)
     {
         if (!_server->connectionRecord()->isReplicaSet() || 
@@ -259,6 +280,12 @@ namespace Robomongo
         openCurrentServerShell(_server, "db.serverStatus()");
     }
 
+    void ExplorerServerTreeItem::ui_serverDashboard()
+    {
+        ServerDashboardDialog *dialog = new ServerDashboardDialog(_server, treeWidget());
+        dialog->show();
+    }
+
     void ExplorerServerTreeItem::ui_serverVersion()
     {
         openCurrentServerShell(_server, "db.version()");
@@ -360,6 +387,9 @@ namespace Robomongo
                                                                         isPrimary, memberAndHealth.second));
         }
 
+        if (!_server->replicaSetStatus().empty())
+            _replicaSetFolder->applyStatus(_server->replicaSetStatus());
+
         _replicaSetFolder->setRefreshFlag(false);
         _replicaSetFolder->setExpanded(expanded);
         _replicaSetFolder->setRefreshFlag(true);
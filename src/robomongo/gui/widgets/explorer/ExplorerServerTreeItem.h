@@ -27,7 +27,7 @@ namespace Robomongo
         */
         void expand();
 
-        // Disable/enable menu items, except [1]:Refresh and [9]:Disconnect which are 
+        // Disable/enable menu items, except [1]:Refresh and [10]:Disconnect which are 
         // always enabled, according to replica set status (online or offline).
         void disableSomeContextMenuActions(bool disable);
 
@@ -36,6 +36,7 @@ namespace Robomongo
         void handle(DatabaseListLoadedEvent *event);
         void handle(MongoServerLoadingDatabasesEvent *event);
         void handle(ReplicaSetFolderRefreshed *event);
+        void handle(ReplicaSetStatusChanged *event);
 
         // Special handle for server refresh events for replica set connections only
         void handle(ConnectionEstablishedEvent *event);
@@ -51,6 +52,7 @@ namespace Robomongo
         void ui_createDatabase();
         void ui_serverHostInfo();
         void ui_serverStatus();
+        void ui_serverDashboard();
         void ui_serverVersion();
 
     private:
@@ -1,5 +1,7 @@
 #include "robomongo/gui/widgets/workarea/BsonTableModel.h"
 
+#include <algorithm>
+
 #include <QBrush>
 #include <QIcon>
 
@@ -10,21 +12,27 @@
 namespace Robomongo
 {
     BsonTableModelProxy::BsonTableModelProxy(QObject *parent) 
-        : BaseClass(parent)
+        : BaseClass(parent),
+        _rowsCount(0),
+        _filtered(false),
+        _flatten(false),
+        _root(NULL)
     {
-       
+
     }
 
     int BsonTableModelProxy::rowCount(const QModelIndex &parent) const
     {
-        int count = sourceModel()->rowCount(parent);
-        return count;
+        // Table is flat: only documents are shown as rows
+        if (parent.isValid())
+            return 0;
+
+        return _filtered ? static_cast<int>(_filterRows.size()) : _rowsCount;
     }
 
     QModelIndex BsonTableModelProxy::parent( const QModelIndex& index ) const
     {
-        QModelIndex sourceParent = sourceModel()->parent( mapToSource(index) );
-        return sourceParent;
+        return QModelIndex();
     }
 
     int BsonTableModelProxy::columnCount(const QModelIndex &parent) const
@@ -34,16 +42,26 @@ namespace Robomongo
 
     QModelIndex BsonTableModelProxy::mapFromSource( const QModelIndex & sourceIndex ) const
     {
-        int row = sourceIndex.row();
         int col = sourceIndex.column();
 
         BsonTreeItem *node = QtUtils::item<BsonTreeItem *>(sourceIndex);
         if (!node || _columns.size() <= col)
             return QModelIndex();
 
-        BsonTreeItem *child = node->childByKey(_columns[col]);
+        // Row of source index is already filtered by source model, so position of document is used
+        int row = node->superParent()->row();
+        if (row < 0 || _rowsCount <= row)
+            return QModelIndex();
+
+        if (_filtered) {
+            std::vector<unsigned>::const_iterator const it = std::lower_bound(_filterRows.begin(), _filterRows.end(), unsigned(row));
+            if (it == _filterRows.end() || *it != unsigned(row))
+                return QModelIndex();
 
-        return createIndex( row, col, child );
+            row = it - _filterRows.begin();
+        }
+
+        return createIndex( row, col, cell(row, col) );
     }
 
     QModelIndex BsonTableModelProxy::sibling(int row, int column, const QModelIndex &idx) const
@@ -53,13 +71,10 @@ namespace Robomongo
 
     QModelIndex BsonTableModelProxy::index( int row, int col, const QModelIndex& parent ) const
     {
-        BsonTreeItem *node = QtUtils::item<BsonTreeItem *>(sourceModel()->index(row, 0, parent));
-        if (!node || _columns.size() <= col)
+        if (parent.isValid() || row < 0 || col < 0 || rowCount() <= row || _columns.size() <= col)
             return QModelIndex();
 
-        BsonTreeItem *child = node->childByKey(_columns[col]);
-
-        return createIndex( row, col, child );
+        return createIndex( row, col, cell(row, col) );
     }
 
     QModelIndex BsonTableModelProxy::mapToSource( const QModelIndex &proxyIndex ) const
@@ -73,10 +88,12 @@ namespace Robomongo
         BsonTreeItem *child = static_cast<BsonTreeItem *>(proxyIndex.internalPointer());
         if (child) {
             QtUtils::HackQModelIndex* hack = reinterpret_cast<QtUtils::HackQModelIndex*>(&sourceIndex);
-            BsonTreeItem *parent = static_cast<BsonTreeItem *>(child->parent());
+
+            // Cell of flattened column belongs to subdocument, row is the document itself
+            const BsonTreeItem *document = child->superParent();
             hack->r = proxyIndex.row();
             hack->c = proxyIndex.column();
-            hack->i = parent;
+            hack->i = const_cast<BsonTreeItem *>(document);
             hack->m = sourceModel();
         }
         return sourceIndex;
@@ -84,23 +101,94 @@ namespace Robomongo
 
     void BsonTableModelProxy::setSourceModel( QAbstractItemModel* model )
     {
-        if (model) {
-            BsonTreeItem *child = QtUtils::item<BsonTreeItem *>(model->index(0, 0));
-            if (child) {
-                _root = qobject_cast<BsonTreeItem *>(child->parent());
-                if (_root) {
-                    int count = _root->childrenCount();
-                    for (int i = 0; i < count; ++i) {
-                        BsonTreeItem *child = _root->child(i);
-                        int countc = child->childrenCount();
-                        for (int j = 0; j < countc; ++j) {
-                            addColumn(child->child(j)->key());
-                        }
-                    }
-                }
+        _columns.clear();
+        _columnsIndex.clear();
+        _cells.clear();
+        _rowsCount = 0;
+        _filterRows.clear();
+        _filtered = false;
+        _flatten = false;
+        _root = NULL;
+
+        // Sets source model first, so that layoutCells() can fetch documents
+        BaseClass::setSourceModel(model);
+
+        BsonTreeModel *treeModel = qobject_cast<BsonTreeModel *>(model);
+        if (!treeModel)
+            return;
+
+        _root = treeModel->root();
+        _rowsCount = _root->childrenCount();
+
+        // Until schema is inferred, columns are top-level keys of this page
+        for (int i = 0; i < _rowsCount; ++i) {
+            BsonTreeItem *child = _root->child(i);
+            treeModel->fetch(child);
+            int countc = child->childrenCount();
+            for (int j = 0; j < countc; ++j) {
+                addColumn(child->child(j)->key());
             }
         }
-        return BaseClass::setSourceModel(model);
+
+        layoutCells();
+    }
+
+    void BsonTableModelProxy::setColumns(const std::vector<std::string> &paths, bool flatten)
+    {
+        beginResetModel();
+        _columns.clear();
+        _columnsIndex.clear();
+        _flatten = flatten;
+        for (std::vector<std::string>::const_iterator it = paths.begin(); it != paths.end(); ++it) {
+            addColumn(QtUtils::toQString(*it));
+        }
+        layoutCells();
+        endResetModel();
+    }
+
+    void BsonTableModelProxy::setRowsFilter(const std::vector<unsigned> &documents)
+    {
+        beginResetModel();
+        _filterRows = documents;
+        _filtered = true;
+        endResetModel();
+    }
+
+    void BsonTableModelProxy::clearRowsFilter()
+    {
+        if (!_filtered)
+            return;
+
+        beginResetModel();
+        std::vector<unsigned>().swap(_filterRows);
+        _filtered = false;
+        endResetModel();
+    }
+
+    void BsonTableModelProxy::layoutCells()
+    {
+        _cells.assign(_columns.size() * _rowsCount, NULL);
+        for (int i = 0; i < _rowsCount; ++i) {
+            layoutItem(_root->child(i), i, QString());
+        }
+    }
+
+    void BsonTableModelProxy::layoutItem(BsonTreeItem *parent, int row, const QString &prefix)
+    {
+        static_cast<BsonTreeModel *>(sourceModel())->fetch(parent);
+
+        int count = parent->childrenCount();
+        for (int j = 0; j < count; ++j) {
+            BsonTreeItem *child = parent->child(j);
+            QString const path = prefix.isEmpty() ? child->key() : prefix + "." + child->key();
+
+            QHash<QString, int>::const_iterator it = _columnsIndex.constFind(path);
+            if (it != _columnsIndex.constEnd())
+                _cells[it.value() * _rowsCount + row] = child;
+
+            if (_flatten && child->type() == mongo::Object)
+                layoutItem(child, row, path);
+        }
     }
 
     QVariant BsonTableModelProxy::data(const QModelIndex &index, int role) const
@@ -120,12 +208,14 @@ namespace Robomongo
         }
 
         if (role == Qt::DisplayRole || role == Qt::ToolTipRole) {
+            BsonTreeModel *model = static_cast<BsonTreeModel *>(sourceModel());
+            QString const value = model->itemValue(node);
             bool isCut = node->type() == mongo::String ||  node->type() == mongo::Code || node->type() == mongo::CodeWScope;  
             if (role == Qt::ToolTipRole) {
-                result = isCut ? node->value() : node->value().left(500); 
+                result = isCut ? value : value.left(500);
             }
             else{
-                result = isCut ? node->value() : node->value().simplified().left(300); 
+                result = isCut ? value : value.simplified().left(300);
             }
         }
         else if (role == Qt::DecorationRole) {
@@ -143,7 +233,8 @@ namespace Robomongo
         if (orientation == Qt::Horizontal && role == Qt::DisplayRole) {
             return column(section); 
         } else {
-            return QString("%1").arg(section + 1);
+            // Documents keep their numbers when filtered
+            return QString("%1").arg(documentRow(section) + 1);
         }
     }
 
@@ -152,22 +243,20 @@ namespace Robomongo
         return _columns[col];
     }
 
-    size_t BsonTableModelProxy::findIndexColumn(const QString &col) const
+    BsonTreeItem *BsonTableModelProxy::cell(int row, int col) const
     {
-        for (int i = 0; i < _columns.size(); ++i) {
-            if (_columns[i] == col) {
-                return i;
-            }
-        }
-        return _columns.size();
+        return _cells[col * _rowsCount + documentRow(row)];
     }
 
     size_t BsonTableModelProxy::addColumn(const QString &col)
     {
-        size_t column = findIndexColumn(col);
-        if (column == _columns.size()) {
-            _columns.push_back(col);
-        }
+        QHash<QString, int>::const_iterator it = _columnsIndex.constFind(col);
+        if (it != _columnsIndex.constEnd())
+            return it.value();
+
+        size_t column = _columns.size();
+        _columnsIndex.insert(col, column);
+        _columns.push_back(col);
         return column;
     }
 }
@@ -1,7 +1,9 @@
 #pragma once
+#include <string>
 #include <vector>
 
 #include <QAbstractProxyModel>
+#include <QHash>
 
 namespace Robomongo
 {
@@ -28,12 +30,47 @@ namespace Robomongo
         virtual void setSourceModel( QAbstractItemModel* model );
         virtual QModelIndex parent( const QModelIndex& index ) const;
         virtual QModelIndex sibling(int row, int column, const QModelIndex &idx) const;
+
+        /**
+         * @brief Replaces columns with the given dotted paths (i.e. inferred schema).
+         * When "flatten" is true, fields of subdocuments are shown in own columns.
+         */
+        void setColumns(const std::vector<std::string> &paths, bool flatten);
+
+        /**
+         * @brief Shows only documents at the given (ascending) positions
+         */
+        void setRowsFilter(const std::vector<unsigned> &documents);
+        void clearRowsFilter();
+
     private:
+        int documentRow(int row) const { return _filtered ? _filterRows[row] : row; }
         QString column(int col) const;
         size_t addColumn(const QString &col);
-        size_t findIndexColumn(const QString &col) const;
+        BsonTreeItem *cell(int row, int col) const;
+        void layoutCells();
+        void layoutItem(BsonTreeItem *parent, int row, const QString &prefix);
 
         ColumnsValuesType _columns;
+
+        /**
+         * @brief Column name -> column position, built once in setSourceModel()
+         */
+        QHash<QString, int> _columnsIndex;
+
+        /**
+         * @brief Dense column-major array of cells (items of document fields).
+         * Cell of (row, col) is located at (col * _rowsCount + row), NULL for
+         * documents that don't have such field.
+         */
+        std::vector<BsonTreeItem *> _cells;
+        int _rowsCount;
+
+        // Visible row -> position of document, when filtered
+        std::vector<unsigned> _filterRows;
+        bool _filtered;
+
+        bool _flatten;
         BsonTreeItem *_root;
     };
 }
@@ -1,74 +1,52 @@
 #include "robomongo/gui/widgets/workarea/BsonTreeItem.h"
 #include <mongo/client/dbclient_base.h>
 
+#include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/settings/SettingsManager.h"
+#include "robomongo/core/domain/MongoDocument.h"
+#include "robomongo/core/utils/BsonUtils.h"
+#include "robomongo/core/utils/QtUtils.h"
+
 using namespace mongo;
 namespace
 {
-    struct removeIfFound
-    {
-        removeIfFound(Robomongo::BsonTreeItem *item) :_whatSearch(item) {}
-        bool operator()(const Robomongo::BsonTreeItem* item) const
-        {
-            if (item == _whatSearch) {
-                delete _whatSearch;
-                return true;
-            }
-            return false;
-        }
-        const Robomongo::BsonTreeItem *const _whatSearch;
-    };
+    const Robomongo::BsonTreeItem::IndexType noIndex = ~Robomongo::BsonTreeItem::IndexType(0);
 
-    const Robomongo::BsonTreeItem *findSuperRoot(const Robomongo::BsonTreeItem *const item)
-    {
-        Robomongo::BsonTreeItem *parent = qobject_cast<Robomongo::BsonTreeItem *>(item->parent());
-        if (parent) {
-            Robomongo::BsonTreeItem *grParent = qobject_cast<Robomongo::BsonTreeItem *>(parent->parent());
-            if (grParent) {
-               return findSuperRoot(parent);
-            }
-        }
-        return item;
+    QString arrayValue(int itemsCount) {
+        QString elements = itemsCount == 1 ? "element" : "elements";
+        return QString("[ %1 %2 ]").arg(itemsCount).arg(elements);
+    }
+
+    QString objectValue(int itemsCount) {
+        QString fields = itemsCount == 1 ? "field" : "fields";
+        return QString("{ %1 %2 }").arg(itemsCount).arg(fields);
     }
 }
 namespace Robomongo
 {
-    BsonTreeItem::BsonTreeItem(QObject *parent) 
-        :BaseClass(parent)
-    {
-       
-    }
-
-    BsonTreeItem::BsonTreeItem(const mongo::BSONObj &bsonObjRoot, QObject *parent)
-        :BaseClass(parent),
-        _root(bsonObjRoot)
-    {
-
-    }
-
-    unsigned BsonTreeItem::childrenCount() const
-    {
-        return _items.size();
-    }
-
-    void BsonTreeItem::clear()
-    {
-        _items.clear();
-    }
-
-    void BsonTreeItem::addChild(BsonTreeItem *item)
+    BsonTreeItem::BsonTreeItem() :
+        _table(NULL),
+        _parent(noIndex),
+        _row(0),
+        _document(noIndex),
+        _offset(-1),
+        _firstChild(0),
+        _childrenCount(0),
+        _type(mongo::EOO),
+        _binType(mongo::BinDataGeneral),
+        _fetched(false)
     {
-        _items.push_back(item);
     }
 
     BsonTreeItem* BsonTreeItem::child(unsigned pos) const
     {
-        return _items[pos];
+        return _table->item(_firstChild + pos);
     }
 
     BsonTreeItem* BsonTreeItem::childSafe(unsigned pos) const
     {
         if (childrenCount() > pos) {
-            return _items[pos];
+            return child(pos);
         }
         else {
             return NULL;
@@ -77,81 +55,185 @@ namespace Robomongo
 
     BsonTreeItem* BsonTreeItem::childByKey(const QString &val)
     {
-        for (unsigned i = 0; i < _items.size(); ++i) {
-            if (_items[i]->key() == val) {
-                return _items[i];
+        for (unsigned i = 0; i < _childrenCount; ++i) {
+            BsonTreeItem *item = child(i);
+            if (item->key() == val) {
+                return item;
             }
         }
         return NULL;
     }
 
+    BsonTreeItem* BsonTreeItem::parent() const
+    {
+        if (_parent == noIndex)
+            return NULL;
+
+        return _table->item(_parent);
+    }
+
     const BsonTreeItem *BsonTreeItem::superParent() const
     {
-        return findSuperRoot(this);
+        if (_document == noIndex)
+            return this;
+
+        // Documents are stored right after the invisible root
+        return _table->item(_document + 1);
     }
 
     mongo::BSONObj BsonTreeItem::superRoot() const
     {
-        return superParent()->root();
+        if (_document == noIndex)
+            return mongo::BSONObj();
+
+        return _table->document(_document);
     }
 
     mongo::BSONObj BsonTreeItem::root() const
     {
-        return _root;
+        if (_document == noIndex)
+            return mongo::BSONObj();
+
+        if (isSuperRoot())
+            return superRoot();
+
+        return parent()->embeddedObject();
     }
 
-    int BsonTreeItem::indexOf(BsonTreeItem *item) const
+    mongo::BSONElement BsonTreeItem::element() const
     {
-        for (unsigned i = 0; i < _items.size(); ++i) {
-            if (item == _items[i]) {
-                return i;
-            }
-        }
-        return -1;
+        if (isSuperRoot())
+            return mongo::BSONElement();
+
+        return mongo::BSONElement(_table->document(_document).objdata() + _offset);
     }
 
-    QString BsonTreeItem::key() const
+    mongo::BSONObj BsonTreeItem::embeddedObject() const
     {
-        return _fields._key;
+        if (isSuperRoot())
+            return superRoot();
+
+        mongo::BSONElement elem = element();
+        if (elem.isABSONObj())
+            return elem.Obj();
+
+        return mongo::BSONObj();
     }
 
-    QString BsonTreeItem::value() const
+    std::string BsonTreeItem::fieldName() const
     {
-        return _fields._value;
+        if (isSuperRoot())
+            return std::string();
+
+        return element().fieldName();
     }
 
-    mongo::BSONType BsonTreeItem::type() const
+    QString BsonTreeItem::key() const
     {
-        return _fields._type;
+        if (isSuperRoot())
+            return QString();
+
+        QString uiFieldName = QtUtils::toQString(fieldName());
+
+        // When we iterate array, show field names in square brackets
+        // In this case field names are numeric, starting from 0.
+        if (BsonUtils::isArray(parent()->type()))
+            return "[" + uiFieldName + "]";
+
+        return uiFieldName;
     }
 
-    void BsonTreeItem::setKey(const QString &key)
+    QString BsonTreeItem::value() const
     {
-        _fields._key = key;
+        if (BsonUtils::isArray(type()))
+            return arrayValue(BsonUtils::elementsCount(embeddedObject()));
+
+        if (BsonUtils::isDocument(type()))
+            return objectValue(BsonUtils::elementsCount(embeddedObject()));
+
+        if (isSuperRoot())
+            return QString();
+
+        std::string result;
+        BsonUtils::buildJsonString(element(), result,
+                                   AppRegistry::instance().settingsManager()->uuidEncoding(),
+                                   AppRegistry::instance().settingsManager()->timeZone());
+        return QtUtils::toQString(result);
     }
 
-    void BsonTreeItem::setValue(const QString &value)
+    BsonTreeItemTable::BsonTreeItemTable(const std::vector<MongoDocumentPtr> &documents) :
+        _count(0)
     {
-        _fields._value = value;
+        _documents.reserve(documents.size());
+        for (auto const &doc : documents)
+            _documents.push_back(doc->bsonObj());
+
+        BsonTreeItem *root = allocate();
+        root->_firstChild = _count;
+        root->_childrenCount = _documents.size();
+        root->_fetched = true;
+
+        for (IndexType i = 0; i < _documents.size(); ++i) {
+            BsonTreeItem *item = allocate();
+            item->_parent = 0;
+            item->_row = i;
+            item->_document = i;
+            item->_type = _documents[i].isArray() ? mongo::Array : mongo::Object;
+        }
     }
 
-    void BsonTreeItem::setType(mongo::BSONType type)
+    BsonTreeItem *BsonTreeItemTable::item(IndexType index) const
     {
-       _fields._type = type;
+        return &_chunks[index >> ChunkBits][index & ChunkMask];
     }
 
-    mongo::BinDataType BsonTreeItem::binType() const
+    BsonTreeItemTable::IndexType BsonTreeItemTable::indexOf(const BsonTreeItem *item) const
     {
-        return _fields._binType;
+        if (item->_parent == noIndex)
+            return 0;
+
+        return this->item(item->_parent)->_firstChild + item->_row;
     }
 
-    void BsonTreeItem::setBinType(mongo::BinDataType type)
+    BsonTreeItem *BsonTreeItemTable::allocate()
     {
-        _fields._binType = type;
+        if ((_count & ChunkMask) == 0)
+            _chunks.emplace_back(new BsonTreeItem[ChunkSize]);
+
+        BsonTreeItem *item = this->item(_count++);
+        item->_table = this;
+        return item;
     }
 
-    void BsonTreeItem::removeChild(BsonTreeItem *item)
-    {
-        _items.erase(std::remove_if(_items.begin(), _items.end(), removeIfFound(item)), _items.end());
+    void BsonTreeItemTable::fetch(BsonTreeItem *parent)
+    {
+        if (parent->_fetched)
+            return;
+
+        parent->_fetched = true;
+        if (!BsonUtils::isDocument(parent->type()))
+            return;
+
+        IndexType const parentIndex = indexOf(parent);
+        mongo::BSONObj const obj = parent->embeddedObject();
+        const char *const base = _documents[parent->_document].objdata();
+
+        // Children are appended one after another, so that they can be
+        // found by index of the first child and position.
+        parent->_firstChild = _count;
+        IndexType row = 0;
+        mongo::BSONObjIterator iterator(obj);
+        while (iterator.more()) {
+            mongo::BSONElement element = iterator.next();
+            BsonTreeItem *item = allocate();
+            item->_parent = parentIndex;
+            item->_row = row++;
+            item->_document = parent->_document;
+            item->_offset = element.rawdata() - base;
+            item->_type = element.type();
+            if (element.type() == mongo::BinData)
+                item->_binType = element.binDataType();
+        }
+        parent->_childrenCount = row;
     }
 }
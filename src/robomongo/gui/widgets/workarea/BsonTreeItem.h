@@ -1,26 +1,27 @@
 #pragma once
 
+#include <memory>
 #include <vector>
-#include <QObject>
+#include <QString>
 #include <mongo/bson/bsonobj.h>
 #include <mongo/bson/bsonelement.h>
 
+#include "robomongo/core/Core.h"
+
 namespace Robomongo
 {
+    class BsonTreeItemTable;
+
     /**
      * @brief BSON tree item (represents array or object)
+     *
+     * Item is a plain node of BsonTreeItemTable. It doesn't keep any formatted
+     * strings or BSON copies, only indexes into the table and the offset of its
+     * element inside the document buffer. Children of the item are stored in the
+     * table contiguously, so child, parent and row lookups are O(1).
      */
-    struct BsonItemFields
-    {
-        QString _key;
-        QString _value;
-        mongo::BSONType _type;
-        mongo::BinDataType _binType;
-    };
-
-    class BsonTreeItem : public QObject
+    class BsonTreeItem
     {
-        Q_OBJECT
     public:
         enum eColumn
         {
@@ -30,45 +31,98 @@ namespace Robomongo
             eCountColumns = 3
         };
 
-        typedef QObject BaseClass;
-        typedef std::vector<BsonTreeItem*> ChildContainerType;
+        typedef quint32 IndexType;
 
-        explicit BsonTreeItem(QObject *parent = 0);
-        explicit BsonTreeItem(const mongo::BSONObj &bsonObjRoot, QObject *parent = 0);
+        BsonTreeItem();
 
-        unsigned childrenCount() const;
-        void clear();
-        void addChild(BsonTreeItem *item);
-        void removeChild(BsonTreeItem *item);
+        unsigned childrenCount() const { return _childrenCount; }
+        bool isFetched() const { return _fetched; }
         BsonTreeItem* child(unsigned pos) const;
         BsonTreeItem* childSafe(unsigned pos) const;
         BsonTreeItem* childByKey(const QString &val);
-        int indexOf(BsonTreeItem *item) const;
+        BsonTreeItem* parent() const;
+
+        /**
+         * @returns position of this item among children of its parent
+         */
+        int row() const { return _row; }
 
         const BsonTreeItem* superParent() const;
         mongo::BSONObj root() const;
         mongo::BSONObj superRoot() const;
 
-        std::string fieldName() const { return _fieldName; };
-        void setFieldName(const std::string &fieldName) { _fieldName = fieldName; };
+        /**
+         * @returns element this item represents, or EOO element for top-level items
+         */
+        mongo::BSONElement element() const;
 
-        QString key() const;
-        void setKey(const QString &key);
+        /**
+         * @returns object or array that should be used to build children of this item
+         */
+        mongo::BSONObj embeddedObject() const;
+
+        std::string fieldName() const;
 
+        QString key() const;
         QString value() const;
-        void setValue(const QString &value);
 
-        mongo::BSONType type() const;
-        void setType(mongo::BSONType type);
+        mongo::BSONType type() const { return static_cast<mongo::BSONType>(_type); }
+        mongo::BinDataType binType() const { return static_cast<mongo::BinDataType>(_binType); }
+
+    private:
+        friend class BsonTreeItemTable;
+
+        bool isSuperRoot() const { return _offset < 0; }
+
+        const BsonTreeItemTable *_table;
+        IndexType _parent;          // index of parent item in the table
+        IndexType _row;             // position among children of the parent
+        IndexType _document;        // index of the document this item belongs to
+        qint32 _offset;             // offset of the element from the beginning of document, -1 for documents
+        IndexType _firstChild;      // index of the first child in the table
+        IndexType _childrenCount;
+        qint8 _type;
+        quint8 _binType;
+        bool _fetched;
+    };
+
+    /**
+     * @brief Flat, arena allocated storage of BsonTreeItem nodes.
+     *
+     * Node #0 is invisible root, nodes #1..N are documents. Nodes are allocated in
+     * fixed size chunks, so pointers to them stay valid while the table grows.
+     */
+    class BsonTreeItemTable
+    {
+    public:
+        typedef BsonTreeItem::IndexType IndexType;
+
+        explicit BsonTreeItemTable(const std::vector<MongoDocumentPtr> &documents);
+
+        BsonTreeItem *root() const { return item(0); }
+        BsonTreeItem *item(IndexType index) const;
+        IndexType itemsCount() const { return _count; }
+
+        /**
+         * @brief Bytes taken by allocated nodes (documents are not counted)
+         */
+        size_t memoryUsage() const { return _chunks.size() * ChunkSize * sizeof(BsonTreeItem); }
+
+        const mongo::BSONObj &document(IndexType index) const { return _documents[index]; }
+
+        /**
+         * @brief Appends children of "parent" to the table, if not yet done.
+         */
+        void fetch(BsonTreeItem *parent);
 
-        mongo::BinDataType binType() const;
-        void setBinType(mongo::BinDataType type);
+    private:
+        IndexType indexOf(const BsonTreeItem *item) const;
+        BsonTreeItem *allocate();
 
-    protected:
+        enum { ChunkBits = 12, ChunkSize = 1 << ChunkBits, ChunkMask = ChunkSize - 1 };
 
-        const mongo::BSONObj _root;
-        ChildContainerType _items;
-        BsonItemFields _fields;
-        std::string _fieldName;
+        std::vector<mongo::BSONObj> _documents;
+        std::vector<std::unique_ptr<BsonTreeItem[]> > _chunks;
+        IndexType _count;
     };
 }
@@ -0,0 +1,161 @@
+#include "gtest/gtest.h"
+#include "robomongo/gui/widgets/workarea/BsonTreeItem.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <QObject>
+#include <QString>
+
+#include <mongo/bson/bsonobjbuilder.h>
+
+#include "robomongo/core/domain/MongoDocument.h"
+#include "robomongo/core/utils/BsonUtils.h"
+#include "robomongo/core/utils/QtUtils.h"
+
+using namespace Robomongo;
+
+namespace
+{
+    std::vector<MongoDocumentPtr> buildDocuments(int count, int fields)
+    {
+        std::vector<MongoDocumentPtr> documents;
+        for (int i = 0; i < count; ++i) {
+            mongo::BSONObjBuilder builder;
+            for (int j = 0; j < fields; ++j)
+                builder.append("f" + std::to_string(j), j);
+            documents.push_back(MongoDocument::fromBsonObj(builder.obj()));
+        }
+        return documents;
+    }
+
+    // Layout of the tree item before BsonTreeItemTable: QObject per node, children vector,
+    // key and value strings and a copy of the parent document
+    class QObjectTreeItem : public QObject
+    {
+    public:
+        QObjectTreeItem(const mongo::BSONObj &root, QObject *parent) : QObject(parent), _root(root) {}
+
+        std::vector<QObjectTreeItem *> _items;
+        const mongo::BSONObj _root;
+        QString _key;
+        QString _value;
+        mongo::BSONType _type;
+        std::string _fieldName;
+
+        int indexOf(QObjectTreeItem *item) const
+        {
+            for (unsigned i = 0; i < _items.size(); ++i) {
+                if (_items[i] == item)
+                    return i;
+            }
+            return -1;
+        }
+    };
+
+    // Same work as parseDocument() of BsonTreeModel did for every element
+    void parseDocument(QObjectTreeItem *parent, const mongo::BSONObj &doc)
+    {
+        mongo::BSONObjIterator iterator(doc);
+        while (iterator.more()) {
+            mongo::BSONElement element = iterator.next();
+            QObjectTreeItem *item = new QObjectTreeItem(doc, parent);
+            item->_fieldName = element.fieldName();
+            item->_key = QtUtils::toQString(item->_fieldName);
+
+            std::string value;
+            BsonUtils::buildJsonString(element, value, DefaultEncoding, Utc);
+            item->_value = QtUtils::toQString(value);
+            item->_type = element.type();
+            parent->_items.push_back(item);
+        }
+    }
+}
+
+TEST(BsonTreeItemBench, fetch_OneMillionNodes_NavigationIsConstantTime)
+{
+    const int documentsCount = 1000;
+    const int fieldsCount = 1000;
+    std::vector<MongoDocumentPtr> documents = buildDocuments(documentsCount, fieldsCount);
+
+    auto const start = std::chrono::steady_clock::now();
+
+    BsonTreeItemTable table(documents);
+    BsonTreeItem *root = table.root();
+    for (unsigned i = 0; i < root->childrenCount(); ++i)
+        table.fetch(root->child(i));
+
+    auto const built = std::chrono::steady_clock::now();
+
+    // Walk every node the way QTreeView does: index() -> parent() -> row()
+    for (unsigned i = 0; i < root->childrenCount(); ++i) {
+        BsonTreeItem *doc = root->child(i);
+        ASSERT_EQ(unsigned(fieldsCount), doc->childrenCount());
+        for (unsigned j = 0; j < doc->childrenCount(); ++j) {
+            BsonTreeItem *item = doc->child(j);
+            ASSERT_EQ(doc, item->parent());
+            ASSERT_EQ(int(j), item->row());
+        }
+    }
+
+    auto const walked = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(1u + documentsCount + documentsCount * fieldsCount, table.itemsCount());
+
+    using std::chrono::duration_cast;
+    using std::chrono::milliseconds;
+    std::cout << "[ BENCH    ] " << table.itemsCount() << " nodes, "
+              << sizeof(BsonTreeItem) << " bytes per node, "
+              << (table.itemsCount() * sizeof(BsonTreeItem)) / (1024 * 1024) << " MB total; "
+              << "build " << duration_cast<milliseconds>(built - start).count() << " ms, "
+              << "walk " << duration_cast<milliseconds>(walked - built).count() << " ms"
+              << std::endl;
+}
+
+// The same tree built with the layout used before BsonTreeItemTable, for comparison
+// with fetch_OneMillionNodes_NavigationIsConstantTime
+TEST(BsonTreeItemBench, fetch_OneMillionNodes_QObjectTreeForComparison)
+{
+    const int documentsCount = 1000;
+    const int fieldsCount = 1000;
+    std::vector<MongoDocumentPtr> documents = buildDocuments(documentsCount, fieldsCount);
+
+    auto const start = std::chrono::steady_clock::now();
+
+    QObjectTreeItem *root = new QObjectTreeItem(mongo::BSONObj(), nullptr);
+    for (auto const& document : documents) {
+        QObjectTreeItem *doc = new QObjectTreeItem(document->bsonObj(), root);
+        parseDocument(doc, document->bsonObj());
+        root->_items.push_back(doc);
+    }
+
+    auto const built = std::chrono::steady_clock::now();
+
+    // Row of item was found with indexOf() in its parent
+    for (auto const doc : root->_items) {
+        ASSERT_EQ(size_t(fieldsCount), doc->_items.size());
+        for (unsigned j = 0; j < doc->_items.size(); ++j) {
+            QObjectTreeItem *item = doc->_items[j];
+            QObjectTreeItem *parent = static_cast<QObjectTreeItem *>(item->parent());
+            ASSERT_EQ(doc, parent);
+            ASSERT_EQ(int(j), parent->indexOf(item));
+        }
+    }
+
+    auto const walked = std::chrono::steady_clock::now();
+
+    delete root;
+
+    auto const deleted = std::chrono::steady_clock::now();
+
+    // Heap of QObject private data and strings is not included in the object size
+    using std::chrono::duration_cast;
+    using std::chrono::milliseconds;
+    std::cout << "[ BENCH    ] QObject tree: " << 1 + documentsCount + documentsCount * fieldsCount << " nodes, "
+              << sizeof(QObjectTreeItem) << " bytes per node object plus heap; "
+              << "build " << duration_cast<milliseconds>(built - start).count() << " ms, "
+              << "walk " << duration_cast<milliseconds>(walked - built).count() << " ms, "
+              << "delete " << duration_cast<milliseconds>(deleted - walked).count() << " ms"
+              << std::endl;
+}
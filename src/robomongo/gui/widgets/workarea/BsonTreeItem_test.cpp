@@ -0,0 +1,42 @@
+#include "gtest/gtest.h"
+#include "robomongo/gui/widgets/workarea/BsonTreeItem.h"
+
+#include <mongo/bson/bsonobjbuilder.h>
+
+#include "robomongo/core/domain/MongoDocument.h"
+
+using namespace Robomongo;
+
+TEST(BsonTreeItemTests, fetch_NestedDocument_ParentsAndRowsAreConsistent)
+{
+    mongo::BSONObjBuilder inner;
+    inner.append("x", 1);
+    inner.append("y", "text");
+
+    mongo::BSONObjBuilder builder;
+    builder.append("_id", 42);
+    builder.append("sub", inner.obj());
+    std::vector<MongoDocumentPtr> documents { MongoDocument::fromBsonObj(builder.obj()) };
+
+    BsonTreeItemTable table(documents);
+    BsonTreeItem *root = table.root();
+    ASSERT_EQ(1u, root->childrenCount());
+
+    BsonTreeItem *doc = root->child(0);
+    EXPECT_FALSE(doc->isFetched());
+    table.fetch(doc);
+    ASSERT_EQ(2u, doc->childrenCount());
+
+    BsonTreeItem *sub = doc->child(1);
+    EXPECT_EQ("sub", sub->fieldName());
+    EXPECT_EQ(mongo::Object, sub->type());
+    EXPECT_EQ(doc, sub->parent());
+    EXPECT_EQ(1, sub->row());
+
+    table.fetch(sub);
+    ASSERT_EQ(2u, sub->childrenCount());
+    EXPECT_EQ("y", sub->child(1)->fieldName());
+    EXPECT_EQ(sub, sub->child(1)->parent());
+    EXPECT_EQ(doc, sub->child(1)->superParent());
+    EXPECT_EQ(42, sub->child(1)->superRoot().getIntField("_id"));
+}
@@ -13,106 +13,82 @@ namespace
 {
     using namespace Robomongo;
 
-    QString arrayValue(int itemsCount) {
-        QString elements = itemsCount == 1 ? "element" : "elements";
-        return QString("[ %1 %2 ]").arg(itemsCount).arg(elements);
-    }
-
-    QString objectValue(int itemsCount) {
-        QString fields = itemsCount == 1 ? "field" : "fields";
-        return QString("{ %1 %2 }").arg(itemsCount).arg(fields);
-    }
-
-    void parseDocument(BsonTreeItem *root, const mongo::BSONObj &doc, bool isArray)
-    {            
-            mongo::BSONObjIterator iterator(doc);
-            while (iterator.more())
-            {
-                mongo::BSONElement element = iterator.next();                
-                BsonTreeItem *childItemInner = new BsonTreeItem(doc, root);
-                std::string fieldName = std::string(element.fieldName());
-                childItemInner->setFieldName(fieldName);
-
-                QString uiFieldName = QtUtils::toQString(fieldName);
-                childItemInner->setKey(uiFieldName);
-
-                if (isArray) {
-                    // When we iterate array, show field names in square brackets
-                    // In this case field names are numeric, starting from 0.
-                    childItemInner->setKey("[" + uiFieldName + "]");
-                }
-
-                if (BsonUtils::isArray(element)) {
-                    int itemsCount = element.Array().size();
-                    childItemInner->setValue(arrayValue(itemsCount));
-                }
-                else if (BsonUtils::isDocument(element)) {
-                    int count = BsonUtils::elementsCount(element.Obj());
-                    childItemInner->setValue(objectValue(count));
-                }
-                else {
-                    std::string result;
-                    BsonUtils::buildJsonString(element, result, AppRegistry::instance().settingsManager()->uuidEncoding(), AppRegistry::instance().settingsManager()->timeZone());
-                    childItemInner->setValue(QtUtils::toQString(result));
-                }
-                childItemInner->setType(element.type());
-                if (element.type() == mongo::BinData) {
-                    childItemInner->setBinType(element.binDataType());
-                }
-                root->addChild(childItemInner);
-                //root->setValue(QString("{ %1 fields }").arg(root->childrenCount()));
-            }            
-    }
+    /**
+     * @brief Number of formatted values kept by the model. Only visible rows
+     * are formatted, so this only needs to be a few screens worth of items.
+     */
+    const int valueCacheSize = 2048;
 }
 
 namespace Robomongo
 {
     BsonTreeModel::BsonTreeModel(const std::vector<MongoDocumentPtr> &documents, QObject *parent) :
         BaseClass(parent),
-        _root(new BsonTreeItem(this))
+        _table(documents),
+        _root(_table.root()),
+        _valueCache(valueCacheSize),
+        _filtered(false)
     {
-        for (int i = 0; i < documents.size(); ++i) {
-            MongoDocumentPtr doc = documents[i]; 
-            BsonTreeItem *child = new BsonTreeItem(doc->bsonObj(), _root);
-            parseDocument(child, doc->bsonObj(), doc->bsonObj().isArray());
-
-            QString idValue;
-            BsonTreeItem *idItem = child->childByKey("_id");
-            if (idItem) {
-                idValue = idItem->value();
-            }
-
-            child->setKey(QString("(%1) %2").arg(i + 1).arg(idValue));
-
-            int count = BsonUtils::elementsCount(doc->bsonObj());
-
-            if (doc->bsonObj().isArray()) {
-                child->setValue(arrayValue(count));
-                child->setType(mongo::Array);
-            } else {
-                child->setValue(objectValue(count));
-                child->setType(mongo::Object);
-            }
-            _root->addChild(child);
-        }
+        // Children of documents are parsed on demand in fetchMore()
     }
 
     void BsonTreeModel::fetchMore(const QModelIndex &parent)
     {
         BsonTreeItem *node = QtUtils::item<BsonTreeItem*>(parent);
         if (node) {
-            mongo::BSONElement elem = BsonUtils::indexOf(node->root(), parent.row());
-            if (!elem.isNull() && elem.isABSONObj()) {
-                parseDocument(node, elem.Obj(), elem.type() == mongo::Array);
-            }            
+            // Only remember where every element is located in the BSON buffer.
+            // Key, value and type strings are built lazily in data()
+            _table.fetch(node);
         }
         return BaseClass::fetchMore(parent);
     }
 
+    void BsonTreeModel::fetch(BsonTreeItem *item)
+    {
+        _table.fetch(item);
+    }
+
+    size_t BsonTreeModel::memoryUsage() const
+    {
+        // Cached values are short strings, that rarely exceed 64 characters
+        return _table.memoryUsage() + _valueCache.size() * (sizeof(QString) + 64 * sizeof(QChar));
+    }
+
+    void BsonTreeModel::setDocumentsFilter(const std::vector<unsigned> &documents)
+    {
+        beginResetModel();
+        _filterRows = documents;
+        _filterPositions.assign(_root->childrenCount(), -1);
+        for (size_t i = 0; i < _filterRows.size(); ++i)
+            _filterPositions[_filterRows[i]] = static_cast<int>(i);
+        _filtered = true;
+        endResetModel();
+    }
+
+    void BsonTreeModel::clearDocumentsFilter()
+    {
+        if (!_filtered)
+            return;
+
+        beginResetModel();
+        std::vector<unsigned>().swap(_filterRows);
+        std::vector<int>().swap(_filterPositions);
+        _filtered = false;
+        endResetModel();
+    }
+
+    int BsonTreeModel::visibleRow(const BsonTreeItem *node) const
+    {
+        if (_filtered && node->parent() == _root)
+            return _filterPositions[node->row()];
+
+        return node->row();
+    }
+
     bool BsonTreeModel::canFetchMore(const QModelIndex &parent) const
     {
         BsonTreeItem *node = QtUtils::item<BsonTreeItem*>(parent);
-        if (node && !node->childrenCount()) {
+        if (node && !node->isFetched()) {
             return BsonUtils::isDocument(node->type());
         }
         return false;
@@ -176,16 +152,18 @@ namespace Robomongo
         if (role == Qt::DisplayRole || role == Qt::ToolTipRole) {
             if (col == BsonTreeItem::eKey) {
                 if (role == Qt::DisplayRole) {
-                    result = node->key();
+                    // Documents keep their numbers when filtered
+                    result = itemKey(node, node->row());
                 }
             }
             else if (col == BsonTreeItem::eValue) {
+                QString const value = itemValue(node);
                 bool isCut = node->type() == mongo::String ||  node->type() == mongo::Code || node->type() == mongo::CodeWScope;  
                 if (role == Qt::ToolTipRole) {
-                    result = isCut ? node->value().left(500) : node->value(); 
+                    result = isCut ? value.left(500) : value; 
                 }
                 else{
-                    result = isCut ? node->value().simplified().left(300) : node->value(); 
+                    result = isCut ? value.simplified().left(300) : value; 
                 }
             }
             else if (col == BsonTreeItem::eType) {
@@ -196,6 +174,33 @@ namespace Robomongo
         return result;
     }
 
+    QString BsonTreeModel::itemKey(const BsonTreeItem *node, int row) const
+    {
+        if (node->parent() != _root)
+            return node->key();
+
+        // Top-level documents are captioned with their position and _id value
+        QString idValue;
+        mongo::BSONElement id = node->root().getField("_id");
+        if (!id.eoo()) {
+            std::string result;
+            BsonUtils::buildJsonString(id, result, AppRegistry::instance().settingsManager()->uuidEncoding(), AppRegistry::instance().settingsManager()->timeZone());
+            idValue = QtUtils::toQString(result);
+        }
+
+        return QString("(%1) %2").arg(row + 1).arg(idValue);
+    }
+
+    QString BsonTreeModel::itemValue(const BsonTreeItem *node) const
+    {
+        if (QString *cached = _valueCache.object(node))
+            return *cached;
+
+        QString value = node->value();
+        _valueCache.insert(node, new QString(value));
+        return value;
+    }
+
     Qt::ItemFlags BsonTreeModel::flags(const QModelIndex &index) const
     {
         Qt::ItemFlags result = 0;
@@ -210,6 +215,8 @@ namespace Robomongo
         const BsonTreeItem *parentItem = NULL;
         if (parent.isValid())
             parentItem = QtUtils::item<BsonTreeItem*>(parent);
+        else if (_filtered)
+            return _filterRows.size();
         else
             parentItem = _root;
 
@@ -246,11 +253,9 @@ namespace Robomongo
         QModelIndex result;
         if (index.isValid()) {
             BsonTreeItem *const childItem = QtUtils::item<BsonTreeItem*const>(index);
-            BsonTreeItem *const parentItem = static_cast<BsonTreeItem*const>(childItem->parent());
+            BsonTreeItem *const parentItem = childItem->parent();
             if (parentItem && parentItem != _root) {
-                BsonTreeItem *const grandParent = static_cast<BsonTreeItem*const>(parentItem->parent());
-                int row = grandParent->indexOf(parentItem);
-                result = createIndex(row, 0, parentItem);
+                result = createIndex(visibleRow(parentItem), 0, parentItem);
             }
         }
         return result;
@@ -267,32 +272,11 @@ namespace Robomongo
                 parentItem = QtUtils::item<BsonTreeItem*>(parent);
             }
 
-            BsonTreeItem *childItem = parentItem->child(row);
+            BsonTreeItem *childItem = parentItem->child(parentItem == _root && _filtered ? _filterRows[row] : row);
             if (childItem) {
                 index = createIndex(row, column, childItem);
             }
         }
         return index;
     }
-
-    void BsonTreeModel::insertItem(BsonTreeItem *parent, BsonTreeItem *children)
-    {
-        QModelIndex index = createIndex(0, 0, parent);
-        unsigned child_count = parent->childrenCount();
-        beginInsertRows(index, child_count, child_count);
-        parent->addChild(children);
-        endInsertRows();
-    }
-
-    void BsonTreeModel::removeitem(BsonTreeItem *children)
-    {
-        BsonTreeItem *parent = static_cast<BsonTreeItem *>(children->parent());
-        if (parent) {
-            QModelIndex index = createIndex(0, 0, parent);
-            int row = parent->indexOf(children);
-            beginRemoveRows(index, row, row);
-            parent->removeChild(children);
-            endRemoveRows();
-        }
-    }
 }
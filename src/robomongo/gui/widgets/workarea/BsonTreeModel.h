@@ -1,12 +1,12 @@
 #pragma once
 #include <vector>
 #include <QAbstractItemModel>
+#include <QCache>
 #include "robomongo/core/Core.h"
+#include "robomongo/gui/widgets/workarea/BsonTreeItem.h"
 
 namespace Robomongo
 {
-    class BsonTreeItem;
-
     class BsonTreeModel : public QAbstractItemModel
     {
         Q_OBJECT
@@ -25,13 +25,56 @@ namespace Robomongo
         virtual QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const;
         virtual QModelIndex parent(const QModelIndex& index) const;
 
-        void insertItem(BsonTreeItem *parent, BsonTreeItem *children);
-        void removeitem(BsonTreeItem *children);
-
         virtual void fetchMore(const QModelIndex &parent);
         virtual bool canFetchMore(const QModelIndex &parent) const;
         virtual bool hasChildren(const QModelIndex &parent = QModelIndex()) const;
+
+        /**
+         * @returns formatted value of the item, cached for recently shown items
+         */
+        QString itemValue(const BsonTreeItem *node) const;
+
+        /**
+         * @brief Invisible root item, its children are documents
+         */
+        BsonTreeItem *root() const { return _root; }
+
+        /**
+         * @brief Builds children of item, if not yet done
+         */
+        void fetch(BsonTreeItem *item);
+
+        /**
+         * @brief Approximate bytes taken by the model on top of documents it shows
+         */
+        size_t memoryUsage() const;
+
+        /**
+         * @brief Shows only documents at the given (ascending) positions
+         */
+        void setDocumentsFilter(const std::vector<unsigned> &documents);
+        void clearDocumentsFilter();
+        bool isFiltered() const { return _filtered; }
+
     protected:
+        QString itemKey(const BsonTreeItem *node, int row) const;
+
+        /**
+         * @returns row under which item is shown, differs from its position only for filtered documents
+         */
+        int visibleRow(const BsonTreeItem *node) const;
+
+        BsonTreeItemTable _table;
         BsonTreeItem *const _root;
+
+        /**
+         * @brief LRU cache of formatted values of the recently shown items
+         */
+        mutable QCache<const BsonTreeItem *, QString> _valueCache;
+
+        // Visible row -> position of document, and position of document -> visible row (-1 if hidden)
+        std::vector<unsigned> _filterRows;
+        std::vector<int> _filterPositions;
+        bool _filtered;
     };
 }
@@ -2,19 +2,38 @@
 
 #include <QHeaderView>
 #include <QAction>
+#include <QElapsedTimer>
+#include <QHBoxLayout>
+#include <QLabel>
 #include <QMenu>
 #include <QKeyEvent>
+#include <QPushButton>
+#include <QTimer>
 
 #include "robomongo/core/utils/QtUtils.h"
 #include "robomongo/gui/GuiRegistry.h"
 #include "robomongo/gui/widgets/workarea/BsonTreeItem.h"
 #include "robomongo/gui/widgets/workarea/OutputWidget.h"
 
+namespace
+{
+    // Time spent on expanding in one event loop iteration, so that UI stays responsive
+    const int expandSliceMs = 15;
+
+    // Number of items expanded before user is asked to continue
+    const int expandBatchSize = 5000;
+
+    // Children of an item are listed in one pass, so items larger than this are
+    // fetched at the start of a slice rather than after other work
+    const int expandLargeItemBytes = 1024 * 1024;
+}
+
 namespace Robomongo
 {
     BsonTreeView::BsonTreeView(MongoShell *shell, const MongoQueryInfo &queryInfo, QWidget *parent)
         : BaseClass(parent), _notifier(this, shell, queryInfo), 
-          _outputItemContentWidget(dynamic_cast<const OutputItemContentWidget*>(parent))
+          _outputItemContentWidget(dynamic_cast<const OutputItemContentWidget*>(parent)),
+          _expandedCount(0), _expandLimit(0)
     {
 #if defined(Q_OS_MAC)
         setAttribute(Qt::WA_MacShowFocusRect, false);
@@ -33,6 +52,27 @@ namespace Robomongo
         _collapseRecursive->setShortcut(QKeySequence(Qt::ALT + Qt::Key_Left));
         VERIFY(connect(_collapseRecursive, SIGNAL(triggered()), SLOT(onCollapseRecursive())));
 
+        _expandTimer = new QTimer(this);
+        _expandTimer->setInterval(0);
+        VERIFY(connect(_expandTimer, SIGNAL(timeout()), this, SLOT(expandStep())));
+
+        // Progress of recursive expansion, shown over the bottom of the tree
+        _expandPanel = new QFrame(this);
+        _expandPanel->setStyleSheet("QFrame {background-color: #e1e1e1; border: 0px solid #c7c5c4; border-radius: 6px;}");
+        _expandLabel = new QLabel;
+        _expandMoreButton = new QPushButton("Show more");
+        VERIFY(connect(_expandMoreButton, SIGNAL(clicked()), this, SLOT(expandMore())));
+        QPushButton *cancelButton = new QPushButton("Cancel");
+        VERIFY(connect(cancelButton, SIGNAL(clicked()), this, SLOT(cancelExpand())));
+
+        QHBoxLayout *expandLayout = new QHBoxLayout;
+        expandLayout->setContentsMargins(8, 4, 8, 4);
+        expandLayout->addWidget(_expandLabel);
+        expandLayout->addWidget(_expandMoreButton);
+        expandLayout->addWidget(cancelButton);
+        _expandPanel->setLayout(expandLayout);
+        _expandPanel->hide();
+
         setStyleSheet("QTreeView { border-left: 1px solid #c7c5c4; border-top: 1px solid #c7c5c4; }");
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
         header()->setSectionResizeMode(QHeaderView::Interactive);
@@ -83,11 +123,20 @@ namespace Robomongo
     {
         BaseClass::resizeEvent(event);
         header()->resizeSections(QHeaderView::Stretch);
+
+        if (_expandPanel->isVisible())
+            updateExpandPanel();
     }
 
     void BsonTreeView::keyPressEvent(QKeyEvent *event)
     {
         switch (event->key()) {
+            case Qt::Key_Escape:
+                if (_expandPanel->isVisible()) {
+                    cancelExpand();
+                    return;
+                }
+                break;
             case Qt::Key_Delete:
                 _notifier.handleDeleteCommand();
                 break;
@@ -111,16 +160,124 @@ namespace Robomongo
 
     void BsonTreeView::expandNode(const QModelIndex &index)
     {
-        if (index.isValid()) {
-            BaseClass::expand(index);
-            BsonTreeItem *item = QtUtils::item<BsonTreeItem*>(index);
-            for (unsigned i = 0; i < item->childrenCount(); ++i) {
-                BsonTreeItem *tritem = item->child(i);
-                if (tritem && detail::isDocumentType(tritem)) {
-                    expandNode(model()->index(i, 0, index));
+        if (!index.isValid())
+            return;
+
+        _expandQueue.push_back(QPersistentModelIndex(index));
+        if (!_expandPanel->isVisible())
+            startExpand();
+        else if (!_expandTimer->isActive())
+            expandMore();
+    }
+
+    void BsonTreeView::startExpand()
+    {
+        _expandedCount = 0;
+        _expandLimit = expandBatchSize;
+        _expandTimer->start();
+        updateExpandPanel();
+    }
+
+    void BsonTreeView::expandStep()
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        // Expanded items are only remembered, tree is laid out once after the slice
+        scheduleDelayedItemsLayout();
+
+        bool sliceStarted = false;
+        while (_expandedCount < _expandLimit && timer.elapsed() < expandSliceMs) {
+            QModelIndex index;
+            if (_expandStack.empty()) {
+                if (_expandQueue.empty())
+                    break;
+                index = _expandQueue.front();
+            } else {
+                ExpandCursor &cursor = _expandStack.back();
+
+                // Index is invalidated when model is reset, i.e. when documents are filtered
+                if (!cursor.parent.isValid()) {
+                    _expandStack.clear();
+                    continue;
                 }
+
+                BsonTreeItem *item = QtUtils::item<BsonTreeItem*>(cursor.parent);
+                if (cursor.next >= item->childrenCount()) {
+                    _expandStack.pop_back();
+                    continue;
+                }
+
+                BsonTreeItem *tritem = item->child(cursor.next);
+                if (!tritem || !detail::isDocumentType(tritem)) {
+                    ++cursor.next;
+                    continue;
+                }
+                index = model()->index(cursor.next, 0, cursor.parent);
             }
+
+            BsonTreeItem *node = index.isValid() ? QtUtils::item<BsonTreeItem*>(index) : NULL;
+            if (sliceStarted && node && !node->isFetched() && node->embeddedObject().objsize() > expandLargeItemBytes)
+                break;
+
+            if (_expandStack.empty())
+                _expandQueue.pop_front();
+            else
+                ++_expandStack.back().next;
+
+            if (!node)
+                continue;
+
+            if (model()->canFetchMore(index))
+                model()->fetchMore(index);
+
+            BaseClass::expand(index);
+            ++_expandedCount;
+            sliceStarted = true;
+            _expandStack.push_back(ExpandCursor(index));
+        }
+
+        if (_expandQueue.empty() && _expandStack.empty()) {
+            cancelExpand();
+            return;
         }
+
+        if (_expandedCount >= _expandLimit)
+            _expandTimer->stop();
+
+        updateExpandPanel();
+    }
+
+    void BsonTreeView::expandMore()
+    {
+        _expandLimit = _expandedCount + expandBatchSize;
+        _expandTimer->start();
+        updateExpandPanel();
+        setFocus();
+    }
+
+    void BsonTreeView::cancelExpand()
+    {
+        _expandTimer->stop();
+        std::deque<QPersistentModelIndex>().swap(_expandQueue);
+        std::vector<ExpandCursor>().swap(_expandStack);
+        _expandPanel->hide();
+    }
+
+    void BsonTreeView::updateExpandPanel()
+    {
+        bool const paused = !_expandTimer->isActive();
+        if (paused)
+            _expandLabel->setText(QString("Expanded %1 items, more are left").arg(_expandedCount));
+        else
+            _expandLabel->setText(QString("Expanding: %1 items (Esc to cancel)").arg(_expandedCount));
+        _expandMoreButton->setVisible(paused);
+
+        QRect const area = viewport()->geometry();
+        _expandPanel->adjustSize();
+        _expandPanel->move(area.left() + 8, area.bottom() - _expandPanel->height() - 8);
+        _expandPanel->show();
+        _expandPanel->raise();
     }
     
     void BsonTreeView::collapseNode(const QModelIndex &index)
@@ -139,6 +296,8 @@ namespace Robomongo
 
     void BsonTreeView::onExpandRecursive()
     {
+        cancelExpand();
+
         QModelIndexList indexes = selectedIndexes();
         if (detail::isMultiSelection(indexes)) {
             for (int i = 0; i<indexes.count(); ++i)
@@ -150,6 +309,8 @@ namespace Robomongo
 
     void BsonTreeView::onCollapseRecursive()
     {
+        cancelExpand();
+
         QModelIndexList indexes = selectedIndexes();
         if (detail::isMultiSelection(indexes)) {
             for (int i = 0; i<indexes.count(); ++i)
@@ -1,10 +1,19 @@
 #pragma once
 
 #include <QTreeView>
+#include <QPersistentModelIndex>
+#include <deque>
+#include <vector>
 
 #include "robomongo/core/domain/Notifier.h"
 #include "robomongo/gui/widgets/workarea/OutputItemContentWidget.h"
 
+QT_BEGIN_NAMESPACE
+class QLabel;
+class QPushButton;
+class QTimer;
+QT_END_NAMESPACE
+
 namespace Robomongo
 {
     class InsertDocumentResponse;
@@ -18,6 +27,11 @@ namespace Robomongo
         BsonTreeView(MongoShell *shell, const MongoQueryInfo &queryInfo, QWidget *parent = NULL);
         virtual QModelIndex selectedIndex() const;
         virtual QModelIndexList selectedIndexes() const;
+
+        /**
+         * @brief Expands item with all nested items. Work is done in small slices
+         * in the event loop, and paused after every few thousands of items.
+         */
         void expandNode(const QModelIndex &index);
         void collapseNode(const QModelIndex &index);
         
@@ -25,15 +39,43 @@ namespace Robomongo
         void onExpandRecursive();
         void onCollapseRecursive();
         void showContextMenu(const QPoint &point);
+        void expandStep();
+        void expandMore();
+        void cancelExpand();
 
     protected:
         virtual void resizeEvent(QResizeEvent *event);
         virtual void keyPressEvent(QKeyEvent *event);
         
     private:
+        void startExpand();
+        void updateExpandPanel();
+
+        // Item whose children are being expanded, and position of its next child
+        struct ExpandCursor
+        {
+            explicit ExpandCursor(const QModelIndex &index) : parent(index), next(0) {}
+            QPersistentModelIndex parent;
+            unsigned next;
+        };
+
         Notifier _notifier;
         QAction *_expandRecursive;
         QAction *_collapseRecursive;
         const OutputItemContentWidget* _outputItemContentWidget;
+
+        // Items waiting for recursive expansion
+        std::deque<QPersistentModelIndex> _expandQueue;
+
+        // Path from the item being expanded to the current level, children are expanded
+        // depth first and the walk is resumed from here in the next slice
+        std::vector<ExpandCursor> _expandStack;
+        QTimer *_expandTimer;
+        int _expandedCount;
+        int _expandLimit;
+
+        QFrame *_expandPanel;
+        QLabel *_expandLabel;
+        QPushButton *_expandMoreButton;
     };
 }
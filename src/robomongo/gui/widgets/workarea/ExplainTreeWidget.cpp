@@ -0,0 +1,271 @@
+#include "robomongo/gui/widgets/workarea/ExplainTreeWidget.h"
+
+#include <algorithm>
+
+#include <QHeaderView>
+
+#include <mongo/bson/bsonobjbuilder.h>
+
+#include "robomongo/core/domain/MongoDocument.h"
+#include "robomongo/core/domain/PipelineProfile.h"
+#include "robomongo/core/utils/ExplainUtils.h"
+#include "robomongo/core/utils/QtUtils.h"
+
+namespace
+{
+    const QColor collectionScanColor(255, 221, 221);
+    const QColor blockingSortColor(255, 236, 204);
+    const QColor wastefulColor(255, 248, 196);
+
+    QString numberText(const mongo::BSONElement &element)
+    {
+        return element.isNumber() ? QString::number(element.safeNumberLong()) : QString();
+    }
+
+    void highlight(QTreeWidgetItem *item, const QColor &color, const QString &toolTip)
+    {
+        for (int column = 0; column < item->treeWidget()->columnCount(); ++column) {
+            item->setBackground(column, color);
+            item->setToolTip(column, toolTip);
+        }
+    }
+
+    // Parameters of stage that matter most when reading the plan
+    std::string stageDetails(const mongo::BSONObj &stage)
+    {
+        std::vector<std::string> details;
+        if (stage.hasField("indexName"))
+            details.push_back(std::string(stage.getStringField("indexName")) + " " + stage.getObjectField("keyPattern").toString());
+        if (stage["isMultiKey"].trueValue())
+            details.push_back("multikey");
+        if (stage.hasField("direction") && std::string("forward") != stage.getStringField("direction"))
+            details.push_back(stage.getStringField("direction"));
+        if (stage["sortPattern"].isABSONObj())
+            details.push_back("sort " + stage.getObjectField("sortPattern").toString());
+        if (stage["usedDisk"].trueValue())
+            details.push_back("used disk");
+        if (stage["filter"].isABSONObj())
+            details.push_back("filter " + stage.getObjectField("filter").toString());
+        if (stage.hasField("limitAmount"))
+            details.push_back("limit " + stage["limitAmount"].toString(false));
+        if (stage.hasField("skipAmount"))
+            details.push_back("skip " + stage["skipAmount"].toString(false));
+        if (stage["transformBy"].isABSONObj())
+            details.push_back("project " + stage.getObjectField("transformBy").toString());
+
+        std::string result;
+        for (auto const& detail : details)
+            result += (result.empty() ? "" : ", ") + detail;
+        return result;
+    }
+
+    bool hasStage(const mongo::BSONObj &plan, bool (*predicate)(const mongo::BSONObj &))
+    {
+        if (predicate(plan))
+            return true;
+
+        if (plan["inputStage"].isABSONObj() && hasStage(plan.getObjectField("inputStage"), predicate))
+            return true;
+
+        for (mongo::BSONObjIterator it(plan.getObjectField("inputStages")); it.more(); ) {
+            mongo::BSONElement const input = it.next();
+            if (input.isABSONObj() && hasStage(input.Obj(), predicate))
+                return true;
+        }
+        return false;
+    }
+
+    bool isCollectionScan(const mongo::BSONObj &stage)
+    {
+        return std::string("COLLSCAN") == stage.getStringField("stage");
+    }
+}
+
+namespace Robomongo
+{
+    ExplainTreeWidget::ExplainTreeWidget(const std::vector<MongoDocumentPtr> &documents, QWidget *parent)
+        : QTreeWidget(parent)
+    {
+        QStringList colums;
+        colums << "Stage" << "Returned" << "Keys Examined" << "Docs Examined" << "Time, ms" << "Details";
+        setHeaderLabels(colums);
+
+        setStyleSheet(
+            "QTreeWidget { border-left: 1px solid #c7c5c4; border-top: 1px solid #c7c5c4; }"
+        );
+
+        for (auto const& document : documents)
+            addExplain(document->bsonObj(), NULL);
+
+        header()->resizeSections(QHeaderView::ResizeToContents);
+    }
+
+    void ExplainTreeWidget::addExplain(const mongo::BSONObj &explain, QTreeWidgetItem *parent)
+    {
+        // Sharded aggregation, or query on 4.4+
+        mongo::BSONElement const shards = explain["shards"];
+        if (shards.isABSONObj()) {
+            for (mongo::BSONObjIterator it(shards.Obj()); it.more(); ) {
+                mongo::BSONElement const shard = it.next();
+                if (shard.isABSONObj())
+                    addExplain(shard.Obj(), addItem(QString("Shard %1").arg(shard.fieldName()), parent));
+            }
+            return;
+        }
+
+        if (explain["stages"].isABSONObj()) {
+            addPipeline(explain, parent);
+            return;
+        }
+
+        mongo::BSONObj const queryPlanner = explain.getObjectField("queryPlanner");
+        mongo::BSONObj const executionStats = explain.getObjectField("executionStats");
+
+        // Sharded query before 4.4, every shard has its plans and statistics
+        mongo::BSONObj const winningPlan = queryPlanner.getObjectField("winningPlan");
+        if (winningPlan["shards"].isABSONObj()) {
+            std::vector<mongo::BSONObj> shardStats;
+            for (mongo::BSONObjIterator it(executionStats.getObjectField("executionStages").getObjectField("shards")); it.more(); )
+                shardStats.push_back(it.next().Obj());
+
+            size_t index = 0;
+            for (mongo::BSONObjIterator it(winningPlan.getObjectField("shards")); it.more(); ++index) {
+                mongo::BSONObj const shard = it.next().Obj();
+                QTreeWidgetItem *item = addItem(QString("Shard %1").arg(QtUtils::toQString(std::string(shard.getStringField("shardName")))), parent);
+                addQuery(shard, index < shardStats.size() ? shardStats[index] : mongo::BSONObj(), item);
+            }
+            return;
+        }
+
+        addQuery(queryPlanner, executionStats, parent);
+    }
+
+    void ExplainTreeWidget::addQuery(const mongo::BSONObj &queryPlanner, const mongo::BSONObj &executionStats,
+                                     QTreeWidgetItem *parent)
+    {
+        mongo::BSONObj const winningPlan = ExplainUtils::classicPlan(queryPlanner.getObjectField("winningPlan"));
+
+        // Totals of the query
+        QTreeWidgetItem *summary = addItem("Summary", parent);
+        std::string details = "Plan: " + ExplainUtils::planSummary(winningPlan);
+        if (hasStage(winningPlan, ExplainUtils::isBlockingSort))
+            details += ", blocking sort";
+        if (queryPlanner["indexFilterSet"].trueValue())
+            details += ", index filter set";
+        summary->setText(DetailsColumn, QtUtils::toQString(details));
+
+        if (!executionStats.isEmpty()) {
+            summary->setText(ReturnedColumn, numberText(executionStats["nReturned"]));
+            summary->setText(KeysColumn, numberText(executionStats["totalKeysExamined"]));
+            summary->setText(DocsColumn, numberText(executionStats["totalDocsExamined"]));
+            summary->setText(TimeColumn, numberText(executionStats["executionTimeMillis"]));
+
+            long long const examined = std::max(executionStats["totalKeysExamined"].safeNumberLong(),
+                                                executionStats["totalDocsExamined"].safeNumberLong());
+            if (ExplainUtils::isWasteful(examined, executionStats["nReturned"].safeNumberLong()))
+                highlight(summary, wastefulColor, "Query examines many more keys or documents than it returns");
+        }
+
+        if (hasStage(winningPlan, isCollectionScan))
+            highlight(summary, collectionScanColor, "Query reads the whole collection, no index is used");
+
+        // Stages with statistics are shown when plans of both engines agree
+        mongo::BSONObj const executionStages = executionStats.getObjectField("executionStages");
+        bool const classic = !queryPlanner.getObjectField("winningPlan")["queryPlan"].isABSONObj();
+        addStage(classic && !executionStages.isEmpty() ? executionStages : winningPlan, 
+                 addItem("Winning Plan", parent));
+
+        mongo::BSONObj const rejectedPlans = queryPlanner.getObjectField("rejectedPlans");
+        if (rejectedPlans.isEmpty())
+            return;
+
+        QTreeWidgetItem *rejected = addItem(QString("Rejected Plans (%1)").arg(rejectedPlans.nFields()), parent);
+        int number = 1;
+        for (mongo::BSONObjIterator it(rejectedPlans); it.more(); ++number) {
+            mongo::BSONObj const plan = ExplainUtils::classicPlan(it.next().Obj());
+            QTreeWidgetItem *item = addItem(QString("Plan %1").arg(number), rejected);
+            item->setText(DetailsColumn, QtUtils::toQString(ExplainUtils::planSummary(plan)));
+            addStage(plan, item);
+        }
+
+        // Rejected plans are rarely needed, only their summaries are shown
+        for (int i = 0; i < rejected->childCount(); ++i)
+            rejected->child(i)->setExpanded(false);
+    }
+
+    void ExplainTreeWidget::addPipeline(const mongo::BSONObj &explain, QTreeWidgetItem *parent)
+    {
+        mongo::BSONObj const stages = explain.getObjectField("stages");
+        mongo::BSONObj const first = stages.firstElement().isABSONObj() ? stages.firstElement().Obj() : mongo::BSONObj();
+        if (first["$cursor"].isABSONObj()) {
+            mongo::BSONObj const cursor = first.getObjectField("$cursor");
+            addQuery(cursor.getObjectField("queryPlanner"), cursor.getObjectField("executionStats"), 
+                     addItem("Query", parent));
+        }
+
+        PipelineProfile profile;
+        ExplainUtils::parsePipelineExplain(explain, profile);
+
+        QTreeWidgetItem *pipeline = addItem("Pipeline", parent);
+        int index = 0;
+        for (mongo::BSONObjIterator it(stages); it.more() && index < static_cast<int>(profile.stages.size()); ++index) {
+            mongo::BSONElement const element = it.next();
+            PipelineStageProfile const &stage = profile.stages[index];
+
+            QTreeWidgetItem *item = addItem(QtUtils::toQString(stage.name), pipeline);
+            if (stage.docsOut >= 0)
+                item->setText(ReturnedColumn, QString::number(stage.docsOut));
+            if (stage.timeMillis >= 0)
+                item->setText(TimeColumn, QString::number(stage.timeMillis));
+            if (stage.name != "$cursor" && element.isABSONObj())
+                item->setText(DetailsColumn, QtUtils::toQString(element.Obj().firstElement().toString(false)));
+            if (stage.spilled)
+                highlight(item, blockingSortColor, "Stage used disk, data did not fit in memory");
+        }
+    }
+
+    QTreeWidgetItem *ExplainTreeWidget::addStage(const mongo::BSONObj &stage, QTreeWidgetItem *parent)
+    {
+        QTreeWidgetItem *item = addItem(QtUtils::toQString(std::string(stage.getStringField("stage"))), parent);
+        item->setText(ReturnedColumn, numberText(stage["nReturned"]));
+        item->setText(KeysColumn, numberText(stage["keysExamined"]));
+        item->setText(DocsColumn, numberText(stage["docsExamined"]));
+        item->setText(TimeColumn, numberText(stage["executionTimeMillisEstimate"]));
+        item->setText(DetailsColumn, QtUtils::toQString(stageDetails(stage)));
+
+        long long const examined = std::max(stage["keysExamined"].safeNumberLong(), stage["docsExamined"].safeNumberLong());
+        if (isCollectionScan(stage))
+            highlight(item, collectionScanColor, "Collection scan reads every document");
+        else if (ExplainUtils::isBlockingSort(stage))
+            highlight(item, blockingSortColor, "Blocking sort: all input is read and sorted in memory");
+        else if (ExplainUtils::isWasteful(examined, stage["nReturned"].safeNumberLong()))
+            highlight(item, wastefulColor, "Stage examines many more keys or documents than it returns");
+
+        if (stage["inputStage"].isABSONObj())
+            addStage(stage.getObjectField("inputStage"), item);
+
+        for (mongo::BSONObjIterator it(stage.getObjectField("inputStages")); it.more(); ) {
+            mongo::BSONElement const input = it.next();
+            if (input.isABSONObj())
+                addStage(input.Obj(), item);
+        }
+
+        return item;
+    }
+
+    QTreeWidgetItem *ExplainTreeWidget::addItem(const QString &title, QTreeWidgetItem *parent)
+    {
+        QTreeWidgetItem *item = new QTreeWidgetItem;
+        item->setText(StageColumn, title);
+        for (int column = ReturnedColumn; column <= TimeColumn; ++column)
+            item->setTextAlignment(column, Qt::AlignRight | Qt::AlignVCenter);
+
+        if (parent)
+            parent->addChild(item);
+        else
+            addTopLevelItem(item);
+
+        item->setExpanded(true);
+        return item;
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <QTreeWidget>
+
+#include <mongo/bson/bsonobj.h>
+
+#include "robomongo/core/Core.h"
+
+namespace Robomongo
+{
+    /**
+     * @brief Renders explain() output: summary of the query, stage tree of the winning
+     * plan with keys and documents examined against returned, and rejected plans.
+     * Collection scans, blocking sorts and stages examining much more than they
+     * return are highlighted.
+     */
+    class ExplainTreeWidget : public QTreeWidget
+    {
+        Q_OBJECT
+    public:
+        ExplainTreeWidget(const std::vector<MongoDocumentPtr> &documents, QWidget *parent = NULL);
+
+    private:
+        enum Column
+        {
+            StageColumn,
+            ReturnedColumn,
+            KeysColumn,
+            DocsColumn,
+            TimeColumn,
+            DetailsColumn
+        };
+
+        void addExplain(const mongo::BSONObj &explain, QTreeWidgetItem *parent);
+        void addQuery(const mongo::BSONObj &queryPlanner, const mongo::BSONObj &executionStats,
+                      QTreeWidgetItem *parent);
+        void addPipeline(const mongo::BSONObj &explain, QTreeWidgetItem *parent);
+        QTreeWidgetItem *addStage(const mongo::BSONObj &stage, QTreeWidgetItem *parent);
+        QTreeWidgetItem *addItem(const QString &title, QTreeWidgetItem *parent);
+    };
+}
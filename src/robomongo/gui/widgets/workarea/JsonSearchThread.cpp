@@ -0,0 +1,100 @@
+#include "robomongo/gui/widgets/workarea/JsonSearchThread.h"
+
+#include <algorithm>
+
+#include "robomongo/core/domain/MongoDocument.h"
+#include "robomongo/core/utils/QtUtils.h"
+#include "robomongo/gui/widgets/workarea/JsonTextView.h"
+
+namespace
+{
+    // Offset of character at (line, index), or size of text if position is beyond the end.
+    // Index is in bytes of UTF-8 form of the line.
+    int offsetOf(const QString &text, int line, int index)
+    {
+        int position = 0;
+        for (int i = 0; i < line; ++i) {
+            position = text.indexOf('\n', position);
+            if (position < 0)
+                return text.size();
+            ++position;
+        }
+
+        int end = text.indexOf('\n', position);
+        if (end < 0)
+            end = text.size();
+
+        QByteArray const utf8 = text.midRef(position, end - position).toUtf8();
+        if (index >= utf8.size())
+            return std::min(position + QString::fromUtf8(utf8).size() + (index - utf8.size()), text.size());
+
+        return position + QString::fromUtf8(utf8.constData(), std::max(index, 0)).size();
+    }
+}
+
+namespace Robomongo
+{
+    JsonSearchThread::JsonSearchThread(const std::vector<MongoDocumentPtr> &bsonObjects, UUIDEncoding uuidEncoding, SupportedTimes timeZone,
+                                       const QString &text, bool caseSensitive, bool forward,
+                                       size_t startDocument, int startLine, int startIndex)
+        :_bsonObjects(bsonObjects),
+        _uuidEncoding(uuidEncoding),
+        _timeZone(timeZone),
+        _text(text),
+        _caseSensitive(caseSensitive),
+        _forward(forward),
+        _startDocument(startDocument),
+        _startLine(startLine),
+        _startIndex(startIndex),
+        _stop(false)
+    {
+    }
+
+    void JsonSearchThread::stop()
+    {
+        _stop = true;
+    }
+
+    void JsonSearchThread::run()
+    {
+        size_t const count = _bsonObjects.size();
+        Qt::CaseSensitivity const cs = _caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
+
+        // Start document is visited twice: first from the cursor, and
+        // in the end (after wrap around) as a whole
+        for (size_t step = 0; step <= count && count > 0; ++step)
+        {
+            if (_stop)
+                return;
+
+            size_t const document = _forward ? (_startDocument + step) % count
+                                             : (_startDocument + count - step % count) % count;
+
+            mongo::BSONObj obj = _bsonObjects[document]->bsonObj();
+            QString const json = QtUtils::toQString(JsonTextView::formatDocument(obj, document + 1, _uuidEncoding, _timeZone));
+
+            int offset = -1;
+            if (step == 0) {
+                int const from = offsetOf(json, _startLine, _startIndex);
+                if (_forward)
+                    offset = json.indexOf(_text, from, cs);
+                else if (from > 0)
+                    offset = json.lastIndexOf(_text, from - 1, cs);
+            }
+            else {
+                offset = _forward ? json.indexOf(_text, 0, cs) : json.lastIndexOf(_text, -1, cs);
+            }
+
+            if (offset < 0)
+                continue;
+
+            int const lineStart = offset > 0 ? json.lastIndexOf('\n', offset - 1) + 1 : 0;
+            emit found(document, json.leftRef(offset).count('\n'), json.midRef(lineStart, offset - lineStart).toUtf8().size(),
+                       json.midRef(offset, _text.size()).toUtf8().size());
+            return;
+        }
+
+        if (!_stop)
+            emit notFound();
+    }
+}
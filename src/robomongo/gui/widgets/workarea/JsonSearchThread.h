@@ -0,0 +1,66 @@
+#pragma once
+
+#include <QThread>
+#include <atomic>
+#include <vector>
+
+#include "robomongo/core/Core.h"
+
+#include "robomongo/core/Enums.h"
+
+namespace Robomongo
+{
+    /*
+    ** In this thread we are searching text in JSON of list of BSON objects.
+    ** Documents are formatted one by one, starting from the given position,
+    ** so that search doesn't need the whole text to be in memory.
+    */
+    class JsonSearchThread : public QThread
+    {
+        Q_OBJECT
+
+    public:
+        /*
+        ** Constructor. Search starts in "startDocument" at "startLine" and "startIndex"
+        ** (relative to the first line of the document) and wraps around the end.
+        ** Index is in bytes of UTF-8 text, as in the editor.
+        */
+        JsonSearchThread(const std::vector<MongoDocumentPtr> &bsonObjects, UUIDEncoding uuidEncoding, SupportedTimes timeZone,
+                         const QString &text, bool caseSensitive, bool forward,
+                         size_t startDocument, int startLine, int startIndex);
+        void stop();
+
+    Q_SIGNALS:
+        /**
+         * @brief Signals position of the match, line is relative to the first line of document.
+         * Index and length of the match are in bytes of UTF-8 text.
+         */
+        void found(int document, int line, int index, int length);
+
+        /**
+         * @brief Signals when all documents are searched without match
+         */
+        void notFound();
+
+    protected:
+
+        /*
+        ** Overload function
+        */
+        virtual void run();
+    private:
+        /*
+        ** List of documents (documents are shared, not copied)
+        */
+        const std::vector<MongoDocumentPtr> _bsonObjects;
+        const UUIDEncoding _uuidEncoding;
+        const SupportedTimes _timeZone;
+        const QString _text;
+        const bool _caseSensitive;
+        const bool _forward;
+        const size_t _startDocument;
+        const int _startLine;
+        const int _startIndex;
+        std::atomic<bool> _stop;
+    };
+}
@@ -0,0 +1,368 @@
+#include "robomongo/gui/widgets/workarea/JsonTextView.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include <QElapsedTimer>
+#include <QHBoxLayout>
+#include <QMessageBox>
+#include <QScrollBar>
+#include <QTimer>
+#include <QVBoxLayout>
+
+#include "robomongo/core/domain/MongoDocument.h"
+#include "robomongo/core/utils/BsonUtils.h"
+#include "robomongo/core/utils/Logger.h"
+#include "robomongo/core/utils/QtUtils.h"
+#include "robomongo/core/utils/StringUtils.h"
+#include "robomongo/gui/editors/PlainJavaScriptEditor.h"
+#include "robomongo/gui/widgets/workarea/JsonSearchThread.h"
+
+namespace
+{
+    // Number of lines formatted above and below the viewport
+    const int marginLines = 1000;
+
+    // Minimum interval between re-renders of the window while scroll bar is dragged (~60 fps)
+    const int renderIntervalMs = 16;
+
+    // Number of documents taken by a thread at once
+    const size_t blockSize = 64;
+
+    // Calls func(i) for every i in [first, last). Blocks of documents are spread
+    // across a pool of threads, the calling thread is one of them.
+    template <typename Func>
+    void parallelFor(size_t first, size_t last, Func func)
+    {
+        size_t const blocksCount = (last - first + blockSize - 1) / blockSize;
+        std::atomic<size_t> nextBlock(0);
+
+        auto worker = [&]() {
+            for (size_t block = nextBlock++; block < blocksCount; block = nextBlock++) {
+                size_t const end = std::min(last, first + (block + 1) * blockSize);
+                for (size_t i = first + block * blockSize; i < end; ++i)
+                    func(i);
+            }
+        };
+
+        size_t const threadsCount = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), blocksCount);
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < threadsCount; ++i)
+            threads.emplace_back(worker);
+
+        worker();
+        for (std::vector<std::thread>::iterator it = threads.begin(); it != threads.end(); ++it)
+            it->join();
+    }
+}
+
+namespace Robomongo
+{
+    JsonTextView::JsonTextView(QWidget *parent) :
+        BaseClass(parent),
+        _uuidEncoding(DefaultEncoding),
+        _timeZone(Utc),
+        _firstLines(1, 0),
+        _windowFirst(0),
+        _windowLast(0),
+        _scrollBar(new QScrollBar(Qt::Vertical, this)),
+        _renderTimer(new QTimer(this)),
+        _searchThread(NULL),
+        _scrolling(false)
+    {
+        // Editor and external scroll bar (that covers all documents) go side by side
+        QVBoxLayout *mainLayout = static_cast<QVBoxLayout *>(layout());
+        mainLayout->removeWidget(sciScintilla());
+        QHBoxLayout *textLayout = new QHBoxLayout();
+        textLayout->setContentsMargins(0, 0, 0, 0);
+        textLayout->setSpacing(0);
+        textLayout->addWidget(sciScintilla(), 1);
+        textLayout->addWidget(_scrollBar);
+        mainLayout->insertLayout(0, textLayout, 1);
+        _scrollBar->hide();
+
+        _renderTimer->setSingleShot(true);
+        _renderTimer->setInterval(renderIntervalMs);
+        VERIFY(connect(_renderTimer, SIGNAL(timeout()), this, SLOT(renderScrollBarLine())));
+
+        VERIFY(connect(_scrollBar, SIGNAL(valueChanged(int)), this, SLOT(scrollBarMoved(int))));
+        VERIFY(connect(sciScintilla()->verticalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(textScrolled())));
+    }
+
+    JsonTextView::~JsonTextView()
+    {
+        if (_searchThread)
+            _searchThread->stop();
+    }
+
+    std::string JsonTextView::formatDocument(const mongo::BSONObj &obj, int position, UUIDEncoding uuidEncoding, SupportedTimes timeZone)
+    {
+        std::string text = "/* " + std::to_string(position) + " */\n";
+        BsonUtils::appendJsonString(text, obj, mongo::TenGen, 1, uuidEncoding, timeZone);
+        return text;
+    }
+
+    void JsonTextView::setDocuments(const std::vector<MongoDocumentPtr> &documents, UUIDEncoding uuidEncoding, SupportedTimes timeZone)
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        _documents = documents;
+        _uuidEncoding = uuidEncoding;
+        _timeZone = timeZone;
+
+        // Header, document and blank line that separates it from the next one
+        std::vector<int> lines(_documents.size());
+        parallelFor(0, _documents.size(), [&](size_t i) {
+            lines[i] = 1 + BsonUtils::jsonLinesCount(_documents[i]->bsonObj()) + 1;
+        });
+
+        _firstLines.assign(1, 0);
+        _firstLines.reserve(_documents.size() + 1);
+        for (std::vector<int>::const_iterator it = lines.begin(); it != lines.end(); ++it)
+            _firstLines.push_back(_firstLines.back() + *it);
+
+        renderWindow(0);
+
+        LOG_MSG(QString("Text view: %1 documents (%2 formatted) rendered in %3 ms")
+                .arg(_documents.size()).arg(_windowLast - _windowFirst).arg(timer.elapsed()).toStdString(),
+                mongo::logger::LogSeverity::Info(), false);
+    }
+
+    bool JsonTextView::isVirtual() const
+    {
+        return _windowFirst > 0 || _windowLast < _documents.size();
+    }
+
+    int JsonTextView::linesOnScreen() const
+    {
+        return std::max<int>(1, sciScintilla()->SendScintilla(QsciScintilla::SCI_LINESONSCREEN));
+    }
+
+    int JsonTextView::windowFirstLine() const
+    {
+        return _firstLines[_windowFirst];
+    }
+
+    int JsonTextView::windowLastLine() const
+    {
+        return _firstLines[_windowLast] - 1;
+    }
+
+    size_t JsonTextView::documentAt(int line) const
+    {
+        // Last document which header is not below the line
+        std::vector<int>::const_iterator it = std::upper_bound(_firstLines.begin(), _firstLines.end() - 1, line);
+        return std::max<ptrdiff_t>(0, (it - _firstLines.begin()) - 1);
+    }
+
+    void JsonTextView::renderWindow(int line)
+    {
+        if (_documents.empty())
+            return;
+
+        // Keep cursor, if it will be still in the window
+        int cursorLine = 0, cursorIndex = 0;
+        sciScintilla()->getCursorPosition(&cursorLine, &cursorIndex);
+        cursorLine += windowFirstLine();
+
+        size_t const first = documentAt(std::max(0, line - marginLines));
+        size_t const last = std::min(_documents.size(), documentAt(line + linesOnScreen() + marginLines) + 1);
+
+        // Documents are formatted in parallel and joined in order, editor gets the text at once
+        std::vector<std::string> texts(last - first);
+        parallelFor(first, last, [&](size_t i) {
+            texts[i - first] = formatDocument(_documents[i]->bsonObj(), i + 1, _uuidEncoding, _timeZone);
+        });
+
+        size_t size = 0;
+        for (std::vector<std::string>::const_iterator it = texts.begin(); it != texts.end(); ++it)
+            size += it->size() + 2;
+
+        // Line count is only an estimate for exotic values (i.e. code), so lines of formatted
+        // documents are fixed. "shift" is the sum of corrections of documents before the next one.
+        int shift = 0;
+        std::string text;
+        text.reserve(size);
+        for (size_t i = first; i < last; ++i) {
+            if (i > first)
+                text += "\n\n";
+
+            std::string const &json = texts[i - first];
+            text += json;
+
+            int const lines = std::count(json.begin(), json.end(), '\n') + 1 + 1;
+            int const estimated = _firstLines[i + 1] - (_firstLines[i] - shift);
+            shift += lines - estimated;
+            _firstLines[i + 1] += shift;
+        }
+
+        if (shift) {
+            for (size_t j = last + 1; j < _firstLines.size(); ++j)
+                _firstLines[j] += shift;
+        }
+
+        _scrolling = true;
+        _windowFirst = first;
+        _windowLast = last;
+        setEditorText(text);
+        if (windowFirstLine() <= cursorLine && cursorLine <= windowLastLine())
+            sciScintilla()->setCursorPosition(cursorLine - windowFirstLine(), cursorIndex);
+        updateScrollRange();
+        _scrolling = false;
+    }
+
+    void JsonTextView::setEditorText(const std::string &text)
+    {
+        QsciScintilla *editor = sciScintilla();
+
+        // Editor keeps UTF-8, so valid text is put there without conversion to UTF-16 and back
+        if (!editor->isUtf8() || !StringUtils::isValidUtf8(text.data(), text.size())) {
+            editor->setText(QtUtils::toQString(text));
+            return;
+        }
+
+        bool const readOnly = editor->isReadOnly();
+        editor->setReadOnly(false);
+        editor->SendScintilla(QsciScintilla::SCI_CLEARALL);
+        editor->SendScintilla(QsciScintilla::SCI_APPENDTEXT, static_cast<unsigned long>(text.size()), text.data());
+        editor->SendScintilla(QsciScintilla::SCI_EMPTYUNDOBUFFER);
+        editor->setReadOnly(readOnly);
+    }
+
+    void JsonTextView::scrollToLine(int line)
+    {
+        line = std::max(0, std::min(line, _scrollBar->maximum()));
+        if (needsRender(line))
+            renderWindow(line);
+
+        _scrolling = true;
+        sciScintilla()->setFirstVisibleLine(line - windowFirstLine());
+        _scrollBar->setValue(line);
+        _scrolling = false;
+    }
+
+    bool JsonTextView::needsRender(int line) const
+    {
+        return (line < windowFirstLine() && _windowFirst > 0) ||
+               (line + linesOnScreen() > windowLastLine() && _windowLast < _documents.size());
+    }
+
+    void JsonTextView::updateScrollRange()
+    {
+        bool const virtualView = isVirtual();
+        int const screen = linesOnScreen();
+
+        // When all documents are in the editor, its own scroll bar is used
+        sciScintilla()->setVerticalScrollBarPolicy(virtualView ? Qt::ScrollBarAlwaysOff : Qt::ScrollBarAsNeeded);
+        _scrollBar->setVisible(virtualView);
+        _scrollBar->setRange(0, std::max(0, _firstLines.back() - 1 - screen));
+        _scrollBar->setPageStep(screen);
+        _scrollBar->setSingleStep(1);
+    }
+
+    void JsonTextView::resizeEvent(QResizeEvent *event)
+    {
+        BaseClass::resizeEvent(event);
+        if (!isVirtual())
+            return;
+
+        updateScrollRange();
+        scrollToLine(_scrollBar->value());
+    }
+
+    void JsonTextView::scrollBarMoved(int line)
+    {
+        if (_scrolling)
+            return;
+
+        // Scrolling inside of the window is cheap, formatting of the new window is
+        // postponed, so that fast drag doesn't format documents for every position
+        if (!needsRender(line)) {
+            scrollToLine(line);
+            return;
+        }
+
+        if (!_renderTimer->isActive())
+            _renderTimer->start();
+    }
+
+    void JsonTextView::renderScrollBarLine()
+    {
+        scrollToLine(_scrollBar->value());
+    }
+
+    void JsonTextView::textScrolled()
+    {
+        if (_scrolling || !isVirtual())
+            return;
+
+        // Editor was scrolled by wheel or keyboard
+        int const line = windowFirstLine() + sciScintilla()->firstVisibleLine();
+        int const screen = linesOnScreen();
+
+        _scrolling = true;
+        _scrollBar->setValue(line);
+        _scrolling = false;
+
+        // Move the window before its edge gets visible
+        if ((line < windowFirstLine() + screen && _windowFirst > 0) ||
+            (line + 2 * screen > windowLastLine() && _windowLast < _documents.size())) {
+            renderWindow(line);
+            _scrolling = true;
+            sciScintilla()->setFirstVisibleLine(line - windowFirstLine());
+            _scrolling = false;
+        }
+    }
+
+    void JsonTextView::findElement(bool forward)
+    {
+        QString const text = findText();
+        if (text.isEmpty() || _documents.empty())
+            return;
+
+        int line = 0, index = 0;
+        sciScintilla()->getCursorPosition(&line, &index);
+        if (!forward)
+            index -= sciScintilla()->selectedText().toUtf8().size();
+
+        int const globalLine = windowFirstLine() + line;
+        size_t const document = documentAt(globalLine);
+
+        if (_searchThread)
+            _searchThread->stop();
+
+        _searchThread = new JsonSearchThread(_documents, _uuidEncoding, _timeZone, text, isCaseSensitive(), forward,
+                                             document, globalLine - _firstLines[document], index);
+        VERIFY(connect(_searchThread, SIGNAL(found(int, int, int, int)), this, SLOT(searchFound(int, int, int, int))));
+        VERIFY(connect(_searchThread, SIGNAL(notFound()), this, SLOT(searchNotFound())));
+        VERIFY(connect(_searchThread, SIGNAL(finished()), _searchThread, SLOT(deleteLater())));
+        _searchThread->start();
+    }
+
+    void JsonTextView::searchFound(int document, int line, int index, int length)
+    {
+        if (sender() != _searchThread)
+            return;
+
+        _searchThread = NULL;
+
+        int const globalLine = _firstLines[document] + line;
+        if (globalLine < windowFirstLine() || globalLine > windowLastLine())
+            scrollToLine(globalLine - linesOnScreen() / 2);
+
+        int const localLine = globalLine - windowFirstLine();
+        sciScintilla()->setSelection(localLine, index, localLine, index + length);
+        sciScintilla()->ensureCursorVisible();
+    }
+
+    void JsonTextView::searchNotFound()
+    {
+        if (sender() != _searchThread)
+            return;
+
+        _searchThread = NULL;
+        QMessageBox::warning(this, tr("Search"), tr("The specified text was not found."));
+    }
+}
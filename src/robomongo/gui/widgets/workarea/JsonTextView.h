@@ -0,0 +1,89 @@
+#pragma once
+
+#include <vector>
+
+#include "robomongo/core/Core.h"
+#include "robomongo/core/Enums.h"
+#include "robomongo/gui/editors/FindFrame.h"
+
+QT_BEGIN_NAMESPACE
+class QScrollBar;
+class QTimer;
+QT_END_NAMESPACE
+
+namespace mongo {
+    class BSONObj;
+}
+
+namespace Robomongo
+{
+    class JsonSearchThread;
+
+    /**
+     * @brief Read-only text view of list of documents.
+     *
+     * Only documents around the viewport are formatted and put into the editor.
+     * Number of lines of every document is computed upfront (without formatting),
+     * so that vertical scroll bar covers the whole list. Line counting and formatting
+     * of the window are split across a pool of threads, and the formatted text is put
+     * into the editor at once. When list fits into window, the view behaves exactly
+     * as plain FindFrame.
+     */
+    class JsonTextView : public FindFrame
+    {
+        Q_OBJECT
+
+    public:
+        typedef FindFrame BaseClass;
+        explicit JsonTextView(QWidget *parent);
+        ~JsonTextView();
+
+        void setDocuments(const std::vector<MongoDocumentPtr> &documents, UUIDEncoding uuidEncoding, SupportedTimes timeZone);
+
+        /**
+         * @brief Text of document with numbered comment header, as it is shown in the view
+         */
+        static std::string formatDocument(const mongo::BSONObj &obj, int position, UUIDEncoding uuidEncoding, SupportedTimes timeZone);
+
+    protected:
+        virtual void findElement(bool forward);
+        virtual void resizeEvent(QResizeEvent *event);
+
+    private Q_SLOTS:
+        void scrollBarMoved(int line);
+        void renderScrollBarLine();
+        void textScrolled();
+        void searchFound(int document, int line, int index, int length);
+        void searchNotFound();
+
+    private:
+        bool isVirtual() const;
+        int linesOnScreen() const;
+        int windowFirstLine() const;
+        int windowLastLine() const;
+        size_t documentAt(int line) const;
+        void renderWindow(int line);
+        void setEditorText(const std::string &text);
+        void scrollToLine(int line);
+        bool needsRender(int line) const;
+        void updateScrollRange();
+
+        std::vector<MongoDocumentPtr> _documents;
+        UUIDEncoding _uuidEncoding;
+        SupportedTimes _timeZone;
+
+        // Global line of header of every document, and total number of lines (+ 1) in the end
+        std::vector<int> _firstLines;
+
+        // Documents [_windowFirst, _windowLast) are currently in the editor
+        size_t _windowFirst;
+        size_t _windowLast;
+
+        QScrollBar *_scrollBar;
+
+        // Window follows dragged scroll bar at most once per frame
+        QTimer *_renderTimer;
+        JsonSearchThread *_searchThread;
+        bool _scrolling;
+    };
+}
@@ -1,5 +1,7 @@
 #include "robomongo/gui/widgets/workarea/OutputItemContentWidget.h"
 
+#include <iterator>
+
 #include <QVBoxLayout>
 #include <Qsci/qscilexerjavascript.h>
 
@@ -8,19 +10,47 @@
 #include "robomongo/core/utils/QtUtils.h"
 #include "robomongo/core/domain/MongoShell.h"
 #include "robomongo/core/domain/MongoAggregateInfo.h"
+#include "robomongo/core/domain/MongoDocument.h"
 
 #include "robomongo/gui/widgets/workarea/OutputWidget.h"
 #include "robomongo/gui/widgets/workarea/OutputItemHeaderWidget.h"
-#include "robomongo/gui/widgets/workarea/JsonPrepareThread.h"
+#include "robomongo/gui/widgets/workarea/JsonTextView.h"
+#include "robomongo/gui/widgets/workarea/SchemaPrepareThread.h"
+#include "robomongo/gui/widgets/workarea/SearchIndexThread.h"
+#include "robomongo/gui/widgets/workarea/ResultMemoryManager.h"
 #include "robomongo/gui/widgets/workarea/BsonTreeView.h"
 #include "robomongo/gui/widgets/workarea/BsonTreeModel.h"
 #include "robomongo/gui/widgets/workarea/BsonTableView.h"
 #include "robomongo/gui/widgets/workarea/BsonTableModel.h"
 #include "robomongo/gui/editors/PlainJavaScriptEditor.h"
 #include "robomongo/gui/widgets/workarea/CollectionStatsTreeWidget.h"
+#include "robomongo/gui/widgets/workarea/ExplainTreeWidget.h"
 #include "robomongo/gui/GuiRegistry.h"
 #include "robomongo/gui/editors/JSLexer.h"
 #include "robomongo/gui/editors/FindFrame.h"
+#include "robomongo/gui/dialogs/PipelineProfileDialog.h"
+
+namespace
+{
+    size_t documentsSize(const std::vector<Robomongo::MongoDocumentPtr> &documents)
+    {
+        size_t size = 0;
+        for (std::vector<Robomongo::MongoDocumentPtr>::const_iterator it = documents.begin(); it != documents.end(); ++it)
+            size += (*it)->bsonObj().objsize();
+        return size;
+    }
+
+    // Size of documents that are freed when the list drops them, shared documents stay in memory
+    size_t unsharedSize(const std::vector<Robomongo::MongoDocumentPtr> &documents)
+    {
+        size_t size = 0;
+        for (std::vector<Robomongo::MongoDocumentPtr>::const_iterator it = documents.begin(); it != documents.end(); ++it) {
+            if (it->use_count() == 1)
+                size += (*it)->bsonObj().objsize();
+        }
+        return size;
+    }
+}
 
 namespace Robomongo
 {
@@ -31,8 +61,13 @@ namespace Robomongo
         BaseClass(parent),
         _textView(NULL),
         _bsonTreeview(NULL),
-        _thread(NULL),
+        _indexThread(NULL),
+        _filtered(false),
         _bsonTable(NULL),
+        _collectionStats(NULL),
+        _explainTree(NULL),
+        _documentsSize(0),
+        _viewsReleased(false),
         _isTextModeSupported(true),
         _isTreeModeSupported(false),
         _isTableModeSupported(false),
@@ -41,7 +76,6 @@ namespace Robomongo
         _isTreeModeInitialized(false),
         _isCustomModeInitialized(false),
         _isTableModeInitialized(false),
-        _isFirstPartRendered(false),
         _text(text),
         _shell(shell),
         _outputWidget(dynamic_cast<OutputWidget*>(parentWidget())),
@@ -49,7 +83,8 @@ namespace Robomongo
         _initialLimit(0),
         _mod(NULL),
         _viewMode(viewMode),
-        _aggrInfo(aggrInfo)
+        _aggrInfo(aggrInfo),
+        _aggrPagesSize(0)
     {
         setup(secs, multipleResults, tabbedResults, firstItem, lastItem);
     }
@@ -64,8 +99,11 @@ namespace Robomongo
         BaseClass(parent),
         _textView(NULL),
         _bsonTreeview(NULL),
-        _thread(NULL),
+        _indexThread(NULL),
+        _filtered(false),
         _bsonTable(NULL),
+        _collectionStats(NULL),
+        _explainTree(NULL),
         _isTextModeSupported(true),
         _isTreeModeSupported(true),
         _isTableModeSupported(true),
@@ -74,8 +112,9 @@ namespace Robomongo
         _isTreeModeInitialized(false),
         _isCustomModeInitialized(false),
         _isTableModeInitialized(false),
-        _isFirstPartRendered(false),
         _documents(documents),
+        _documentsSize(documentsSize(documents)),
+        _viewsReleased(false),
         _queryInfo(queryInfo),
         _type(type),
         _shell(shell),
@@ -84,11 +123,27 @@ namespace Robomongo
         _outputWidget(dynamic_cast<OutputWidget*>(parentWidget())),
         _mod(NULL),
         _viewMode(viewMode),
-        _aggrInfo(aggrInfo)
+        _aggrInfo(aggrInfo),
+        _aggrPagesSize(0)
     {
         setup(secs, multipleResults, tabbedResults, firstItem, lastItem);
     }
 
+    OutputItemContentWidget::~OutputItemContentWidget()
+    {
+        ResultMemoryManager::instance().remove(this);
+
+        // Server would keep the cursor until it times out
+        if (_aggrInfo.isValid)
+            _shell->killAggregateCursor(_aggrInfo);
+
+        for (std::set<SchemaPrepareThread *>::const_iterator it = _schemaThreads.begin(); it != _schemaThreads.end(); ++it)
+            (*it)->stop();
+
+        if (_indexThread)
+            _indexThread->stop();
+    }
+
     void OutputItemContentWidget::setup(double secs, bool multipleResults, bool tabbedResults,
                                         bool firstItem, bool lastItem)
     {      
@@ -108,6 +163,7 @@ namespace Robomongo
             _header->setCollection(QtUtils::toQString(_aggrInfo.collectionName));
             _header->paging()->setBatchSize(_aggrInfo.batchSize);
             _header->paging()->setSkip(_aggrInfo.skip);
+            cachePage(_aggrInfo.skip, _documents);
         }
 
         _header->setTime(QString("%1 sec.").arg(secs, 0, 'g', 3));
@@ -120,14 +176,17 @@ namespace Robomongo
         layout->addWidget(_stack);
         setLayout(layout);
         configureModel();
+        prepareSchema(_aggrInfo.isValid ? _aggrInfo.skip : _queryInfo._skip);
 
-        VERIFY(connect(_header->paging(), SIGNAL(refreshed(int, int)), this, SLOT(refresh(int, int))));
+        VERIFY(connect(_header->paging(), SIGNAL(refreshed(int, int)), this, SLOT(paging_refreshed(int, int))));
         VERIFY(connect(_header->paging(), SIGNAL(leftClicked(int, int)), this, SLOT(paging_leftClicked(int, int))));
         VERIFY(connect(_header->paging(), SIGNAL(rightClicked(int, int)), this, SLOT(paging_rightClicked(int, int))));
         VERIFY(connect(_header, SIGNAL(maximizedPart()), this, SIGNAL(maximizedPart())));
         VERIFY(connect(_header, SIGNAL(restoredSize()), this, SIGNAL(restoredSize())));
+        VERIFY(connect(_header, SIGNAL(filterChanged(const QString &)), this, SLOT(filter_textChanged(const QString &))));
 
         refreshOutputItem();
+        ResultMemoryManager::instance().add(this);
     }
 
     void OutputItemContentWidget::paging_leftClicked(int skip, int limit)
@@ -137,7 +196,8 @@ namespace Robomongo
         if (s < 0)
             s = 0;
 
-        refresh(s, limit);
+        if (!showCachedPage(s, limit))
+            refresh(s, limit);
     }
 
     void OutputItemContentWidget::refreshOutputItem()
@@ -154,7 +214,16 @@ namespace Robomongo
     void OutputItemContentWidget::paging_rightClicked(int skip, int limit)
     {
         skip += limit;
-        refresh(skip, limit);
+        if (!showCachedPage(skip, limit))
+            refresh(skip, limit);
+    }
+
+    void OutputItemContentWidget::paging_refreshed(int skip, int batchSize)
+    {
+        // Explicit refresh reads results again
+        _aggrPages.clear();
+        _aggrPagesSize = 0;
+        refresh(skip, batchSize);
     }
 
     void OutputItemContentWidget::refresh(int skip, int batchSize)
@@ -184,56 +253,107 @@ namespace Robomongo
         info._skip = skip;
         info._batchSize = batchSize;
         _outputWidget->showProgress();
+
+        // Page request carries the cursor position, another one must wait for its response
+        _header->paging()->setEnabled(false);
                 
         _shell->setScriptExecutable(true);
-        if (_aggrInfo.isValid) {
-            // Build original pipeline object, and append extra skip and limit for paging
-            std::string pipelineModified = "[";
-            for (int i = 0; ; i++) {
-                auto const obj = mongo::tojson(_aggrInfo.pipeline.getObjectField(std::to_string(i)));
-                if (obj.empty() || "{}" == obj)
-                    break;
-
-                pipelineModified.append(obj + ",");
-            }
-            pipelineModified.append("{$skip:" + std::to_string(skip) + "}, " +
-                                    "{$limit:" + std::to_string(batchSize) + "}" + 
-                                    "]");
-
-            std::string const query = "db.getCollection('" + _aggrInfo.collectionName + "').aggregate(" +
-                                      pipelineModified + ", " + _aggrInfo.options.toString() + ")";
-            
-            // Create aggr. info with new skip and batchsize
-            AggrInfo const aggrInfo { _aggrInfo.collectionName, skip, batchSize, _aggrInfo.pipeline, 
-                                      _aggrInfo.options, _outputWidget->resultIndex(this) };
-            _shell->setAggrInfo(aggrInfo);
-            _shell->execute(query);
-        }
+        if (_aggrInfo.isValid)
+            _shell->aggregatePage(_outputWidget->resultIndex(this), _aggrInfo, skip, batchSize);
         else
             _shell->query(_outputWidget->resultIndex(this), info);
     }
 
+    void OutputItemContentWidget::profilePipeline()
+    {
+        PipelineProfileDialog *dialog = new PipelineProfileDialog(_shell, _aggrInfo, _outputWidget->resultIndex(this), this);
+        dialog->show();
+    }
+
     void OutputItemContentWidget::updateWithInfo(const MongoQueryInfo &inf, 
                                                  const std::vector<MongoDocumentPtr> &documents)
     {
+        _header->paging()->setEnabled(true);
         update(documents, inf._skip, inf._batchSize);
     }
 
     void OutputItemContentWidget::updateWithInfo(const AggrInfo &aggrInfo, 
                                                  const std::vector<MongoDocumentPtr> &documents)
     {
+        _header->paging()->setEnabled(true);
+
+        // Cached pages start at other positions
+        if (aggrInfo.batchSize != _aggrInfo.batchSize) {
+            _aggrPages.clear();
+            _aggrPagesSize = 0;
+        }
+
+        _aggrInfo = aggrInfo;
+        cachePage(aggrInfo.skip, documents);
         update(documents, aggrInfo.skip, aggrInfo.batchSize);
     }
 
+    void OutputItemContentWidget::pageLoadingFailed()
+    {
+        _header->paging()->setEnabled(true);
+    }
+
+    bool OutputItemContentWidget::showCachedPage(int skip, int batchSize)
+    {
+        if (!_aggrInfo.isValid || batchSize != _aggrInfo.batchSize)
+            return false;
+
+        std::map<int, std::vector<MongoDocumentPtr> >::const_iterator const it = _aggrPages.find(skip);
+        if (it == _aggrPages.end())
+            return false;
+
+        _aggrInfo.skip = skip;
+        update(it->second, skip, batchSize);
+        refreshOutputItem();
+        return true;
+    }
+
+    void OutputItemContentWidget::cachePage(int skip, const std::vector<MongoDocumentPtr> &documents)
+    {
+        if (documents.empty())
+            return;
+
+        std::vector<MongoDocumentPtr> &page = _aggrPages[skip];
+        _aggrPagesSize -= documentsSize(page);
+        page = documents;
+        _aggrPagesSize += documentsSize(page);
+
+        // Pages far from the shown one are dropped first
+        const size_t maxPages = 16;
+        while (_aggrPages.size() > maxPages) {
+            std::map<int, std::vector<MongoDocumentPtr> >::iterator const far =
+                skip - _aggrPages.begin()->first > _aggrPages.rbegin()->first - skip ?
+                _aggrPages.begin() : std::prev(_aggrPages.end());
+            _aggrPagesSize -= documentsSize(far->second);
+            _aggrPages.erase(far);
+        }
+    }
+
     void OutputItemContentWidget::update(const std::vector<MongoDocumentPtr> &documents, int skip, int batchSize)
     {
+        _spill.clear();
         _documents = documents;
+        _documentsSize = documentsSize(documents);
+        _viewsReleased = false;
+
+        // Index of the previous page is useless, filter is applied again when new index is ready
+        if (_indexThread) {
+            _indexThread->stop();
+            _indexThread = NULL;
+        }
+        _index.reset();
+        _filtered = false;
+        _header->setFilterStatus(QString());
 
         _header->paging()->setSkip(skip);
         _header->paging()->setBatchSize(batchSize);
 
         _text.clear();
-        _isFirstPartRendered = false;
         markUninitialized();
 
         if (_bsonTable) {
@@ -254,6 +374,129 @@ namespace Robomongo
             _textView = NULL;
         }
         configureModel();
+        prepareSchema(skip);
+
+        if (!_filter.isEmpty())
+            startIndexing();
+
+        ResultMemoryManager::instance().enforceBudget();
+    }
+
+    size_t OutputItemContentWidget::memoryUsage() const
+    {
+        // Shown page may be also cached
+        bool const cached = _aggrPages.find(_aggrInfo.skip) != _aggrPages.end();
+        size_t usage = (_spill.isEmpty() && !cached) ? _documentsSize : 0;
+        usage += _aggrPagesSize;
+        usage += _text.size() * sizeof(QChar);
+
+        if (_mod)
+            usage += _mod->memoryUsage();
+
+        if (_textView)
+            usage += _textView->sciScintilla()->length();
+
+        if (_index)
+            usage += _index->memoryUsage();
+
+        return usage;
+    }
+
+    void OutputItemContentWidget::releaseViews()
+    {
+        if (_viewsReleased)
+            return;
+
+        if (_bsonTable) {
+            _stack->removeWidget(_bsonTable);
+            delete _bsonTable;
+            _bsonTable = NULL;
+        }
+
+        if (_bsonTreeview) {
+            _stack->removeWidget(_bsonTreeview);
+            delete _bsonTreeview;
+            _bsonTreeview = NULL;
+        }
+
+        if (_textView) {
+            _stack->removeWidget(_textView);
+            delete _textView;
+            _textView = NULL;
+        }
+
+        if (_collectionStats) {
+            _stack->removeWidget(_collectionStats);
+            delete _collectionStats;
+            _collectionStats = NULL;
+        }
+
+        if (_explainTree) {
+            _stack->removeWidget(_explainTree);
+            delete _explainTree;
+            _explainTree = NULL;
+        }
+
+        // Index is rebuilt only when filter changes, matched documents are kept
+        if (_indexThread) {
+            _indexThread->stop();
+            _indexThread = NULL;
+        }
+        _index.reset();
+
+        // Schema is small and is kept, so table columns survive the release
+        delete _mod;
+        _mod = NULL;
+        markUninitialized();
+        _viewsReleased = true;
+    }
+
+    size_t OutputItemContentWidget::spillDocuments()
+    {
+        if (_documents.empty() || !_spill.isEmpty())
+            return 0;
+
+        releaseViews();
+
+        // Shown page is also referenced by _documents, it is freed below (if at all)
+        size_t freed = 0;
+        for (std::map<int, std::vector<MongoDocumentPtr> >::const_iterator it = _aggrPages.begin(); it != _aggrPages.end(); ++it)
+            freed += unsharedSize(it->second);
+        _aggrPages.clear();
+        _aggrPagesSize = 0;
+
+        // Schema threads hold their own references to documents, so they would not be freed
+        if (!_schemaThreads.empty())
+            return freed;
+
+        size_t const unshared = unsharedSize(_documents);
+        if (_spill.write(_documents)) {
+            std::vector<MongoDocumentPtr>().swap(_documents);
+            freed += unshared;
+        }
+        return freed;
+    }
+
+    void OutputItemContentWidget::restore()
+    {
+        if (!_spill.isEmpty()) {
+            _documents = _spill.read();
+            _documentsSize = documentsSize(_documents);
+        }
+
+        if (_viewsReleased) {
+            _viewsReleased = false;
+            configureModel();
+            applyFilter();
+            refreshOutputItem();
+        }
+    }
+
+    void OutputItemContentWidget::showEvent(QShowEvent *event)
+    {
+        restore();
+        BaseClass::showEvent(event);
+        ResultMemoryManager::instance().touch(this);
     }
 
     void OutputItemContentWidget::showText()
@@ -265,18 +508,18 @@ namespace Robomongo
 
         if (!_isTextModeInitialized)
         {
-            _textView = configureLogText();
-            if (!_text.isEmpty()) {
+            if (!_text.isEmpty() || _documents.empty()) {
+                _textView = new FindFrame(this);
+                configureLogText(_textView);
                 _textView->sciScintilla()->setText(_text);
             }
             else {
-                if (_documents.size() > 0) {
-                    _textView->sciScintilla()->setText("Loading...");
-                    _thread = new JsonPrepareThread(_documents, AppRegistry::instance().settingsManager()->uuidEncoding(), AppRegistry::instance().settingsManager()->timeZone());
-                    VERIFY(connect(_thread, SIGNAL(partReady(const QString&)), this, SLOT(jsonPartReady(const QString&))));
-                    VERIFY(connect(_thread, SIGNAL(finished()), _thread, SLOT(deleteLater())));
-                    _thread->start();
-                }
+                // Only documents around the viewport are formatted
+                JsonTextView *jsonView = new JsonTextView(this);
+                configureLogText(jsonView);
+                jsonView->setDocuments(_documents, AppRegistry::instance().settingsManager()->uuidEncoding(),
+                                       AppRegistry::instance().settingsManager()->timeZone());
+                _textView = jsonView;
             }
             _stack->addWidget(_textView);
             _isTextModeInitialized = true;
@@ -329,12 +572,18 @@ namespace Robomongo
             if (_type == "collectionStats") {
                 _collectionStats = new CollectionStatsTreeWidget(_documents, NULL);
                 _stack->addWidget(_collectionStats);
-            }               
+            }
+            else if (_type == "explain") {
+                _explainTree = new ExplainTreeWidget(_documents, NULL);
+                _stack->addWidget(_explainTree);
+            }
             _isCustomModeInitialized = true;
         }
 
         if (_collectionStats)
             _stack->setCurrentWidget(_collectionStats);
+        else if (_explainTree)
+            _stack->setCurrentWidget(_explainTree);
     }
 
     void OutputItemContentWidget::showTable()
@@ -355,6 +604,8 @@ namespace Robomongo
             _bsonTable->setModel(modp);
             _stack->addWidget(_bsonTable);
             _isTableModeInitialized = true;
+            applySchemaColumns();
+            applyTableFilter();
         }
 
         _stack->setCurrentWidget(_bsonTable);
@@ -378,29 +629,126 @@ namespace Robomongo
         _header->toggleOrientation(orientation);
     }
 
-    void OutputItemContentWidget::jsonPartReady(const QString &json)
+    void OutputItemContentWidget::prepareSchema(int skip)
+    {
+        if (!_isTableModeSupported || _documents.empty())
+            return;
+
+        // Schema of every page is merged once, revisited (or cached) pages are not counted again.
+        // Threads of the previous pages keep running, so that their schema is not lost.
+        if (!_schemaPages.insert(skip).second)
+            return;
+
+        SchemaPrepareThread *thread = new SchemaPrepareThread(_documents);
+        VERIFY(connect(thread, SIGNAL(done()), this, SLOT(schemaReady())));
+        VERIFY(connect(thread, SIGNAL(finished()), thread, SLOT(deleteLater())));
+        _schemaThreads.insert(thread);
+        thread->start(QThread::LowPriority);
+    }
+
+    void OutputItemContentWidget::schemaReady()
+    {
+        // check that this is one of our threads
+        SchemaPrepareThread *thread = qobject_cast<SchemaPrepareThread *>(sender());
+        if (!thread || !_schemaThreads.erase(thread))
+            return;
+
+        _schema.merge(thread->schema());
+        applySchemaColumns();
+    }
+
+    void OutputItemContentWidget::applySchemaColumns()
+    {
+        if (!_bsonTable || !_schema.documentsCount())
+            return;
+
+        BsonTableModelProxy *modp = qobject_cast<BsonTableModelProxy *>(_bsonTable->model());
+        if (modp) {
+            bool const flatten = AppRegistry::instance().settingsManager()->flattenTableColumns();
+            modp->setColumns(_schema.columns(flatten), flatten);
+        }
+    }
+
+    void OutputItemContentWidget::startIndexing()
+    {
+        if (_indexThread || _documents.empty())
+            return;
+
+        _indexThread = new SearchIndexThread(_documents, AppRegistry::instance().settingsManager()->uuidEncoding(),
+                                             AppRegistry::instance().settingsManager()->timeZone());
+        VERIFY(connect(_indexThread, SIGNAL(done()), this, SLOT(indexReady())));
+        VERIFY(connect(_indexThread, SIGNAL(finished()), _indexThread, SLOT(deleteLater())));
+        _indexThread->start(QThread::LowPriority);
+    }
+
+    void OutputItemContentWidget::indexReady()
     {
         // check that this is our current thread
-        JsonPrepareThread *thread = qobject_cast<JsonPrepareThread *>(sender());
-        if (thread && thread != _thread)
-        {
-            // close previous thread
-            thread->stop();
-            thread->wait();
+        SearchIndexThread *thread = qobject_cast<SearchIndexThread *>(sender());
+        if (!thread || thread != _indexThread)
+            return;
+
+        _index = thread->takeIndex();
+        _indexThread = NULL;
+
+        if (!_filter.isEmpty())
+            filter_textChanged(_filter);
+    }
+
+    void OutputItemContentWidget::filter_textChanged(const QString &text)
+    {
+        _filter = text;
+
+        if (_filter.isEmpty()) {
+            _filtered = false;
+            std::vector<unsigned>().swap(_filteredDocuments);
+            applyFilter();
+            return;
         }
-        else
-        {
-            if (_textView)
-            {
-                if (_isFirstPartRendered)
-                    _textView->sciScintilla()->append(json);
-                else
-                    _textView->sciScintilla()->setText(json);
-                _isFirstPartRendered = true;
-            }
+
+        // Filter is applied as soon as index is built
+        if (!_index) {
+            _header->setFilterStatus("Indexing documents...");
+            startIndexing();
+            return;
+        }
+
+        _filteredDocuments = _index->search(QtUtils::toStdString(_filter));
+        _filtered = true;
+        applyFilter();
+    }
+
+    void OutputItemContentWidget::applyFilter()
+    {
+        if (_mod) {
+            if (_filtered)
+                _mod->setDocumentsFilter(_filteredDocuments);
+            else
+                _mod->clearDocumentsFilter();
         }
+
+        applyTableFilter();
+
+        _header->setFilterStatus(_filtered ? QString("%1 of %2 documents match").arg(_filteredDocuments.size())
+                                                                                 .arg(_mod ? _mod->root()->childrenCount() : 0)
+                                           : QString());
     }
-    
+
+    void OutputItemContentWidget::applyTableFilter()
+    {
+        if (!_bsonTable)
+            return;
+
+        BsonTableModelProxy *modp = qobject_cast<BsonTableModelProxy *>(_bsonTable->model());
+        if (!modp)
+            return;
+
+        if (_filtered)
+            modp->setRowsFilter(_filteredDocuments);
+        else
+            modp->clearRowsFilter();
+    }
+
     BsonTreeModel *OutputItemContentWidget::configureModel()
     {
         delete _mod;
@@ -408,25 +756,23 @@ namespace Robomongo
         return _mod;
     }
 
-    FindFrame *Robomongo::OutputItemContentWidget::configureLogText()
+    void OutputItemContentWidget::configureLogText(FindFrame *logText)
     {
         const QFont &textFont = GuiRegistry::instance().font();
 
         QsciLexerJavaScript *javaScriptLexer = new JSLexer(this);
         javaScriptLexer->setFont(textFont);
 
-        FindFrame *_logText = new FindFrame(this);
-        _logText->sciScintilla()->setLexer(javaScriptLexer);
-        _logText->sciScintilla()->setTabWidth(4);        
-        _logText->sciScintilla()->setAppropriateBraceMatching();
-        _logText->sciScintilla()->setFont(textFont);
-        _logText->sciScintilla()->setReadOnly(true);
-        _logText->sciScintilla()->setWrapMode((QsciScintilla::WrapMode) QsciScintilla::SC_WRAP_NONE);
-        _logText->sciScintilla()->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
-        _logText->sciScintilla()->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+        logText->sciScintilla()->setLexer(javaScriptLexer);
+        logText->sciScintilla()->setTabWidth(4);        
+        logText->sciScintilla()->setAppropriateBraceMatching();
+        logText->sciScintilla()->setFont(textFont);
+        logText->sciScintilla()->setReadOnly(true);
+        logText->sciScintilla()->setWrapMode((QsciScintilla::WrapMode) QsciScintilla::SC_WRAP_NONE);
+        logText->sciScintilla()->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
+        logText->sciScintilla()->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
         // Wrap mode turned off because it introduces huge performance problems
         // even for medium size documents.    
-        _logText->sciScintilla()->setStyleSheet("QFrame {background-color: rgb(73, 76, 78); border: 1px solid #c7c5c4; border-radius: 0px; margin: 0px; padding: 0px;}");
-        return _logText;
+        logText->sciScintilla()->setStyleSheet("QFrame {background-color: rgb(73, 76, 78); border: 1px solid #c7c5c4; border-radius: 0px; margin: 0px; padding: 0px;}");
     }
 }
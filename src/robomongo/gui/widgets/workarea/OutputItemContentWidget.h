@@ -5,7 +5,13 @@
 #include "robomongo/core/Core.h"
 #include "robomongo/core/domain/MongoQueryInfo.h"
 #include "robomongo/core/domain/MongoAggregateInfo.h"
+#include "robomongo/core/domain/DocumentSpillFile.h"
 #include "robomongo/core/Enums.h"
+#include "robomongo/core/utils/BsonSchema.h"
+#include "robomongo/gui/widgets/workarea/ResultMemoryManager.h"
+#include <map>
+#include <memory>
+#include <set>
 #include <vector>
 
 namespace Robomongo
@@ -14,13 +20,16 @@ namespace Robomongo
     class BsonTreeView;
     class BsonTableView;
     class BsonTreeModel;
-    class JsonPrepareThread;
+    class SchemaPrepareThread;
+    class SearchIndexThread;
+    class TrigramIndex;
     class CollectionStatsTreeWidget;
+    class ExplainTreeWidget;
     class MongoShell;
     class OutputItemHeaderWidget;
     class OutputWidget;
 
-    class OutputItemContentWidget : public QWidget
+    class OutputItemContentWidget : public QWidget, public ResultMemoryManager::Result
     {
         Q_OBJECT
 
@@ -35,25 +44,55 @@ namespace Robomongo
                                 const MongoQueryInfo &queryInfo, double secs, bool multipleResults,
                                 bool tabbedResults, bool firstItem, bool lastItem, AggrInfo aggrInfo,
                                 QWidget *parent);
+        ~OutputItemContentWidget();
         int _initialSkip;
         int _initialLimit;
         void updateWithInfo(const MongoQueryInfo &inf, const std::vector<MongoDocumentPtr> &documents);
         void updateWithInfo(const AggrInfo &aggrInfo, const std::vector<MongoDocumentPtr> &documents);
         void update(const std::vector<MongoDocumentPtr> &documents, int skip, int batchSize);
+        void pageLoadingFailed();
         bool isTextModeSupported() const { return _isTextModeSupported; }
         bool isTreeModeSupported() const { return _isTreeModeSupported; }
         bool isCustomModeSupported() const { return _isCustomModeSupported; }
         bool isTableModeSupported() const { return _isTableModeSupported; }
+        bool isAggregation() const { return _aggrInfo.isValid; }
         ViewMode viewMode() const { return _viewMode; }
 
         void refreshOutputItem();
         void markUninitialized();
 
+        /**
+         * @brief Sets columns of table view from schema of fetched pages, flattened or not
+         * as "flattenTableColumns" setting says
+         */
+        void applySchemaColumns();
+
         void applyDockUndockSettings(bool isDocking) const;
         void toggleOrientation(Qt::Orientation orientation) const;
 
         const OutputWidget* outputWidget() const { return _outputWidget; }
 
+        /**
+         * @brief Approximate bytes taken by documents, model and views of this result
+         */
+        size_t memoryUsage() const override;
+
+        bool isShown() const override { return isVisible(); }
+
+        /**
+         * @brief Deletes model and views, they are rebuilt when result is shown again
+         */
+        void releaseViews() override;
+
+        /**
+         * @brief Releases views and moves documents to a temporary file. Returns bytes
+         * of documents that were actually freed, documents shared with others stay in memory.
+         */
+        size_t spillDocuments() override;
+
+    protected:
+        void showEvent(QShowEvent *event) override;
+
     Q_SIGNALS:
         void restoredSize();
         void maximizedPart();
@@ -63,32 +102,63 @@ namespace Robomongo
         void showTree();        
         void showTable();
         void showCustom();
+        void profilePipeline();
 
     private Q_SLOTS:
-        void jsonPartReady(const QString &json);
+        void schemaReady();
+        void indexReady();
+        void filter_textChanged(const QString &text);
         void refresh(int skip, int batchSize);
+        void paging_refreshed(int skip, int batchSize);
         void paging_rightClicked(int skip, int batchSize);
         void paging_leftClicked(int skip, int limit);      
 
     private:
         void setup(double secs, bool multipleResults, bool tabbedResults, bool firstItem, bool lastItem);
-        FindFrame *configureLogText();
+        void configureLogText(FindFrame *logText);
         BsonTreeModel *configureModel();
+        void prepareSchema(int skip);
+        void startIndexing();
+        void applyFilter();
+        void applyTableFilter();
+        void restore();
+        bool showCachedPage(int skip, int batchSize);
+        void cachePage(int skip, const std::vector<MongoDocumentPtr> &documents);
 
         FindFrame *_textView;
         BsonTreeView *_bsonTreeview;
         BsonTableView *_bsonTable;
         BsonTreeModel *_mod;
         CollectionStatsTreeWidget *_collectionStats;
+        ExplainTreeWidget *_explainTree;
 
         QString _text;
         QString _type; // type of request
         std::vector<MongoDocumentPtr> _documents;
+        size_t _documentsSize;
+        DocumentSpillFile _spill;
+        bool _viewsReleased;
         MongoQueryInfo _queryInfo;
         AggrInfo _aggrInfo;
 
+        // Pages of aggregation results already read from the cursor, by skip
+        std::map<int, std::vector<MongoDocumentPtr> > _aggrPages;
+        size_t _aggrPagesSize;
+
         QStackedWidget *_stack;
-        JsonPrepareThread *_thread;
+
+        // Schema of all pages fetched so far, drives columns of the table view.
+        // Every page (by skip) is merged once, even when it is fetched again.
+        std::set<SchemaPrepareThread *> _schemaThreads;
+        std::set<int> _schemaPages;
+        BsonSchema _schema;
+
+        // Search index of documents, built when filter is used for the first time
+        SearchIndexThread *_indexThread;
+        std::unique_ptr<TrigramIndex> _index;
+        QString _filter;
+        std::vector<unsigned> _filteredDocuments;
+        bool _filtered;
 
         MongoShell *_shell;
         OutputItemHeaderWidget *_header;
@@ -103,7 +173,6 @@ namespace Robomongo
         bool _isTableModeInitialized;
         bool _isCustomModeInitialized;
 
-        bool _isFirstPartRendered;
         ViewMode _viewMode;
     };
 }
@@ -2,8 +2,10 @@
 
 #include <QHBoxLayout>
 #include <QLabel>
+#include <QLineEdit>
 #include <QPushButton>
 #include <QSplitter>
+#include <QTimer>
 
 #include "robomongo/core/utils/QtUtils.h"
 #include "robomongo/gui/GuiRegistry.h"
@@ -16,6 +18,11 @@
 
 namespace
 {
+    const char *const filterToolTip = "Show only documents with field names or values containing this text";
+
+    // Delay after the last keystroke, before documents are filtered
+    const int filterDelay = 250;
+
     QFrame *createVerticalLine()
     {
         QFrame *vline = new QFrame();
@@ -33,7 +40,8 @@ namespace Robomongo
             OutputItemContentWidget *outputItemContentWidget, bool multipleResults, 
             bool tabbedResults, bool firstItem, bool lastItem, QWidget *parent) :
         QFrame(parent),
-        _maxButton(nullptr), _dockUndockButton(nullptr), _maximized(false), 
+        _maxButton(nullptr), _dockUndockButton(nullptr),
+        _filterSupported(outputItemContentWidget->isTreeModeSupported()), _maximized(false), 
         _multipleResults(multipleResults), 
         _firstItem(firstItem), _lastItem(lastItem), _orientation(Qt::Vertical)
     {
@@ -79,6 +87,14 @@ namespace Robomongo
         _customButton->setFlat(true);
         _customButton->setCheckable(true);
 
+        // Profile pipeline button, for aggregation results only
+        _profileButton = new QPushButton(this);
+        _profileButton->setIcon(GuiRegistry::instance().timeIcon());
+        _profileButton->setToolTip("Profile pipeline: time, documents and memory of every stage");
+        _profileButton->setFixedSize(24, 24);
+        _profileButton->setFlat(true);
+        _profileButton->setVisible(outputItemContentWidget->isAggregation());
+
         // Create maximize button only if there are multiple results
         if (_multipleResults && !tabbedResults) {
             _maxButton = new QPushButton;
@@ -103,14 +119,33 @@ namespace Robomongo
         VERIFY(connect(_treeButton, SIGNAL(clicked()), outputItemContentWidget, SLOT(showTree())));
         VERIFY(connect(_tableButton, SIGNAL(clicked()), outputItemContentWidget, SLOT(showTable())));
         VERIFY(connect(_customButton, SIGNAL(clicked()), outputItemContentWidget, SLOT(showCustom())));
+        VERIFY(connect(_profileButton, SIGNAL(clicked()), outputItemContentWidget, SLOT(profilePipeline())));
 
         _collectionIndicator = new Indicator(GuiRegistry::instance().collectionIcon());
         _timeIndicator = new Indicator(GuiRegistry::instance().timeIcon());
         _paging = new PagingWidget();
 
+        // Filters documents of tree and table views
+        _filterEdit = new QLineEdit;
+        _filterEdit->setPlaceholderText("Filter documents");
+        _filterEdit->setToolTip(filterToolTip);
+        _filterEdit->setClearButtonEnabled(true);
+        _filterEdit->setFixedWidth(180);
+        VERIFY(connect(_filterEdit, SIGNAL(textChanged(const QString &)), this, SLOT(filter_textChanged(const QString &))));
+
+        _filterStatus = new QLabel;
+        _filterStatus->setContentsMargins(0, 0, 6, 0);
+
+        _filterTimer = new QTimer(this);
+        _filterTimer->setSingleShot(true);
+        _filterTimer->setInterval(filterDelay);
+        VERIFY(connect(_filterTimer, SIGNAL(timeout()), this, SLOT(emitFilterChanged())));
+
         _collectionIndicator->hide();
         _timeIndicator->hide();
         _paging->hide();
+        _filterEdit->hide();
+        _filterStatus->hide();
 
         QHBoxLayout *layout = new QHBoxLayout();
 #ifdef __APPLE__
@@ -121,8 +156,12 @@ namespace Robomongo
         layout->setSpacing(0);
         layout->addWidget(_collectionIndicator);
         layout->addWidget(_timeIndicator);
+        layout->addWidget(_profileButton);
         QSpacerItem *hSpacer = new QSpacerItem(2000, 24, QSizePolicy::Preferred, QSizePolicy::Minimum);
         layout->addSpacerItem(hSpacer);
+        layout->addWidget(_filterStatus);
+        layout->addWidget(_filterEdit);
+        layout->addSpacing(4);
         layout->addWidget(_paging);
         layout->addWidget(createVerticalLine());
         layout->addSpacing(2);
@@ -183,6 +222,8 @@ namespace Robomongo
         _tableButton->setChecked(false);
         _customButton->setIcon(GuiRegistry::instance().customIcon());
         _customButton->setChecked(false);
+        _filterEdit->hide();
+        _filterStatus->hide();
     }
 
     void OutputItemHeaderWidget::showTree()
@@ -195,6 +236,8 @@ namespace Robomongo
         _tableButton->setChecked(false);
         _customButton->setIcon(GuiRegistry::instance().customIcon());
         _customButton->setChecked(false);
+        _filterEdit->setVisible(_filterSupported);
+        _filterStatus->setVisible(_filterSupported && !_filterStatus->text().isEmpty());
     }
 
     void OutputItemHeaderWidget::showTable()
@@ -207,6 +250,8 @@ namespace Robomongo
         _tableButton->setChecked(true);
         _customButton->setIcon(GuiRegistry::instance().customIcon());
         _customButton->setChecked(false);
+        _filterEdit->setVisible(_filterSupported);
+        _filterStatus->setVisible(_filterSupported && !_filterStatus->text().isEmpty());
     }
 
     void OutputItemHeaderWidget::showCustom()
@@ -219,6 +264,32 @@ namespace Robomongo
         _tableButton->setChecked(false);
         _customButton->setIcon(GuiRegistry::instance().customHighlightedIcon());
         _customButton->setChecked(true);
+        _filterEdit->hide();
+        _filterStatus->hide();
+    }
+
+    void OutputItemHeaderWidget::setFilterStatus(const QString &status)
+    {
+        _filterEdit->setToolTip(status.isEmpty() ? QString(filterToolTip) : status);
+        _filterStatus->setText(status);
+        _filterStatus->setVisible(!_filterEdit->isHidden() && !status.isEmpty());
+    }
+
+    void OutputItemHeaderWidget::filter_textChanged(const QString &text)
+    {
+        // Cleared filter shows all documents right away, typing is debounced
+        if (text.isEmpty()) {
+            _filterTimer->stop();
+            emitFilterChanged();
+            return;
+        }
+
+        _filterTimer->start();
+    }
+
+    void OutputItemHeaderWidget::emitFilterChanged()
+    {
+        emit filterChanged(_filterEdit->text());
     }
 
     void OutputItemHeaderWidget::applyDockUndockSettings(bool isDocking)
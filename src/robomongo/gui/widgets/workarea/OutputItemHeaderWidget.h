@@ -2,7 +2,10 @@
 
 #include <QWidget>
 QT_BEGIN_NAMESPACE
+class QLabel;
 class QPushButton;
+class QLineEdit;
+class QTimer;
 QT_END_NAMESPACE
 
 #include "robomongo/gui/editors/PlainJavaScriptEditor.h"
@@ -29,18 +32,28 @@ namespace Robomongo
         void applyDockUndockSettings(bool docking);
         void toggleOrientation(Qt::Orientation orientation);
 
+        /**
+         * @brief Shows number of documents that match the filter, empty text clears it
+         */
+        void setFilterStatus(const QString &status);
+
     protected:
         virtual void mouseDoubleClickEvent(QMouseEvent *);
 
     Q_SIGNALS:
         void restoredSize();
         void maximizedPart();
+        void filterChanged(const QString &text);
 
     public Q_SLOTS:        
         void setTime(const QString &time);
         void setCollection(const QString &collection);
         void maximizeMinimizePart();
 
+    private Q_SLOTS:
+        void filter_textChanged(const QString &text);
+        void emitFilterChanged();
+
     private:
         void updateDockButtonOnToggleOrientation() const;
 
@@ -48,13 +61,18 @@ namespace Robomongo
         QPushButton *_treeButton;
         QPushButton *_tableButton;
         QPushButton *_customButton;
+        QPushButton *_profileButton;
         QPushButton *_maxButton;
         QFrame *_verticalLine;
         QPushButton *_dockUndockButton;
         Indicator *_collectionIndicator;
         Indicator *_timeIndicator;
         PagingWidget *_paging;
+        QLineEdit *_filterEdit;
+        QLabel *_filterStatus;
+        QTimer *_filterTimer;
 
+        bool _filterSupported;
         bool _maximized;
         bool _multipleResults;
         bool _firstItem;
@@ -123,6 +123,19 @@ namespace Robomongo
         outputItemContentWidget->refreshOutputItem();
     }
 
+    void OutputWidget::pageLoadingFailed()
+    {
+        // Failed request has no result index, paging is enabled for all results
+        for (auto const& item : _outputItemContentWidgets)
+            item->pageLoadingFailed();
+    }
+
+    void OutputWidget::applyTableColumnsSettings()
+    {
+        for (auto const& item : _outputItemContentWidgets)
+            item->applySchemaColumns();
+    }
+
     void OutputWidget::toggleOrientation()
     {
         bool const horizontal = _splitter->orientation() == Qt::Horizontal;
@@ -245,6 +258,12 @@ namespace Robomongo
 
     void OutputWidget::clearAllParts()
     {
+        // Tabbed results are not in the splitter
+        for (OutputItemContentWidget *widget : _outputItemContentWidgets) {
+            if (_splitter->indexOf(widget) < 0)
+                delete widget;
+        }
+
         _prevViewModes.clear();
         while (_splitter->count() > 0) {
             OutputItemContentWidget *widget =  (OutputItemContentWidget *)_splitter->widget(_splitter->count()-1);
@@ -252,6 +271,7 @@ namespace Robomongo
             widget->hide();
             delete widget;
         }
+        _outputItemContentWidgets.clear();
     }
 
     QString OutputWidget::buildStyleSheet()
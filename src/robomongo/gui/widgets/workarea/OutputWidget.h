@@ -26,14 +26,26 @@ namespace Robomongo
                         const std::vector<MongoDocumentPtr> &documents);
         void updatePart(int partIndex, const AggrInfo &agrrInfo,
                         const std::vector<MongoDocumentPtr> &documents);
+        void pageLoadingFailed();
         void toggleOrientation();
 
+        /**
+         * @brief Deletes widgets of all results, they release resources of server (i.e. cursors)
+         * so it must be done while shell is alive
+         */
+        void clearAllParts();
+
         void switchMode(std::function<void(OutputItemContentWidget*)> modeFunc);
         void enterTreeMode();
         void enterTextMode();
         void enterTableMode();
         void enterCustomMode();
 
+        /**
+         * @brief Rebuilds columns of table views after "flattenTableColumns" setting changed
+         */
+        void applyTableColumnsSettings();
+
         int resultIndex(OutputItemContentWidget *result);
 
         void showProgress();
@@ -50,7 +62,6 @@ namespace Robomongo
 
     private:
         void mouseReleaseEvent(QMouseEvent *event);
-        void clearAllParts();
         QString buildStyleSheet();
         void tryToMakeAllPartsEqualInSize();
 
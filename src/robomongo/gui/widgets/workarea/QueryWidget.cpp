@@ -193,6 +193,7 @@ namespace Robomongo
 
     QueryWidget::~QueryWidget()
     {
+        _viewer->clearAllParts();
         AppRegistry::instance().app()->closeShell(_shell);
     }
 
@@ -222,6 +223,11 @@ namespace Robomongo
         _viewer->enterTableMode();
     }
 
+    void QueryWidget::applyTableColumnsSettings()
+    {
+        _viewer->applyTableColumnsSettings();
+    }
+
     void QueryWidget::enterCustomMode()
     {
         _viewer->enterCustomMode();
@@ -253,6 +259,7 @@ namespace Robomongo
         hideProgress();
 
         if (event->isError()) {
+            _viewer->pageLoadingFailed();
             QString message = QString("Failed to load documents.\n\nError:\n%1")
                 .arg(QtUtils::toQString(event->error().errorMessage()));
             QMessageBox::information(this, "Error", message);
@@ -260,7 +267,10 @@ namespace Robomongo
         }
 
         // this should be in viewer, subscribed to ScriptExecutedEvent
-        _viewer->updatePart(event->resultIndex(), event->queryInfo(), event->documents()); 
+        if (event->aggrInfo().isValid)
+            _viewer->updatePart(event->resultIndex(), event->aggrInfo(), event->documents());
+        else
+            _viewer->updatePart(event->resultIndex(), event->queryInfo(), event->documents()); 
     }
 
     void QueryWidget::handle(ScriptExecutedEvent *event)
@@ -268,15 +278,6 @@ namespace Robomongo
         hideProgress();        
         _currentResult = event->result();
 
-        if (_currentResult.results().size() == 1) {
-            MongoShellResult const& result = _currentResult.results().front();
-            AggrInfo const& aggrInfo = result.aggrInfo();
-            if (aggrInfo.isValid && aggrInfo.resultIndex > -1) {
-                _viewer->updatePart(aggrInfo.resultIndex, aggrInfo, _currentResult.results().front().documents());
-                return;
-            }
-        }
-
         updateCurrentTab();
 
         displayData(event->result().results(), event->empty());
@@ -45,6 +45,7 @@ namespace Robomongo
         void enterTextMode();
         void enterTableMode();
         void enterCustomMode();
+        void applyTableColumnsSettings();
         void setScriptFocus();
         void showAutocompletion();
         void hideAutocompletion();
@@ -0,0 +1,74 @@
+#include "robomongo/gui/widgets/workarea/ResultMemoryManager.h"
+
+#include <algorithm>
+
+#include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/settings/SettingsManager.h"
+
+namespace Robomongo
+{
+    ResultMemoryManager &ResultMemoryManager::instance()
+    {
+        // Preferences update the budget when it is changed
+        static ResultMemoryManager _instance(
+            static_cast<size_t>(AppRegistry::instance().settingsManager()->resultMemoryBudgetMb()) * 1024 * 1024);
+        return _instance;
+    }
+
+    void ResultMemoryManager::add(Result *result)
+    {
+        // Budget is enforced when result is shown, new result is not visible yet
+        _results.push_front(result);
+    }
+
+    void ResultMemoryManager::remove(Result *result)
+    {
+        _results.remove(result);
+    }
+
+    void ResultMemoryManager::touch(Result *result)
+    {
+        std::list<Result *>::iterator it = std::find(_results.begin(), _results.end(), result);
+        if (it != _results.end())
+            _results.splice(_results.begin(), _results, it);
+
+        enforceBudget();
+    }
+
+    size_t ResultMemoryManager::totalUsage() const
+    {
+        size_t total = 0;
+        for (std::list<Result *>::const_iterator it = _results.begin(); it != _results.end(); ++it)
+            total += (*it)->memoryUsage();
+        return total;
+    }
+
+    void ResultMemoryManager::enforceBudget()
+    {
+        if (_budget == 0)
+            return;
+
+        size_t total = totalUsage();
+
+        // Models and views are cheaper to rebuild than documents to reload, so they go first
+        for (int pass = 0; pass < 2 && total > _budget; ++pass) {
+            for (std::list<Result *>::reverse_iterator it = _results.rbegin();
+                 it != _results.rend() && total > _budget; ++it) {
+                Result *result = *it;
+                if (result->isShown())
+                    continue;
+
+                size_t const before = result->memoryUsage();
+                result->releaseViews();
+                size_t freed = before - std::min(before, result->memoryUsage());
+
+                // Only documents without other references count, i.e. ones not shared
+                // with another result or a thread that still works with them
+                if (pass == 1)
+                    freed += result->spillDocuments();
+
+                total -= std::min(total, freed);
+            }
+        }
+    }
+}
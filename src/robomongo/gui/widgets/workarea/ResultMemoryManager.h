@@ -0,0 +1,82 @@
+#pragma once
+
+#include <list>
+#include <cstddef>
+
+namespace Robomongo
+{
+    /**
+     * @brief Keeps memory taken by results of all tabs within the budget from settings.
+     *
+     * Results are kept in order of their last use. When total memory exceeds the budget,
+     * hidden results are compacted, least recently used first: at first their models and
+     * views are released, then raw BSON of documents is spilled to a temporary file.
+     * Visible results are never touched; hidden ones are restored when shown again.
+     */
+    class ResultMemoryManager
+    {
+    public:
+        /**
+         * @brief Result that gives its memory back while hidden (OutputItemContentWidget)
+         */
+        class Result
+        {
+        public:
+            virtual ~Result() {}
+
+            /**
+             * @brief Approximate bytes taken by documents, model and views of the result
+             */
+            virtual size_t memoryUsage() const = 0;
+
+            /**
+             * @brief Shown results are never compacted
+             */
+            virtual bool isShown() const = 0;
+
+            virtual void releaseViews() = 0;
+
+            /**
+             * @brief Returns bytes of documents that were actually freed
+             */
+            virtual size_t spillDocuments() = 0;
+        };
+
+        /**
+         * @brief Manager of all results, with budget from settings
+         */
+        static ResultMemoryManager &instance();
+
+        /**
+         * @brief Budget of 0 bytes means no limit
+         */
+        explicit ResultMemoryManager(size_t budget = 0) : _budget(budget) {}
+
+        void setBudget(size_t budget) { _budget = budget; }
+        size_t budget() const { return _budget; }
+
+        void add(Result *result);
+        void remove(Result *result);
+
+        /**
+         * @brief Marks result as most recently used and enforces the budget
+         */
+        void touch(Result *result);
+
+        /**
+         * @brief Compacts hidden results until total memory fits into the budget
+         */
+        void enforceBudget();
+
+        size_t totalUsage() const;
+
+    private:
+        ResultMemoryManager(const ResultMemoryManager &);
+        ResultMemoryManager &operator=(const ResultMemoryManager &);
+
+        size_t _budget;
+
+        // Most recently used result goes first
+        std::list<Result *> _results;
+    };
+}
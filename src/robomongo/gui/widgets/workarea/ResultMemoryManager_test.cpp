@@ -0,0 +1,222 @@
+#include "gtest/gtest.h"
+#include "robomongo/gui/widgets/workarea/ResultMemoryManager.h"
+
+#include <string>
+#include <vector>
+
+#include <mongo/bson/bsonobjbuilder.h>
+
+#include "robomongo/core/domain/DocumentSpillFile.h"
+#include "robomongo/core/domain/MongoDocument.h"
+
+using namespace Robomongo;
+
+namespace
+{
+    size_t documentsSize(const std::vector<MongoDocumentPtr> &documents)
+    {
+        size_t size = 0;
+        for (auto const& document : documents)
+            size += document->bsonObj().objsize();
+        return size;
+    }
+
+    std::vector<MongoDocumentPtr> buildDocuments(int count)
+    {
+        std::vector<MongoDocumentPtr> documents;
+        for (int i = 0; i < count; ++i)
+            documents.push_back(MongoDocument::fromBsonObj(BSON("_id" << i << "name" << std::string(100, 'x'))));
+        return documents;
+    }
+
+    // Accounts memory the same way as OutputItemContentWidget: documents until they
+    // are spilled, plus views until they are released
+    class FakeResult : public ResultMemoryManager::Result
+    {
+    public:
+        FakeResult(const std::vector<MongoDocumentPtr> &documents, size_t viewsSize) :
+            documents(documents), viewsSize(viewsSize), shown(false) {}
+
+        size_t memoryUsage() const override
+        {
+            return (spill.isEmpty() ? documentsSize(documents) : 0) + viewsSize;
+        }
+
+        bool isShown() const override { return shown; }
+
+        void releaseViews() override { viewsSize = 0; }
+
+        size_t spillDocuments() override
+        {
+            if (documents.empty() || !spill.isEmpty())
+                return 0;
+
+            size_t freed = 0;
+            for (auto const& document : documents) {
+                if (document.use_count() == 1)
+                    freed += document->bsonObj().objsize();
+            }
+
+            if (!spill.write(documents))
+                return 0;
+
+            std::vector<MongoDocumentPtr>().swap(documents);
+            return freed;
+        }
+
+        void restore()
+        {
+            if (!spill.isEmpty())
+                documents = spill.read();
+        }
+
+        bool isSpilled() const { return !spill.isEmpty(); }
+
+        std::vector<MongoDocumentPtr> documents;
+        size_t viewsSize;
+        bool shown;
+        DocumentSpillFile spill;
+    };
+}
+
+TEST(ResultMemoryManagerTests, totalUsage_SeveralResults_SumOfUsage)
+{
+    FakeResult first(buildDocuments(10), 1000);
+    FakeResult second(buildDocuments(20), 500);
+
+    ResultMemoryManager manager;
+    manager.add(&first);
+    manager.add(&second);
+
+    EXPECT_EQ(first.memoryUsage() + second.memoryUsage(), manager.totalUsage());
+
+    manager.remove(&first);
+    EXPECT_EQ(second.memoryUsage(), manager.totalUsage());
+}
+
+TEST(ResultMemoryManagerTests, enforceBudget_WithinBudgetOrNoBudget_KeepsEverything)
+{
+    FakeResult result(buildDocuments(10), 1000);
+
+    ResultMemoryManager unlimited;
+    unlimited.add(&result);
+    unlimited.enforceBudget();
+    EXPECT_EQ(1000u, result.viewsSize);
+    EXPECT_FALSE(result.isSpilled());
+
+    ResultMemoryManager manager(result.memoryUsage());
+    manager.add(&result);
+    manager.enforceBudget();
+    EXPECT_EQ(1000u, result.viewsSize);
+    EXPECT_FALSE(result.isSpilled());
+}
+
+TEST(ResultMemoryManagerTests, enforceBudget_OverBudget_ReleasesViewsBeforeSpilling)
+{
+    FakeResult first(buildDocuments(10), 1000);
+    FakeResult second(buildDocuments(10), 1000);
+
+    // Releasing both views is enough, documents stay in memory
+    ResultMemoryManager manager(first.memoryUsage() + second.memoryUsage() - 1500);
+    manager.add(&first);
+    manager.add(&second);
+    manager.enforceBudget();
+
+    EXPECT_EQ(0u, first.viewsSize);
+    EXPECT_EQ(0u, second.viewsSize);
+    EXPECT_FALSE(first.isSpilled());
+    EXPECT_FALSE(second.isSpilled());
+    EXPECT_TRUE(manager.totalUsage() <= manager.budget());
+}
+
+TEST(ResultMemoryManagerTests, touch_OverBudget_CompactsLeastRecentlyUsedFirst)
+{
+    FakeResult first(buildDocuments(10), 1000);
+    FakeResult second(buildDocuments(10), 1000);
+    FakeResult third(buildDocuments(10), 1000);
+
+    ResultMemoryManager manager;
+    manager.add(&first);
+    manager.add(&second);
+    manager.add(&third);
+
+    // Order of use is first, third, second: only views of second have to go
+    manager.touch(&first);
+    manager.setBudget(manager.totalUsage() - 500);
+    manager.enforceBudget();
+
+    EXPECT_EQ(1000u, first.viewsSize);
+    EXPECT_EQ(0u, second.viewsSize);
+    EXPECT_EQ(1000u, third.viewsSize);
+}
+
+TEST(ResultMemoryManagerTests, enforceBudget_ShownResult_IsNeverCompacted)
+{
+    FakeResult shown(buildDocuments(10), 1000);
+    FakeResult hidden(buildDocuments(10), 1000);
+    shown.shown = true;
+
+    ResultMemoryManager manager(1);
+    manager.add(&shown);
+    manager.add(&hidden);
+    manager.enforceBudget();
+
+    EXPECT_EQ(1000u, shown.viewsSize);
+    EXPECT_FALSE(shown.isSpilled());
+    EXPECT_EQ(0u, hidden.viewsSize);
+    EXPECT_TRUE(hidden.isSpilled());
+}
+
+TEST(ResultMemoryManagerTests, enforceBudget_SpillAndRestore_RoundTripsDocuments)
+{
+    FakeResult result(buildDocuments(100), 0);
+
+    // BSON is kept, documents themselves are referenced only by result
+    std::vector<mongo::BSONObj> originals;
+    for (auto const& document : result.documents)
+        originals.push_back(document->bsonObj());
+
+    ResultMemoryManager manager(1);
+    manager.add(&result);
+    manager.enforceBudget();
+
+    ASSERT_TRUE(result.isSpilled());
+    EXPECT_TRUE(result.documents.empty());
+    EXPECT_EQ(0u, manager.totalUsage());
+
+    result.restore();
+    EXPECT_FALSE(result.isSpilled());
+    ASSERT_EQ(originals.size(), result.documents.size());
+    for (size_t i = 0; i < originals.size(); ++i)
+        EXPECT_TRUE(originals[i].binaryEqual(result.documents[i]->bsonObj()));
+}
+
+TEST(ResultMemoryManagerTests, enforceBudget_SharedDocuments_AreNotCountedAsFreed)
+{
+    std::vector<MongoDocumentPtr> const shared = buildDocuments(10);
+    FakeResult sharing(shared, 0);
+    FakeResult owning(buildDocuments(10), 0);
+
+    // Spill of "sharing" (least recently used) frees nothing, so "owning" is spilled too
+    ResultMemoryManager manager(documentsSize(shared) + documentsSize(shared) / 2);
+    manager.add(&sharing);
+    manager.add(&owning);
+    manager.enforceBudget();
+
+    EXPECT_TRUE(sharing.isSpilled());
+    EXPECT_TRUE(owning.isSpilled());
+}
+
+TEST(ResultMemoryManagerTests, enforceBudget_UnsharedDocuments_StopsWhenBudgetIsMet)
+{
+    FakeResult first(buildDocuments(10), 0);
+    FakeResult second(buildDocuments(10), 0);
+
+    ResultMemoryManager manager(first.memoryUsage() + first.memoryUsage() / 2);
+    manager.add(&first);
+    manager.add(&second);
+    manager.enforceBudget();
+
+    EXPECT_TRUE(first.isSpilled());
+    EXPECT_FALSE(second.isSpilled());
+}
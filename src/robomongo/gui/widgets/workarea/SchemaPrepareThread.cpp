@@ -0,0 +1,30 @@
+#include "robomongo/gui/widgets/workarea/SchemaPrepareThread.h"
+
+#include "robomongo/core/domain/MongoDocument.h"
+
+namespace Robomongo
+{
+    SchemaPrepareThread::SchemaPrepareThread(const std::vector<MongoDocumentPtr> &bsonObjects)
+        :_bsonObjects(bsonObjects),
+        _stop(false)
+    {
+    }
+
+    void SchemaPrepareThread::stop()
+    {
+        _stop = true;
+    }
+
+    void SchemaPrepareThread::run()
+    {
+        for (std::vector<MongoDocumentPtr>::const_iterator it = _bsonObjects.begin(); it != _bsonObjects.end(); ++it)
+        {
+            if (_stop)
+                return;
+
+            _schema.add((*it)->bsonObj());
+        }
+
+        emit done();
+    }
+}
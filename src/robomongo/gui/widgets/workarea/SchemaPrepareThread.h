@@ -0,0 +1,51 @@
+#pragma once
+
+#include <QThread>
+#include <atomic>
+#include <vector>
+
+#include "robomongo/core/Core.h"
+#include "robomongo/core/utils/BsonSchema.h"
+
+namespace Robomongo
+{
+    /*
+    ** In this thread we are inferring schema (dotted paths, presence and types) of list of BSON objects
+    */
+    class SchemaPrepareThread : public QThread
+    {
+        Q_OBJECT
+
+    public:
+        /*
+        ** Constructor
+        */
+        SchemaPrepareThread(const std::vector<MongoDocumentPtr> &bsonObjects);
+        void stop();
+
+        /**
+         * @brief Schema of the documents. Valid only after "done()" is emitted.
+         */
+        const BsonSchema &schema() const { return _schema; }
+
+    Q_SIGNALS:
+        /**
+         * @brief Signals when all documents are processed
+         */
+        void done();
+
+    protected:
+
+        /*
+        ** Overload function
+        */
+        virtual void run();
+    private:
+        /*
+        ** List of documents (documents are shared, not copied)
+        */
+        const std::vector<MongoDocumentPtr> _bsonObjects;
+        BsonSchema _schema;
+        std::atomic<bool> _stop;
+    };
+}
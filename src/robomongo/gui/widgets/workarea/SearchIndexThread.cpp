@@ -0,0 +1,32 @@
+#include "robomongo/gui/widgets/workarea/SearchIndexThread.h"
+
+#include "robomongo/core/domain/MongoDocument.h"
+
+namespace Robomongo
+{
+    SearchIndexThread::SearchIndexThread(const std::vector<MongoDocumentPtr> &bsonObjects,
+                                         UUIDEncoding uuidEncoding, SupportedTimes timeZone)
+        :_bsonObjects(bsonObjects),
+        _index(new TrigramIndex(uuidEncoding, timeZone)),
+        _stop(false)
+    {
+    }
+
+    void SearchIndexThread::stop()
+    {
+        _stop = true;
+    }
+
+    void SearchIndexThread::run()
+    {
+        for (std::vector<MongoDocumentPtr>::const_iterator it = _bsonObjects.begin(); it != _bsonObjects.end(); ++it)
+        {
+            if (_stop)
+                return;
+
+            _index->add((*it)->bsonObj());
+        }
+
+        emit done();
+    }
+}
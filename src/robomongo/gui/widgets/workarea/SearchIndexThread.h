@@ -0,0 +1,53 @@
+#pragma once
+
+#include <QThread>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "robomongo/core/Core.h"
+#include "robomongo/core/Enums.h"
+#include "robomongo/core/utils/TrigramIndex.h"
+
+namespace Robomongo
+{
+    /*
+    ** In this thread we are building search index (trigrams of field paths and values) of list of BSON objects
+    */
+    class SearchIndexThread : public QThread
+    {
+        Q_OBJECT
+
+    public:
+        /*
+        ** Constructor
+        */
+        SearchIndexThread(const std::vector<MongoDocumentPtr> &bsonObjects, UUIDEncoding uuidEncoding, SupportedTimes timeZone);
+        void stop();
+
+        /**
+         * @brief Passes ownership of the index to the caller. Valid only after "done()" is emitted.
+         */
+        std::unique_ptr<TrigramIndex> takeIndex() { return std::move(_index); }
+
+    Q_SIGNALS:
+        /**
+         * @brief Signals when all documents are indexed
+         */
+        void done();
+
+    protected:
+
+        /*
+        ** Overload function
+        */
+        virtual void run();
+    private:
+        /*
+        ** List of documents (documents are shared, not copied)
+        */
+        const std::vector<MongoDocumentPtr> _bsonObjects;
+        std::unique_ptr<TrigramIndex> _index;
+        std::atomic<bool> _stop;
+    };
+}
@@ -33,6 +33,7 @@
 #include <boost/date_time/posix_time/posix_time_io.hpp>
 #include <boost/scoped_array.hpp>
 
+#include <algorithm>
 #include <cstdint>
 
 #include "mongo/base/parse_number.h"
@@ -46,6 +47,7 @@
 #include "mongo/util/str.h"
 #include "mongo/util/time_support.h"
 #include "robomongo/core/HexUtils.h"
+#include "robomongo/core/utils/StringUtils.h"
 
 namespace mongo {
 namespace Robomongo {
@@ -72,7 +74,7 @@ enum {
     ID_RESERVE_SIZE = 64,
     PAT_RESERVE_SIZE = 4096,
     OPT_RESERVE_SIZE = 64,
-    FIELD_RESERVE_SIZE = 4096,
+    FIELD_RESERVE_SIZE = 64,
     STRINGVAL_RESERVE_SIZE = 4096,
     BINDATA_RESERVE_SIZE = 4096,
     BINDATATYPE_RESERVE_SIZE = 4096,
@@ -80,15 +82,27 @@ enum {
     DB_RESERVE_SIZE = 64,
     NUMBERLONG_RESERVE_SIZE = 64,
     NUMBERDECIMAL_RESERVE_SIZE = 64,
-    DATE_RESERVE_SIZE = 64
+    DATE_RESERVE_SIZE = 64,
+    DOCUMENT_RESERVE_SIZE = 512
 };
 
 static const char* LBRACE = "{", * RBRACE = "}", * LBRACKET = "[", * RBRACKET = "]", * LPAREN = "(",
                    * RPAREN = ")", * COLON = ":", * COMMA = ",", * FORWARDSLASH = "/",
                    * SINGLEQUOTE = "'", * DOUBLEQUOTE = "\"";
 
-JParse::JParse(StringData str)
-    : _buf(str.rawData()), _input(_buf), _input_end(_input + str.size()) {}
+// Whitespace as of isspace() in "C" locale
+static inline bool isWhitespace(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// ALPHA DIGIT "_$"
+static inline bool isFieldNameChar(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' ||
+        c == '$';
+}
+
+JParse::JParse(StringData str, const std::atomic<bool>* stop)
+    : _buf(str.rawData()), _input(_buf), _input_end(_input + str.size()), _stop(stop) {}
 
 Status JParse::parseError(StringData msg) {
     std::ostringstream ossmsg;
@@ -103,133 +117,141 @@ Status JParse::parseError(StringData msg) {
     return Status(ErrorCodes::FailedToParse, ossmsg.str());
 }
 
+Status JParse::cancelled() {
+    return Status(ErrorCodes::Interrupted, "Parsing cancelled");
+}
+
 Status JParse::value(StringData fieldName, BSONObjBuilder& builder) {
     MONGO_JSON_DEBUG("fieldName: " << fieldName);
-    if (peekToken(LBRACE)) {
-        Status ret = object(fieldName, builder);
-        if (ret != Status::OK()) {
-            return ret;
-        }
-    } else if (peekToken(LBRACKET)) {
-        Status ret = array(fieldName, builder);
-        if (ret != Status::OK()) {
-            return ret;
-        }
-    } else if (readToken("new")) {
-        Status ret = constructor(fieldName, builder);
-        if (ret != Status::OK()) {
-            return ret;
-        }
-    } else if (readToken("Date")) {
-        Status ret = date(fieldName, builder);
-        if (ret != Status::OK()) {
-            return ret;
-        }
-    }
 
-//#ifdef ROBOMONGO
-    else if (readToken("ISODate")) {
-        Status ret = isodate(fieldName, builder);
-        if (ret != Status::OK()) {
-            return ret;
-        }
-    }
-    else if (readToken("UUID")) {
-        Status ret = uuid(fieldName, builder);
-        if (ret != Status::OK()) {
-            return ret;
-        }
-    }
-    else if (readToken("LUUID")) {
-        Status ret = luuid(fieldName, builder);
-        if (ret != Status::OK()) {
-            return ret;
-        }
-    }
-    else if (readToken("JUUID")) {
-        Status ret = juuid(fieldName, builder);
-        if (ret != Status::OK()) {
-            return ret;
-        }
-    }
-    else if (readToken("NUUID") || readToken("CSUUID")) {
-        Status ret = nuuid(fieldName, builder);
-        if (ret != Status::OK()) {
-            return ret;
-        }
-    }
-    else if (readToken("PYUUID")) {
-        Status ret = pyuuid(fieldName, builder);
-        if (ret != Status::OK()) {
-            return ret;
-        }
-    }
-//#endif
+    // Robomongo: dispatch on the first character instead of trying every token
+    // in turn. Tokens that share the first character keep their original order.
+    _input = skipWhitespace(_input);
+    switch (_input < _input_end ? *_input : '\0') {
+        case '{':
+            return object(fieldName, builder);
+        case '[':
+            return array(fieldName, builder);
+        case '/':
+            return regex(fieldName, builder);
+        case '"':
+        case '\'': {
+            // Strings without escapes are appended straight from the input
+            const char* begin = _input + 1;
+            size_t plain = ::Robomongo::StringUtils::jsonPlainPrefix(begin, _input_end - begin, *_input);
+            if (begin + plain < _input_end && begin[plain] == *_input) {
+                builder.append(fieldName, StringData(begin, plain));
+                _input = begin + plain + 1;
+                return Status::OK();
+            }
 
-    else if (readToken("Timestamp")) {
-        Status ret = timestamp(fieldName, builder);
-        if (ret != Status::OK()) {
-            return ret;
-        }
-    } else if (readToken("ObjectId")) {
-        Status ret = objectId(fieldName, builder);
-        if (ret != Status::OK()) {
-            return ret;
-        }
-    } else if (readToken("NumberLong")) {
-        Status ret = numberLong(fieldName, builder);
-        if (ret != Status::OK()) {
-            return ret;
-        }
-    } else if (readToken("NumberInt")) {
-        Status ret = numberInt(fieldName, builder);
-        if (ret != Status::OK()) {
-            return ret;
-        }
-    } else if (readToken("NumberDecimal")) {
-        Status ret = numberDecimal(fieldName, builder);
-        if (ret != Status::OK()) {
-            return ret;
-        }
-    } else if (readToken("Dbref") || readToken("DBRef")) {
-        Status ret = dbRef(fieldName, builder);
-        if (ret != Status::OK()) {
-            return ret;
-        }
-    } else if (peekToken(FORWARDSLASH)) {
-        Status ret = regex(fieldName, builder);
-        if (ret != Status::OK()) {
-            return ret;
-        }
-    } else if (peekToken(DOUBLEQUOTE) || peekToken(SINGLEQUOTE)) {
-        std::string valueString;
-        valueString.reserve(STRINGVAL_RESERVE_SIZE);
-        Status ret = quotedString(&valueString);
-        if (ret != Status::OK()) {
-            return ret;
-        }
-        builder.append(fieldName, valueString);
-    } else if (readToken("true")) {
-        builder.append(fieldName, true);
-    } else if (readToken("false")) {
-        builder.append(fieldName, false);
-    } else if (readToken("null")) {
-        builder.appendNull(fieldName);
-    } else if (readToken("undefined")) {
-        builder.appendUndefined(fieldName);
-    } else if (readToken("NaN")) {
-        builder.append(fieldName, std::numeric_limits<double>::quiet_NaN());
-    } else if (readToken("Infinity")) {
-        builder.append(fieldName, std::numeric_limits<double>::infinity());
-    } else if (readToken("-Infinity")) {
-        builder.append(fieldName, -std::numeric_limits<double>::infinity());
-    } else {
-        Status ret = number(fieldName, builder);
-        if (ret != Status::OK()) {
-            return ret;
-        }
+            std::string valueString;
+            valueString.reserve(std::max<size_t>(plain + 16, STRINGVAL_RESERVE_SIZE));
+            Status ret = quotedString(&valueString);
+            if (ret != Status::OK()) {
+                return ret;
+            }
+            builder.append(fieldName, valueString);
+            return Status::OK();
+        }
+        case 'n':
+            if (readToken("new")) {
+                return constructor(fieldName, builder);
+            } else if (readToken("null")) {
+                builder.appendNull(fieldName);
+                return Status::OK();
+            }
+            break;
+        case 'D':
+            if (readToken("Date")) {
+                return date(fieldName, builder);
+            } else if (readToken("Dbref") || readToken("DBRef")) {
+                return dbRef(fieldName, builder);
+            }
+            break;
+        case 'I':
+            if (readToken("ISODate")) {
+                return isodate(fieldName, builder);
+            } else if (readToken("Infinity")) {
+                builder.append(fieldName, std::numeric_limits<double>::infinity());
+                return Status::OK();
+            }
+            break;
+        case 'U':
+            if (readToken("UUID")) {
+                return uuid(fieldName, builder);
+            }
+            break;
+        case 'L':
+            if (readToken("LUUID")) {
+                return luuid(fieldName, builder);
+            }
+            break;
+        case 'J':
+            if (readToken("JUUID")) {
+                return juuid(fieldName, builder);
+            }
+            break;
+        case 'N':
+            if (readToken("NUUID")) {
+                return nuuid(fieldName, builder);
+            } else if (readToken("NumberLong")) {
+                return numberLong(fieldName, builder);
+            } else if (readToken("NumberInt")) {
+                return numberInt(fieldName, builder);
+            } else if (readToken("NumberDecimal")) {
+                return numberDecimal(fieldName, builder);
+            } else if (readToken("NaN")) {
+                builder.append(fieldName, std::numeric_limits<double>::quiet_NaN());
+                return Status::OK();
+            }
+            break;
+        case 'C':
+            if (readToken("CSUUID")) {
+                return nuuid(fieldName, builder);
+            }
+            break;
+        case 'P':
+            if (readToken("PYUUID")) {
+                return pyuuid(fieldName, builder);
+            }
+            break;
+        case 'T':
+            if (readToken("Timestamp")) {
+                return timestamp(fieldName, builder);
+            }
+            break;
+        case 'O':
+            if (readToken("ObjectId")) {
+                return objectId(fieldName, builder);
+            }
+            break;
+        case 't':
+            if (readToken("true")) {
+                builder.append(fieldName, true);
+                return Status::OK();
+            }
+            break;
+        case 'f':
+            if (readToken("false")) {
+                builder.append(fieldName, false);
+                return Status::OK();
+            }
+            break;
+        case 'u':
+            if (readToken("undefined")) {
+                builder.appendUndefined(fieldName);
+                return Status::OK();
+            }
+            break;
+        case '-':
+            if (readToken("-Infinity")) {
+                builder.append(fieldName, -std::numeric_limits<double>::infinity());
+                return Status::OK();
+            }
+            break;
     }
-    return Status::OK();
+    return number(fieldName, builder);
 }
 
 Status JParse::parse(BSONObjBuilder& builder) {
@@ -238,6 +260,9 @@ Status JParse::parse(BSONObjBuilder& builder) {
 
 Status JParse::object(StringData fieldName, BSONObjBuilder& builder, bool subObject) {
     MONGO_JSON_DEBUG("fieldName: " << fieldName);
+    if (isStopped()) {
+        return cancelled();
+    }
     if (!readToken(LBRACE)) {
         return parseError("Expecting '{'");
     }
@@ -365,9 +390,15 @@ Status JParse::object(StringData fieldName, BSONObjBuilder& builder, bool subObj
         if (valueRet != Status::OK()) {
             return valueRet;
         }
+        // Robomongo: name buffer is shared by all fields of the object
+        std::string fieldName;
+        fieldName.reserve(FIELD_RESERVE_SIZE);
         while (readToken(COMMA)) {
-            std::string fieldName;
-            fieldName.reserve(FIELD_RESERVE_SIZE);
+            // Robomongo: wide objects are checked for stop between fields
+            if (isStopped()) {
+                return cancelled();
+            }
+            fieldName.clear();
             Status fieldRet = field(&fieldName);
             if (fieldRet != Status::OK()) {
                 return fieldRet;
@@ -761,6 +792,9 @@ Status JParse::array(StringData fieldName, BSONObjBuilder& builder, bool subObje
 
     if (!peekToken(RBRACKET)) {
         do {
+            if (isStopped()) {
+                return cancelled();
+            }
             Status ret = value(builder.numStr(index), *arrayBuilder);
             if (ret != Status::OK()) {
                 return ret;
@@ -1149,6 +1183,35 @@ Status JParse::regexOptCheck(StringData opt) {
 }
 
 Status JParse::number(StringData fieldName, BSONObjBuilder& builder) {
+    // Robomongo: plain integers (up to 18 digits, which always fit into 64 bits)
+    // are parsed directly. Anything that strtod() could read further goes below.
+    {
+        const char* p = _input;
+        bool const negative = p < _input_end && *p == '-';
+        if (negative) {
+            ++p;
+        }
+        const char* const digits = p;
+        long long value = 0;
+        while (p < _input_end && p - digits < 19 && *p >= '0' && *p <= '9') {
+            value = value * 10 + (*p++ - '0');
+        }
+        size_t const count = p - digits;
+        if (count > 0 && count <= 18 && p < _input_end &&
+            !(*p >= '0' && *p <= '9') && *p != '.' && *p != 'e' && *p != 'E' && *p != 'x' && *p != 'X') {
+            if (negative) {
+                value = -value;
+            }
+            if (value == static_cast<int>(value)) {
+                builder.append(fieldName, static_cast<int>(value));
+            } else {
+                builder.append(fieldName, value);
+            }
+            _input = p;
+            return Status::OK();
+        }
+    }
+
     char* endptrll;
     char* endptrd;
     long long retll;
@@ -1200,19 +1263,25 @@ Status JParse::field(std::string* result) {
         return quotedString(result);
     } else {
         // Unquoted key
-        // 'isspace()' takes an 'int' (signed), so (default signed) 'char's get sign-extended
-        // and therefore 'corrupted' unless we force them to be unsigned ... 0x80 becomes
-        // 0xffffff80 as seen by isspace when sign-extended ... we want it to be 0x00000080
-        while (_input < _input_end && isspace(*reinterpret_cast<const unsigned char*>(_input))) {
-            ++_input;
-        }
+        _input = skipWhitespace(_input);
         if (_input >= _input_end) {
             return parseError("Field name expected");
         }
-        if (!match(*_input, ALPHA "_$")) {
+        if (!isFieldNameChar(*_input) || (*_input >= '0' && *_input <= '9')) {
             return parseError("First character in field must be [A-Za-z$_]");
         }
-        return chars(result, "", ALPHA DIGIT "_$");
+
+        // Robomongo: same as chars(result, "", ALPHA DIGIT "_$"), without strchr() per character
+        const char* q = _input;
+        while (q < _input_end && isFieldNameChar(*q)) {
+            ++q;
+        }
+        if (q >= _input_end) {
+            return parseError("Unexpected end of input");
+        }
+        result->append(_input, q);
+        _input = q;
+        return Status::OK();
     }
 }
 
@@ -1250,8 +1319,20 @@ Status JParse::chars(std::string* result, const char* terminalSet, const char* a
         return parseError("Unexpected end of input");
     }
     const char* q = _input;
+
+    // Robomongo: quoted strings copy runs without escapes and control characters at once
+    bool const quoted = allowedSet == NULL && terminalSet[0] != '\0' && terminalSet[1] == '\0';
+
     while (q < _input_end && !match(*q, terminalSet)) {
         MONGO_JSON_DEBUG("q: " << q);
+        if (quoted) {
+            size_t const plain = ::Robomongo::StringUtils::jsonPlainPrefix(q, _input_end - q, *terminalSet);
+            if (plain > 0) {
+                result->append(q, plain);
+                q += plain;
+                continue;
+            }
+        }
         if (allowedSet != NULL) {
             if (!match(*q, allowedSet)) {
                 _input = q;
@@ -1373,12 +1454,7 @@ bool JParse::readTokenImpl(const char* token, bool advance) {
     if (token == NULL) {
         return false;
     }
-    // 'isspace()' takes an 'int' (signed), so (default signed) 'char's get sign-extended
-    // and therefore 'corrupted' unless we force them to be unsigned ... 0x80 becomes
-    // 0xffffff80 as seen by isspace when sign-extended ... we want it to be 0x00000080
-    while (check < _input_end && isspace(*reinterpret_cast<const unsigned char*>(check))) {
-        ++check;
-    }
+    check = skipWhitespace(check);
     while (*token != '\0') {
         if (check >= _input_end) {
             return false;
@@ -1393,6 +1469,14 @@ bool JParse::readTokenImpl(const char* token, bool advance) {
     return true;
 }
 
+inline const char* JParse::skipWhitespace(const char* p) const {
+    // Most tokens are not preceded by whitespace, or by a single space
+    if (p < _input_end && !isWhitespace(*p)) {
+        return p;
+    }
+    return p + ::Robomongo::StringUtils::whitespacePrefix(p, _input_end - p);
+}
+
 bool JParse::readField(StringData expectedField) {
     MONGO_JSON_DEBUG("expectedField: " << expectedField);
     std::string nextField;
@@ -1437,15 +1521,17 @@ bool JParse::isArray() {
     return peekToken(LBRACKET);
 }
 
-BSONObj fromjson(const char* jsonString, int* len) {
+BSONObj fromjson(const char* jsonString, int* len, const std::atomic<bool>* stop) {
     MONGO_JSON_DEBUG("jsonString: " << jsonString);
     if (jsonString[0] == '\0') {
         if (len)
             *len = 0;
         return BSONObj();
     }
-    JParse jparse(jsonString);
-    BSONObjBuilder builder;
+    // Robomongo: input may hold many documents, so its size is not a size hint for this one.
+    // Buffer starts small and doubles, so the returned document never keeps unused megabytes.
+    JParse jparse(jsonString, stop);
+    BSONObjBuilder builder(DOCUMENT_RESERVE_SIZE);
     Status ret = Status::OK();
     try {
         ret = jparse.parse(builder);
@@ -1457,6 +1543,9 @@ BSONObj fromjson(const char* jsonString, int* len) {
         throw ParseMsgAssertionException(17031, message.str(), jparse.offset(), ret.reason());
     }
 
+    if (ret.code() == ErrorCodes::Interrupted)
+        throw ParseCancelledException(jparse.offset());
+
     if (ret != Status::OK()) {
         ostringstream message;
         message << "code " << ret.code() << ": " << ret.codeString() << ": " << ret.reason();
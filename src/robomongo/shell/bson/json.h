@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <string>
 
 #include "mongo/bson/bsonobj.h"
@@ -52,8 +53,10 @@ namespace Robomongo {
  */
 BSONObj fromjson(const std::string& str);
 
-/** @param len will be size of JSON object in text chars. */
-BSONObj fromjson(const char* str, int* len = NULL);
+/** @param len will be size of JSON object in text chars.
+ *  @param stop (Robomongo) is checked at every object and array, ParseCancelledException
+ *  is thrown when it is set. */
+BSONObj fromjson(const char* str, int* len = NULL, const std::atomic<bool>* stop = NULL);
 
 /**
  * Tests whether the JSON string is an Array.
@@ -96,7 +99,7 @@ std::string tojson(const BSONObj& obj, JsonStringFormat format = Strict, bool pr
  */
 class JParse {
 public:
-    explicit JParse(StringData str);
+    explicit JParse(StringData str, const std::atomic<bool>* stop = NULL);
 
     /*
      * Notation: All-uppercase symbols denote non-terminals; all other
@@ -468,6 +471,12 @@ private:
      */
     bool readTokenImpl(const char* token, bool advance = true);
 
+    /**
+     * @return pointer to the first non whitespace character at or after p
+     * (or _input_end).  Long runs of whitespace are skipped with SIMD.
+     */
+    inline const char* skipWhitespace(const char* p) const;
+
     /**
      * @return true if the next field in our stream matches field.
      * Handles single quoted, double quoted, and unquoted field names
@@ -497,6 +506,18 @@ private:
      */
     Status parseError(StringData msg);
 
+    /**
+     * @return true if parsing is stopped from another thread
+     */
+    bool isStopped() const {
+        return _stop && _stop->load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @return Interrupted status, parsing is abandoned
+     */
+    Status cancelled();
+
 public:
     inline int offset() {
         return (_input - _buf);
@@ -517,6 +538,7 @@ private:
     const char* const _buf;
     const char* _input;
     const char* const _input_end;
+    const std::atomic<bool>* const _stop;
 };
 
 //#ifdef ROBOMONGO
@@ -536,6 +558,20 @@ private:
         std::string _reason;
         int _offset;
     };
+
+    // Parsing was stopped before the document was complete
+    class ParseCancelledException : public std::exception {
+    public:
+        explicit ParseCancelledException(int offset) :
+            _offset(offset) {}
+
+        virtual const char* what() const throw() { return "Parsing cancelled"; }
+
+        int offset() const { return _offset; }
+
+    private:
+        int _offset;
+    };
 //#endif
 
 }  // namespace Robomongo
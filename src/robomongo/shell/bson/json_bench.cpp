@@ -0,0 +1,73 @@
+#include "gtest/gtest.h"
+#include "robomongo/shell/bson/json.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/json.h"
+#include "mongo/db/jsobj.h"
+
+namespace
+{
+    // Documents of the kind users paste into the editor: log events,
+    // orders with nested items, and mixed extended JSON values.
+    std::vector<std::string> fixtureDocuments()
+    {
+        return {
+            "{\n"
+            "    \"_id\" : ObjectId(\"5f1d7c3e9b1e8a3d4c2b1a09\"),\n"
+            "    \"ts\" : Date(1595800000123),\n"
+            "    \"level\" : \"INFO\",\n"
+            "    \"component\" : \"NETWORK\",\n"
+            "    \"msg\" : \"end connection 10.0.0.12:53412 (\\\"slow\\\" client)\\n\\tat line 7\",\n"
+            "    \"attr\" : {\n"
+            "        \"remote\" : \"10.0.0.12:53412\",\n"
+            "        \"connectionCount\" : 42,\n"
+            "        \"durationMillis\" : 1234.5,\n"
+            "        \"tags\" : [ \"a\", \"b\", \"\\u00e9t\\u00e9\" ]\n"
+            "    }\n"
+            "}",
+
+            "{ _id: 1001, customer: { name: 'Jane Roe', email: \"jane@example.com\" }, "
+            "items: [ { sku: \"X-1\", qty: 2, price: 9.99 }, { sku: \"Y-22\", qty: -1, price: 1e3 } ], "
+            "total: NumberLong(\"123456789012\"), paid: true, notes: null, big: 12345678901234567890, "
+            "small: -2147483649, hex: 0x1F, regex: /^ab+c\\/d/i, neg: -Infinity, nan: NaN }",
+
+            "{\"text\": \"Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor "
+            "incididunt ut labore et dolore magna aliqua. Ut enim ad minim veniam, quis nostrud exercitation\", "
+            "\"unicode\": \"\xd0\x9f\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82 \xe4\xb8\x96\xe7\x95\x8c\", "
+            "\"nested\": [[1, 2, [3, [4, {\"deep\": [ ]}]]], {}], \"$comment\": 'single \\'quoted\\''}"
+        };
+    }
+}
+
+TEST(JsonBench, fromjson_LargeDocument_Throughput)
+{
+    // One multi-MB document made of fixture documents, as if pasted into the editor
+    std::vector<std::string> const fixtures = fixtureDocuments();
+    std::string json = "{ \"docs\" : [\n";
+    for (int i = 0; json.size() < 8 * 1024 * 1024; ++i) {
+        if (i > 0)
+            json += ",\n";
+        json += fixtures[i % fixtures.size()];
+    }
+    json += "\n] }";
+
+    using std::chrono::steady_clock;
+    auto const start = steady_clock::now();
+    mongo::BSONObj const expected = mongo::fromjson(json);
+    auto const mongoDone = steady_clock::now();
+    mongo::BSONObj const actual = mongo::Robomongo::fromjson(json);
+    auto const done = steady_clock::now();
+
+    EXPECT_TRUE(expected.binaryEqual(actual));
+
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    std::cout << "[ BENCH    ] " << json.size() << " bytes of JSON; "
+              << "mongo::fromjson " << duration_cast<microseconds>(mongoDone - start).count() << " us, "
+              << "Robomongo::fromjson " << duration_cast<microseconds>(done - mongoDone).count() << " us"
+              << std::endl;
+}
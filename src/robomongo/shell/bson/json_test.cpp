@@ -0,0 +1,157 @@
+#include "gtest/gtest.h"
+#include "robomongo/shell/bson/json.h"
+#include "robomongo/core/utils/BsonUtils.h"
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/json.h"
+#include "mongo/db/jsobj.h"
+
+namespace
+{
+    // Documents of the kind users paste into the editor: log events,
+    // orders with nested items, and mixed extended JSON values.
+    std::vector<std::string> fixtureDocuments()
+    {
+        return {
+            "{\n"
+            "    \"_id\" : ObjectId(\"5f1d7c3e9b1e8a3d4c2b1a09\"),\n"
+            "    \"ts\" : Date(1595800000123),\n"
+            "    \"level\" : \"INFO\",\n"
+            "    \"component\" : \"NETWORK\",\n"
+            "    \"msg\" : \"end connection 10.0.0.12:53412 (\\\"slow\\\" client)\\n\\tat line 7\",\n"
+            "    \"attr\" : {\n"
+            "        \"remote\" : \"10.0.0.12:53412\",\n"
+            "        \"connectionCount\" : 42,\n"
+            "        \"durationMillis\" : 1234.5,\n"
+            "        \"tags\" : [ \"a\", \"b\", \"\\u00e9t\\u00e9\" ]\n"
+            "    }\n"
+            "}",
+
+            "{ _id: 1001, customer: { name: 'Jane Roe', email: \"jane@example.com\" }, "
+            "items: [ { sku: \"X-1\", qty: 2, price: 9.99 }, { sku: \"Y-22\", qty: -1, price: 1e3 } ], "
+            "total: NumberLong(\"123456789012\"), paid: true, notes: null, big: 12345678901234567890, "
+            "small: -2147483649, hex: 0x1F, regex: /^ab+c\\/d/i, neg: -Infinity, nan: NaN }",
+
+            "{\"text\": \"Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor "
+            "incididunt ut labore et dolore magna aliqua. Ut enim ad minim veniam, quis nostrud exercitation\", "
+            "\"unicode\": \"\xd0\x9f\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82 \xe4\xb8\x96\xe7\x95\x8c\", "
+            "\"nested\": [[1, 2, [3, [4, {\"deep\": [ ]}]]], {}], \"$comment\": 'single \\'quoted\\''}"
+        };
+    }
+
+    // Bytes of UUID 00112233-4455-6677-8899-aabbccddeeff in the given byte order
+    mongo::BSONObj uuidDocument(mongo::BinDataType type, const unsigned char (&order)[16])
+    {
+        char bytes[16];
+        for (int i = 0; i < 16; ++i)
+            bytes[i] = static_cast<char>(order[i] * 0x11);
+
+        mongo::BSONObjBuilder builder;
+        builder.appendBinData("u", 16, type, bytes);
+        return builder.obj();
+    }
+
+    const unsigned char plainOrder[16] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+    const unsigned char javaOrder[16] = { 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8 };
+    const unsigned char csharpOrder[16] = { 3, 2, 1, 0, 5, 4, 7, 6, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+    // Shell tokens of Robomongo, the document they are parsed into, and UUID encoding
+    // that prints the document back with the same token
+    struct TokenCase {
+        std::string json;
+        mongo::BSONObj expected;
+        Robomongo::UUIDEncoding encoding;
+    };
+
+    std::vector<TokenCase> tokenCases()
+    {
+        mongo::OID const oid("5a1b2c3d4e5f60718293a4b5");
+        mongo::BSONObj const ref = BSON("r" << BSON("$ref" << "coll" << "$id" << oid));
+        char const uuid[] = "\"00112233-4455-6677-8899-aabbccddeeff\"";
+
+        return {
+            { "{ d: ISODate(\"2020-01-02T03:04:05.678Z\") }",
+              BSON("d" << mongo::Date_t::fromMillisSinceEpoch(1577934245678LL)), Robomongo::DefaultEncoding },
+            // Beyond dates supported by ISODate, printed back as Date
+            { "{ d: Date(9300000000000) }",
+              BSON("d" << mongo::Date_t::fromMillisSinceEpoch(9300000000000LL)), Robomongo::DefaultEncoding },
+            { std::string("{ u: UUID(") + uuid + ") }",
+              uuidDocument(mongo::newUUID, plainOrder), Robomongo::DefaultEncoding },
+            { std::string("{ u: LUUID(") + uuid + ") }",
+              uuidDocument(mongo::bdtUUID, plainOrder), Robomongo::DefaultEncoding },
+            { std::string("{ u: JUUID(") + uuid + ") }",
+              uuidDocument(mongo::bdtUUID, javaOrder), Robomongo::JavaLegacy },
+            { std::string("{ u: NUUID(") + uuid + ") }",
+              uuidDocument(mongo::bdtUUID, csharpOrder), Robomongo::CSharpLegacy },
+            { std::string("{ u: CSUUID(") + uuid + ") }",
+              uuidDocument(mongo::bdtUUID, csharpOrder), Robomongo::CSharpLegacy },
+            { std::string("{ u: PYUUID(") + uuid + ") }",
+              uuidDocument(mongo::bdtUUID, plainOrder), Robomongo::PythonLegacy },
+            { "{ n: NumberDecimal(\"1234.5678\") }",
+              BSON("n" << mongo::Decimal128("1234.5678")), Robomongo::DefaultEncoding },
+            { "{ r: DBRef(\"coll\", ObjectId(\"5a1b2c3d4e5f60718293a4b5\")) }",
+              ref, Robomongo::DefaultEncoding },
+            { "{ r: Dbref(\"coll\", ObjectId(\"5a1b2c3d4e5f60718293a4b5\")) }",
+              ref, Robomongo::DefaultEncoding },
+            { "{ t: Timestamp(100, 2) }",
+              BSON("t" << mongo::Timestamp(100, 2)), Robomongo::DefaultEncoding },
+            { "{ x: undefined }",
+              BSON("x" << mongo::BSONUndefined), Robomongo::DefaultEncoding },
+            { "{ p: Infinity, m: -Infinity }",
+              BSON("p" << std::numeric_limits<double>::infinity()
+                   << "m" << -std::numeric_limits<double>::infinity()), Robomongo::DefaultEncoding }
+        };
+    }
+}
+
+TEST(JsonTests, fromjson_FixtureDocuments_MatchesMongoFromjson)
+{
+    for (const std::string &json : fixtureDocuments()) {
+        mongo::BSONObj const expected = mongo::fromjson(json);
+        mongo::BSONObj const actual = mongo::Robomongo::fromjson(json);
+        EXPECT_TRUE(expected.binaryEqual(actual)) << json << "\n" << expected.toString() << "\n" << actual.toString();
+    }
+}
+
+TEST(JsonTests, fromjson_ShellTokens_ParseToExpectedDocuments)
+{
+    for (const TokenCase &c : tokenCases()) {
+        mongo::BSONObj const actual = mongo::Robomongo::fromjson(c.json);
+        EXPECT_TRUE(c.expected.binaryEqual(actual)) << c.json << "\n" << actual.toString();
+    }
+}
+
+// Text shown by Robomongo is parsed back into the same document
+TEST(JsonTests, fromjson_ShellTokens_RoundTripThroughJsonString)
+{
+    for (const TokenCase &c : tokenCases()) {
+        std::string const json = Robomongo::BsonUtils::jsonString(c.expected, mongo::TenGen, 1, c.encoding, Robomongo::Utc);
+        mongo::BSONObj const actual = mongo::Robomongo::fromjson(json);
+        EXPECT_TRUE(c.expected.binaryEqual(actual)) << c.json << "\n" << json;
+    }
+}
+
+TEST(JsonTests, fromjson_ConcatenatedDocuments_ReportsLength)
+{
+    std::string const json = "{ a: 1 }   { b: \"two\" }";
+
+    int len = 0;
+    mongo::BSONObj const first = mongo::Robomongo::fromjson(json.c_str(), &len);
+    EXPECT_EQ(8, len);
+    EXPECT_EQ(1, first.getIntField("a"));
+
+    mongo::BSONObj const second = mongo::Robomongo::fromjson(json.c_str() + len, &len);
+    EXPECT_EQ(std::string("two"), second.getStringField("b"));
+}
+
+TEST(JsonTests, fromjson_Errors_Throw)
+{
+    EXPECT_ANY_THROW(mongo::Robomongo::fromjson("{ a: \"unterminated }"));
+    EXPECT_ANY_THROW(mongo::Robomongo::fromjson("{ a: \"control \x01\" }"));
+    EXPECT_ANY_THROW(mongo::Robomongo::fromjson("{ 1a: 1 }"));
+    EXPECT_ANY_THROW(mongo::Robomongo::fromjson("{ a: nul }"));
+    EXPECT_ANY_THROW(mongo::Robomongo::fromjson("{ a: 1"));
+}